@@ -3,6 +3,8 @@
 #include "core/io/input.h"
 #include "core/io/resource_importer.h"
 #include "core/object/command_queue.h"
+#include "core/object/thread_safe_command_queue.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/display_manager.h"
 #include "core/os/os.h"
 #include "core/register_core_types.h"
@@ -14,6 +16,8 @@ static Input *inputs = nullptr;
 static ResourceImporter *resource_importer = nullptr;
 static DisplayManager *display_manager = nullptr;
 static GlobalCommandQueue *command_queue = nullptr;
+static ThreadSafeCommandQueue *thread_safe_command_queue = nullptr;
+static WorkerThreadPool *worker_thread_pool = nullptr;
 
 static String version_str;
 static String rendering_backend = "";
@@ -55,6 +59,8 @@ void core_print_help() {
 	print_help_option("-v --verbose",
 					  "Loads the engine in verbose printing mode, putting far more information into the console.");
 	print_help_option("--version", "Prints the current version of the application");
+	print_help_option("--worker-threads",
+					  "Set the number of worker threads. Defaults to one fewer than the number of CPU cores.");
 
 	print_help_option("Windowing options:", "", true);
 	print_help_option("--width", "Set the width of the window to a given amount");
@@ -85,6 +91,7 @@ Error core_initialize(int argc, char *argv[]) {
 						  VICTORIA_BUILD_OS);
 
 	Vector2i window_size = {1280, 720};
+	int worker_threads = -1;
 
 	register_core_types();
 
@@ -130,6 +137,11 @@ Error core_initialize(int argc, char *argv[]) {
 			window_size.y = e->get().to_int();
 		}
 
+		if (arg == "--worker-threads") {
+			e = e->next();
+			worker_threads = e->get().to_int();
+		}
+
 		if (arg == "--rendering-driver") {
 			rendering_backend = e->next()->get();
 			e = e->next();
@@ -150,6 +162,11 @@ Error core_initialize(int argc, char *argv[]) {
 	} else {
 		command_queue = vnew(GlobalCommandQueue);
 	}
+	thread_safe_command_queue = vnew(ThreadSafeCommandQueue);
+
+	worker_thread_pool = vnew(WorkerThreadPool);
+	worker_thread_pool->init(worker_threads);
+	print_verbose(vformat("Running %u worker threads.", worker_thread_pool->get_thread_count()));
 
 	// Set backend to OpenGL native if none is found
 	if (rendering_backend.is_empty()) {
@@ -183,8 +200,18 @@ Error core_initialize(int argc, char *argv[]) {
 void core_finalize() {
 	DisplayManager::get_singleton()->finalize();
 
+	// Runs any tasks still pending before the rest of the engine is torn down.
+	vdelete(worker_thread_pool);
+
+	// The worker threads are gone, so nothing can push to the queue any more.
+	thread_safe_command_queue->flush();
+	vdelete(thread_safe_command_queue);
+
 	// Clear command queue if we own it.
 	if (command_queue) {
+		print_verbose(vformat("Command queue peaked at %u bytes, using %u pages.",
+							  command_queue->get_high_water_mark(),
+							  command_queue->get_page_count()));
 		command_queue->flush();
 		vdelete(command_queue);
 	}
@@ -193,5 +220,7 @@ void core_finalize() {
 	vdelete(resource_importer);
 	vdelete(display_manager);
 
+	unregister_core_types();
+
 	OS::destroy();
 }
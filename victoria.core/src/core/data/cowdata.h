@@ -1,13 +1,13 @@
 #pragma once
 
-#pragma once
-
 #include "atomic_counter.h"
 
 #include "core/error/error_macros.h"
 #include "core/os/memory.h"
 #include "core/typedefs.h"
 
+#include <type_traits>
+
 /**
  * @brief A vector-like class that uses copy-on-write semantics for various operations, as well as taking ownership of
  * all data that is passed to it. For a class that is intended for end-users, see `core/data/vector.h`.
@@ -20,7 +20,11 @@ private:
 	// The refcount offset pointer.
 	static constexpr size_t REFC_OFFSET = 0;
 	static constexpr size_t SIZE_OFFSET = REFC_OFFSET + sizeof(AtomicCounter<uint64_t>);
-	static constexpr size_t DATA_OFFSET = SIZE_OFFSET + sizeof(uint64_t);
+	static constexpr size_t CAPACITY_OFFSET = SIZE_OFFSET + sizeof(uint64_t);
+	static constexpr size_t DATA_OFFSET = CAPACITY_OFFSET + sizeof(uint64_t);
+
+	// `String` is the only user of `CoWData<char>`, so its buffers are accounted for separately.
+	static constexpr MemoryTag MEMORY_TAG = std::is_same_v<T, char> ? MEMORY_TAG_STRING : MEMORY_TAG_CONTAINER;
 
 	// The internal pointer that makes up the actual array in memory
 	mutable T *_ptr = nullptr;
@@ -41,6 +45,27 @@ private:
 		return (uint64_t *)(((uint8_t *)_ptr) - DATA_OFFSET + SIZE_OFFSET);
 	}
 
+	/**
+	 * @brief Gets the number of elements the buffer can hold before it needs to be reallocated. Assumes the pointer is
+	 * not null.
+	 * @return A pointer to the element capacity.
+	 */
+	FORCE_INLINE uint64_t *_get_capacity() const {
+		return (uint64_t *)(((uint8_t *)_ptr) - DATA_OFFSET + CAPACITY_OFFSET);
+	}
+
+	/**
+	 * @brief Obtains the capacity to grow the buffer to so that it can hold at least `p_min_capacity` elements. The
+	 * capacity grows by a factor of 1.5 so that repeated appends only reallocate a logarithmic number of times.
+	 * @param p_min_capacity The smallest capacity that would be acceptable.
+	 * @return The capacity to reallocate the buffer to.
+	 */
+	FORCE_INLINE uint64_t _get_grown_capacity(uint64_t p_min_capacity) const {
+		uint64_t capacity = *_get_capacity();
+		capacity += (capacity >> 1) + 1;
+		return capacity > p_min_capacity ? capacity : p_min_capacity;
+	}
+
 	/**
 	 * @brief Private initializer method. Unreferences any data currently held, and copies the pointer to the incoming
 	 * vector. Does not fire if the two are the same.
@@ -64,25 +89,37 @@ private:
 	/**
 	 * @brief Copies data from the current buffer to a newly allocated one, by forking the current. Dereferences data
 	 * by forcing the old pointer to go out of scope, which if it is the only one watching the data will cause a free.
-	 * @param p_count The number of elements to copy from the old pointer.
+	 * The new buffer's size is set to the number of elements copied over.
+	 * @param p_old_count The number of elements to copy from the old pointer.
+	 * @param p_new_capacity The capacity of the new buffer. Elements past this capacity are not copied.
 	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` on failure, which is a likely crash condition.
 	 */
-	Error _copy_to_new_buffer(uint64_t p_old_count, uint64_t p_new_count);
+	Error _copy_to_new_buffer(uint64_t p_old_count, uint64_t p_new_capacity);
 
 	/**
-	 * @brief Allocates a new pointer to the current buffer, as well as placing a new AtomicCounter in its slot and
-	 * setting the element count to the proper value.
-	 * @param p_element_count The new element count for the buffer.
+	 * @brief Allocates a new pointer to the current buffer, as well as placing a new AtomicCounter in its slot. The
+	 * element count is set to zero, and the capacity to the given value.
+	 * @param p_capacity The number of elements the new buffer can hold.
 	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` if failed, which should crash.
 	 */
-	Error _alloc_buffer(uint64_t p_size);
+	Error _alloc_buffer(uint64_t p_capacity);
 
 	/**
-	 * @brief Reallocates the current buffer to a new size.
-	 * @param p_element_count The new number of elements in the buffer.
+	 * @brief Reallocates the current buffer to a new capacity. Does not modify the element count.
+	 * @param p_capacity The new number of elements the buffer can hold.
 	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` on failure, which should crash.
 	 */
-	Error _realloc_buffer(uint64_t p_size);
+	Error _realloc_buffer(uint64_t p_capacity);
+
+	/**
+	 * @brief Ensures that the buffer exists, is only referenced by this object and can hold at least the given number
+	 * of elements. Shared buffers are copied into a new buffer, and unique buffers are grown geometrically unless
+	 * `p_exact` is set.
+	 * @param p_min_capacity The number of elements the buffer needs to be able to hold.
+	 * @param p_exact Whether to allocate exactly `p_min_capacity` elements rather than growing geometrically.
+	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` on failure, which should crash.
+	 */
+	Error _reserve_unique(uint64_t p_min_capacity, bool p_exact);
 
 public:
 	/**
@@ -158,6 +195,14 @@ public:
 		return _ptr == nullptr || *_get_size() == 0;
 	}
 
+	/**
+	 * @brief Gets the number of elements the vector can hold before it needs to reallocate its buffer.
+	 * @returns The capacity of the vector, which is always greater than or equal to its size.
+	 */
+	FORCE_INLINE int64_t get_capacity() const {
+		return _ptr ? *_get_capacity() : 0;
+	}
+
 	/**
 	 * @brief Obtains the number of references to the given vector.
 	 * @return The number of references to the given vector.
@@ -192,6 +237,20 @@ public:
 	 */
 	Error resize(int64_t p_new_size);
 
+	/**
+	 * @brief Allocates enough memory for the vector to hold the given number of elements without reallocating. Does
+	 * not change the size of the vector, and never shrinks the buffer.
+	 * @param p_capacity The number of elements to reserve memory for.
+	 * @return `OK` on success, and an error code if the memory could not be allocated.
+	 */
+	Error reserve(int64_t p_capacity);
+
+	/**
+	 * @brief Reallocates the buffer so that its capacity matches its size, freeing any memory reserved for future
+	 * elements. Does nothing if the buffer is shared with another vector.
+	 */
+	void shrink_to_fit();
+
 	/**
 	 * @brief Removes an item at a given index in the vector.
 	 * @param index The index into the vector to remove from
@@ -244,11 +303,11 @@ public:
 	 * @param p_init The initializer list to construct the vector from
 	 */
 	FORCE_INLINE CoWData(std::initializer_list<T> p_init) {
-		ERR_FAIL_COND(resize(p_init.size() * sizeof(T)) != OK);
+		ERR_FAIL_COND(_reserve_unique(p_init.size(), true) != OK);
 
 		int i = 0;
 		for (const T &element : p_init) {
-			_ptr[i] = element;
+			vnew_placement(_ptr + i, T(element));
 
 			i++;
 		}
@@ -300,9 +359,10 @@ void CoWData<T>::_unref() {
 	}
 
 	// Set pointer to null and free a copy of it.
+	uint64_t alloc_size = (*_get_capacity() * sizeof(T)) + DATA_OFFSET;
 	T *prev = _ptr;
 	_ptr = nullptr;
-	Memory::vfree((((uint8_t *)prev) - DATA_OFFSET));
+	Memory::vfree((((uint8_t *)prev) - DATA_OFFSET), alloc_size);
 }
 
 template <typename T>
@@ -314,6 +374,24 @@ Error CoWData<T>::_copy_on_write() {
 	return _copy_to_new_buffer(size(), size());
 }
 
+template <typename T>
+Error CoWData<T>::_reserve_unique(uint64_t p_min_capacity, bool p_exact) {
+	if (!_ptr) {
+		return _alloc_buffer(p_min_capacity);
+	}
+
+	if (_get_refc()->get() != 1) {
+		const uint64_t current_size = size();
+		return _copy_to_new_buffer(current_size, current_size > p_min_capacity ? current_size : p_min_capacity);
+	}
+
+	if (*_get_capacity() >= p_min_capacity) {
+		return OK;
+	}
+
+	return _realloc_buffer(p_exact ? p_min_capacity : _get_grown_capacity(p_min_capacity));
+}
+
 template <typename T>
 Error CoWData<T>::resize(int64_t p_new_size) {
 	ERR_FAIL_COND_R(p_new_size < 0, ERR_INVALID_PARAMETER);
@@ -325,25 +403,13 @@ Error CoWData<T>::resize(int64_t p_new_size) {
 	}
 
 	if (current_size < p_new_size) {
-		if (!_ptr) {
-			Error err = _alloc_buffer(p_new_size);
-			if (err) {
-				return err;
-			}
-		} else if (_get_refc()->get() == 1) {
-			Error err = _realloc_buffer(p_new_size);
-			if (err) {
-				return err;
-			}
-		} else {
-			Error err = _copy_to_new_buffer(current_size, p_new_size);
-			if (err) {
-				return err;
-			}
+		Error err = _reserve_unique(p_new_size, false);
+		if (err) {
+			return err;
 		}
 
 		if constexpr (!std::is_trivially_constructible_v<T>) {
-			for (int i = current_size; i < p_new_size; i++) {
+			for (int64_t i = current_size; i < p_new_size; i++) {
 				vnew_placement(_ptr + i, T());
 			}
 		}
@@ -354,60 +420,93 @@ Error CoWData<T>::resize(int64_t p_new_size) {
 			return OK;
 		} else if (_get_refc()->get() == 1) {
 			if constexpr (!std::is_trivially_destructible_v<T>) {
-				for (uint64_t i = p_new_size; i < *_get_size(); i++) {
+				for (int64_t i = p_new_size; i < current_size; i++) {
 					_ptr[i].~T();
 				}
 			}
-
-			Error err = _realloc_buffer(p_new_size);
+		} else {
+			Error err = _copy_to_new_buffer(p_new_size, p_new_size);
 			if (err) {
 				return err;
 			}
-		} else {
-			return _copy_to_new_buffer(current_size, p_new_size);
 		}
 	}
 
+	*_get_size() = p_new_size;
 	return OK;
 }
 
 template <typename T>
-Error CoWData<T>::_copy_to_new_buffer(uint64_t p_old_count, uint64_t p_new_count) {
+Error CoWData<T>::reserve(int64_t p_capacity) {
+	ERR_FAIL_COND_R(p_capacity < 0, ERR_INVALID_PARAMETER);
+
+	if (p_capacity <= get_capacity() || p_capacity == 0) {
+		return OK;
+	}
+
+	return _reserve_unique(p_capacity, true);
+}
+
+template <typename T>
+void CoWData<T>::shrink_to_fit() {
+	if (!_ptr || _get_refc()->get() != 1) {
+		return;
+	}
+
+	const uint64_t current_size = size();
+	if (current_size == 0) {
+		_unref();
+		return;
+	}
+
+	if (*_get_capacity() > current_size) {
+		CRASH_COND(_realloc_buffer(current_size) != OK);
+	}
+}
+
+template <typename T>
+Error CoWData<T>::_copy_to_new_buffer(uint64_t p_old_count, uint64_t p_new_capacity) {
 	const CoWData prev;
 	prev._ptr = _ptr;
 	_ptr = nullptr;
 
-	Error err = _alloc_buffer(p_new_count);
+	Error err = _alloc_buffer(p_new_capacity);
 	if (err) {
 		_ptr = prev._ptr;
 		prev._ptr = nullptr;
 		return err;
 	}
 
-	memcpy_arr_placement(_ptr, prev._ptr, p_old_count > p_new_count ? p_new_count : p_old_count);
+	const uint64_t count = p_old_count > p_new_capacity ? p_new_capacity : p_old_count;
+	memcpy_arr_placement(_ptr, prev._ptr, count);
+	*_get_size() = count;
 	return OK;
 }
 
 template <typename T>
-Error CoWData<T>::_alloc_buffer(uint64_t p_element_count) {
-	T *ptr = (T *)Memory::vallocate((p_element_count * sizeof(T)) + DATA_OFFSET);
+Error CoWData<T>::_alloc_buffer(uint64_t p_capacity) {
+	T *ptr = (T *)Memory::vallocate((p_capacity * sizeof(T)) + DATA_OFFSET, MEMORY_TAG);
 	ERR_COND_NULL_R(ptr, ERR_OUT_OF_MEMORY);
 
 	_ptr = (T *)(((uint8_t *)ptr) + DATA_OFFSET);
 
 	new (_get_refc()) AtomicCounter<uint64_t>(1);
-	*_get_size() = p_element_count;
+	*_get_size() = 0;
+	*_get_capacity() = p_capacity;
 	return OK;
 }
 
 template <typename T>
-Error CoWData<T>::_realloc_buffer(uint64_t p_element_count) {
-	T *nptr = (T *)Memory::vreallocate(((uint8_t *)_ptr) - DATA_OFFSET, (p_element_count * sizeof(T)) + DATA_OFFSET);
+Error CoWData<T>::_realloc_buffer(uint64_t p_capacity) {
+	T *nptr = (T *)Memory::vreallocate(((uint8_t *)_ptr) - DATA_OFFSET,
+									   (*_get_capacity() * sizeof(T)) + DATA_OFFSET,
+									   (p_capacity * sizeof(T)) + DATA_OFFSET,
+									   MEMORY_TAG);
 	ERR_COND_NULL_R(nptr, ERR_OUT_OF_MEMORY);
 
 	_ptr = (T *)(((uint8_t *)nptr) + DATA_OFFSET);
 	ERR_FAIL_COND_R(_get_refc()->get() != 1, ERR_BUG);
-	*_get_size() = p_element_count;
+	*_get_capacity() = p_capacity;
 	return OK;
 }
 
@@ -427,59 +526,42 @@ void CoWData<T>::remove_at(int64_t p_index) {
 
 	if (_get_refc()->get() == 1) {
 		_ptr[p_index].~T();
-		// Copy data down to the current pointer position.
+		// Copy data down to the current pointer position. The capacity is kept for future insertions.
 		Memory::vmemmove(_ptr + p_index, _ptr + p_index + 1, (new_size - p_index) * sizeof(T));
-		// Delete content at the end of the buffer
-		Error err = _realloc_buffer(new_size);
-		CRASH_COND(err != OK);
 	} else {
-		// Copy data to a new buffer
-		T *other = _ptr;
-		_ptr = (T *)Memory::vallocate(new_size);
-		if (std::is_trivially_copyable_v<T>) {
-			Memory::vcopy_memory(_ptr, other, p_index * sizeof(T));
-			Memory::vcopy_memory(_ptr + p_index, other + p_index, (new_size - p_index) * sizeof(T));
-		} else {
-			for (int i = 0; i < p_index; i++) {
-				vnew_placement(_ptr + i, T(other[i]));
-			}
+		// Copy every element but the removed one into a new buffer
+		const CoWData prev;
+		prev._ptr = _ptr;
+		_ptr = nullptr;
 
-			for (uint64_t i = p_index; i < new_size; i++) {
-				vnew_placement(_ptr + i, T(other[i]));
-			}
+		Error err = _alloc_buffer(new_size);
+		if (err) {
+			_ptr = prev._ptr;
+			prev._ptr = nullptr;
+			CRASH_NOW_MSG("Failed to allocate a new buffer when removing an element.");
 		}
+
+		memcpy_arr_placement(_ptr, prev._ptr, p_index);
+		memcpy_arr_placement(_ptr + p_index, prev._ptr + p_index + 1, new_size - p_index);
 	}
+
+	*_get_size() = new_size;
 }
 
 template <typename T>
 Error CoWData<T>::insert(T &&p_item, int64_t p_index) {
-	const int64_t new_size = size() + 1;
-	ERR_OUT_OF_BOUNDS_R(p_index, new_size, ERR_INVALID_PARAMETER);
-
 	const int64_t old_size = size();
+	const int64_t new_size = old_size + 1;
+	ERR_OUT_OF_BOUNDS_R(p_index, new_size, ERR_INVALID_PARAMETER);
 
-	if (!_ptr) {
-		Error err = _alloc_buffer(new_size);
-		if (err) {
-			return err;
-		}
-	} else {
-		if (_get_refc()->get() == 1) {
-			Error err = _realloc_buffer(new_size);
-			if (err) {
-				return err;
-			}
-
-		} else {
-			Error err = _copy_to_new_buffer(old_size, new_size);
-			if (err) {
-				return err;
-			}
-		}
-		Memory::vmemmove(_ptr + p_index + 1, _ptr + p_index, (old_size - p_index) * sizeof(T));
+	Error err = _reserve_unique(new_size, false);
+	if (err) {
+		return err;
 	}
 
+	Memory::vmemmove(_ptr + p_index + 1, _ptr + p_index, (old_size - p_index) * sizeof(T));
 	vnew_placement(_ptr + p_index, T(std::move(p_item)));
+	*_get_size() = new_size;
 	return OK;
 }
 
@@ -487,20 +569,12 @@ template <typename T>
 Error CoWData<T>::push_back(T &&p_item) {
 	const uint64_t new_size = size() + 1;
 
-	if (!_ptr) {
-		_alloc_buffer(1);
-	} else if (_get_refc()->get() == 1) {
-		Error err = _realloc_buffer(new_size);
-		if (err != OK) {
-			return err;
-		}
-	} else {
-		Error err = _copy_to_new_buffer(size(), new_size);
-		if (err != OK) {
-			return err;
-		}
+	Error err = _reserve_unique(new_size, false);
+	if (err != OK) {
+		return err;
 	}
 
 	vnew_placement(_ptr + new_size - 1, T(std::move(p_item)));
+	*_get_size() = new_size;
 	return OK;
 }
@@ -0,0 +1,702 @@
+#pragma once
+
+#include "hashfuncs.h"
+#include "key_value.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <initializer_list>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define FLAT_HASHTABLE_USE_SSE2
+#	include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+
+/**
+ * @brief Group of 16 control bytes from a `FlatHashTable`, compared at once. Each control byte is either `EMPTY`,
+ * `DELETED`, or holds the lower 7 bits of the hash of the key in its slot, which lets a lookup discard almost every
+ * non-matching slot without touching the slot itself. Uses SSE2 when it is available, and plain loops otherwise.
+ */
+struct FlatHashGroup {
+	static constexpr uint32_t SIZE = 16;
+
+	static constexpr int8_t EMPTY = -128;
+	static constexpr int8_t DELETED = -2;
+
+#ifdef FLAT_HASHTABLE_USE_SSE2
+	__m128i ctrl;
+
+	FORCE_INLINE uint32_t match(int8_t p_h2) const {
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl));
+	}
+
+	// Empty and deleted slots are the only ones with their sign bit set.
+	FORCE_INLINE uint32_t match_empty_or_deleted() const {
+		return (uint32_t)_mm_movemask_epi8(ctrl);
+	}
+
+	explicit FlatHashGroup(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128((const __m128i *)p_ctrl);
+	}
+#else
+	const int8_t *ctrl;
+
+	FORCE_INLINE uint32_t match(int8_t p_h2) const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			mask |= (uint32_t)(ctrl[i] == p_h2) << i;
+		}
+		return mask;
+	}
+
+	FORCE_INLINE uint32_t match_empty_or_deleted() const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			mask |= (uint32_t)(ctrl[i] < 0) << i;
+		}
+		return mask;
+	}
+
+	explicit FlatHashGroup(const int8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+#endif
+
+	FORCE_INLINE uint32_t match_empty() const {
+		return match(EMPTY);
+	}
+
+	/**
+	 * @brief Obtains the index of the lowest set bit in a non-zero match mask.
+	 */
+	static FORCE_INLINE uint32_t first(uint32_t p_mask) {
+#ifdef _MSC_VER
+		unsigned long idx;
+		_BitScanForward(&idx, p_mask);
+		return idx;
+#else
+		return __builtin_ctz(p_mask);
+#endif
+	}
+
+	/**
+	 * @brief Obtains the number of unset bits above the highest set bit in a non-zero match mask.
+	 */
+	static FORCE_INLINE uint32_t leading_zeros(uint32_t p_mask) {
+#ifdef _MSC_VER
+		unsigned long idx;
+		_BitScanReverse(&idx, p_mask);
+		return SIZE - 1 - idx;
+#else
+		return __builtin_clz(p_mask) - (32 - SIZE);
+#endif
+	}
+};
+
+/**
+ * @brief Hashtable using open addressing with keys and values stored inline, in the style of a Swiss table. A separate
+ * array of control bytes is probed 16 slots at a time, so most lookups touch a single cache line of metadata and then
+ * the slot holding the key. Unlike `HashTable`, pointers and references to values are NOT stable: any insertion may
+ * rehash the table and move its contents, so they should not be held onto across insertions. Iteration order is also
+ * unspecified. The capacity is always a power of two, and the table grows once it is 7/8 full.
+ * `TKey` must have a valid `Hasher` function, like with `HashTable`.
+ */
+template <typename TKey, typename TValue, typename Hasher = HasherDefault>
+class FlatHashTable {
+	typedef KeyValue<TKey, TValue> Pair;
+
+	// Control bytes, one per slot. The first group is mirrored past the end so that groups can be read from any index
+	// without wrapping around.
+	int8_t *ctrl = nullptr;
+	// Slots holding the key-value pairs. Only constructed where the control byte is full.
+	KeyValue<TKey, TValue> *slots = nullptr;
+
+	// The number of slots, always zero or a power of two no smaller than a group.
+	uint32_t capacity = 0;
+	// The number of elements in the table.
+	uint32_t element_count = 0;
+	// The number of empty slots that can still be filled before the table needs to rehash.
+	uint32_t growth_left = 0;
+
+	static FORCE_INLINE uint32_t _get_max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	/**
+	 * @brief Hashes the given key and mixes the result. Both halves of the hash are used separately, so the mix makes
+	 * sure that hashes which only differ in a few bits (like `hash_djb2` of similar strings) still spread out over the
+	 * table.
+	 */
+	FORCE_INLINE uint32_t _hash(const TKey &p_key) const {
+		uint32_t h = Hasher::hash(p_key);
+		h ^= h >> 16;
+		h *= 0x85ebca6b;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35;
+		h ^= h >> 16;
+		return h;
+	}
+
+	// The upper bits of the hash select where probing begins, the lower 7 bits are stored in the control byte.
+	static FORCE_INLINE uint32_t _h1(uint32_t p_hash) {
+		return p_hash >> 7;
+	}
+
+	static FORCE_INLINE int8_t _h2(uint32_t p_hash) {
+		return (int8_t)(p_hash & 0x7f);
+	}
+
+	FORCE_INLINE void _set_ctrl(uint32_t p_idx, int8_t p_value) {
+		ctrl[p_idx] = p_value;
+		if (p_idx < FlatHashGroup::SIZE) {
+			ctrl[capacity + p_idx] = p_value;
+		}
+	}
+
+	/**
+	 * @brief Finds the slot holding the given key.
+	 * @param p_key The key to look for.
+	 * @param p_hash The precalculated hash of the key.
+	 * @param r_idx The index of the slot. Undefined if the function returns `false`.
+	 * @return `true` if the key exists in the table, `false` if not.
+	 */
+	bool _find_index(const TKey &p_key, uint32_t p_hash, uint32_t &r_idx) const {
+		if (element_count == 0) {
+			return false;
+		}
+
+		const uint32_t mask = capacity - 1;
+		const int8_t h2 = _h2(p_hash);
+		uint32_t offset = _h1(p_hash) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			FlatHashGroup g(ctrl + offset);
+			uint32_t matches = g.match(h2);
+			while (matches) {
+				uint32_t idx = (offset + FlatHashGroup::first(matches)) & mask;
+				if (likely(slots[idx].key == p_key)) {
+					r_idx = idx;
+					return true;
+				}
+				matches &= matches - 1;
+			}
+
+			// An empty slot means the key would have been placed here, so it cannot be further along
+			if (g.match_empty()) {
+				return false;
+			}
+
+			step += FlatHashGroup::SIZE;
+			offset = (offset + step) & mask;
+		}
+	}
+
+	/**
+	 * @brief Finds the first empty or deleted slot along the probe sequence of a hash. The table must have at least
+	 * one such slot.
+	 * @param p_hash The hash to probe for.
+	 * @return The index of the free slot.
+	 */
+	uint32_t _find_free_slot(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t offset = _h1(p_hash) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			uint32_t free = FlatHashGroup(ctrl + offset).match_empty_or_deleted();
+			if (free) {
+				return (offset + FlatHashGroup::first(free)) & mask;
+			}
+
+			step += FlatHashGroup::SIZE;
+			offset = (offset + step) & mask;
+		}
+	}
+
+	/**
+	 * @brief Moves every element into a newly allocated set of arrays. Removes all deleted slots along the way.
+	 * @param p_new_capacity The capacity of the new arrays. Must be a power of two no smaller than a group.
+	 */
+	void _rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		KeyValue<TKey, TValue> *old_slots = slots;
+		const uint32_t old_capacity = capacity;
+
+		ctrl = (int8_t *)Memory::vallocate(p_new_capacity + FlatHashGroup::SIZE, MEMORY_TAG_CONTAINER);
+		slots = (KeyValue<TKey, TValue> *)Memory::vallocate(p_new_capacity * sizeof(KeyValue<TKey, TValue>),
+															MEMORY_TAG_CONTAINER);
+		CRASH_COND_MSG(!ctrl || !slots, "Out of memory when resizing a FlatHashTable.");
+		Memory::vset_memory(ctrl, FlatHashGroup::EMPTY, p_new_capacity + FlatHashGroup::SIZE);
+		capacity = p_new_capacity;
+		growth_left = _get_max_load(capacity) - element_count;
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+
+			uint32_t h = _hash(old_slots[i].key);
+			uint32_t idx = _find_free_slot(h);
+			_set_ctrl(idx, _h2(h));
+			vnew_placement(slots + idx, Pair(std::move(old_slots[i])));
+			old_slots[i].~KeyValue<TKey, TValue>();
+		}
+
+		Memory::vfree(old_ctrl, old_capacity + FlatHashGroup::SIZE);
+		Memory::vfree(old_slots, old_capacity * sizeof(KeyValue<TKey, TValue>));
+	}
+
+	/**
+	 * @brief Makes room for one more element, either by growing the table or by clearing out deleted slots if enough
+	 * of them have built up.
+	 */
+	void _grow() {
+		if (capacity == 0) {
+			_rehash(FlatHashGroup::SIZE);
+		} else if (element_count * 2 <= _get_max_load(capacity)) {
+			_rehash(capacity);
+		} else {
+			_rehash(capacity * 2);
+		}
+	}
+
+	/**
+	 * @brief Inserts a key that is known not to exist in the table.
+	 * @param p_hash The precalculated hash of the key.
+	 * @param p_key The key to insert.
+	 * @param p_value The value to insert.
+	 * @return The index of the slot the pair was placed in.
+	 */
+	uint32_t _insert_new(uint32_t p_hash, const TKey &p_key, const TValue &p_value) {
+		uint32_t idx = capacity ? _find_free_slot(p_hash) : 0;
+		if (capacity == 0 || (growth_left == 0 && ctrl[idx] == FlatHashGroup::EMPTY)) {
+			// The key or value may be a reference into this table, so copy them before growing frees the slots.
+			Pair pair(p_key, p_value);
+			_grow();
+			return _place_new(_find_free_slot(p_hash), p_hash, std::move(pair));
+		}
+
+		return _place_new(idx, p_hash, Pair(p_key, p_value));
+	}
+
+	/**
+	 * @brief Moves a pair into a free slot found by `_find_free_slot()`.
+	 * @return The index of the slot.
+	 */
+	uint32_t _place_new(uint32_t p_idx, uint32_t p_hash, Pair &&p_pair) {
+		growth_left -= ctrl[p_idx] == FlatHashGroup::EMPTY;
+		_set_ctrl(p_idx, _h2(p_hash));
+		vnew_placement(slots + p_idx, Pair(std::move(p_pair)));
+		element_count++;
+		return p_idx;
+	}
+
+	/**
+	 * @brief Destroys every element, without freeing the arrays.
+	 */
+	void _destroy_elements() {
+		if constexpr (!std::is_trivially_destructible_v<KeyValue<TKey, TValue>>) {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (ctrl[i] >= 0) {
+					slots[i].~KeyValue<TKey, TValue>();
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Frees everything held by the table and resets it to its unallocated state.
+	 */
+	void _reset() {
+		if (ctrl) {
+			_destroy_elements();
+			Memory::vfree(ctrl, capacity + FlatHashGroup::SIZE);
+			Memory::vfree(slots, capacity * sizeof(KeyValue<TKey, TValue>));
+		}
+
+		ctrl = nullptr;
+		slots = nullptr;
+		capacity = 0;
+		element_count = 0;
+		growth_left = 0;
+	}
+
+	void _take_from(FlatHashTable &p_from) {
+		ctrl = p_from.ctrl;
+		slots = p_from.slots;
+		capacity = p_from.capacity;
+		element_count = p_from.element_count;
+		growth_left = p_from.growth_left;
+
+		p_from.ctrl = nullptr;
+		p_from.slots = nullptr;
+		p_from.capacity = 0;
+		p_from.element_count = 0;
+		p_from.growth_left = 0;
+	}
+
+public:
+	/**
+	 * @brief Checks to see if the number of elements in the `FlatHashTable` is zero.
+	 * @return `true` if yes, `false` if not.
+	 */
+	FORCE_INLINE bool is_empty() const {
+		return element_count == 0;
+	}
+
+	/**
+	 * @brief Obtains the number of elements present in the `FlatHashTable`.
+	 * @return The number of elements in the `FlatHashTable`.
+	 */
+	FORCE_INLINE int64_t size() const {
+		return element_count;
+	}
+
+	/**
+	 * @brief Obtains the number of slots in the `FlatHashTable`. This is zero until the first insertion, and a power
+	 * of two afterwards. Only 7/8 of the slots can be filled before the table grows.
+	 * @return The capacity of the `FlatHashTable`.
+	 */
+	FORCE_INLINE int64_t get_capacity() const {
+		return capacity;
+	}
+
+	/* Iterators */
+
+	// Iterator struct for non-constant usages. Walks the slots in memory order, skipping any that are not full.
+	struct Iterator {
+		FORCE_INLINE KeyValue<TKey, TValue> &operator*() const {
+			return *slot;
+		}
+		FORCE_INLINE KeyValue<TKey, TValue> *operator->() const {
+			return slot;
+		}
+
+		FORCE_INLINE Iterator &operator++() {
+			ctrl++;
+			slot++;
+			_skip_free();
+			return *this;
+		}
+
+		FORCE_INLINE bool operator==(const Iterator &p_other) const {
+			return ctrl == p_other.ctrl;
+		}
+		FORCE_INLINE bool operator!=(const Iterator &p_other) const {
+			return ctrl != p_other.ctrl;
+		}
+
+		Iterator(const int8_t *p_ctrl, const int8_t *p_end, KeyValue<TKey, TValue> *p_slot) {
+			ctrl = p_ctrl;
+			end = p_end;
+			slot = p_slot;
+			_skip_free();
+		}
+		Iterator() {}
+
+	private:
+		const int8_t *ctrl = nullptr;
+		const int8_t *end = nullptr;
+		KeyValue<TKey, TValue> *slot = nullptr;
+
+		FORCE_INLINE void _skip_free() {
+			while (ctrl != end && *ctrl < 0) {
+				ctrl++;
+				slot++;
+			}
+		}
+	};
+
+	// Constant iterator for constant usages
+	struct ConstIterator {
+		FORCE_INLINE const KeyValue<TKey, TValue> &operator*() const {
+			return *slot;
+		}
+		FORCE_INLINE const KeyValue<TKey, TValue> *operator->() const {
+			return slot;
+		}
+
+		FORCE_INLINE ConstIterator &operator++() {
+			ctrl++;
+			slot++;
+			_skip_free();
+			return *this;
+		}
+
+		FORCE_INLINE bool operator==(const ConstIterator &p_other) const {
+			return ctrl == p_other.ctrl;
+		}
+		FORCE_INLINE bool operator!=(const ConstIterator &p_other) const {
+			return ctrl != p_other.ctrl;
+		}
+
+		ConstIterator(const int8_t *p_ctrl, const int8_t *p_end, const KeyValue<TKey, TValue> *p_slot) {
+			ctrl = p_ctrl;
+			end = p_end;
+			slot = p_slot;
+			_skip_free();
+		}
+		ConstIterator() {}
+
+	private:
+		const int8_t *ctrl = nullptr;
+		const int8_t *end = nullptr;
+		const KeyValue<TKey, TValue> *slot = nullptr;
+
+		FORCE_INLINE void _skip_free() {
+			while (ctrl != end && *ctrl < 0) {
+				ctrl++;
+				slot++;
+			}
+		}
+	};
+
+	FORCE_INLINE Iterator begin() {
+		return Iterator(ctrl, ctrl + capacity, slots);
+	}
+
+	FORCE_INLINE Iterator end() {
+		return Iterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+	}
+
+	FORCE_INLINE ConstIterator begin() const {
+		return ConstIterator(ctrl, ctrl + capacity, slots);
+	}
+
+	FORCE_INLINE ConstIterator end() const {
+		return ConstIterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+	}
+
+	/* Getters and setters */
+
+	/**
+	 * @brief Obtains a reference to the value that is held by `p_key`. Crashes the engine if the key does not exist.
+	 * @param p_key The key to find the corresponding value of.
+	 * @return A reference to the value held by `p_key`.
+	 */
+	FORCE_INLINE TValue &get(const TKey &p_key) {
+		uint32_t idx = 0;
+		bool exists = _find_index(p_key, _hash(p_key), idx);
+		CRASH_COND_MSG(!exists, "FlatHashTable key could not be found.");
+		return slots[idx].value;
+	}
+
+	/**
+	 * @brief Obtains a constant reference to the value that is held by `p_key`. Crashes the engine if the key does not
+	 * exist.
+	 * @param p_key The key to find the corresponding value of.
+	 * @return A constant reference to the value held by `p_key`.
+	 */
+	FORCE_INLINE const TValue &get(const TKey &p_key) const {
+		uint32_t idx = 0;
+		bool exists = _find_index(p_key, _hash(p_key), idx);
+		CRASH_COND_MSG(!exists, "FlatHashTable key could not be found.");
+		return slots[idx].value;
+	}
+
+	/**
+	 * @brief Obtains a pointer to the value held by the given key. The pointer is invalidated by the next insertion.
+	 * @param p_key The key to find the data for.
+	 * @return A pointer to the value, or `nullptr` if the key does not exist in the `FlatHashTable`.
+	 */
+	FORCE_INLINE TValue *get_ptr(const TKey &p_key) {
+		uint32_t idx = 0;
+		if (_find_index(p_key, _hash(p_key), idx)) {
+			return &slots[idx].value;
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * @brief Obtains a constant pointer to the value held by the given key. The pointer is invalidated by the next
+	 * insertion.
+	 * @param p_key The key to find the data for.
+	 * @return A constant pointer to the value, or `nullptr` if the key does not exist in the `FlatHashTable`.
+	 */
+	FORCE_INLINE const TValue *get_ptr(const TKey &p_key) const {
+		uint32_t idx = 0;
+		if (_find_index(p_key, _hash(p_key), idx)) {
+			return &slots[idx].value;
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * @brief Obtains a reference to the value held by the given key. If the value does not exist, a key-value pair is
+	 * inserted with the default for the value set.
+	 * @param p_key The key to find the data for.
+	 * @return A reference to the data in the `FlatHashTable`.
+	 */
+	FORCE_INLINE TValue &operator[](const TKey &p_key) {
+		uint32_t h = _hash(p_key);
+		uint32_t idx = 0;
+		if (!_find_index(p_key, h, idx)) {
+			idx = _insert_new(h, p_key, TValue());
+		}
+
+		return slots[idx].value;
+	}
+
+	/**
+	 * @brief Obtains a constant reference to the value held by the given key. Crashes the engine if the key does not
+	 * exist.
+	 * @param p_key The key to check for the data of.
+	 * @return A constant reference to the data in the `FlatHashTable`.
+	 */
+	FORCE_INLINE const TValue &operator[](const TKey &p_key) const {
+		return get(p_key);
+	}
+
+	/**
+	 * @brief Checks to see if the given key exists inside of the `FlatHashTable`.
+	 * @param p_key The key to check as to whether it is valid.
+	 * @return `true` if the key leads to valid data, `false` if not.
+	 */
+	FORCE_INLINE bool has(const TKey &p_key) const {
+		uint32_t tmp;
+		return _find_index(p_key, _hash(p_key), tmp);
+	}
+
+	/**
+	 * @brief Inserts a key-value pair into the `FlatHashTable`. If the key already exists, its value is overwritten.
+	 * @param p_key The key of the pair.
+	 * @param p_value The value of the pair.
+	 */
+	FORCE_INLINE void insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t h = _hash(p_key);
+		uint32_t idx = 0;
+		if (_find_index(p_key, h, idx)) {
+			slots[idx].value = p_value;
+			return;
+		}
+
+		_insert_new(h, p_key, p_value);
+	}
+
+	/**
+	 * @brief Removes the given entry from the `FlatHashTable`, if it exists.
+	 * @param p_key The key corresponding to the entry to remove.
+	 * @return `true` if the entry existed and was deleted, `false` if it did not exist.
+	 */
+	bool erase(const TKey &p_key) {
+		uint32_t idx = 0;
+		if (!_find_index(p_key, _hash(p_key), idx)) {
+			return false;
+		}
+
+		slots[idx].~KeyValue<TKey, TValue>();
+		element_count--;
+
+		// If no group containing this slot was ever full, no probe has passed over it, so it can be marked empty
+		// rather than deleted and become reusable straight away.
+		const uint32_t idx_before = (idx - FlatHashGroup::SIZE) & (capacity - 1);
+		const uint32_t empty_before = FlatHashGroup(ctrl + idx_before).match_empty();
+		const uint32_t empty_after = FlatHashGroup(ctrl + idx).match_empty();
+		if (empty_before && empty_after &&
+			FlatHashGroup::first(empty_after) + FlatHashGroup::leading_zeros(empty_before) < FlatHashGroup::SIZE) {
+			_set_ctrl(idx, FlatHashGroup::EMPTY);
+			growth_left++;
+		} else {
+			_set_ctrl(idx, FlatHashGroup::DELETED);
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Clears any data currently held by the `FlatHashTable`. Memory is kept so that it can be refilled without
+	 * allocating.
+	 */
+	void clear() {
+		if (capacity == 0) {
+			return;
+		}
+
+		_destroy_elements();
+		Memory::vset_memory(ctrl, FlatHashGroup::EMPTY, capacity + FlatHashGroup::SIZE);
+		element_count = 0;
+		growth_left = _get_max_load(capacity);
+	}
+
+	/**
+	 * @brief Makes sure that the given number of elements can be held without the table needing to grow.
+	 * @param p_capacity The number of elements to make room for.
+	 */
+	void reserve(uint32_t p_capacity) {
+		if (p_capacity == 0) {
+			return;
+		}
+
+		uint32_t new_capacity = capacity ? capacity : FlatHashGroup::SIZE;
+		while (_get_max_load(new_capacity) < p_capacity) {
+			new_capacity *= 2;
+		}
+
+		if (new_capacity != capacity) {
+			_rehash(new_capacity);
+		}
+	}
+
+	/* Assignment operators */
+
+	void operator=(const FlatHashTable &p_other) {
+		if (this == &p_other) {
+			return;
+		}
+
+		clear();
+		reserve(p_other.element_count);
+		for (const KeyValue<TKey, TValue> &kv : p_other) {
+			_insert_new(_hash(kv.key), kv.key, kv.value);
+		}
+	}
+
+	void operator=(FlatHashTable &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+
+		_reset();
+		_take_from(p_from);
+	}
+
+	/* Constructors */
+
+	FlatHashTable() {}
+
+	FlatHashTable(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+
+	explicit FlatHashTable(const FlatHashTable &p_other) {
+		reserve(p_other.element_count);
+		for (const KeyValue<TKey, TValue> &kv : p_other) {
+			_insert_new(_hash(kv.key), kv.key, kv.value);
+		}
+	}
+
+	FlatHashTable(FlatHashTable &&p_other) {
+		_take_from(p_other);
+	}
+
+	FlatHashTable(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &kv : p_init) {
+			insert(kv.key, kv.value);
+		}
+	}
+
+	~FlatHashTable() {
+		_reset();
+	}
+};
@@ -0,0 +1,428 @@
+#pragma once
+
+#include "key_value.h"
+#include "local_vector.h"
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+/**
+ * @brief An ordered map that keeps its keys and values in two sorted contiguous arrays, and finds keys with a binary
+ * search. Compared to `RBMap`, there is no allocation per element and a lookup only reads the keys, which sit next to
+ * each other in memory, so lookups are much faster. Inserting or erasing moves every element after it, so the map
+ * suits data that is built once and then mostly read, such as glyph tables. `K` must be default-constructible and
+ * ordered by `operator<`.
+ * Iterators and pointers to values are invalidated by any insertion or erasure.
+ */
+template <typename K, typename V>
+class FlatMap {
+	// Sorted in ascending order. `_values[i]` is the value of `_keys[i]`.
+	LocalVector<K> _keys;
+	LocalVector<V> _values;
+
+	// An optional copy of the keys in Eytzinger order, where the children of the key at index `i` are at `2i` and
+	// `2i + 1`. Index 0 is unused. Empty unless `build_search_index` was called since the last change.
+	LocalVector<K> _search_keys;
+	// The index into `_keys` of each key in `_search_keys`.
+	LocalVector<uint32_t> _search_index;
+
+	/**
+	 * @brief Finds the index of the first key that is not less than the given key, or the size of the map if there is
+	 * none. The loop has a fixed number of iterations for a given size, and compiles to conditional moves.
+	 */
+	uint32_t _lower_bound(const K &p_key) const {
+		uint32_t length = _keys.size();
+		if (length == 0) {
+			return 0;
+		}
+
+		const K *keys = _keys.ptr();
+		const K *base = keys;
+		while (length > 1) {
+			uint32_t half = length / 2;
+			base = base[half - 1] < p_key ? base + half : base;
+			length -= half;
+		}
+
+		return (base - keys) + (*base < p_key);
+	}
+
+	/**
+	 * @brief Finds the index of the given key with the Eytzinger search index.
+	 * @return The index of the key in `_keys`, or -1 if it is not in the map.
+	 */
+	int64_t _find_eytzinger(const K &p_key) const {
+		const K *keys = _search_keys.ptr();
+		uint32_t size = _keys.size();
+		uint32_t k = 1;
+		while (k <= size) {
+			k = 2 * k + (keys[k] < p_key);
+		}
+
+		// Undo the right turns taken after the last left turn, which leads back to the lower bound.
+		while (k & 1) {
+			k >>= 1;
+		}
+		k >>= 1;
+
+		if (k == 0 || p_key < keys[k]) {
+			return -1;
+		}
+		return _search_index[k];
+	}
+
+	/**
+	 * @brief Finds the index of the given key.
+	 * @return The index of the key in `_keys`, or -1 if it is not in the map.
+	 */
+	FORCE_INLINE int64_t _find_index(const K &p_key) const {
+		if (!_search_keys.is_empty()) {
+			return _find_eytzinger(p_key);
+		}
+
+		uint32_t idx = _lower_bound(p_key);
+		if (idx < _keys.size() && !(p_key < _keys[idx])) {
+			return idx;
+		}
+		return -1;
+	}
+
+	/**
+	 * @brief Fills the Eytzinger index by walking the sorted keys in order, and the implicit tree in order alongside.
+	 * @return The index of the next sorted key to place.
+	 */
+	uint32_t _build_search_index(uint32_t p_idx, uint32_t p_node) {
+		if (p_node <= _keys.size()) {
+			p_idx = _build_search_index(p_idx, 2 * p_node);
+			_search_keys[p_node] = _keys[p_idx];
+			_search_index[p_node] = p_idx;
+			p_idx = _build_search_index(p_idx + 1, 2 * p_node + 1);
+		}
+
+		return p_idx;
+	}
+
+	FORCE_INLINE void _drop_search_index() {
+		if (unlikely(!_search_keys.is_empty())) {
+			_search_keys.reset();
+			_search_index.reset();
+		}
+	}
+
+public:
+	// A view of one element, with the same `key` and `value` members as the `KeyValue` that other maps iterate over.
+	typedef KeyValue<const K &, V &> Element;
+	typedef KeyValue<const K &, const V &> ConstElement;
+
+	struct Iterator {
+		friend class FlatMap;
+
+		FORCE_INLINE Element operator*() const {
+			return Element(map->_keys[idx], map->_values[idx]);
+		}
+
+		FORCE_INLINE const K &key() const {
+			return map->_keys[idx];
+		}
+
+		FORCE_INLINE V &value() const {
+			return map->_values[idx];
+		}
+
+		FORCE_INLINE Iterator &operator++() {
+			idx++;
+			return *this;
+		}
+
+		FORCE_INLINE Iterator &operator--() {
+			idx--;
+			return *this;
+		}
+
+		FORCE_INLINE bool operator==(const Iterator &p_other) const {
+			return idx == p_other.idx;
+		}
+		FORCE_INLINE bool operator!=(const Iterator &p_other) const {
+			return idx != p_other.idx;
+		}
+
+		// Whether the iterator points at an element, rather than past either end of the map.
+		explicit operator bool() const {
+			return map && idx < map->_keys.size();
+		}
+
+		Iterator(FlatMap *p_map, uint32_t p_idx) {
+			map = p_map;
+			idx = p_idx;
+		}
+		Iterator() {}
+
+	private:
+		FlatMap *map = nullptr;
+		uint32_t idx = 0;
+	};
+
+	struct ConstIterator {
+		FORCE_INLINE ConstElement operator*() const {
+			return ConstElement(map->_keys[idx], map->_values[idx]);
+		}
+
+		FORCE_INLINE const K &key() const {
+			return map->_keys[idx];
+		}
+
+		FORCE_INLINE const V &value() const {
+			return map->_values[idx];
+		}
+
+		FORCE_INLINE ConstIterator &operator++() {
+			idx++;
+			return *this;
+		}
+
+		FORCE_INLINE ConstIterator &operator--() {
+			idx--;
+			return *this;
+		}
+
+		FORCE_INLINE bool operator==(const ConstIterator &p_other) const {
+			return idx == p_other.idx;
+		}
+		FORCE_INLINE bool operator!=(const ConstIterator &p_other) const {
+			return idx != p_other.idx;
+		}
+
+		explicit operator bool() const {
+			return map && idx < map->_keys.size();
+		}
+
+		ConstIterator(const FlatMap *p_map, uint32_t p_idx) {
+			map = p_map;
+			idx = p_idx;
+		}
+		ConstIterator() {}
+
+	private:
+		const FlatMap *map = nullptr;
+		uint32_t idx = 0;
+	};
+
+	FORCE_INLINE Iterator begin() {
+		return Iterator(this, 0);
+	}
+
+	FORCE_INLINE Iterator end() {
+		return Iterator(this, _keys.size());
+	}
+
+	FORCE_INLINE ConstIterator begin() const {
+		return ConstIterator(this, 0);
+	}
+
+	FORCE_INLINE ConstIterator end() const {
+		return ConstIterator(this, _keys.size());
+	}
+
+	FORCE_INLINE uint32_t size() const {
+		return _keys.size();
+	}
+
+	FORCE_INLINE bool is_empty() const {
+		return _keys.is_empty();
+	}
+
+	/**
+	 * @brief Finds the element with the given key.
+	 * @return An iterator to the element, which converts to `false` if the key is not in the map.
+	 */
+	FORCE_INLINE Iterator find(const K &p_key) {
+		int64_t idx = _find_index(p_key);
+		return Iterator(this, idx == -1 ? _keys.size() : (uint32_t)idx);
+	}
+
+	FORCE_INLINE ConstIterator find(const K &p_key) const {
+		int64_t idx = _find_index(p_key);
+		return ConstIterator(this, idx == -1 ? _keys.size() : (uint32_t)idx);
+	}
+
+	/**
+	 * @brief Obtains a pointer to the value held by the given key, or `nullptr` if the key is not in the map.
+	 */
+	FORCE_INLINE V *get_ptr(const K &p_key) {
+		int64_t idx = _find_index(p_key);
+		return idx == -1 ? nullptr : &_values[idx];
+	}
+
+	FORCE_INLINE const V *get_ptr(const K &p_key) const {
+		int64_t idx = _find_index(p_key);
+		return idx == -1 ? nullptr : &_values[idx];
+	}
+
+	FORCE_INLINE bool has(const K &p_key) const {
+		return _find_index(p_key) != -1;
+	}
+
+	/**
+	 * @brief Inserts a key-value pair into the map, keeping it sorted. If the key already exists, its value is
+	 * overwritten. Inserting keys in ascending order only ever appends to the arrays.
+	 */
+	void insert(const K &p_key, const V &p_value) {
+		uint32_t idx = _lower_bound(p_key);
+		if (idx < _keys.size() && !(p_key < _keys[idx])) {
+			_values[idx] = p_value;
+			return;
+		}
+
+		_drop_search_index();
+		_keys.insert(p_key, idx);
+		_values.insert(p_value, idx);
+	}
+
+	/**
+	 * @brief Removes the element with the given key, if it exists.
+	 * @return `true` if the element existed and was removed.
+	 */
+	bool erase(const K &p_key) {
+		int64_t idx = _find_index(p_key);
+		if (idx == -1) {
+			return false;
+		}
+
+		_drop_search_index();
+		_keys.remove_at(idx);
+		_values.remove_at(idx);
+		return true;
+	}
+
+	void clear() {
+		_drop_search_index();
+		_keys.clear();
+		_values.clear();
+	}
+
+	void reserve(uint32_t p_capacity) {
+		_keys.reserve(p_capacity);
+		_values.reserve(p_capacity);
+	}
+
+	/**
+	 * @brief Replaces the contents of the map with the given keys and values, which may be in any order. Sorts the
+	 * input once, in O(n log n), rather than inserting each element in turn. If a key appears more than once, the
+	 * value that comes last in the input is kept.
+	 * @param p_keys The keys to insert.
+	 * @param p_values The value of each key.
+	 * @param p_count The number of keys and values.
+	 */
+	void assign(const K *p_keys, const V *p_values, uint32_t p_count) {
+		clear();
+		if (p_count == 0) {
+			return;
+		}
+
+		LocalVector<uint32_t> order;
+		order.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			order[i] = i;
+		}
+		// A stable sort keeps duplicate keys in input order, so the last one can be told apart.
+		std::stable_sort(order.begin(), order.end(), [p_keys](uint32_t p_a, uint32_t p_b) {
+			return p_keys[p_a] < p_keys[p_b];
+		});
+
+		reserve(p_count);
+		for (uint32_t i : order) {
+			if (!_keys.is_empty() && !(_keys[_keys.size() - 1] < p_keys[i])) {
+				_values[_values.size() - 1] = p_values[i];
+				continue;
+			}
+
+			_keys.push_back(p_keys[i]);
+			_values.push_back(p_values[i]);
+		}
+	}
+
+	/**
+	 * @brief Builds a copy of the keys in Eytzinger order, where the keys a binary search visits first are stored
+	 * first. The top levels of every search then share the same few cache lines, which speeds up lookups in maps too
+	 * large to stay in cache. Only worth it for large maps that are read far more often than they change, since the
+	 * index is dropped by the next insertion or erasure.
+	 */
+	void build_search_index() {
+		_drop_search_index();
+		if (_keys.is_empty()) {
+			return;
+		}
+
+		_search_keys.resize(_keys.size() + 1);
+		_search_index.resize(_keys.size() + 1);
+		_build_search_index(0, 1);
+	}
+
+	FORCE_INLINE bool has_search_index() const {
+		return !_search_keys.is_empty();
+	}
+
+	/**
+	 * @brief Obtains a reference to the value held by the given key. Crashes the engine if the key is not in the map,
+	 * like `RBMap`.
+	 */
+	V &operator[](const K &p_key) {
+		int64_t idx = _find_index(p_key);
+		CRASH_COND_MSG(idx == -1, "FlatMap key did not exist.");
+		return _values[idx];
+	}
+
+	const V &operator[](const K &p_key) const {
+		int64_t idx = _find_index(p_key);
+		CRASH_COND_MSG(idx == -1, "FlatMap key did not exist.");
+		return _values[idx];
+	}
+
+	void operator=(const FlatMap &p_other) {
+		if (this == &p_other) {
+			return;
+		}
+
+		clear();
+		reserve(p_other.size());
+		for (uint32_t i = 0; i < p_other.size(); i++) {
+			_keys.push_back(p_other._keys[i]);
+			_values.push_back(p_other._values[i]);
+		}
+	}
+
+	void operator=(FlatMap &&p_other) {
+		_keys = std::move(p_other._keys);
+		_values = std::move(p_other._values);
+		_search_keys = std::move(p_other._search_keys);
+		_search_index = std::move(p_other._search_index);
+	}
+
+	FlatMap(std::initializer_list<KeyValue<K, V>> p_init) {
+		LocalVector<K> keys;
+		LocalVector<V> values;
+		keys.reserve(p_init.size());
+		values.reserve(p_init.size());
+		for (const KeyValue<K, V> &kv : p_init) {
+			keys.push_back(kv.key);
+			values.push_back(kv.value);
+		}
+
+		assign(keys.ptr(), values.ptr(), keys.size());
+	}
+
+	explicit FlatMap(const FlatMap &p_other) {
+		*this = p_other;
+	}
+
+	FlatMap(FlatMap &&p_other) :
+		_keys(std::move(p_other._keys)),
+		_values(std::move(p_other._values)),
+		_search_keys(std::move(p_other._search_keys)),
+		_search_index(std::move(p_other._search_index)) {}
+
+	FlatMap() {}
+};
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/frame_allocator.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A contiguous array whose memory comes from the `FrameAllocator` of the thread that grows it. Growing the
+ * array is a pointer bump, usually done in place, and nothing is freed when it is destroyed. This makes it ideal for
+ * short-lived scratch arrays that are built and thrown away within a frame.
+ * The contents are only valid until the end of the frame after the one the array was last grown in, so it must never
+ * be stored in an object that outlives that. Like `LocalVector<T>`, it can only be moved, not copied.
+ */
+template <typename T>
+class FrameVector {
+private:
+	T *data = nullptr;
+	uint32_t count = 0;
+	uint32_t capacity = 0;
+
+	/**
+	 * @brief Grows the buffer so that it can hold at least the given number of elements. The buffer is grown in place
+	 * if it is the last allocation made from the arena, otherwise a new one is allocated and the elements are moved
+	 * over. The old buffer is simply left behind until the arena is reset.
+	 * @param p_min_capacity The smallest capacity that is acceptable.
+	 */
+	void _grow(uint32_t p_min_capacity) {
+		if (likely(p_min_capacity <= capacity)) {
+			return;
+		}
+
+		// Abandoned buffers are only reclaimed when the arena resets, so grow faster than other vectors to waste less.
+		uint32_t new_capacity = capacity ? capacity * 2 : 8;
+		if (new_capacity < p_min_capacity) {
+			new_capacity = p_min_capacity;
+		}
+
+		if (data && FrameAllocator::extend(data, capacity * sizeof(T), new_capacity * sizeof(T))) {
+			capacity = new_capacity;
+			return;
+		}
+
+		T *new_data = (T *)FrameAllocator::allocate(new_capacity * sizeof(T), alignof(T));
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			Memory::vcopy_memory(new_data, data, count * sizeof(T));
+		} else {
+			for (uint32_t i = 0; i < count; i++) {
+				vnew_placement(new_data + i, T(std::move(data[i])));
+				data[i].~T();
+			}
+		}
+
+		data = new_data;
+		capacity = new_capacity;
+	}
+
+public:
+	FORCE_INLINE T *ptrw() {
+		return data;
+	}
+
+	FORCE_INLINE const T *ptr() const {
+		return data;
+	}
+
+	FORCE_INLINE uint32_t size() const {
+		return count;
+	}
+
+	FORCE_INLINE uint32_t get_capacity() const {
+		return capacity;
+	}
+
+	FORCE_INLINE bool is_empty() const {
+		return count == 0;
+	}
+
+	FORCE_INLINE T &operator[](uint32_t p_index) {
+		CRASH_OUT_OF_BOUNDS(p_index, count);
+		return data[p_index];
+	}
+
+	FORCE_INLINE const T &operator[](uint32_t p_index) const {
+		CRASH_OUT_OF_BOUNDS(p_index, count);
+		return data[p_index];
+	}
+
+	/**
+	 * @brief Appends an item to the end of the vector, growing the buffer if needed.
+	 * @param p_elem The item to append
+	 */
+	FORCE_INLINE void push_back(T p_elem) {
+		_grow(count + 1);
+		vnew_placement(data + count, T(std::move(p_elem)));
+		count++;
+	}
+
+	FORCE_INLINE void append(T p_elem) {
+		push_back(std::move(p_elem));
+	}
+
+	/**
+	 * @brief Finds the first index of the given item.
+	 * @param p_item The item to look for
+	 * @return The index of the item, or -1 if it is not in the vector.
+	 */
+	int64_t find(const T &p_item) const {
+		for (uint32_t i = 0; i < count; i++) {
+			if (data[i] == p_item) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	FORCE_INLINE bool has(const T &p_item) const {
+		return find(p_item) != -1;
+	}
+
+	/**
+	 * @brief Reserves memory for at least the given number of elements. Reserving up front avoids leaving abandoned
+	 * buffers in the arena when the final size is known.
+	 * @param p_capacity The number of elements to reserve memory for
+	 */
+	void reserve(uint32_t p_capacity) {
+		_grow(p_capacity);
+	}
+
+	/**
+	 * @brief Resizes the vector to the given number of elements. New elements are default-constructed if their type is
+	 * non-trivial, and removed elements are destroyed. The capacity is never reduced.
+	 * @param p_size The new number of elements
+	 */
+	void resize(uint32_t p_size) {
+		if (p_size > count) {
+			_grow(p_size);
+			if constexpr (!std::is_trivially_constructible_v<T>) {
+				for (uint32_t i = count; i < p_size; i++) {
+					vnew_placement(data + i, T());
+				}
+			}
+		} else if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (uint32_t i = p_size; i < count; i++) {
+				data[i].~T();
+			}
+		}
+
+		count = p_size;
+	}
+
+	/**
+	 * @brief Destroys every element in the vector, keeping the buffer so that it can be refilled.
+	 */
+	FORCE_INLINE void clear() {
+		resize(0);
+	}
+
+	FORCE_INLINE T *begin() {
+		return data;
+	}
+
+	FORCE_INLINE T *end() {
+		return data + count;
+	}
+
+	FORCE_INLINE const T *begin() const {
+		return data;
+	}
+
+	FORCE_INLINE const T *end() const {
+		return data + count;
+	}
+
+	void operator=(FrameVector &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+
+		clear();
+		data = p_from.data;
+		count = p_from.count;
+		capacity = p_from.capacity;
+		p_from.data = nullptr;
+		p_from.count = 0;
+		p_from.capacity = 0;
+	}
+
+	void operator=(const FrameVector &p_from) = delete;
+
+	FrameVector(FrameVector &&p_from) {
+		data = p_from.data;
+		count = p_from.count;
+		capacity = p_from.capacity;
+		p_from.data = nullptr;
+		p_from.count = 0;
+		p_from.capacity = 0;
+	}
+
+	FrameVector(const FrameVector &p_from) = delete;
+
+	FrameVector() {}
+
+	~FrameVector() {
+		// The memory itself belongs to the arena, so only the elements need to be destroyed.
+		clear();
+	}
+};
@@ -22,6 +22,68 @@ uint32_t hash_lowbias32(uint32_t x) {
 	return x;
 }
 
+static FORCE_INLINE uint64_t read_u64(const uint8_t *p_data) {
+	uint64_t v;
+	memcpy(&v, p_data, sizeof(v));
+	return v;
+}
+
+static FORCE_INLINE uint64_t read_u32(const uint8_t *p_data) {
+	uint32_t v;
+	memcpy(&v, p_data, sizeof(v));
+	return v;
+}
+
+// https://github.com/wangyi-fudan/wyhash
+uint64_t hash_bytes(const void *p_data, uint64_t p_length, uint64_t p_seed) {
+	const uint8_t *p = (const uint8_t *)p_data;
+	uint64_t seed = p_seed ^ hash_mum(p_seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+	uint64_t a = 0;
+	uint64_t b = 0;
+
+	if (likely(p_length <= 16)) {
+		if (p_length >= 4) {
+			// Two overlapping pairs of 4-byte reads cover every length from 4 to 16 without a loop.
+			uint64_t offset = (p_length >> 3) << 2;
+			a = (read_u32(p) << 32) | read_u32(p + offset);
+			b = (read_u32(p + p_length - 4) << 32) | read_u32(p + p_length - 4 - offset);
+		} else if (p_length > 0) {
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[p_length >> 1] << 8) | p[p_length - 1];
+		}
+	} else {
+		uint64_t i = p_length;
+		if (unlikely(i >= 48)) {
+			// Three independent lanes, so that the multiplies of each lane can run in parallel.
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+			do {
+				seed = hash_mum(read_u64(p) ^ HASH_SECRET[1], read_u64(p + 8) ^ seed);
+				seed1 = hash_mum(read_u64(p + 16) ^ HASH_SECRET[2], read_u64(p + 24) ^ seed1);
+				seed2 = hash_mum(read_u64(p + 32) ^ HASH_SECRET[3], read_u64(p + 40) ^ seed2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (i > 16) {
+			seed = hash_mum(read_u64(p) ^ HASH_SECRET[1], read_u64(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+
+		// The last 16 bytes, which may overlap with bytes that were already mixed in.
+		a = read_u64(p + i - 16);
+		b = read_u64(p + i - 8);
+	}
+
+	a ^= HASH_SECRET[1];
+	b ^= seed;
+	uint64_t lo = a * b;
+	uint64_t hi = hash_mum(a, b) ^ lo;
+	return hash_mum(lo ^ HASH_SECRET[0] ^ p_length, hi ^ HASH_SECRET[1]);
+}
+
 /* clang-format off */
 uint32_t PRIMES[] = {
     5,
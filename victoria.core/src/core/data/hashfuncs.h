@@ -2,27 +2,183 @@
 
 #include "core/typedefs.h"
 
+#include <string.h>
+
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#	include <intrin.h>
+#endif
+
+class String;
+class StringName;
+class RID;
+struct Vector2;
+struct Vector2i;
+struct Vector3;
+struct Vector3i;
+struct Vector4;
+struct Vector4i;
+
 VAPI uint32_t hash_djb2(uint8_t *str);
 VAPI uint32_t hash_lowbias32(uint32_t x);
 
+/**
+ * @brief Hashes a block of memory. The hash is in the style of wyhash: the data is read eight bytes at a time and
+ * mixed with full 64x64-bit multiplies, over three independent lanes for longer inputs, so it runs many times faster
+ * than hashing one byte at a time. The length is part of the hash, so inputs that only differ in trailing zeros still
+ * hash differently. Assumes a little-endian target, so hashes should not be stored or sent between machines.
+ * @param p_data The memory to hash.
+ * @param p_length The number of bytes to hash.
+ * @param p_seed An optional seed, to obtain an independent hash of the same data.
+ */
+VAPI uint64_t hash_bytes(const void *p_data, uint64_t p_length, uint64_t p_seed = 0);
+
+// The constants used by the multiply-mix functions below, which are the ones used by wyhash.
+static constexpr uint64_t HASH_SECRET[4] = {
+	0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+/**
+ * @brief Multiplies two 64-bit values into a 128-bit result and folds the two halves together. This is the building
+ * block of `hash_bytes` and `hash_combine`, and mixes every input bit into every output bit in a single instruction on
+ * most 64-bit targets.
+ */
+static FORCE_INLINE uint64_t hash_mum(uint64_t p_a, uint64_t p_b) {
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = (__uint128_t)p_a * p_b;
+	return (uint64_t)r ^ (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t hi = 0;
+	uint64_t lo = _umul128(p_a, p_b, &hi);
+	return lo ^ hi;
+#else
+	// Built from four 32x32-bit multiplies on targets without a 128-bit product.
+	uint64_t a_hi = p_a >> 32, a_lo = (uint32_t)p_a;
+	uint64_t b_hi = p_b >> 32, b_lo = (uint32_t)p_b;
+	uint64_t lo_lo = a_lo * b_lo;
+	uint64_t hi_lo = a_hi * b_lo;
+	uint64_t lo_hi = a_lo * b_hi;
+	uint64_t hi_hi = a_hi * b_hi;
+	uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+	uint64_t lo = (cross << 32) | (uint32_t)lo_lo;
+	uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+	return lo ^ hi;
+#endif
+}
+
+/**
+ * @brief Scrambles a 64-bit integer so that every bit of the input affects every bit of the output. Use it for integer
+ * and pointer keys, whose low bits are often all the same.
+ */
+static FORCE_INLINE uint64_t hash_mix64(uint64_t p_value) {
+	// The finalizer of splitmix64.
+	p_value = (p_value ^ (p_value >> 30)) * 0xbf58476d1ce4e5b9ull;
+	p_value = (p_value ^ (p_value >> 27)) * 0x94d049bb133111ebull;
+	return p_value ^ (p_value >> 31);
+}
+
+/**
+ * @brief Folds a 64-bit hash down to the 32 bits used by the hash tables.
+ */
+static FORCE_INLINE uint32_t hash_fold(uint64_t p_hash) {
+	return (uint32_t)(p_hash ^ (p_hash >> 32));
+}
+
+/**
+ * @brief Adds a value to a hash, for keys made up of several values. The order of the values matters, so `(1, 2)` and
+ * `(2, 1)` hash differently. Start from `HASH_SECRET[0]` or from the hash of the first value.
+ */
+static FORCE_INLINE uint64_t hash_combine(uint64_t p_hash, uint64_t p_value) {
+	return hash_mum(p_hash ^ HASH_SECRET[1], p_value ^ HASH_SECRET[2]);
+}
+
+/**
+ * @brief Hashes the bits of a floating-point number, treating `0.0` and `-0.0` alike and every NaN alike, since they
+ * compare (or fail to compare) the same way.
+ */
+static FORCE_INLINE uint64_t hash_double_bits(double p_value) {
+	if (p_value == 0.0) {
+		return 0;
+	}
+	if (p_value != p_value) {
+		return 0x7ff8000000000000ull;
+	}
+
+	uint64_t bits;
+	memcpy(&bits, &p_value, sizeof(bits));
+	return bits;
+}
+
+/**
+ * @brief Hashes a string of known length to the 32 bits used by the hash tables.
+ */
+static FORCE_INLINE uint32_t hash_string(const char *p_str, uint64_t p_length) {
+	return hash_fold(hash_bytes(p_str, p_length));
+}
+
+template <typename T>
+static constexpr bool is_hashed_as_string_v = std::is_same_v<T, char> || std::is_same_v<T, uint8_t>;
+
 struct HasherDefault {
 public:
 	static FORCE_INLINE uint32_t hash(uint8_t *p_key);
 	static FORCE_INLINE uint32_t hash(const char *p_key);
 	static FORCE_INLINE uint32_t hash(uint32_t p_key);
+	static FORCE_INLINE uint32_t hash(int32_t p_key);
+	static FORCE_INLINE uint32_t hash(uint64_t p_key);
+	static FORCE_INLINE uint32_t hash(int64_t p_key);
+	static FORCE_INLINE uint32_t hash(double p_key);
+	// Defined in `vstring.h` and `string_name.h` respectively.
+	static FORCE_INLINE uint32_t hash(const String &p_key);
+	static FORCE_INLINE uint32_t hash(const StringName &p_key);
+	// Defined in `rid.h` and the header of each vector type.
+	static FORCE_INLINE uint32_t hash(const RID &p_key);
+	static FORCE_INLINE uint32_t hash(const Vector2 &p_key);
+	static FORCE_INLINE uint32_t hash(const Vector2i &p_key);
+	static FORCE_INLINE uint32_t hash(const Vector3 &p_key);
+	static FORCE_INLINE uint32_t hash(const Vector3i &p_key);
+	static FORCE_INLINE uint32_t hash(const Vector4 &p_key);
+	static FORCE_INLINE uint32_t hash(const Vector4i &p_key);
+
+	template <typename T, std::enable_if_t<std::is_enum_v<T>, int> = 0>
+	static FORCE_INLINE uint32_t hash(T p_key) {
+		return hash_lowbias32((uint32_t)p_key);
+	}
+
+	// Pointers are hashed by their address. Character pointers are hashed as strings by the overloads above.
+	template <typename T, std::enable_if_t<!is_hashed_as_string_v<std::remove_cv_t<T>>, int> = 0>
+	static FORCE_INLINE uint32_t hash(T *p_key) {
+		return hash_fold(hash_mix64((uint64_t)(uintptr_t)p_key));
+	}
 };
 
 uint32_t HasherDefault::hash(uint8_t *p_key) {
-	return hash_djb2(p_key);
+	return hash_string((const char *)p_key, strlen((const char *)p_key));
 }
 
 uint32_t HasherDefault::hash(const char *p_key) {
-	return hash_djb2((uint8_t *)p_key);
+	return hash_string(p_key, strlen(p_key));
 }
 
 uint32_t HasherDefault::hash(uint32_t p_key) {
 	return hash_lowbias32(p_key);
 }
 
+uint32_t HasherDefault::hash(int32_t p_key) {
+	return hash_lowbias32((uint32_t)p_key);
+}
+
+uint32_t HasherDefault::hash(uint64_t p_key) {
+	return hash_fold(hash_mix64(p_key));
+}
+
+uint32_t HasherDefault::hash(int64_t p_key) {
+	return hash_fold(hash_mix64((uint64_t)p_key));
+}
+
+uint32_t HasherDefault::hash(double p_key) {
+	return hash_fold(hash_mix64(hash_double_bits(p_key)));
+}
+
 VAPI extern uint32_t PRIMES[];
-VAPI extern uint32_t PRIMES_SIZE;
\ No newline at end of file
+VAPI extern uint32_t PRIMES_SIZE;
@@ -20,6 +20,9 @@ struct HashTableElement {
 /**
  * @brief Hashtable that implements Robin-Hood hashing. Pointers and references held to data in the hashtable remain
  * under permutations, making it a very secure datatype at the cost of being expensive to allocate information for.
+ * Each element is kept at most as far from its ideal slot as any element it passed over while being inserted, so a
+ * lookup can stop as soon as it reaches an element that is closer to its own ideal slot than the key being searched
+ * for would be. Erasing shifts the following elements back rather than leaving tombstones.
  * `TKey` is the datatype to hash against, and must have a valid `Hasher` function (or its own custom hasher) to work.
  * The `Allocator` needs to be typed and implement the methods `new_allocation` and `delete_allocation`. Most data
  * won't need this to function normally.
@@ -43,6 +46,8 @@ class HashTable : private Allocator {
 	uint64_t element_count = 0;
 	// The index into the `PRIMES` array that the current capacity exists at.
 	uint32_t _prime_idx = 0;
+	// The fraction of the capacity that may be filled before the table grows.
+	float _max_load_factor = 0.8f;
 
 	/**
 	 * @brief Hashes the given key into an unsigned 32-bit integer. If the hash function returns `0`, this function
@@ -84,8 +89,8 @@ class HashTable : private Allocator {
 		uint32_t *old_hashes = hashes;
 
 		hashed_data = (HashTableElement<TKey, TValue> **)Memory::vallocate_zeroed(
-			p_new_size * sizeof(HashTableElement<TKey, TValue> *));
-		hashes = (uint32_t *)Memory::vallocate_zeroed(p_new_size * sizeof(uint32_t));
+			p_new_size * sizeof(HashTableElement<TKey, TValue> *), MEMORY_TAG_CONTAINER);
+		hashes = (uint32_t *)Memory::vallocate_zeroed(p_new_size * sizeof(uint32_t), MEMORY_TAG_CONTAINER);
 		element_count = 0;
 
 		// No need to resize
@@ -102,50 +107,27 @@ class HashTable : private Allocator {
 			_insert_element(old_hashes[i], old_data[i], PRIMES[_prime_idx]);
 		}
 
-		Memory::vfree(old_hashes);
-		Memory::vfree(old_data);
+		Memory::vfree(old_hashes, p_old_size * sizeof(uint32_t));
+		Memory::vfree(old_data, p_old_size * sizeof(HashTableElement<TKey, TValue> *));
 	}
 
 	/**
-	 * @brief Finds a given value based on its hash alone. If the value could not be found, it crashes the engine. Do
-	 * NOT use this function in code unless you are confident that the hash corresponds to a valid key-value pair.
-	 * @param p_hash The precalculated hash to find the value for.
-	 * @return A reference to the value corresponding to the given hash.
-	 */
-	TValue &_find(uint32_t p_hash) const {
-		uint32_t size = PRIMES[_prime_idx];
-		int probe = 0;
-		uint32_t idx = p_hash % size;
-
-		while (idx + probe < size) {
-			if (hashes[idx] == p_hash) {
-				return ((KeyValue<TKey, TValue> *)(hashed_data + idx + probe))->value;
-			}
-
-			_inc_mod(idx, size);
-			probe++;
-		}
-
-		CRASH_NOW();
-	}
-
-	/**
-	 * @brief Obtains the "probe distance", or the distance from the current index to the next valid hash location.
-	 * @param p_hash The precalculated hash to find the distance to.
-	 * @param p_idx The index into the `HashTable`'s data to locate it at.
+	 * @brief Obtains the "probe distance", or the number of slots between the ideal slot of a hash and the slot it is
+	 * stored in, wrapping around the end of the table.
+	 * @param p_hash The precalculated hash to find the distance for.
+	 * @param p_idx The index into the `HashTable`'s data that the hash is stored at.
+	 * @param p_size The current capacity of the table.
 	 * @return The probing distance of the hash and the respective index.
 	 */
-	FORCE_INLINE uint32_t _get_probe_distance(uint32_t p_hash, uint32_t p_idx) const {
-		uint32_t size = PRIMES[_prime_idx];
-		uint32_t initail_idx = p_hash % size;
-
-		return p_idx >= initail_idx ? p_idx - initail_idx : initail_idx;
+	FORCE_INLINE uint32_t _get_probe_distance(uint32_t p_hash, uint32_t p_idx, uint32_t p_size) const {
+		uint32_t initial_idx = p_hash % p_size;
+		return p_idx >= initial_idx ? p_idx - initial_idx : p_idx + p_size - initial_idx;
 	}
 
 	/**
 	 * @brief Finds the index into the `HashTable` where a given key and its hash exist. Returns the index in `r_idx`.
-	 * @param p_key The key to check for the existence of. There should be a check for hash collisions (where two equal
-	 * hashes exist on non-equal keys) but that check will be added later.
+	 * @param p_key The key to check for the existence of. Keys are compared whenever the hashes match, so different
+	 * keys with the same hash are told apart.
 	 * @param p_hash The precalculated hash to find the index of. Saves having to re-hash the key in this function,
 	 * which could wind up being a lengthy process.
 	 * @param r_idx The return index to place the value into. If the function returns `false`, then the contents of
@@ -163,15 +145,17 @@ class HashTable : private Allocator {
 		uint32_t probe_len = 0;
 
 		while (true) {
-			if (hashes[idx] == 0) {
+			uint32_t hash = hashes[idx];
+			if (hash == 0) {
 				return false;
 			}
 
-			if (probe_len > _get_probe_distance(p_hash, idx)) {
+			// Had the key been inserted, it would have displaced any element closer to its own ideal slot.
+			if (probe_len > _get_probe_distance(hash, idx, size)) {
 				return false;
 			}
 
-			if (hashes[idx] == p_hash && hashed_data[idx]->data.key == p_key) {
+			if (hash == p_hash && hashed_data[idx]->data.key == p_key) {
 				r_idx = idx;
 				return true;
 			}
@@ -193,7 +177,7 @@ class HashTable : private Allocator {
 	void _insert_element(uint32_t p_hash, HashTableElement<TKey, TValue> *p_value, uint32_t p_table_size) {
 		// Open hashing --> closed hashing allows us to keep the initial hash, useful for comparison
 		uint32_t idx = p_hash % p_table_size;
-		int probe_len = 0;
+		uint32_t probe_len = 0;
 		HashTableElement<TKey, TValue> *data = p_value;
 		uint32_t hash = p_hash;
 
@@ -206,15 +190,13 @@ class HashTable : private Allocator {
 				return;
 			}
 
-			// Occupied, check hash distance
-			int probe_dist = _get_probe_distance(hashes[idx], idx);
+			// Occupied, so take the slot from its element if that element is closer to its ideal slot, and carry on
+			// inserting the element that was displaced from where it left off.
+			uint32_t probe_dist = _get_probe_distance(hashes[idx], idx, p_table_size);
 			if (probe_dist < probe_len) {
-				// Swap hashes + data
 				SWAP(hashes[idx], hash);
 				SWAP(hashed_data[idx], data);
-				// Recompute probe length and index
 				probe_len = probe_dist;
-				idx = (hash % p_table_size) + probe_dist;
 			}
 
 			probe_len++;
@@ -238,12 +220,13 @@ class HashTable : private Allocator {
 		// Need to allocate table
 		if (hashed_data == nullptr) {
 			hashed_data = (HashTableElement<TKey, TValue> **)Memory::vallocate_zeroed(
-				size * sizeof(HashTableElement<TKey, TValue> *));
-			hashes = (uint32_t *)Memory::vallocate_zeroed(size * sizeof(uint32_t));
+				size * sizeof(HashTableElement<TKey, TValue> *), MEMORY_TAG_CONTAINER);
+			hashes = (uint32_t *)Memory::vallocate_zeroed(size * sizeof(uint32_t), MEMORY_TAG_CONTAINER);
 		}
 
 		// Check if a resize is needed (most of the table is now being occupied)
-		if (element_count + 1 > 0.8 * size) {
+		if (element_count + 1 > _max_load_factor * size) {
+			CRASH_COND_MSG(_prime_idx + 1 >= PRIMES_SIZE, "HashTable has reached its maximum capacity.");
 			_resize_and_remap(size, PRIMES[++_prime_idx]);
 			// Modify size since it's just changed
 			size = PRIMES[_prime_idx];
@@ -288,7 +271,7 @@ public:
 	/**
 	 * @brief Obtains the capacity of the `HashTable`. This value represents the number of values that can currently be
 	 * fit inside of the `HashTable` before it runs out of space. Note that resizing and rehashing occurs at (elements
-	 * + 1 > 0.8 * capacity) instead of at max capacity to hopefully reduce the number of collisions. Additionally, the
+	 * + 1 > max load factor * capacity) instead of at max capacity to keep probe sequences short. Additionally, the
 	 * capacity of the `HashTable` is always a prime number (see `PRIMES` as defined in `hashfuncs.cpp`).
 	 * @return The capacity of the `HashTable`.
 	 */
@@ -514,12 +497,19 @@ public:
 	}
 
 	/**
-	 * @brief Inserts a key-value pair into the `HashTable`. Hashes the key for you, how kind.
+	 * @brief Inserts a key-value pair into the `HashTable`. Hashes the key for you, how kind. If the key already
+	 * exists, its value is overwritten.
 	 * @param p_key The key of the pair.
 	 * @param p_value The value of the pair.
 	 */
 	FORCE_INLINE void insert(const TKey &p_key, const TValue &p_value) {
 		uint32_t h = _hash(p_key);
+		uint32_t idx = 0;
+		if (_find_hashed_index(p_key, h, idx)) {
+			hashed_data[idx]->data.value = p_value;
+			return;
+		}
+
 		_insert(h, KeyValue<TKey, TValue>(p_key, p_value));
 	}
 
@@ -538,42 +528,40 @@ public:
 			return false;
 		}
 
-		// Removing an item should mean that every item with the same hash is moved down a step
-		// Check hash idx + 1
-		// If hash is valid, move down. Invalidate hash idx + 1
-		// Repeat at idx + 2
-		uint32_t next_idx = idx + 1;
-		uint32_t size = PRIMES[_prime_idx];
-		while (hashes[next_idx] != 0) {
-			// Get closed hash (should point to next index)
-			uint32_t h2 = hashes[next_idx] % size;
-			if (h2 == idx) {
-				SWAP(hashed_data[next_idx - 1], hashed_data[next_idx]);
-			} else {
-				break;
-			}
+		HashTableElement<TKey, TValue> *elem = hashed_data[idx];
 
+		// Shift every following element that is not in its ideal slot back by one, which leaves the table exactly as
+		// if the element had never been inserted.
+		uint32_t size = PRIMES[_prime_idx];
+		uint32_t next_idx = idx;
+		_inc_mod(next_idx, size);
+		while (hashes[next_idx] != 0 && _get_probe_distance(hashes[next_idx], next_idx, size) != 0) {
+			hashes[idx] = hashes[next_idx];
+			hashed_data[idx] = hashed_data[next_idx];
+			idx = next_idx;
 			_inc_mod(next_idx, size);
 		}
 
 		hashes[idx] = 0;
-		if (_head == hashed_data[idx]) {
-			_head = hashed_data[idx]->next;
+		hashed_data[idx] = nullptr;
+
+		if (_head == elem) {
+			_head = elem->next;
 		}
 
-		if (_tail == hashed_data[idx]) {
-			_tail = hashed_data[idx]->prev;
+		if (_tail == elem) {
+			_tail = elem->prev;
 		}
 
-		if (hashed_data[idx]->prev) {
-			hashed_data[idx]->prev->next = hashed_data[idx]->next;
+		if (elem->prev) {
+			elem->prev->next = elem->next;
 		}
 
-		if (hashed_data[idx]->next) {
-			hashed_data[idx]->next->prev = hashed_data[idx]->prev;
+		if (elem->next) {
+			elem->next->prev = elem->prev;
 		}
 
-		Allocator::delete_allocation(hashed_data[idx]);
+		Allocator::delete_allocation(elem);
 
 		element_count--;
 		return true;
@@ -590,7 +578,9 @@ public:
 			Allocator::delete_allocation(current);
 			current = prev;
 		}
-		Memory::vzero(hashes, sizeof(uint32_t) * element_count);
+		if (hashes != nullptr) {
+			Memory::vzero(hashes, sizeof(uint32_t) * PRIMES[_prime_idx]);
+		}
 		_tail = nullptr;
 		_head = nullptr;
 		element_count = 0;
@@ -622,7 +612,64 @@ public:
 			return;
 		}
 
-		_resize_and_remap(element_count, PRIMES[nprime]);
+		uint32_t old_size = PRIMES[_prime_idx];
+		_prime_idx = nprime;
+		_resize_and_remap(old_size, PRIMES[nprime]);
+	}
+
+	/**
+	 * @brief Sets the fraction of the capacity that may be filled before the `HashTable` grows. Lower values use more
+	 * memory to keep probe sequences shorter. If the table is already fuller than the new limit, it grows immediately.
+	 * @param p_load_factor The new maximum load factor, between 0.1 and 0.95. Defaults to 0.8.
+	 */
+	void set_max_load_factor(float p_load_factor) {
+		ERR_FAIL_COND_MSG(p_load_factor < 0.1f || p_load_factor > 0.95f,
+						  "HashTable load factor must be between 0.1 and 0.95.");
+		_max_load_factor = p_load_factor;
+
+		uint32_t nprime = _prime_idx;
+		while (element_count > _max_load_factor * PRIMES[nprime]) {
+			ERR_FAIL_COND(nprime + 1 >= PRIMES_SIZE);
+			nprime++;
+		}
+
+		if (nprime != _prime_idx) {
+			reserve(PRIMES[nprime]);
+		}
+	}
+
+	FORCE_INLINE float get_max_load_factor() const {
+		return _max_load_factor;
+	}
+
+	/**
+	 * @brief Counts how many elements are stored at each distance from their ideal slot, for diagnosing hash functions
+	 * that cluster keys together. With a good hash, almost every element is within a few slots of its ideal one.
+	 * @param r_histogram An array of `p_length` counters, which is zeroed and then filled in. Elements that are
+	 * further away than the array can hold are counted in its last entry.
+	 * @param p_length The number of entries in `r_histogram`.
+	 * @return The longest probe distance of any element in the table.
+	 */
+	uint32_t get_probe_histogram(uint32_t *r_histogram, uint32_t p_length) const {
+		ERR_FAIL_COND_R(p_length == 0, 0);
+		Memory::vzero(r_histogram, p_length * sizeof(uint32_t));
+		if (hashed_data == nullptr) {
+			return 0;
+		}
+
+		uint32_t size = PRIMES[_prime_idx];
+		uint32_t max_distance = 0;
+		for (uint32_t i = 0; i < size; i++) {
+			if (hashes[i] == 0) {
+				continue;
+			}
+
+			uint32_t distance = _get_probe_distance(hashes[i], i, size);
+			max_distance = distance > max_distance ? distance : max_distance;
+			r_histogram[distance < p_length ? distance : p_length - 1]++;
+		}
+
+		return max_distance;
 	}
 
 	/* Assignment operators */
@@ -640,7 +687,8 @@ public:
 			clear();
 		}
 
-		reserve(p_other._prime_idx);
+		_max_load_factor = p_other._max_load_factor;
+		reserve(PRIMES[p_other._prime_idx]);
 
 		if (p_other.hashed_data == nullptr) {
 			return;
@@ -666,15 +714,18 @@ public:
 		}
 
 		if (hashed_data != nullptr) {
-			Memory::vfree(hashed_data);
-			Memory::vfree(hashes);
+			Memory::vfree(hashed_data, PRIMES[_prime_idx] * sizeof(HashTableElement<TKey, TValue> *));
+			Memory::vfree(hashes, PRIMES[_prime_idx] * sizeof(uint32_t));
 		}
 
+		// The elements were allocated by the other table's allocator, so it has to come along with them.
+		Allocator::operator=(static_cast<Allocator &&>(p_from));
 		hashed_data = p_from.hashed_data;
 		hashes = p_from.hashes;
 		_head = p_from._head;
 		_tail = p_from._tail;
 		_prime_idx = p_from._prime_idx;
+		_max_load_factor = p_from._max_load_factor;
 		element_count = p_from.element_count;
 
 		p_from.hashed_data = nullptr;
@@ -711,6 +762,7 @@ public:
 	 * @param p_other The `HashTable` to copy data from.
 	 */
 	explicit HashTable(const HashTable &p_other) {
+		_max_load_factor = p_other._max_load_factor;
 		reserve(PRIMES[p_other._prime_idx]);
 
 		if (p_other.element_count == 0) {
@@ -728,12 +780,14 @@ public:
 	 * out of scope, it sets all the data in it to the default values and takes ownership of the pointers.
 	 * @param p_other The `HashTable` to move data from into here.
 	 */
-	HashTable(HashTable &&p_other) {
+	HashTable(HashTable &&p_other) :
+		Allocator(static_cast<Allocator &&>(p_other)) {
 		hashed_data = p_other.hashed_data;
 		hashes = p_other.hashes;
 		_head = p_other._head;
 		_tail = p_other._tail;
 		_prime_idx = p_other._prime_idx;
+		_max_load_factor = p_other._max_load_factor;
 		element_count = p_other.element_count;
 
 		p_other.hashed_data = nullptr;
@@ -763,8 +817,8 @@ public:
 	~HashTable() {
 		clear();
 		if (hashed_data != nullptr) {
-			Memory::vfree(hashed_data);
-			Memory::vfree(hashes);
+			Memory::vfree(hashed_data, PRIMES[_prime_idx] * sizeof(HashTableElement<TKey, TValue> *));
+			Memory::vfree(hashes, PRIMES[_prime_idx] * sizeof(uint32_t));
 		}
 	}
 };
@@ -2,6 +2,8 @@
 
 #include "core/typedefs.h"
 
+#include <utility>
+
 template <typename K, typename V>
 class KeyValue {
 public:
@@ -25,6 +27,10 @@ public:
 		key(p_other.key),
 		value(p_other.value) {}
 
+	KeyValue(KeyValue &&p_other) :
+		key(std::move(const_cast<K &>(p_other.key))),
+		value(std::move(p_other.value)) {}
+
 	KeyValue(const K &p_key, const V &p_value) :
 		key(p_key),
 		value(p_value) {}
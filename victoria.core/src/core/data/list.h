@@ -5,44 +5,58 @@
 #include "core/typedefs.h"
 
 template <typename T>
-class List {
-public:
-	struct Element {
-	private:
-		friend class List<T>;
+class ListElement;
 
-		T value;
-		Element *next_ptr = nullptr;
-		Element *prev_ptr = nullptr;
+/**
+ * @brief Doubly linked list. Each element is allocated separately through `Allocator`, which needs to be typed for
+ * `ListElement<T>` and implement `new_allocation` and `delete_allocation` (see `DefaultTypedAllocator`).
+ */
+template <typename T, typename Allocator = DefaultTypedAllocator<ListElement<T>>>
+class List;
 
-	public:
-		FORCE_INLINE Element *next() {
-			return next_ptr;
-		}
+template <typename T>
+class ListElement {
+private:
+	template <typename, typename>
+	friend class List;
 
-		FORCE_INLINE const Element *next() const {
-			return next_ptr;
-		}
+	T value;
+	ListElement *next_ptr = nullptr;
+	ListElement *prev_ptr = nullptr;
 
-		FORCE_INLINE Element *prev() {
-			return prev_ptr;
-		}
+public:
+	FORCE_INLINE ListElement *next() {
+		return next_ptr;
+	}
 
-		FORCE_INLINE const Element *prev() const {
-			return prev_ptr;
-		}
+	FORCE_INLINE const ListElement *next() const {
+		return next_ptr;
+	}
 
-		FORCE_INLINE T &get() {
-			return value;
-		}
+	FORCE_INLINE ListElement *prev() {
+		return prev_ptr;
+	}
 
-		FORCE_INLINE const T &get() const {
-			return value;
-		}
+	FORCE_INLINE const ListElement *prev() const {
+		return prev_ptr;
+	}
 
-		Element() {}
-		~Element() {}
-	};
+	FORCE_INLINE T &get() {
+		return value;
+	}
+
+	FORCE_INLINE const T &get() const {
+		return value;
+	}
+
+	ListElement() {}
+	~ListElement() {}
+};
+
+template <typename T, typename Allocator>
+class List : private Allocator {
+public:
+	typedef ListElement<T> Element;
 
 private:
 	Element *head = nullptr;
@@ -175,6 +189,7 @@ public:
 		}
 
 		clear();
+		Allocator::operator=(static_cast<Allocator &&>(p_other));
 		head = p_other.head;
 		tail = p_other.tail;
 		element_count = p_other.element_count;
@@ -191,7 +206,7 @@ public:
 	}
 
 	FORCE_INLINE Element *push_front(const T &p_item) {
-		Element *e = vnew(Element);
+		Element *e = Allocator::new_allocation();
 		e->value = p_item;
 		e->next_ptr = head;
 		e->prev_ptr = nullptr;
@@ -215,7 +230,7 @@ public:
 	}
 
 	FORCE_INLINE Element *push_back(const T &p_item) {
-		Element *e = vnew(Element);
+		Element *e = Allocator::new_allocation();
 		e->value = p_item;
 		e->prev_ptr = tail;
 		e->next_ptr = nullptr;
@@ -256,7 +271,7 @@ public:
 			p_elem->prev_ptr->next_ptr = p_elem->next_ptr;
 		}
 
-		vdelete(p_elem);
+		Allocator::delete_allocation(p_elem);
 		p_elem = nullptr;
 		element_count--;
 		return true;
@@ -331,7 +346,8 @@ public:
 		}
 	}
 
-	List(List &&p_other) {
+	List(List &&p_other) :
+		Allocator(static_cast<Allocator &&>(p_other)) {
 		head = p_other.head;
 		tail = p_other.tail;
 		element_count = p_other.element_count;
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A contiguous array that is owned by a single object. Unlike `Vector<T>`, it does not use copy-on-write or
+ * reference counting, so writes never need to check whether the buffer is shared, and its capacity is kept when it is
+ * cleared. This makes it ideal for per-frame scratch arrays that are refilled often. As ownership is unique, the
+ * class can only be moved, not copied; use `Vector<T>` when data needs to be shared.
+ */
+template <typename T>
+class LocalVector {
+private:
+	T *data = nullptr;
+	uint32_t count = 0;
+	uint32_t capacity = 0;
+
+	/**
+	 * @brief Reallocates the buffer to hold exactly the given number of elements. Trivially copyable types are
+	 * reallocated in-place, while other types are moved into the new buffer one by one.
+	 * @param p_capacity The new capacity of the buffer. Must not be smaller than the current size.
+	 */
+	void _realloc(uint32_t p_capacity) {
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			data = (T *)Memory::vreallocate(
+				data, capacity * sizeof(T), p_capacity * sizeof(T), MEMORY_TAG_CONTAINER);
+			CRASH_COND_MSG(!data, "Out of memory when growing a LocalVector.");
+		} else {
+			T *new_data = (T *)Memory::vallocate(p_capacity * sizeof(T), MEMORY_TAG_CONTAINER);
+			CRASH_COND_MSG(!new_data, "Out of memory when growing a LocalVector.");
+			for (uint32_t i = 0; i < count; i++) {
+				vnew_placement(new_data + i, T(std::move(data[i])));
+				data[i].~T();
+			}
+			Memory::vfree(data, capacity * sizeof(T));
+			data = new_data;
+		}
+
+		capacity = p_capacity;
+	}
+
+	/**
+	 * @brief Grows the buffer geometrically so that it can hold at least the given number of elements.
+	 * @param p_min_capacity The smallest capacity that is acceptable.
+	 */
+	FORCE_INLINE void _grow(uint32_t p_min_capacity) {
+		if (likely(p_min_capacity <= capacity)) {
+			return;
+		}
+
+		uint32_t new_capacity = capacity + (capacity >> 1) + 1;
+		_realloc(new_capacity > p_min_capacity ? new_capacity : p_min_capacity);
+	}
+
+public:
+	FORCE_INLINE T *ptrw() {
+		return data;
+	}
+
+	FORCE_INLINE const T *ptr() const {
+		return data;
+	}
+
+	FORCE_INLINE uint32_t size() const {
+		return count;
+	}
+
+	FORCE_INLINE uint32_t get_capacity() const {
+		return capacity;
+	}
+
+	FORCE_INLINE bool is_empty() const {
+		return count == 0;
+	}
+
+	FORCE_INLINE T &operator[](uint32_t p_index) {
+		CRASH_OUT_OF_BOUNDS(p_index, count);
+		return data[p_index];
+	}
+
+	FORCE_INLINE const T &operator[](uint32_t p_index) const {
+		CRASH_OUT_OF_BOUNDS(p_index, count);
+		return data[p_index];
+	}
+
+	/**
+	 * @brief Appends an item to the end of the vector, growing the buffer if needed.
+	 * @param p_elem The item to append
+	 */
+	FORCE_INLINE void push_back(T p_elem) {
+		_grow(count + 1);
+		vnew_placement(data + count, T(std::move(p_elem)));
+		count++;
+	}
+
+	FORCE_INLINE void append(T p_elem) {
+		push_back(std::move(p_elem));
+	}
+
+	/**
+	 * @brief Inserts an item at the given index, moving every item after it up by one.
+	 * @param p_item The item to insert
+	 * @param p_index The index to insert the item at. May be equal to the size of the vector.
+	 */
+	void insert(T p_item, uint32_t p_index) {
+		ERR_OUT_OF_BOUNDS(p_index, count + 1);
+
+		_grow(count + 1);
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			Memory::vmemmove(data + p_index + 1, data + p_index, (count - p_index) * sizeof(T));
+		} else {
+			for (uint32_t i = count; i > p_index; i--) {
+				vnew_placement(data + i, T(std::move(data[i - 1])));
+				data[i - 1].~T();
+			}
+		}
+
+		vnew_placement(data + p_index, T(std::move(p_item)));
+		count++;
+	}
+
+	/**
+	 * @brief Removes the item at the given index, keeping the order of the remaining items.
+	 * @param p_index The index of the item to remove
+	 */
+	void remove_at(uint32_t p_index) {
+		ERR_OUT_OF_BOUNDS(p_index, count);
+
+		count--;
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			Memory::vmemmove(data + p_index, data + p_index + 1, (count - p_index) * sizeof(T));
+		} else {
+			for (uint32_t i = p_index; i < count; i++) {
+				data[i] = std::move(data[i + 1]);
+			}
+			data[count].~T();
+		}
+	}
+
+	/**
+	 * @brief Removes the item at the given index by moving the last item into its place. Does not keep the order of
+	 * the items, but runs in constant time.
+	 * @param p_index The index of the item to remove
+	 */
+	void remove_at_unordered(uint32_t p_index) {
+		ERR_OUT_OF_BOUNDS(p_index, count);
+
+		count--;
+		if (p_index < count) {
+			data[p_index] = std::move(data[count]);
+		}
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			data[count].~T();
+		}
+	}
+
+	/**
+	 * @brief Finds the first index of the given item.
+	 * @param p_item The item to look for
+	 * @return The index of the item, or -1 if it is not in the vector.
+	 */
+	int64_t find(const T &p_item) const {
+		for (uint32_t i = 0; i < count; i++) {
+			if (data[i] == p_item) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	FORCE_INLINE bool has(const T &p_item) const {
+		return find(p_item) != -1;
+	}
+
+	/**
+	 * @brief Reserves memory for at least the given number of elements. Never shrinks the buffer.
+	 * @param p_capacity The number of elements to reserve memory for
+	 */
+	void reserve(uint32_t p_capacity) {
+		if (p_capacity > capacity) {
+			_realloc(p_capacity);
+		}
+	}
+
+	/**
+	 * @brief Resizes the vector to the given number of elements. New elements are default-constructed if their type is
+	 * non-trivial, and removed elements are destroyed. The capacity is never reduced.
+	 * @param p_size The new number of elements
+	 */
+	void resize(uint32_t p_size) {
+		if (p_size > count) {
+			_grow(p_size);
+			if constexpr (!std::is_trivially_constructible_v<T>) {
+				for (uint32_t i = count; i < p_size; i++) {
+					vnew_placement(data + i, T());
+				}
+			}
+		} else if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (uint32_t i = p_size; i < count; i++) {
+				data[i].~T();
+			}
+		}
+
+		count = p_size;
+	}
+
+	/**
+	 * @brief Destroys every element in the vector, but keeps the buffer so that it can be refilled without
+	 * allocating. Use `reset()` to free the memory as well.
+	 */
+	FORCE_INLINE void clear() {
+		resize(0);
+	}
+
+	/**
+	 * @brief Destroys every element in the vector and frees its buffer.
+	 */
+	void reset() {
+		clear();
+		Memory::vfree(data, capacity * sizeof(T));
+		data = nullptr;
+		capacity = 0;
+	}
+
+	/**
+	 * @brief Frees any memory reserved past the current size of the vector.
+	 */
+	void shrink_to_fit() {
+		if (count == 0) {
+			reset();
+		} else if (capacity > count) {
+			_realloc(count);
+		}
+	}
+
+	// As the buffer is contiguous and never shared, plain pointers are used as iterators.
+	FORCE_INLINE T *begin() {
+		return data;
+	}
+
+	FORCE_INLINE T *end() {
+		return data + count;
+	}
+
+	FORCE_INLINE const T *begin() const {
+		return data;
+	}
+
+	FORCE_INLINE const T *end() const {
+		return data + count;
+	}
+
+	void operator=(LocalVector &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+
+		reset();
+		data = p_from.data;
+		count = p_from.count;
+		capacity = p_from.capacity;
+		p_from.data = nullptr;
+		p_from.count = 0;
+		p_from.capacity = 0;
+	}
+
+	void operator=(const LocalVector &p_from) = delete;
+
+	LocalVector(LocalVector &&p_from) {
+		data = p_from.data;
+		count = p_from.count;
+		capacity = p_from.capacity;
+		p_from.data = nullptr;
+		p_from.count = 0;
+		p_from.capacity = 0;
+	}
+
+	LocalVector(const LocalVector &p_from) = delete;
+
+	LocalVector(std::initializer_list<T> p_init) {
+		reserve(p_init.size());
+		for (const T &element : p_init) {
+			vnew_placement(data + count, T(element));
+			count++;
+		}
+	}
+
+	LocalVector() {}
+
+	~LocalVector() {
+		reset();
+	}
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "local_vector.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <utility>
+
+/**
+ * @brief Typed allocator that hands out objects from page-sized slabs, for use as the `Allocator` of a container
+ * (such as `HashTable`, `List` or `RBMap`) in place of `DefaultTypedAllocator`. Freed objects are kept in a free list
+ * that belongs to the allocator and are reused by the next allocation, so once the allocator has warmed up, allocating
+ * and freeing a node does not reach the global allocator at all. Pages are only returned to the system when the
+ * allocator is reset or destroyed.
+ * Each allocator is owned by a single container and is not thread-safe. It can be moved along with its container,
+ * but not copied, as the objects it has handed out still point into its pages.
+ * `PAGE_ELEMENTS` sets how many objects each page holds, which by default fills roughly 4KiB. Containers that are
+ * often small should use fewer elements per page to avoid wasting memory.
+ */
+template <typename T, uint32_t PAGE_ELEMENTS = (sizeof(T) < 4096 ? 4096 / sizeof(T) : 1)>
+class PagedAllocator {
+	static_assert(PAGE_ELEMENTS > 0, "A PagedAllocator page must hold at least one element.");
+
+	// Storage for a single object. Holds a pointer to the next free slot while it is not in use.
+	union Slot {
+		Slot *next;
+		alignas(T) uint8_t data[sizeof(T)];
+	};
+
+	// Every page allocated so far, each holding `PAGE_ELEMENTS` slots.
+	LocalVector<Slot *> pages;
+	// The first free slot, or `nullptr` if every slot is in use.
+	Slot *free_list = nullptr;
+	// The number of objects currently handed out.
+	uint32_t allocation_count = 0;
+
+	/**
+	 * @brief Allocates a new page and adds each of its slots to the free list.
+	 */
+	void _allocate_page() {
+		Slot *page = (Slot *)Memory::vallocate(sizeof(Slot) * PAGE_ELEMENTS, MEMORY_TAG_CONTAINER);
+		CRASH_COND_MSG(!page, "Out of memory when allocating a new page for a PagedAllocator.");
+
+		for (uint32_t i = 0; i < PAGE_ELEMENTS - 1; i++) {
+			page[i].next = &page[i + 1];
+		}
+		page[PAGE_ELEMENTS - 1].next = free_list;
+
+		free_list = page;
+		pages.push_back(page);
+	}
+
+	void _take_from(PagedAllocator &p_from) {
+		pages = std::move(p_from.pages);
+		free_list = p_from.free_list;
+		allocation_count = p_from.allocation_count;
+
+		p_from.free_list = nullptr;
+		p_from.allocation_count = 0;
+	}
+
+public:
+	/**
+	 * @brief Constructs a new object in a free slot, allocating a new page if none are left.
+	 * @param p_args The arguments to construct the object with.
+	 * @return A pointer to the new object, which must be freed through `delete_allocation` on this allocator.
+	 */
+	template <typename... Args>
+	FORCE_INLINE T *new_allocation(Args &&...p_args) {
+		if (unlikely(!free_list)) {
+			_allocate_page();
+		}
+
+		Slot *slot = free_list;
+		free_list = slot->next;
+		allocation_count++;
+		return vnew_placement(slot->data, T(std::forward<Args>(p_args)...));
+	}
+
+	/**
+	 * @brief Destroys an object and returns its slot to the free list.
+	 * @param p_allocation The object to free. Must have been allocated by this allocator.
+	 */
+	FORCE_INLINE void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p_allocation->~T();
+		}
+
+		Slot *slot = (Slot *)p_allocation;
+		slot->next = free_list;
+		free_list = slot;
+		allocation_count--;
+	}
+
+	/**
+	 * @brief Obtains the number of objects currently handed out by the allocator.
+	 */
+	FORCE_INLINE uint32_t get_allocation_count() const {
+		return allocation_count;
+	}
+
+	/**
+	 * @brief Obtains the number of pages allocated, which are only freed when the allocator is reset.
+	 */
+	FORCE_INLINE uint32_t get_page_count() const {
+		return pages.size();
+	}
+
+	/**
+	 * @brief Frees every page held by the allocator. Every object must have been freed beforehand, otherwise the
+	 * pages are leaked rather than freed from under them.
+	 */
+	void reset() {
+		ERR_FAIL_COND_MSG(allocation_count != 0, "Attempted to reset a PagedAllocator with objects still in use.");
+
+		for (Slot *page : pages) {
+			Memory::vfree(page, sizeof(Slot) * PAGE_ELEMENTS);
+		}
+		pages.reset();
+		free_list = nullptr;
+	}
+
+	void operator=(PagedAllocator &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+
+		reset();
+		_take_from(p_from);
+	}
+
+	void operator=(const PagedAllocator &p_from) = delete;
+
+	PagedAllocator(PagedAllocator &&p_from) {
+		_take_from(p_from);
+	}
+
+	PagedAllocator(const PagedAllocator &p_from) = delete;
+
+	PagedAllocator() {}
+
+	~PagedAllocator() {
+		reset();
+	}
+};
@@ -6,72 +6,84 @@
 #include "core/os/memory.h"
 #include "core/typedefs.h"
 
+template <typename K, typename V>
+class RBMapElement;
+
 /**
- * Implementation of a RB Map (see https://en.wikipedia.org/wiki/Red%E2%80%93black_tree)
+ * @brief Implementation of a RB Map (see https://en.wikipedia.org/wiki/Red%E2%80%93black_tree). Each element is
+ * allocated separately through `Allocator`, which needs to be typed for `RBMapElement<K, V>` and implement
+ * `new_allocation` and `delete_allocation` (see `DefaultTypedAllocator`).
  */
+template <typename K, typename V, typename Allocator = DefaultTypedAllocator<RBMapElement<K, V>>>
+class RBMap;
 
 template <typename K, typename V>
-class RBMap {
-	enum Colour {
-		RED,
-		BLACK
-	};
+class RBMapElement {
+private:
+	template <typename, typename, typename>
+	friend class RBMap;
+
+	int colour = 0; // New elements are red, see `RBMap::Colour`.
+	RBMapElement *left = nullptr;
+	RBMapElement *right = nullptr;
+	RBMapElement *parent = nullptr;
+	RBMapElement *_next = nullptr;
+	RBMapElement *_prev = nullptr;
+	KeyValue<K, V> _data;
 
 public:
-	class Element {
-	private:
-		friend class RBMap<K, V>;
-		int colour = RED;
-		Element *left = nullptr;
-		Element *right = nullptr;
-		Element *parent = nullptr;
-		Element *_next = nullptr;
-		Element *_prev = nullptr;
-		KeyValue<K, V> _data;
+	KeyValue<K, V> &key_value() {
+		return _data;
+	}
 
-	public:
-		KeyValue<K, V> &key_value() {
-			return _data;
-		}
+	const KeyValue<K, V> &key_value() const {
+		return _data;
+	}
 
-		const KeyValue<K, V> &key_value() const {
-			return _data;
-		}
+	const RBMapElement *next() const {
+		return _next;
+	}
 
-		const Element *next() const {
-			return _next;
-		}
+	RBMapElement *next() {
+		return _next;
+	}
 
-		Element *next() {
-			return _next;
-		}
+	const RBMapElement *prev() const {
+		return _prev;
+	}
 
-		const Element *prev() const {
-			return _prev;
-		}
+	RBMapElement *prev() {
+		return _prev;
+	}
 
-		Element *prev() {
-			return _prev;
-		}
+	const K &key() const {
+		return _data.key;
+	}
 
-		const K &key() const {
-			return _data.key;
-		}
+	V &value() {
+		return _data.value;
+	}
 
-		V &value() {
-			return _data.value;
-		}
+	const V &value() const {
+		return _data.value;
+	}
 
-		const V &value() const {
-			return _data.value;
-		}
+	FORCE_INLINE RBMapElement(const KeyValue<K, V> &p_kv) :
+		_data(p_kv) {}
+};
 
-		FORCE_INLINE Element(const KeyValue<K, V> &p_kv) :
-			_data(p_kv) {}
+template <typename K, typename V, typename Allocator>
+class RBMap : private Allocator {
+	enum Colour {
+		RED,
+		BLACK
 	};
 
+public:
+	typedef RBMapElement<K, V> Element;
+
 	struct Iterator {
-		friend class RBMap<K, V>;
+		friend class RBMap;
 
 		FORCE_INLINE KeyValue<K, V> &operator*() const {
 			return e->key_value();
@@ -139,6 +151,24 @@ private:
 		_root->colour = BLACK;
 	}
 
+	void _create_nil() {
+		_nil = vnew(Element(KeyValue<K, V>(K(), V())));
+		_nil->parent = _nil->left = _nil->right = _nil;
+		_nil->colour = BLACK;
+	}
+
+	// Takes every node from the given map. The sentinel goes along with them, as each leaf points to it, so the other
+	// map is given a new one.
+	void _take_from(RBMap &p_from) {
+		_root = p_from._root;
+		_nil = p_from._nil;
+		element_count = p_from.element_count;
+
+		p_from._root = nullptr;
+		p_from.element_count = 0;
+		p_from._create_nil();
+	}
+
 	void _free_root() {
 		if (_root) {
 			vdelete(_root);
@@ -310,7 +340,7 @@ private:
 			}
 		}
 
-		Element *new_node = vnew(Element(KeyValue<K, V>(p_key, p_value)));
+		Element *new_node = Allocator::new_allocation(KeyValue<K, V>(p_key, p_value));
 		new_node->parent = parent;
 		new_node->left = _nil;
 		new_node->right = _nil;
@@ -451,7 +481,7 @@ private:
 			p_node->_prev->_next = p_node->_next;
 		}
 
-		vdelete(p_node);
+		Allocator::delete_allocation(p_node);
 		element_count--;
 		ERR_FAIL_COND(_nil->colour != BLACK);
 	}
@@ -479,7 +509,7 @@ private:
 
 		_cleanup_node(p_node->left);
 		_cleanup_node(p_node->right);
-		vdelete(p_node);
+		Allocator::delete_allocation(p_node);
 	}
 
 public:
@@ -495,7 +525,8 @@ public:
 			return nullptr;
 		}
 
-		return _find(p_key);
+		Element *e = _find(p_key);
+		return e != _nil ? e : nullptr;
 	}
 
 	FORCE_INLINE void insert(const K &p_key, const V &p_value) {
@@ -517,6 +548,7 @@ public:
 		}
 
 		_erase(e);
+		return true;
 	}
 
 	void clear() {
@@ -524,8 +556,9 @@ public:
 			return;
 		}
 
-		_cleanup_node(_root);
-		_root = nullptr;
+		// The root is a sentinel created outside of the allocator, so only the nodes below it are freed through it.
+		_cleanup_node(_root->left);
+		_free_root();
 		element_count = 0;
 	}
 
@@ -575,10 +608,42 @@ public:
 		return e;
 	}
 
+	void operator=(const RBMap &p_other) {
+		if (this == &p_other) {
+			return;
+		}
+
+		clear();
+		for (const Element *e = p_other.front(); e; e = e->next()) {
+			insert(e->key(), e->value());
+		}
+	}
+
+	void operator=(RBMap &&p_other) {
+		if (this == &p_other) {
+			return;
+		}
+
+		clear();
+		vdelete(_nil);
+		Allocator::operator=(static_cast<Allocator &&>(p_other));
+		_take_from(p_other);
+	}
+
 	FORCE_INLINE RBMap() {
-		_nil = vnew(Element(KeyValue<K, V>(K(), V())));
-		_nil->parent = _nil->left = _nil->right = _nil;
-		_nil->colour = BLACK;
+		_create_nil();
+	}
+
+	explicit RBMap(const RBMap &p_other) {
+		_create_nil();
+		for (const Element *e = p_other.front(); e; e = e->next()) {
+			insert(e->key(), e->value());
+		}
+	}
+
+	RBMap(RBMap &&p_other) :
+		Allocator(static_cast<Allocator &&>(p_other)) {
+		_take_from(p_other);
 	}
 
 	FORCE_INLINE ~RBMap() {
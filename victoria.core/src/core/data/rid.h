@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/data/hashfuncs.h"
 #include "core/typedefs.h"
 
 class RIDAllocatorBase;
@@ -30,3 +31,7 @@ public:
 
 	FORCE_INLINE RID() {}
 };
+
+uint32_t HasherDefault::hash(const RID &p_key) {
+	return hash_fold(hash_mix64(p_key.get_id()));
+}
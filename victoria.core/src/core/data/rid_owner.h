@@ -57,11 +57,18 @@ class RIDAllocator : public RIDAllocatorBase {
 
 			ERR_FAIL_COND_MSG_R(new_chunk_count == max_chunks, "Item RID limit reached.", RID());
 
-			items = (Item **)Memory::vreallocate(items, sizeof(Item *) * (new_chunk_count + 1));
-			items[new_chunk_count] = (Item *)Memory::vallocate(sizeof(Item) * items_per_chunk);
-
-			free_list = (uint32_t **)Memory::vreallocate(free_list, sizeof(uint32_t *) * (new_chunk_count + 1));
-			free_list[new_chunk_count] = (uint32_t *)Memory::vallocate(sizeof(uint32_t) * items_per_chunk);
+			items = (Item **)Memory::vreallocate(items,
+												 sizeof(Item *) * new_chunk_count,
+												 sizeof(Item *) * (new_chunk_count + 1),
+												 MEMORY_TAG_CONTAINER);
+			items[new_chunk_count] = (Item *)Memory::vallocate(sizeof(Item) * items_per_chunk, MEMORY_TAG_CONTAINER);
+
+			free_list = (uint32_t **)Memory::vreallocate(free_list,
+														 sizeof(uint32_t *) * new_chunk_count,
+														 sizeof(uint32_t *) * (new_chunk_count + 1),
+														 MEMORY_TAG_CONTAINER);
+			free_list[new_chunk_count] =
+				(uint32_t *)Memory::vallocate(sizeof(uint32_t) * items_per_chunk, MEMORY_TAG_CONTAINER);
 
 			for (uint64_t i = 0; i < items_per_chunk; i++) {
 				items[new_chunk_count][i].validator = 0xffffffff; // Set to invalid ID
@@ -183,7 +190,8 @@ public:
 			index; // Make the now-freed item the next spot on the free list
 	}
 
-	FORCE_INLINE void get_owned_list(Vector<RID> *p_list) const {
+	template <typename TList>
+	FORCE_INLINE void get_owned_list(TList *p_list) const {
 		for (uint64_t i = 0; i < max_allocations; i++) {
 			uint64_t validator = items[i / items_per_chunk][i % items_per_chunk].validator;
 			if (validator != 0xffffffff) {
@@ -213,13 +221,13 @@ public:
 
 		uint32_t chunks_used = max_allocations / items_per_chunk;
 		for (uint32_t i = 0; i < chunks_used; i++) {
-			Memory::vfree(items[i]);
-			Memory::vfree(free_list[i]);
+			Memory::vfree(items[i], sizeof(Item) * items_per_chunk);
+			Memory::vfree(free_list[i], sizeof(uint32_t) * items_per_chunk);
 		}
 
 		if (items) {
-			Memory::vfree(items);
-			Memory::vfree(free_list);
+			Memory::vfree(items, sizeof(Item *) * chunks_used);
+			Memory::vfree(free_list, sizeof(uint32_t *) * chunks_used);
 		}
 	}
 };
@@ -271,7 +279,8 @@ public:
 		allocator.free(p_rid);
 	}
 
-	FORCE_INLINE void get_owned_list(Vector<RID> *p_list) const {
+	template <typename TList>
+	FORCE_INLINE void get_owned_list(TList *p_list) const {
 		allocator.get_owned_list(p_list);
 	}
 
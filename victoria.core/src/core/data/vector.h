@@ -119,6 +119,14 @@ public:
 		return _cowdata.size();
 	}
 
+	/**
+	 * @brief Gets the number of elements the vector can hold before it has to reallocate its memory.
+	 * @returns The capacity of the vector, which is never less than its size.
+	 */
+	FORCE_INLINE int64_t get_capacity() const {
+		return _cowdata.get_capacity();
+	}
+
 	/**
 	 * @brief Method to find out if a vector type has any values in it.
 	 * @returns `TRUE` if the vector is empty, `FALSE` if it is not.
@@ -178,6 +186,23 @@ public:
 		return _cowdata.resize(p_new_size);
 	}
 
+	/**
+	 * @brief Reserves memory for at least the given number of elements, so that appending up to that many elements
+	 * will not reallocate the buffer. Does not change the size of the vector.
+	 * @param p_capacity The number of elements to reserve memory for
+	 * @returns `OK` on success, and an error code if the memory could not be allocated.
+	 */
+	FORCE_INLINE Error reserve(int64_t p_capacity) {
+		return _cowdata.reserve(p_capacity);
+	}
+
+	/**
+	 * @brief Frees any memory reserved past the current size of the vector.
+	 */
+	FORCE_INLINE void shrink_to_fit() {
+		_cowdata.shrink_to_fit();
+	}
+
 	/**
 	 * @brief Removes an item at a given index in the vector.
 	 * @param index The index into the vector to remove from
@@ -343,12 +368,13 @@ public:
 
 template <typename T>
 void Vector<T>::append_array(Vector<T> p_other) {
-	if (p_other._cowdata.ptr()) {
+	if (!p_other._cowdata.ptr()) {
 		return;
 	}
 
 	if (!_cowdata.ptr()) {
 		_cowdata = p_other._cowdata;
+		return;
 	}
 
 	const int64_t s1 = size();
@@ -106,14 +106,9 @@ void Input::parse_input_event(const Ref<InputEvent> &p_event) {
 		}
 
 		if (key_event->pressed) {
-			if (!pressed_keys.has(key)) {
-				pressed_keys.append(key);
-			}
+			pressed_keys.insert(key, true);
 		} else {
-			if (pressed_keys.has(key)) {
-				int idx = pressed_keys.find(key);
-				pressed_keys.remove_at(idx);
-			}
+			pressed_keys.erase(key);
 		}
 		// TODO: Re-add left/right command key options. Could be encoded in the uppermost bit of a key event.
 	}
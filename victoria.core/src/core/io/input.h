@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/data/flat_hashtable.h"
 #include "core/math/vector2i.h"
 #include "core/object/ref_counted.h"
 #include "core/typedefs.h"
@@ -250,7 +251,7 @@ public:
  * @brief Input singleton class.
  */
 class VAPI Input {
-	Vector<Key> pressed_keys;
+	FlatHashTable<Key, bool> pressed_keys;
 
 	Mouse current_mouse;
 	Mouse previous_mouse;
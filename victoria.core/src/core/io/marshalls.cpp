@@ -0,0 +1,272 @@
+#include "core/io/marshalls.h"
+
+#include "core/variant/variant_internal.h"
+
+#include <string.h>
+
+#include <utility>
+
+// The low bits of the byte before each value hold its type, and the top bit marks integers and floats that were too
+// large to be stored in 32 bits.
+static constexpr uint8_t ENCODE_TYPE_MASK = 0x7F;
+static constexpr uint8_t ENCODE_FLAG_64 = 0x80;
+
+// Deeper arrays are refused, as they would recurse for too long and come from arrays that contain themselves.
+static constexpr int ENCODE_MAX_DEPTH = 1024;
+
+typedef Error (*VariantEncodeFunc)(const Variant &p_variant, uint8_t *r_buffer, int64_t &r_pos, int p_depth);
+typedef Error (*VariantDecodeFunc)(Variant &r_variant,
+								   uint8_t p_header,
+								   const uint8_t *p_buffer,
+								   int64_t p_len,
+								   int64_t &r_pos,
+								   int p_depth);
+
+static Error encode_variant_at(const Variant &p_variant, uint8_t *r_buffer, int64_t &r_pos, int p_depth);
+static Error decode_variant_at(Variant &r_variant,
+							   const uint8_t *p_buffer,
+							   int64_t p_len,
+							   int64_t &r_pos,
+							   int p_depth);
+
+/* Reading and writing raw bytes */
+
+static FORCE_INLINE void encode_bytes(const void *p_data, uint64_t p_size, uint8_t *r_buffer, int64_t &r_pos) {
+	if (r_buffer) {
+		memcpy(r_buffer + r_pos, p_data, p_size);
+	}
+	r_pos += p_size;
+}
+
+template <typename T>
+static FORCE_INLINE void encode_value(T p_value, uint8_t *r_buffer, int64_t &r_pos) {
+	encode_bytes(&p_value, sizeof(T), r_buffer, r_pos);
+}
+
+static FORCE_INLINE bool decode_bytes(void *r_data,
+									  uint64_t p_size,
+									  const uint8_t *p_buffer,
+									  int64_t p_len,
+									  int64_t &r_pos) {
+	if ((uint64_t)(p_len - r_pos) < p_size) {
+		return false;
+	}
+	memcpy(r_data, p_buffer + r_pos, p_size);
+	r_pos += p_size;
+	return true;
+}
+
+template <typename T>
+static FORCE_INLINE bool decode_value(T &r_value, const uint8_t *p_buffer, int64_t p_len, int64_t &r_pos) {
+	return decode_bytes(&r_value, sizeof(T), p_buffer, p_len, r_pos);
+}
+
+/* Functions for each type, which are put into the tables below */
+
+template <Variant::Type T>
+static Error encode_typed(const Variant &p_variant, uint8_t *r_buffer, int64_t &r_pos, int p_depth) {
+	if constexpr (T == Variant::NIL) {
+		encode_value<uint8_t>(T, r_buffer, r_pos);
+	} else if constexpr (T == Variant::BOOL) {
+		encode_value<uint8_t>(T, r_buffer, r_pos);
+		encode_value<uint8_t>(*VariantInternal::get_ptr<T>(p_variant) ? 1 : 0, r_buffer, r_pos);
+	} else if constexpr (T == Variant::INT) {
+		const int64_t value = *VariantInternal::get_ptr<T>(p_variant);
+		if (value == (int32_t)value) {
+			encode_value<uint8_t>(T, r_buffer, r_pos);
+			encode_value<int32_t>(value, r_buffer, r_pos);
+		} else {
+			encode_value<uint8_t>(T | ENCODE_FLAG_64, r_buffer, r_pos);
+			encode_value<int64_t>(value, r_buffer, r_pos);
+		}
+	} else if constexpr (T == Variant::FLOAT) {
+		const double value = *VariantInternal::get_ptr<T>(p_variant);
+		if ((double)(float)value == value) {
+			encode_value<uint8_t>(T, r_buffer, r_pos);
+			encode_value<float>(value, r_buffer, r_pos);
+		} else {
+			encode_value<uint8_t>(T | ENCODE_FLAG_64, r_buffer, r_pos);
+			encode_value<double>(value, r_buffer, r_pos);
+		}
+	} else if constexpr (T == Variant::STRING) {
+		const String &string = *VariantInternal::get_ptr<T>(p_variant);
+		encode_value<uint8_t>(T, r_buffer, r_pos);
+		encode_value<uint32_t>(string.length(), r_buffer, r_pos);
+		encode_bytes(string.get_data(), string.length(), r_buffer, r_pos);
+	} else if constexpr (T == Variant::ARRAY) {
+		ERR_FAIL_COND_MSG_R(p_depth > ENCODE_MAX_DEPTH, "Arrays are nested too deeply to encode.", ERR_INVALID_DATA);
+
+		const Array &array = *VariantInternal::get_ptr<T>(p_variant);
+		ERR_FAIL_COND_MSG_R(array.size() > UINT32_MAX, "Array is too long to encode.", ERR_INVALID_DATA);
+		encode_value<uint8_t>(T, r_buffer, r_pos);
+		encode_value<uint32_t>(array.size(), r_buffer, r_pos);
+		for (int64_t i = 0; i < array.size(); i++) {
+			Error err = encode_variant_at(array[i], r_buffer, r_pos, p_depth + 1);
+			if (err != OK) {
+				return err;
+			}
+		}
+	} else if constexpr (T >= Variant::BYTE_ARRAY) {
+		const VariantInternal::Type<T> &array = *VariantInternal::get_ptr<T>(p_variant);
+		ERR_FAIL_COND_MSG_R(array.size() > UINT32_MAX, "Array is too long to encode.", ERR_INVALID_DATA);
+		encode_value<uint8_t>(T, r_buffer, r_pos);
+		encode_value<uint32_t>(array.size(), r_buffer, r_pos);
+		encode_bytes(array.ptr(), array.size() * sizeof(typename VariantTypeInfo<T>::Element), r_buffer, r_pos);
+	} else {
+		// Vectors are written as their components.
+		const VariantInternal::Type<T> &vector = *VariantInternal::get_ptr<T>(p_variant);
+		encode_value<uint8_t>(T, r_buffer, r_pos);
+		encode_bytes(vector.elements, sizeof(vector.elements), r_buffer, r_pos);
+	}
+
+	return OK;
+}
+
+template <Variant::Type T>
+static Error decode_typed(Variant &r_variant,
+						  uint8_t p_header,
+						  const uint8_t *p_buffer,
+						  int64_t p_len,
+						  int64_t &r_pos,
+						  int p_depth) {
+	// Only integers and floats can have a flag set.
+	if constexpr (T != Variant::INT && T != Variant::FLOAT) {
+		if (p_header & ENCODE_FLAG_64) {
+			return ERR_INVALID_DATA;
+		}
+	}
+
+	r_variant = Variant::construct(T);
+
+	if constexpr (T == Variant::BOOL) {
+		uint8_t value;
+		if (!decode_value(value, p_buffer, p_len, r_pos) || value > 1) {
+			return ERR_INVALID_DATA;
+		}
+		*VariantInternal::get_ptr<T>(r_variant) = value;
+	} else if constexpr (T == Variant::INT || T == Variant::FLOAT) {
+		typedef VariantInternal::Type<T> Wide;
+		typedef std::conditional_t<T == Variant::INT, int32_t, float> Narrow;
+		if (p_header & ENCODE_FLAG_64) {
+			Wide value;
+			if (!decode_value(value, p_buffer, p_len, r_pos)) {
+				return ERR_INVALID_DATA;
+			}
+			*VariantInternal::get_ptr<T>(r_variant) = value;
+		} else {
+			Narrow value;
+			if (!decode_value(value, p_buffer, p_len, r_pos)) {
+				return ERR_INVALID_DATA;
+			}
+			*VariantInternal::get_ptr<T>(r_variant) = value;
+		}
+	} else if constexpr (T == Variant::STRING) {
+		uint32_t length;
+		if (!decode_value(length, p_buffer, p_len, r_pos) || length > INT32_MAX - 1 || length > p_len - r_pos) {
+			return ERR_INVALID_DATA;
+		}
+		*VariantInternal::get_ptr<T>(r_variant) = String(StringView((const char *)p_buffer + r_pos, length));
+		r_pos += length;
+	} else if constexpr (T == Variant::ARRAY) {
+		uint32_t count;
+		// Every element takes at least a byte, so a count larger than what is left is refused before allocating.
+		if (p_depth > ENCODE_MAX_DEPTH || !decode_value(count, p_buffer, p_len, r_pos) || count > p_len - r_pos) {
+			return ERR_INVALID_DATA;
+		}
+
+		Array &array = *VariantInternal::get_ptr<T>(r_variant);
+		if (array.resize(count) != OK) {
+			return ERR_INVALID_DATA;
+		}
+		for (uint32_t i = 0; i < count; i++) {
+			Error err = decode_variant_at(array[i], p_buffer, p_len, r_pos, p_depth + 1);
+			if (err != OK) {
+				return err;
+			}
+		}
+	} else if constexpr (T >= Variant::BYTE_ARRAY) {
+		typedef typename VariantTypeInfo<T>::Element Element;
+		uint32_t count;
+		if (!decode_value(count, p_buffer, p_len, r_pos) || count * sizeof(Element) > (uint64_t)(p_len - r_pos)) {
+			return ERR_INVALID_DATA;
+		}
+
+		// The array was just created, so it is not shared and writing to it does not copy it.
+		VariantInternal::Type<T> &array = *VariantInternal::get_ptr<T>(r_variant);
+		if (array.resize(count) != OK) {
+			return ERR_INVALID_DATA;
+		}
+		decode_bytes(array.ptrw(), count * sizeof(Element), p_buffer, p_len, r_pos);
+	} else if constexpr (T != Variant::NIL) {
+		VariantInternal::Type<T> &vector = *VariantInternal::get_ptr<T>(r_variant);
+		if (!decode_bytes(vector.elements, sizeof(vector.elements), p_buffer, p_len, r_pos)) {
+			return ERR_INVALID_DATA;
+		}
+	}
+
+	return OK;
+}
+
+/* Dispatch tables */
+
+struct VariantEncodingFuncs {
+	VariantEncodeFunc encode[Variant::VARIANT_MAX];
+	VariantDecodeFunc decode[Variant::VARIANT_MAX];
+};
+
+template <std::size_t... Is>
+static constexpr VariantEncodingFuncs make_encoding_funcs(std::index_sequence<Is...>) {
+	return VariantEncodingFuncs{
+		{&encode_typed<(Variant::Type)Is>...},
+		{&decode_typed<(Variant::Type)Is>...},
+	};
+}
+
+static constexpr VariantEncodingFuncs encoding_funcs =
+	make_encoding_funcs(std::make_index_sequence<Variant::VARIANT_MAX>());
+
+static Error encode_variant_at(const Variant &p_variant, uint8_t *r_buffer, int64_t &r_pos, int p_depth) {
+	return encoding_funcs.encode[p_variant.get_type()](p_variant, r_buffer, r_pos, p_depth);
+}
+
+static Error decode_variant_at(Variant &r_variant,
+							   const uint8_t *p_buffer,
+							   int64_t p_len,
+							   int64_t &r_pos,
+							   int p_depth) {
+	uint8_t header;
+	if (!decode_value(header, p_buffer, p_len, r_pos) || (header & ENCODE_TYPE_MASK) >= Variant::VARIANT_MAX) {
+		return ERR_INVALID_DATA;
+	}
+
+	return encoding_funcs.decode[header & ENCODE_TYPE_MASK](r_variant, header, p_buffer, p_len, r_pos, p_depth);
+}
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int64_t &r_len) {
+	r_len = 0;
+	return encode_variant_at(p_variant, r_buffer, r_len, 0);
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer) {
+	int64_t len = 0;
+	Error err = encode_variant(p_variant, nullptr, len);
+	if (err != OK) {
+		return err;
+	}
+
+	const int64_t offset = r_buffer.size();
+	err = r_buffer.resize(offset + len);
+	ERR_FAIL_COND_MSG_R(err != OK, "Could not grow the buffer to encode the value.", err);
+	return encode_variant(p_variant, r_buffer.ptrw() + offset, len);
+}
+
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int64_t p_len, int64_t *r_len) {
+	ERR_COND_NULL_R(p_buffer, ERR_INVALID_PARAMETER);
+
+	int64_t pos = 0;
+	Error err = decode_variant_at(r_variant, p_buffer, p_len, pos, 0);
+	if (err == OK && r_len) {
+		*r_len = pos;
+	}
+	return err;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "core/data/vector.h"
+#include "core/error/error_types.h"
+#include "core/typedefs.h"
+#include "core/variant/variant.h"
+
+/**
+ * @brief Encodes a `Variant` into a compact binary form that `decode_variant` turns back into the same value. Each
+ * value starts with a byte giving its type, integers and floats that fit in 32 bits are stored in 4 bytes, and strings
+ * and arrays are prefixed with their length. Values are written in the byte order of the machine, which is
+ * little-endian on every target the engine runs on, so typed arrays are written with a single copy of their elements.
+ * @param p_variant The value to encode.
+ * @param r_buffer Where to write the encoded value, which needs room for `r_len` bytes. Pass `nullptr` to only obtain
+ * the length the encoded value takes.
+ * @param r_len Set to the number of bytes the encoded value takes.
+ * @return `ERR_INVALID_DATA` if a string or array is too long to encode or arrays are nested too deeply, which happens
+ * when an array contains itself, and `OK` otherwise.
+ */
+VAPI Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int64_t &r_len);
+
+/**
+ * @brief Encodes a `Variant` the same as above, appending the encoded value to the end of a byte array.
+ */
+VAPI Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer);
+
+/**
+ * @brief Decodes a value written by `encode_variant`. Typed arrays are copied straight from the buffer into the array
+ * held by the `Variant`, with one copy of their elements and no conversion. The data is checked as it is read, so it
+ * can come from an untrusted source such as the network: malformed data is rejected without printing an error.
+ * @param r_variant Set to the decoded value. Left in an unspecified state if decoding fails.
+ * @param p_buffer The encoded value.
+ * @param p_len The number of bytes in the buffer, which can hold more than one value.
+ * @param r_len If given, set to the number of bytes the decoded value took, which is where the next value starts.
+ * @return `ERR_INVALID_DATA` if the data is malformed or cut off, and `OK` otherwise.
+ */
+VAPI Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int64_t p_len, int64_t *r_len = nullptr);
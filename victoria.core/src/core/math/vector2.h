@@ -2,6 +2,7 @@
 
 #include "math_funcs.h"
 
+#include "core/data/hashfuncs.h"
 #include "core/typedefs.h"
 
 class String;
@@ -354,3 +355,11 @@ Vector2 Vector2::normalized() {
 	ret.normalize();
 	return ret;
 }
+
+uint32_t HasherDefault::hash(const Vector2 &p_key) {
+	uint64_t h = HASH_SECRET[0];
+	for (int i = 0; i < 2; i++) {
+		h = hash_combine(h, hash_double_bits(p_key.elements[i]));
+	}
+	return hash_fold(h);
+}
@@ -2,6 +2,7 @@
 
 #include "math_funcs.h"
 
+#include "core/data/hashfuncs.h"
 #include "core/typedefs.h"
 
 class String;
@@ -315,3 +316,11 @@ Vector2i Vector2i::normalized() {
 	ret.normalize();
 	return ret;
 }
+
+uint32_t HasherDefault::hash(const Vector2i &p_key) {
+	uint64_t h = HASH_SECRET[0];
+	for (int i = 0; i < 2; i++) {
+		h = hash_combine(h, (uint64_t)p_key.elements[i]);
+	}
+	return hash_fold(h);
+}
@@ -2,6 +2,7 @@
 
 #include "math_funcs.h"
 
+#include "core/data/hashfuncs.h"
 #include "core/typedefs.h"
 
 class String;
@@ -350,4 +351,12 @@ bool Vector3::is_equal(const Vector3 &p_other) const {
 
 FORCE_INLINE Vector3 operator*(double p_left, const Vector3 &p_right) {
 	return p_right * p_left;
-}
\ No newline at end of file
+}
+
+uint32_t HasherDefault::hash(const Vector3 &p_key) {
+	uint64_t h = HASH_SECRET[0];
+	for (int i = 0; i < 3; i++) {
+		h = hash_combine(h, hash_double_bits(p_key.elements[i]));
+	}
+	return hash_fold(h);
+}
@@ -2,6 +2,7 @@
 
 #include "math_funcs.h"
 
+#include "core/data/hashfuncs.h"
 #include "core/typedefs.h"
 
 class String;
@@ -336,3 +337,11 @@ bool Vector3i::is_normalized() const {
 bool Vector3i::is_equal(const Vector3i &p_other) const {
 	return Math::is_equal(x, p_other.x) && Math::is_equal(y, p_other.y) && Math::is_equal(z, p_other.z);
 }
+
+uint32_t HasherDefault::hash(const Vector3i &p_key) {
+	uint64_t h = HASH_SECRET[0];
+	for (int i = 0; i < 3; i++) {
+		h = hash_combine(h, (uint64_t)p_key.elements[i]);
+	}
+	return hash_fold(h);
+}
@@ -2,6 +2,7 @@
 
 #include "math_funcs.h"
 
+#include "core/data/hashfuncs.h"
 #include "core/typedefs.h"
 
 class String;
@@ -265,3 +266,11 @@ bool Vector4i::is_equal(const Vector4i &p_other) const {
 	return Math::is_equal(x, p_other.x) && Math::is_equal(y, p_other.y) && Math::is_equal(z, p_other.z) &&
 		   Math::is_equal(w, p_other.w);
 }
+
+uint32_t HasherDefault::hash(const Vector4i &p_key) {
+	uint64_t h = HASH_SECRET[0];
+	for (int i = 0; i < 4; i++) {
+		h = hash_combine(h, (uint64_t)p_key.elements[i]);
+	}
+	return hash_fold(h);
+}
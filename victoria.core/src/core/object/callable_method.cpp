@@ -1,79 +1,69 @@
 #include "core/object/callable_method.h"
 
 #include "core/object/command_queue.h"
+#include "core/object/thread_safe_command_queue.h"
+#include "core/os/thread.h"
+
+void CallableMethod::_clear() {
+	if (valid) {
+		_get_base()->~CallableMethodBase();
+		valid = false;
+	}
+}
 
 void CallableMethod::callp(const Variant **p_args, Error &r_error) const {
 	r_error = OK;
-	base->call(p_args == nullptr ? nullptr : p_args);
+	_get_base()->call(p_args);
 }
 
 void CallableMethod::call_deferredp(const Variant **p_args, int p_argc, Error &r_error) const {
-	r_error = OK;
+	// The global queue is only safe to push to from the main thread, which is also the one that flushes it.
+	if (!Thread::is_main_thread() && ThreadSafeCommandQueue::get_singleton()) {
+		r_error = ThreadSafeCommandQueue::get_singleton()->push_commandp(*this, p_args, p_argc);
+		return;
+	}
+
 	r_error = GlobalCommandQueue::get_singleton()->push_commandp(*this, p_args, p_argc);
 }
 
 String CallableMethod::get_name() const {
-	if (base) {
-		return base->get_name();
+	if (valid) {
+		return _get_base()->get_name();
 	}
 	return "";
 }
 
 void CallableMethod::operator=(const CallableMethod &p_other) {
-	CallableMethodBase *cleanup = nullptr;
-	if (base == p_other.base) {
+	if (this == &p_other) {
 		return;
 	}
 
-	cleanup = base;
-	base = nullptr;
-
-	if (p_other.base->refcount.ref()) {
-		base = p_other.base;
-	}
-
-	if (cleanup != nullptr && cleanup->refcount.unref()) {
-		vdelete(cleanup);
+	_clear();
+	if (p_other.valid) {
+		p_other._get_base()->copy_to(storage);
+		valid = true;
 	}
-
-	cleanup = nullptr;
-}
-
-bool CallableMethod::operator==(const CallableMethod &p_other) {
-	if (base == p_other.base) {
-		return true;
-	}
-
-	return false;
 }
 
-bool CallableMethod::operator!=(const CallableMethod &p_other) {
-	if (base == p_other.base) {
-		return false;
+bool CallableMethod::operator==(const CallableMethod &p_other) const {
+	if (!valid || !p_other.valid) {
+		return valid == p_other.valid;
 	}
 
-	return true;
+	return _get_base()->is_equal(*p_other._get_base());
 }
 
-CallableMethod::CallableMethod(CallableMethodBase *p_base) {
-	base = p_base;
+bool CallableMethod::operator!=(const CallableMethod &p_other) const {
+	return !(*this == p_other);
 }
 
-CallableMethod::~CallableMethod() {
-	if (base && base->refcount.unref()) {
-		vdelete(base);
-		base = nullptr;
+CallableMethod::CallableMethod(const CallableMethod &p_other) {
+	if (p_other.valid) {
+		p_other._get_base()->copy_to(storage);
+		valid = true;
 	}
 }
 
-CallableMethodBase::CallableMethodBase() {
-	refcount.init();
-}
-
-String CallableMethodBase::get_name() const {
-	return name;
+CallableMethod::~CallableMethod() {
+	_clear();
 }
-
-void CallableMethodBase::set_name(const String &p_name) {
-	name = p_name;
-}
\ No newline at end of file
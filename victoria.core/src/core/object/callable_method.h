@@ -1,16 +1,80 @@
 #pragma once
 
-#include "core/data/atomic_counter.h"
 #include "core/string/vstring.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
-class CallableMethodBase;
+/**
+ * @brief Implementation of `CallableMethod` data so that functionality referring to different types of methods can be
+ * implemented and access the same. Implementations are stored inside the `CallableMethod` itself rather than on the
+ * heap, so they must fit in `CallableMethod::INLINE_SIZE` bytes and be cheap to copy.
+ */
+class VAPI CallableMethodBase {
+public:
+	/**
+	 * @brief Calls the bound method. Abstract on the base as this needs to be overridden for each implementation, as
+	 * static function pointers differ to non-static ones and the like.
+	 * @param p_args Array of argument pointers to pass into the function.
+	 */
+	virtual void call(const Variant **p_args) const = 0;
+
+	/**
+	 * @brief Obtains the name of the function, in the form `<class_name>::<function_name>`. Only meant for debugging,
+	 * so it is built when asked for rather than stored.
+	 */
+	virtual String get_name() const = 0;
+
+	/**
+	 * @brief Checks whether both implementations call the same method on the same object.
+	 */
+	virtual bool is_equal(const CallableMethodBase &p_other) const = 0;
+
+	/**
+	 * @brief Copy-constructs this implementation into the storage of another `CallableMethod`.
+	 */
+	virtual void copy_to(void *p_storage) const = 0;
+
+	virtual ~CallableMethodBase() {}
+};
 
 class VAPI CallableMethod {
-	CallableMethodBase *base = nullptr;
+public:
+	enum {
+		// Enough for the vtable, an object and a member function pointer, which is up to three pointers wide on some
+		// compilers, and the name.
+		INLINE_SIZE = 6 * sizeof(void *)
+	};
+
+private:
+	alignas(void *) uint8_t storage[INLINE_SIZE];
+	bool valid = false;
+
+	FORCE_INLINE CallableMethodBase *_get_base() {
+		return (CallableMethodBase *)storage;
+	}
+
+	FORCE_INLINE const CallableMethodBase *_get_base() const {
+		return (const CallableMethodBase *)storage;
+	}
+
+	void _clear();
 
 public:
+	/**
+	 * @brief Creates a callable holding an implementation of `CallableMethodBase`, constructed in place without
+	 * allocating.
+	 * @param p_args The arguments passed to the constructor of the implementation.
+	 */
+	template <typename T, typename... CtorArgs>
+	static CallableMethod create(CtorArgs... p_args) {
+		static_assert(sizeof(T) <= INLINE_SIZE, "CallableMethodBase implementation is too large to store inline.");
+		static_assert(alignof(T) <= alignof(void *), "CallableMethodBase implementation is over-aligned.");
+		CallableMethod callable;
+		vnew_placement(callable.storage, T(p_args...));
+		callable.valid = true;
+		return callable;
+	}
+
 	/**
 	 * @brief Calls the method bound to this callable with the passed arguments.
 	 * @param p_args Variadic list of arguments that are passed to the function. Currently, there is no way to verify
@@ -59,7 +123,8 @@ public:
 	void call_deferredp(const Variant **p_args, int p_argc, Error &r_error) const;
 
 	/**
-	 * @brief Obtains the name of the function.
+	 * @brief Obtains the name of the function. Builds a new string every time, so it should only be used for
+	 * debugging and error messages.
 	 * @return The name of the function.
 	 */
 	String get_name() const;
@@ -70,7 +135,7 @@ public:
 	 * @return `true` if non-null, and `false` if not.
 	 */
 	FORCE_INLINE bool is_valid() const {
-		return base != nullptr;
+		return valid;
 	}
 
 	/**
@@ -78,52 +143,21 @@ public:
 	 * @return `true` if null, and `false` if not.
 	 */
 	FORCE_INLINE bool is_null() const {
-		return base == nullptr;
+		return !valid;
 	}
 
 	void operator=(const CallableMethod &p_other);
 
-	bool operator==(const CallableMethod &p_other);
-	bool operator!=(const CallableMethod &p_other);
-
-	CallableMethod() {}
-	CallableMethod(CallableMethodBase *p_base);
-	~CallableMethod();
-};
-
-/**
- * @brief Implementation of `CallableMethod` data so that functionality referring to different types of methods can be
- * implemented and access the same.
- */
-class VAPI CallableMethodBase {
-	friend class CallableMethod;
-	String name;	   // The name of the function. Will be in the form `<class_name>::<function_name>`.
-	Refcount refcount; // The reference count to the current method base. Bases are transferred between callables to
-					   // save on memory allocations and consistency
-
-public:
-	/**
-	 * @brief Sets the name of the function. Shouldn't be called outside of the constructor, but for implementation
-	 * reasons needs to be public.
-	 * @param p_name The name of the function, usually derived from the function pointer passed during creation.
-	 */
-	void set_name(const String &p_name);
-
 	/**
-	 * @brief Virtual name-getting function. Can be overridden in later implementations.
-	 * @return The name of the method.
+	 * @brief Checks whether both callables call the same method on the same object, even if they were created
+	 * separately.
 	 */
-	virtual String get_name() const;
+	bool operator==(const CallableMethod &p_other) const;
+	bool operator!=(const CallableMethod &p_other) const;
 
-	/**
-	 * @brief Calls the bound method. Abstract on the base as this needs to be overridden for each implementation, as
-	 * static function pointers differ to non-static ones and the like.
-	 * @param p_args Array of argument pointers to pass into the function.
-	 */
-	virtual void call(const Variant **p_args) = 0;
-
-	CallableMethodBase();
-	virtual ~CallableMethodBase() {}
+	CallableMethod() {}
+	CallableMethod(const CallableMethod &p_other);
+	~CallableMethod();
 };
 
 template <typename... Args>
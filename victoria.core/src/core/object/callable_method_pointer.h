@@ -15,32 +15,48 @@ void static_method_call_varargs(void (*p_method)(Args...), const Variant **p_arg
 	p_method(VariantCaster<Args>::cast(*p_args[Is])...);
 }
 
+/**
+ * @brief Turns the stringified function passed to `callable_mp` into its name, without the leading `&`.
+ */
+FORCE_INLINE String callable_method_pointer_name(const char *p_name) {
+	return String(p_name[0] == '&' ? p_name + 1 : p_name);
+}
+
 template <typename C, typename... Args>
 class VAPI CallableMethodPointer : public CallableMethodBase {
 	C *instance_ptr = nullptr;
 	void (C::*method_ptr)(Args...) = nullptr;
+	const char *name = nullptr; // The stringified function, which lives as long as the program
 
 public:
 	virtual String get_name() const override {
-		return CallableMethodBase::get_name();
+		return callable_method_pointer_name(name);
 	}
 
-	virtual void call(const Variant **p_args) override {
+	virtual void call(const Variant **p_args) const override {
 		method_call_varargs(instance_ptr, method_ptr, p_args, BuildIndicies<sizeof...(Args)>{});
 	}
 
+	virtual bool is_equal(const CallableMethodBase &p_other) const override {
+		const CallableMethodPointer *other = dynamic_cast<const CallableMethodPointer *>(&p_other);
+		return other && other->instance_ptr == instance_ptr && other->method_ptr == method_ptr;
+	}
+
+	virtual void copy_to(void *p_storage) const override {
+		vnew_placement(p_storage, CallableMethodPointer(*this));
+	}
+
 	CallableMethodPointer(C *p_instance, const char *p_name, void (C::*p_method)(Args...)) {
 		instance_ptr = p_instance;
 		method_ptr = p_method;
+		name = p_name;
 	}
 };
 
 template <typename C, typename... Args>
 VAPI CallableMethod create_callable_method_pointer(C *p_instance, const char *p_name, void (C::*p_method)(Args...)) {
 	typedef CallableMethodPointer<C, Args...> CMP;
-	CMP *cmp = vnew(CMP(p_instance, p_name, p_method));
-	cmp->set_name(p_name + 1);
-	return CallableMethod(cmp);
+	return CallableMethod::create<CMP>(p_instance, p_name, p_method);
 }
 
 #define callable_mp(m_c, m_p) create_callable_method_pointer(m_c, #m_p, m_p)
@@ -48,27 +64,36 @@ VAPI CallableMethod create_callable_method_pointer(C *p_instance, const char *p_
 template <typename... Args>
 class VAPI CallableMethodPointerStatic : public CallableMethodBase {
 	void (*method_ptr)(Args...) = nullptr;
+	const char *name = nullptr; // The stringified function, which lives as long as the program
 
 public:
 	virtual String get_name() const override {
-		return CallableMethodBase::get_name();
+		return callable_method_pointer_name(name);
 	}
 
-	virtual void call(const Variant **p_args) override {
+	virtual void call(const Variant **p_args) const override {
 		static_method_call_varargs(method_ptr, p_args, BuildIndicies<sizeof...(Args)>{});
 	}
 
+	virtual bool is_equal(const CallableMethodBase &p_other) const override {
+		const CallableMethodPointerStatic *other = dynamic_cast<const CallableMethodPointerStatic *>(&p_other);
+		return other && other->method_ptr == method_ptr;
+	}
+
+	virtual void copy_to(void *p_storage) const override {
+		vnew_placement(p_storage, CallableMethodPointerStatic(*this));
+	}
+
 	CallableMethodPointerStatic(const char *p_name, void (*p_method)(Args...)) {
 		method_ptr = p_method;
+		name = p_name;
 	}
 };
 
 template <typename... Args>
 VAPI CallableMethod create_static_callable_method_pointer(const char *p_name, void (*p_method)(Args...)) {
 	typedef CallableMethodPointerStatic<Args...> CMPS;
-	CMPS *cmp = vnew(CMPS(p_name, p_method));
-	cmp->set_name(p_name + 1);
-	return CallableMethod(cmp);
+	return CallableMethod::create<CMPS>(p_name, p_method);
 }
 
 #define static_callable_mp(m_n) create_static_callable_method_pointer(#m_n, m_n)
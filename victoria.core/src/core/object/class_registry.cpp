@@ -1,8 +1,10 @@
 #include "core/object/class_registry.h"
 
-HashTable<String, ClassRegistry::ClassInfo> ClassRegistry::classes;
+FlatHashTable<StringName, ClassRegistry::ClassInfo> ClassRegistry::classes;
+uint32_t ClassRegistry::class_id_count = 0;
+LocalVector<MethodBind *> ClassRegistry::method_binds;
 
-Object *ClassRegistry::instantiate(const String &p_class) {
+Object *ClassRegistry::instantiate(const StringName &p_class) {
 	ClassInfo *ci;
 
 	ci = classes.get_ptr(p_class);
@@ -16,26 +18,144 @@ Object *ClassRegistry::instantiate(const String &p_class) {
 	return ci->creation_func();
 }
 
-void ClassRegistry::add_signal(const String &p_class, const String &p_signal) {
+void ClassRegistry::_set_signal_base(ClassInfo &r_info) {
+	const ClassInfo *parent = classes.get_ptr(r_info.inherits);
+	r_info.signal_base = parent ? parent->signal_base + parent->signals.size() : 0;
+}
+
+void ClassRegistry::_update_class_types() {
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		E.value.type->pre = 0;
+		E.value.type->post = 0;
+		if (E.value.type->id == 0) {
+			E.value.type->id = ++class_id_count;
+		}
+	}
+
+	uint32_t next = 0;
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		if (E.value.inherits == StringName()) {
+			_number_class(E.value, next);
+		}
+	}
+}
+
+void ClassRegistry::_number_class(ClassInfo &r_info, uint32_t &r_next) {
+	r_info.type->pre = ++r_next;
+	// Fine to go through every class for each one, as there are few of them and they are only registered on startup.
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		if (E.value.inherits == r_info.name) {
+			_number_class(E.value, r_next);
+		}
+	}
+	r_info.type->post = r_next;
+}
+
+SignalID ClassRegistry::add_signal(const StringName &p_class, const StringName &p_signal) {
 	ClassInfo *c = classes.get_ptr(p_class);
-	ERR_COND_NULL_MSG(c, vformat("Class \'%s\' is null.", p_class.get_data()));
+	ERR_COND_NULL_MSG_R(c, vformat("Class \'%s\' is null.", p_class.get_data()), INVALID_SIGNAL_ID);
 
-	if (c->signals.has(p_signal)) {
-		return;
+	for (int64_t i = 0; i < c->signals.size(); i++) {
+		if (c->signals[i] == p_signal) {
+			return c->signal_base + i;
+		}
 	}
 
 	c->signals.push_back(p_signal);
+	return c->signal_base + c->signals.size() - 1;
 }
 
-bool ClassRegistry::has_signal(const String &p_class, const String &p_signal) {
+SignalID ClassRegistry::get_signal_id(const StringName &p_class, const StringName &p_signal) {
+	const ClassInfo *c = classes.get_ptr(p_class);
+	while (c) {
+		for (int64_t i = 0; i < c->signals.size(); i++) {
+			if (c->signals[i] == p_signal) {
+				return c->signal_base + i;
+			}
+		}
+
+		c = classes.get_ptr(c->inherits);
+	}
+
+	return INVALID_SIGNAL_ID;
+}
+
+uint32_t ClassRegistry::get_signal_count(const StringName &p_class) {
+	const ClassInfo *c = classes.get_ptr(p_class);
+	return c ? c->signal_base + c->signals.size() : 0;
+}
+
+bool ClassRegistry::has_signal(const StringName &p_class, const StringName &p_signal) {
+	return get_signal_id(p_class, p_signal) != INVALID_SIGNAL_ID;
+}
+
+uint32_t ClassRegistry::get_class_id(const StringName &p_class) {
+	const ClassInfo *c = classes.get_ptr(p_class);
+	return c ? c->type->id : 0;
+}
+
+MethodID ClassRegistry::_add_method_bind(MethodBind *p_bind,
+										 const StringName &p_class,
+										 const StringName &p_name,
+										 const StringName *p_argument_names,
+										 int p_argument_name_count) {
 	ClassInfo *c = classes.get_ptr(p_class);
+	if (!c) {
+		vdelete(p_bind);
+		ERR_FAIL_MSG_R(vformat("Cannot bind method \'%s\' to class \'%s\', as it is not registered.",
+							   p_name.get_data(),
+							   p_class.get_data()),
+					   INVALID_METHOD_ID);
+	}
+
+	for (int64_t i = 0; i < c->methods.size(); i++) {
+		if (c->methods[i]->name == p_name) {
+			vdelete(p_bind);
+			ERR_FAIL_MSG_R(
+				vformat("Method \'%s\' is already bound to class \'%s\'.", p_name.get_data(), p_class.get_data()),
+				INVALID_METHOD_ID);
+		}
+	}
+
+	p_bind->name = p_name;
+	p_bind->class_name = p_class;
+	p_bind->id = method_binds.size();
+	for (int i = 0; i < p_argument_name_count; i++) {
+		p_bind->argument_names.push_back(p_argument_names[i]);
+	}
+
+	method_binds.push_back(p_bind);
+	c->methods.push_back(p_bind);
+	return p_bind->id;
+}
+
+MethodID ClassRegistry::get_method_id(const StringName &p_class, const StringName &p_method) {
+	MethodBind *bind = get_method(p_class, p_method);
+	return bind ? bind->id : INVALID_METHOD_ID;
+}
+
+MethodBind *ClassRegistry::get_method(const StringName &p_class, const StringName &p_method) {
+	const ClassInfo *c = classes.get_ptr(p_class);
 	while (c) {
-		if (c->signals.has(p_signal)) {
-			return true;
+		for (int64_t i = 0; i < c->methods.size(); i++) {
+			if (c->methods[i]->name == p_method) {
+				return c->methods[i];
+			}
 		}
 
 		c = classes.get_ptr(c->inherits);
 	}
 
-	return false;
-}
\ No newline at end of file
+	return nullptr;
+}
+
+void ClassRegistry::cleanup() {
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		E.value.methods.clear();
+	}
+
+	for (MethodBind *bind : method_binds) {
+		vdelete(bind);
+	}
+	method_binds.reset();
+}
@@ -2,7 +2,9 @@
 
 #include "callable_method_pointer.h" // IWYU pragma: keep
 
-#include "core/data/hashtable.h"
+#include "core/data/flat_hashtable.h"
+#include "core/data/vector.h"
+#include "core/object/method_bind.h"
 #include "core/object/object.h"
 #include "core/string/print_string.h"
 #include "core/typedefs.h"
@@ -11,49 +13,184 @@ class VAPI ClassRegistry {
 private:
 	struct ClassInfo {
 		Object *(*creation_func)() = nullptr;
-		String name;
-		String inherits;
-		List<String> signals;
+		StringName name;
+		StringName inherits;
+		ClassType *type = nullptr;
+		Vector<StringName> signals;	  // Signals added by this class itself, not the ones it inherits
+		Vector<MethodBind *> methods; // Methods bound to this class itself, owned by `method_binds`
+		SignalID signal_base = 0;	  // The ID of this class's first signal, after those of every class it inherits
 		bool is_registered = false;
 	};
-	static HashTable<String, ClassInfo> classes;
+	static FlatHashTable<StringName, ClassInfo> classes;
+
+	/**
+	 * @brief Numbers the class's signals after those of the class it inherits, which has to be registered already for
+	 * its signals to be counted.
+	 */
+	static void _set_signal_base(ClassInfo &r_info);
+
+	static uint32_t class_id_count;
+
+	/**
+	 * @brief Gives the newly registered class its ID, then numbers every class in depth-first order starting from the
+	 * ones that inherit nothing. Classes inheriting from one that is not registered are left unnumbered.
+	 */
+	static void _update_class_types();
+	static void _number_class(ClassInfo &r_info, uint32_t &r_next);
+
+	static LocalVector<MethodBind *> method_binds; // Every bound method, indexed by `MethodID`
+
+	/**
+	 * @brief Adds a method created by `bind_method` to the class and gives it its ID, or deletes it if the class
+	 * cannot take it.
+	 */
+	static MethodID _add_method_bind(MethodBind *p_bind,
+									 const StringName &p_class,
+									 const StringName &p_name,
+									 const StringName *p_argument_names,
+									 int p_argument_name_count);
 
 	template <typename T>
 	static Object *creator() {
-		Object *obj = vnew(T);
+		Object *obj = vnew_tagged(T, MEMORY_TAG_OBJECT);
 		return obj;
 	}
 
 public:
 	template <typename T>
 	static void register_class() {
+		const StringName &cname = T::get_class_name_static();
+		// Registering again would drop the signals and methods the class already bound.
+		if (classes.has(cname)) {
+			return;
+		}
+
 		ClassInfo ci;
-		String cname = T::get_class_name_static();
 		ci.name = cname;
 		ci.inherits = T::get_inherited_class_name_static();
 		ci.creation_func = &creator<T>;
+		ci.type = &T::get_class_type_static();
+		ci.type->notification_mask = T::get_notification_mask_static();
 		ci.is_registered = true;
+		_set_signal_base(ci);
 		print_verbose(vformat("Registering class %s", cname.get_data()));
 		classes.insert(cname, ci);
+		_update_class_types();
 		T::initialize_class();
 	}
 
 	template <typename T>
 	static void register_abstract_class() {
+		const StringName &cname = T::get_class_name_static();
+		// Registering again would drop the signals and methods the class already bound.
+		if (classes.has(cname)) {
+			return;
+		}
+
 		ClassInfo ci;
-		String cname = T::get_class_name_static();
 		ci.name = cname;
 		ci.inherits = T::get_inherited_class_name_static();
+		ci.type = &T::get_class_type_static();
+		ci.type->notification_mask = T::get_notification_mask_static();
 		ci.is_registered = true;
+		_set_signal_base(ci);
 		print_verbose(vformat("Registering abstract class %s", cname.get_data()));
 		classes.insert(cname, ci);
+		_update_class_types();
 		T::initialize_class();
 	}
 
-	static void add_signal(const String &p_class, const String &p_signal);
-	static bool has_signal(const String &p_class, const String &p_signal);
+	/**
+	 * @brief Adds a signal to a class, which should be done in its `_bind_methods()`. A class's signals are given the
+	 * IDs following those of the classes it inherits, so an object only needs an array as long as the number of
+	 * signals its class has to keep track of its connections.
+	 * @return The ID of the signal, which is the same for the class and every class inheriting from it, or
+	 * `INVALID_SIGNAL_ID` if the class is not registered.
+	 */
+	static SignalID add_signal(const StringName &p_class, const StringName &p_signal);
+
+	/**
+	 * @brief Obtains the ID of a signal that the class or one of the classes it inherits has added.
+	 * @return The ID of the signal, or `INVALID_SIGNAL_ID` if there is no such signal.
+	 */
+	static SignalID get_signal_id(const StringName &p_class, const StringName &p_signal);
+
+	/**
+	 * @brief Obtains the number of signals a class has, including the ones it inherits. Every signal ID of the class
+	 * is lower than this.
+	 */
+	static uint32_t get_signal_count(const StringName &p_class);
+
+	static bool has_signal(const StringName &p_class, const StringName &p_signal);
+
+	/**
+	 * @brief Obtains the ID the class was given when it was registered, or 0 if it is not registered.
+	 */
+	static uint32_t get_class_id(const StringName &p_class);
+
+	/**
+	 * @brief Binds a method of a class so that it can be called on objects of the class by name or by ID, which
+	 * should be done in the class's `_bind_methods()`. The calls to the method are generated from its signature, and
+	 * calling it through `MethodBind::ptrcall` involves no lookups or `Variant`s at all.
+	 * @param p_method The method to bind, whose arguments and return value have to be types a `Variant` can hold.
+	 * @param p_name The name to bind the method under.
+	 * @param p_argument_names The names of the method's arguments, either one for each argument or none at all.
+	 * @return The ID of the bound method, or `INVALID_METHOD_ID` if the class is not registered or already has a
+	 * method with that name.
+	 */
+	template <typename T, typename R, typename... Args, typename... Names>
+	static MethodID bind_method(R (T::*p_method)(Args...),
+								const StringName &p_name,
+								const Names &...p_argument_names) {
+		static_assert(sizeof...(Names) == 0 || sizeof...(Names) == sizeof...(Args),
+					  "Either every argument of a bound method is named, or none of them are.");
+		typedef MethodBindT<T, R (T::*)(Args...), R, Args...> MB;
+		const StringName names[sizeof...(Names) + 1] = {StringName(p_argument_names)..., StringName()};
+		MethodBind *bind = vnew_tagged(MB(p_method), MEMORY_TAG_OBJECT);
+		return _add_method_bind(bind, T::get_class_name_static(), p_name, names, sizeof...(Names));
+	}
+
+	/**
+	 * @brief Binds a `const` method of a class, the same as the non-`const` version.
+	 */
+	template <typename T, typename R, typename... Args, typename... Names>
+	static MethodID bind_method(R (T::*p_method)(Args...) const,
+								const StringName &p_name,
+								const Names &...p_argument_names) {
+		static_assert(sizeof...(Names) == 0 || sizeof...(Names) == sizeof...(Args),
+					  "Either every argument of a bound method is named, or none of them are.");
+		typedef MethodBindT<T, R (T::*)(Args...) const, R, Args...> MB;
+		const StringName names[sizeof...(Names) + 1] = {StringName(p_argument_names)..., StringName()};
+		MethodBind *bind = vnew_tagged(MB(p_method), MEMORY_TAG_OBJECT);
+		return _add_method_bind(bind, T::get_class_name_static(), p_name, names, sizeof...(Names));
+	}
+
+	/**
+	 * @brief Obtains the ID of a method bound to the class or one of the classes it inherits. Looking the ID up once
+	 * and keeping it avoids looking the name up on every call.
+	 * @return The ID of the method, or `INVALID_METHOD_ID` if there is no such method.
+	 */
+	static MethodID get_method_id(const StringName &p_class, const StringName &p_method);
+
+	/**
+	 * @brief Obtains a method bound to the class or one of the classes it inherits, or `nullptr` if there is none.
+	 */
+	static MethodBind *get_method(const StringName &p_class, const StringName &p_method);
+
+	/**
+	 * @brief Obtains a bound method from its ID, or `nullptr` if the ID is not valid.
+	 */
+	FORCE_INLINE static MethodBind *get_method(MethodID p_id) {
+		ERR_FAIL_COND_R(p_id >= method_binds.size(), nullptr);
+		return method_binds[p_id];
+	}
+
+	static Object *instantiate(const StringName &p_class);
 
-	static Object *instantiate(const String &p_class);
+	/**
+	 * @brief Frees every bound method. Nothing can be called through the registry afterwards.
+	 */
+	static void cleanup();
 };
 
 #define REGISTER_CLASS(m_class) ClassRegistry::register_class<m_class>();
@@ -5,66 +5,74 @@
 
 #include <stdlib.h>
 
-Error CommandQueue::push_commandp(const CallableMethod &p_method, const Variant **p_args, int p_argcount) {
-	// Allocate a new page if needed
-	if (PAGE_SIZE - bytes_per_page[allocated_memory.page_count - 1] < sizeof(Message)) {
-		uint8_t *new_memory =
-			(uint8_t *)Memory::vreallocate(allocated_memory.mem, ++allocated_memory.page_count * PAGE_SIZE);
-		ERR_COND_NULL_R(new_memory, ERR_OUT_OF_MEMORY);
-		allocated_memory.mem = new_memory;
-		allocated_memory.page_offset = 0;
-		if (bytes_per_page.size() < allocated_memory.page_count) {
-			bytes_per_page.push_back(0);
+Error CommandQueue::_push_page(uint32_t p_size) {
+	Page *page = nullptr;
+	if (p_size <= PAGE_CAPACITY && !_free_pages.is_empty()) {
+		page = _free_pages[_free_pages.size() - 1];
+		_free_pages.remove_at(_free_pages.size() - 1);
+	} else {
+		uint32_t capacity = p_size > PAGE_CAPACITY ? p_size : (uint32_t)PAGE_CAPACITY;
+		page = (Page *)Memory::vallocate(sizeof(Page) + capacity);
+		ERR_COND_NULL_R(page, ERR_OUT_OF_MEMORY);
+		page->capacity = capacity;
+		if (capacity == PAGE_CAPACITY) {
+			_page_count++;
 		}
 	}
-	// Get next possible location on the heap
-	uint32_t &offset = bytes_per_page[allocated_memory.page_count - 1];
-	uint8_t *mem = allocated_memory.mem + (allocated_memory.page_count - 1) * PAGE_SIZE;
 
-	Message *mptr = vnew_placement(mem + offset, Message);
-	offset += sizeof(Message);
-	mptr->callable = p_method;
-	mptr->argcount = p_argcount;
+	page->used = 0;
+	_pages.push_back(page);
+	return OK;
+}
 
-	if (PAGE_SIZE - offset < sizeof(Variant) * p_argcount) {
-		uint8_t *new_memory =
-			(uint8_t *)Memory::vreallocate(allocated_memory.mem, ++allocated_memory.page_count * PAGE_SIZE);
-		ERR_COND_NULL_R(new_memory, ERR_OUT_OF_MEMORY);
-		allocated_memory.mem = new_memory;
-		allocated_memory.page_offset = 0;
-		if (bytes_per_page.size() < allocated_memory.page_count) {
-			bytes_per_page.push_back(0);
-		}
-		mem = allocated_memory.mem + PAGE_SIZE * (allocated_memory.page_count - 1);
-		offset = bytes_per_page[allocated_memory.page_count - 1];
-	}
+void *CommandQueue::_allocate_command(uint32_t p_size, uint32_t &r_size) {
+	r_size = (p_size + COMMAND_ALIGNMENT - 1) & ~(uint32_t)(COMMAND_ALIGNMENT - 1);
 
-	if (p_args && p_argcount > 0) {
-		for (int i = 0; i < p_argcount; i++) {
-			Variant *v = vnew_placement(mem + offset, Variant);
-			offset += sizeof(Variant);
-			*v = *p_args[i];
-		}
+	// Commands are never split between pages, so that they can be read back exactly as they were written.
+	Page *page = _pages.is_empty() ? nullptr : _pages[_pages.size() - 1];
+	if (!page || page->capacity - page->used < r_size) {
+		Error err = _push_page(r_size);
+		ERR_FAIL_COND_R(err != OK, nullptr);
+		page = _pages[_pages.size() - 1];
 	}
 
-	return OK;
+	uint8_t *mem = page->get_data() + page->used;
+	page->used += r_size;
+	_queued_bytes += r_size;
+	if (_queued_bytes > _high_water_mark) {
+		_high_water_mark = _queued_bytes;
+	}
+	return mem;
 }
 
-void CommandQueue::flush() {
-	uint32_t page = 0;
-	uint32_t offset = 0;
-	while (page < allocated_memory.page_count && offset < bytes_per_page[page]) {
-		Message *m = (Message *)(allocated_memory.mem + (page * PAGE_SIZE) + offset);
-		offset += sizeof(Message);
-		// Find arguments
-		uint32_t varmem = m->argcount * sizeof(Variant);
-		if (PAGE_SIZE - offset < varmem) {
-			page++;
-			offset = 0;
+void CommandQueue::_drain(bool p_call) {
+	// Commands may push more commands while being called, which end up on the last page or on new ones, so the page
+	// count and usage are read again every time. The pages themselves never move.
+	for (uint32_t i = 0; i < _pages.size(); i++) {
+		uint32_t offset = 0;
+		while (offset < _pages[i]->used) {
+			Command *c = (Command *)(_pages[i]->get_data() + offset);
+			offset += c->size;
+			c->call(c, p_call);
 		}
+	}
 
-		Variant *args = (Variant *)(allocated_memory.mem + (PAGE_SIZE * page) + offset);
+	for (Page *page : _pages) {
+		if (page->capacity == PAGE_CAPACITY) {
+			_free_pages.push_back(page);
+		} else {
+			Memory::vfree(page, sizeof(Page) + page->capacity);
+		}
+	}
+	_pages.clear();
+	_queued_bytes = 0;
+}
+
+void CommandQueue::VariantCommand::call_variant(Command *p_command, bool p_call) {
+	VariantCommand *m = (VariantCommand *)p_command;
+	Variant *args = (Variant *)(m + 1);
 
+	if (p_call) {
 		// Construct argptrs
 		Variant **argptrs = nullptr;
 		if (m->argcount > 0) {
@@ -79,63 +87,64 @@ void CommandQueue::flush() {
 		if (err != OK) {
 			OS::get_singleton()->printerr("Callable returned error to queue of \'%s\'.", get_error_message(err));
 		}
+	}
 
-		// Destruct elements now they've been unused.
-		for (int i = 0; i < m->argcount; i++) {
-			args[i].~Variant();
-		}
-		m->~Message();
+	// Destruct elements now they've been unused.
+	for (int i = 0; i < m->argcount; i++) {
+		args[i].~Variant();
+	}
+	m->~VariantCommand();
+}
 
-		// Reach end of page
-		if (offset == bytes_per_page[page]) {
-			page++;
-			offset = 0;
-		}
+Error CommandQueue::push_commandp(const CallableMethod &p_method, const Variant **p_args, int p_argcount) {
+	uint32_t size = 0;
+	uint8_t *mem = (uint8_t *)_allocate_command(sizeof(VariantCommand) + sizeof(Variant) * p_argcount, size);
+	ERR_COND_NULL_R(mem, ERR_OUT_OF_MEMORY);
+
+	VariantCommand *mptr = vnew_placement(mem, VariantCommand);
+	mptr->call = &VariantCommand::call_variant;
+	mptr->size = size;
+	mptr->callable = p_method;
+	mptr->argcount = p_argcount;
+
+	// The arguments directly follow the command on the same page.
+	Variant *args = (Variant *)(mptr + 1);
+	for (int i = 0; i < p_argcount; i++) {
+		Variant *v = vnew_placement(&args[i], Variant);
+		*v = *p_args[i];
 	}
 
-	bytes_per_page[0] = 0;
-	allocated_memory.page_count = 1;
+	return OK;
+}
+
+void CommandQueue::flush() {
+	_drain(true);
 }
 
 void CommandQueue::clear() {
-	uint32_t page = 0;
-	uint32_t offset = 0;
-	while (page < allocated_memory.page_count && offset < bytes_per_page[page]) {
-		Message *m = (Message *)(allocated_memory.mem + (page * PAGE_SIZE) + offset);
-		offset += sizeof(Message);
-		if (offset < sizeof(Variant) * m->argcount) {
-			page++;
-			offset = 0;
-		}
-		Variant *args = (Variant *)(allocated_memory.mem + (page * PAGE_SIZE) + offset);
-		for (int i = 0; i < m->argcount; i++) {
-			args[i].~Variant();
-			offset += sizeof(Variant);
-		}
-
-		m->~Message();
+	_drain(false);
+}
 
-		if (offset == bytes_per_page[page]) {
-			page++;
-			offset = 0;
-		}
+void CommandQueue::reserve(uint32_t p_bytes) {
+	uint32_t pages = (p_bytes + PAGE_CAPACITY - 1) / PAGE_CAPACITY;
+	while (_page_count < pages) {
+		Page *page = (Page *)Memory::vallocate(PAGE_SIZE);
+		ERR_COND_NULL(page);
+		page->capacity = PAGE_CAPACITY;
+		_free_pages.push_back(page);
+		_page_count++;
 	}
-
-	bytes_per_page[0] = 0;
-	allocated_memory.page_count = 1;
 }
 
 CommandQueue::CommandQueue() {
-	allocated_memory.mem = (uint8_t *)Memory::vallocate_zeroed(PAGE_SIZE);
-	allocated_memory.page_count = 1;
-	bytes_per_page.push_back(0);
+	reserve(PAGE_CAPACITY);
 }
 
 CommandQueue::~CommandQueue() {
 	clear();
 
-	if (allocated_memory.mem) {
-		Memory::vfree(allocated_memory.mem);
+	for (Page *page : _free_pages) {
+		Memory::vfree(page, PAGE_SIZE);
 	}
 }
 
@@ -1,37 +1,145 @@
 #pragma once
 
+#include "core/data/local_vector.h"
 #include "core/object/callable_method.h"
 #include "core/typedefs.h"
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 /**
  * @brief A class that can have methods pushed to it and called later on. All events are called when `flush()` occurs.
  */
 class VAPI CommandQueue {
-	// A given message pushed to the queue.
-	struct Message {
+	// The start of every command on the queue, which is followed by whatever the command needs to be called.
+	struct Command {
+		// Calls the command if `p_call` is set, then destructs it.
+		void (*call)(Command *p_command, bool p_call);
+		// The number of bytes the whole command takes up, including anything that follows it.
+		uint32_t size;
+	};
+
+	// A command pushed through `push_command`, whose arguments follow it as `Variant`s.
+	struct VariantCommand : public Command {
 		CallableMethod callable; // The actual function to call
 		int32_t argcount;		 // The number of arguments passed to the function
+
+		static void call_variant(Command *p_command, bool p_call);
 	};
 
-	enum {
-		PAGE_SIZE = 4096 // Number of bytes to a page. Aligned with the regular 4 KiB
+	// A command pushed through `push_call`, which keeps the arguments as their own types and calls the method
+	// directly.
+	template <typename C, typename... Args>
+	struct MethodCommand : public Command {
+		C *instance;
+		void (C::*method)(Args...);
+		std::tuple<std::decay_t<Args>...> args;
+
+		template <uint64_t... Is>
+		FORCE_INLINE void invoke(Indicies<Is...>) {
+			(instance->*method)(std::get<Is>(args)...);
+		}
+
+		static void call_method(Command *p_command, bool p_call) {
+			MethodCommand *command = (MethodCommand *)p_command;
+			if (p_call) {
+				command->invoke(BuildIndicies<sizeof...(Args)>{});
+			}
+			command->~MethodCommand();
+		}
+
+		template <typename... CallArgs>
+		MethodCommand(C *p_instance, void (C::*p_method)(Args...), CallArgs &&...p_args) :
+				instance(p_instance), method(p_method), args(std::forward<CallArgs>(p_args)...) {}
+	};
+
+	// The same as `MethodCommand`, for functions that are not part of a class.
+	template <typename... Args>
+	struct FunctionCommand : public Command {
+		void (*function)(Args...);
+		std::tuple<std::decay_t<Args>...> args;
+
+		template <uint64_t... Is>
+		FORCE_INLINE void invoke(Indicies<Is...>) {
+			function(std::get<Is>(args)...);
+		}
+
+		static void call_function(Command *p_command, bool p_call) {
+			FunctionCommand *command = (FunctionCommand *)p_command;
+			if (p_call) {
+				command->invoke(BuildIndicies<sizeof...(Args)>{});
+			}
+			command->~FunctionCommand();
+		}
+
+		template <typename... CallArgs>
+		FunctionCommand(void (*p_function)(Args...), CallArgs &&...p_args) :
+				function(p_function), args(std::forward<CallArgs>(p_args)...) {}
+	};
+
+	// A block of memory that commands are written into, with the commands starting right after the header. Pages are
+	// never moved or grown, so commands stay where they were pushed until they are called.
+	struct Page {
+		uint32_t used;	   // The number of bytes of commands on the page
+		uint32_t capacity; // The number of bytes the page can hold, not counting the header
+
+		FORCE_INLINE uint8_t *get_data() {
+			return (uint8_t *)(this + 1);
+		}
 	};
 
-	// Kind of a paged allocator - memory is given in 4 KiB chunks to the user when it runs out of space.
-	struct PageAllocator {
-		uint8_t *mem;		  // A pointer to the beginning of the memory.
-		uint32_t page_count;  // The number of pages allocated
-		uint32_t page_offset; // The offset into the current page
+	enum {
+		PAGE_SIZE = 4096,						  // Number of bytes to a page with its header, the regular 4 KiB
+		PAGE_CAPACITY = PAGE_SIZE - sizeof(Page), // Number of bytes of commands that fit on a regular page
+		COMMAND_ALIGNMENT = 8					  // Every command starts on a multiple of this many bytes
 	};
 
-	PageAllocator allocated_memory;	 // The allocated memory struct
-	Vector<uint32_t> bytes_per_page; // The bytes allocated to this specific page.
+	LocalVector<Page *> _pages;		 // The pages holding commands, in the order the commands were pushed
+	LocalVector<Page *> _free_pages; // Regular pages kept from earlier flushes, to be used again before allocating
+	uint32_t _queued_bytes = 0;		 // The number of bytes of commands currently on the queue
+	uint32_t _high_water_mark = 0;	 // The most bytes of commands that were ever on the queue at once
+	uint32_t _page_count = 0;		 // The number of regular pages allocated, both in use and free
+
+	/**
+	 * @brief Starts a new page for commands, taking one from the free pages if there is one.
+	 * @param p_size The number of bytes the page needs to hold. Commands larger than a regular page are given a page
+	 * of their own, which is freed once the command is called.
+	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` if no more memory can be allocated.
+	 */
+	Error _push_page(uint32_t p_size);
+
+	/**
+	 * @brief Reserves space for a command on the last page, moving on to a new page if it does not fit.
+	 * @param p_size The number of bytes the command needs, which is rounded up to `COMMAND_ALIGNMENT`.
+	 * @param r_size The number of bytes actually reserved.
+	 * @return A pointer to the reserved space, or `nullptr` if no more memory can be allocated.
+	 */
+	void *_allocate_command(uint32_t p_size, uint32_t &r_size);
+
+	/**
+	 * @brief Goes through every command on the queue, including any pushed while doing so, and empties the queue.
+	 * @param p_call Whether to call the commands, or only destruct them.
+	 */
+	void _drain(bool p_call);
+
+	template <typename T, typename... CallArgs>
+	FORCE_INLINE Error _push_typed(void (*p_call)(Command *, bool), CallArgs &&...p_args) {
+		static_assert(alignof(T) <= COMMAND_ALIGNMENT, "Arguments of queued calls cannot be over-aligned.");
+		uint32_t size = 0;
+		void *mem = _allocate_command(sizeof(T), size);
+		ERR_COND_NULL_R(mem, ERR_OUT_OF_MEMORY);
+
+		T *command = vnew_placement(mem, T(std::forward<CallArgs>(p_args)...));
+		command->call = p_call;
+		command->size = size;
+		return OK;
+	}
 
 public:
 	/**
-	 * @brief Pushes a command onto the command heap. The arguments are either immediately following the command, or on
-	 * the next available page from the method. It is advised to not call this method directly and instead call
-	 * `call_deferred()` instead.
+	 * @brief Pushes a command onto the command heap, with the arguments immediately following the command on the same
+	 * page. It is advised to not call this method directly and instead call `call_deferred()` instead.
 	 * @param p_method The callable to queue up
 	 * @param p_args An array of argument pointers which are then pushed onto the stack.
 	 * @param p_argcount The number of elements in the argument pointer array to push onto the stack
@@ -58,6 +166,36 @@ public:
 		return push_commandp(p_method, sizeof...(p_args) == 0 ? nullptr : argptrs, sizeof...(p_args));
 	}
 
+	/**
+	 * @brief Pushes a call to a method onto the queue without going through `Variant`. The arguments are stored as
+	 * the types the method takes and passed straight to it on `flush()`, so this is much cheaper than
+	 * `push_command()` for calls deferred every frame.
+	 * @param p_instance The object to call the method on, which must still exist when the queue is flushed.
+	 * @param p_method The method to call.
+	 * @param p_args The arguments to call the method with, which must be convertible to the types it takes.
+	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` if no more memory can be allocated.
+	 */
+	template <typename T, typename C, typename... Args, typename... CallArgs>
+	FORCE_INLINE Error push_call(T *p_instance, void (C::*p_method)(Args...), CallArgs &&...p_args) {
+		static_assert(sizeof...(Args) == sizeof...(CallArgs), "Wrong number of arguments for the queued method.");
+		typedef MethodCommand<C, Args...> MC;
+		return _push_typed<MC>(&MC::call_method,
+							   static_cast<C *>(p_instance),
+							   p_method,
+							   std::forward<CallArgs>(p_args)...);
+	}
+
+	/**
+	 * @brief Pushes a call to a function onto the queue without going through `Variant`, the same as the method
+	 * version of `push_call()`.
+	 */
+	template <typename... Args, typename... CallArgs>
+	FORCE_INLINE Error push_call(void (*p_function)(Args...), CallArgs &&...p_args) {
+		static_assert(sizeof...(Args) == sizeof...(CallArgs), "Wrong number of arguments for the queued function.");
+		typedef FunctionCommand<Args...> FC;
+		return _push_typed<FC>(&FC::call_function, p_function, std::forward<CallArgs>(p_args)...);
+	}
+
 	/**
 	 * @brief Flushes all commands pending on the queue by calling the respective functions.
 	 */
@@ -70,6 +208,27 @@ public:
 	 */
 	void clear();
 
+	/**
+	 * @brief Allocates enough free pages up front for the given number of bytes of commands to be queued at once
+	 * without allocating. Passing `get_high_water_mark()` from an earlier run keeps the queue from allocating at all.
+	 */
+	void reserve(uint32_t p_bytes);
+
+	/**
+	 * @brief Obtains the most bytes of commands that were ever waiting on the queue at once.
+	 */
+	FORCE_INLINE uint32_t get_high_water_mark() const {
+		return _high_water_mark;
+	}
+
+	/**
+	 * @brief Obtains the number of regular pages the queue has allocated, which stops growing once the queue has seen
+	 * its busiest frame.
+	 */
+	FORCE_INLINE uint32_t get_page_count() const {
+		return _page_count;
+	}
+
 	CommandQueue();
 	virtual ~CommandQueue(); // mark as virtual so it's called first
 };
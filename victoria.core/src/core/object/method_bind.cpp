@@ -0,0 +1,9 @@
+#include "core/object/method_bind.h"
+
+StringName MethodBind::get_argument_name(int p_index) const {
+	if (p_index < 0 || (uint32_t)p_index >= argument_names.size()) {
+		return StringName();
+	}
+
+	return argument_names[p_index];
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "core/data/local_vector.h"
+#include "core/error/error_types.h"
+#include "core/object/object.h"
+#include "core/string/string_name.h"
+#include "core/typedefs.h"
+#include "core/variant/variant_caster.h"
+
+#include <type_traits>
+
+/**
+ * @brief The index of a method bound to the `ClassRegistry`, which stays the same for as long as the program runs.
+ */
+typedef uint32_t MethodID;
+
+static constexpr MethodID INVALID_METHOD_ID = UINT32_MAX;
+
+/**
+ * @brief A method of a class bound through `ClassRegistry::bind_method`, which can be called on any object of the
+ * class without knowing its type. Methods can be called with `Variant`s through `call()`, or with pointers to the
+ * arguments as the types the method takes through `ptrcall()`, which skips converting them.
+ */
+class VAPI MethodBind {
+	friend class ClassRegistry;
+
+	StringName name;
+	StringName class_name;
+	MethodID id = INVALID_METHOD_ID;
+	LocalVector<StringName> argument_names;
+
+protected:
+	int argument_count = 0;
+	bool returns_value = false;
+
+public:
+	/**
+	 * @brief Calls the method with its arguments and return value as `Variant`s.
+	 * @param p_object The object to call the method on, which has to be of the class the method was bound to.
+	 * @param p_args The arguments to call the method with, which are converted to the types the method takes.
+	 * @param p_argcount The number of arguments, which has to match the number the method takes.
+	 * @param r_error Set to `ERR_INVALID_PARAMETER` if the object or the number of arguments is wrong, and to `OK`
+	 * otherwise.
+	 * @return What the method returned, or a null `Variant` if it returns nothing.
+	 */
+	virtual Variant call(Object *p_object, const Variant **p_args, int p_argcount, Error &r_error) const = 0;
+
+	/**
+	 * @brief Calls the method without going through `Variant` or checking anything, for code that knows what the
+	 * method takes.
+	 * @param p_object The object to call the method on, which has to be of the class the method was bound to.
+	 * @param p_args Pointers to each argument, as the type the method takes without any reference or `const`.
+	 * @param r_ret A pointer to where to write the return value, as the type the method returns. Not used if the
+	 * method returns nothing.
+	 */
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const = 0;
+
+	FORCE_INLINE const StringName &get_name() const {
+		return name;
+	}
+
+	FORCE_INLINE const StringName &get_class_name() const {
+		return class_name;
+	}
+
+	FORCE_INLINE MethodID get_id() const {
+		return id;
+	}
+
+	FORCE_INLINE int get_argument_count() const {
+		return argument_count;
+	}
+
+	/**
+	 * @brief Obtains the name given to an argument when binding the method, or an empty name if none was given.
+	 */
+	StringName get_argument_name(int p_index) const;
+
+	FORCE_INLINE bool has_return_value() const {
+		return returns_value;
+	}
+
+	virtual ~MethodBind() {}
+};
+
+/**
+ * @brief The `MethodBind` for a method of `T`, where `M` is the type of the method pointer so that both `const` and
+ * non-`const` methods are covered. The trampolines for both kinds of call are generated from the method's signature.
+ */
+template <typename T, typename M, typename R, typename... Args>
+class MethodBindT : public MethodBind {
+	static_assert(!std::is_pointer_v<R>, "Bound methods cannot return pointers, as they cannot be held by a Variant.");
+
+	M method;
+
+	template <uint64_t... Is>
+	FORCE_INLINE Variant _call(T *p_instance, const Variant **p_args, Indicies<Is...>) const {
+		if constexpr (std::is_void_v<R>) {
+			(p_instance->*method)(VariantCaster<std::decay_t<Args>>::cast(*p_args[Is])...);
+			return Variant();
+		} else {
+			return Variant((p_instance->*method)(VariantCaster<std::decay_t<Args>>::cast(*p_args[Is])...));
+		}
+	}
+
+	template <uint64_t... Is>
+	FORCE_INLINE void _ptrcall(T *p_instance, const void **p_args, void *r_ret, Indicies<Is...>) const {
+		if constexpr (std::is_void_v<R>) {
+			(p_instance->*method)(*(std::decay_t<Args> *)p_args[Is]...);
+		} else {
+			*(std::decay_t<R> *)r_ret = (p_instance->*method)(*(std::decay_t<Args> *)p_args[Is]...);
+		}
+	}
+
+public:
+	virtual Variant call(Object *p_object, const Variant **p_args, int p_argcount, Error &r_error) const override {
+		T *instance = Object::cast_to<T>(p_object);
+		if (!instance || p_argcount != (int)sizeof...(Args)) {
+			r_error = ERR_INVALID_PARAMETER;
+			return Variant();
+		}
+
+		r_error = OK;
+		return _call(instance, p_args, BuildIndicies<sizeof...(Args)>{});
+	}
+
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(static_cast<T *>(p_object), p_args, r_ret, BuildIndicies<sizeof...(Args)>{});
+	}
+
+	MethodBindT(M p_method) {
+		method = p_method;
+		argument_count = sizeof...(Args);
+		returns_value = !std::is_void_v<R>;
+	}
+};
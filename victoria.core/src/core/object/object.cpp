@@ -8,6 +8,10 @@ bool Object::_predelete() {
 }
 
 void Object::notification(int p_what, bool p_reversed) {
+	if (!handles_notification(p_what)) {
+		return;
+	}
+
 	if (p_reversed) {
 		_notification_backwardv(p_what);
 	} else {
@@ -15,38 +19,160 @@ void Object::notification(int p_what, bool p_reversed) {
 	}
 }
 
-Error Object::connect_method(const String &p_name, const CallableMethod &p_method) {
-	// Avoid crashes by inserting the method beforehand
-	if (callables.size() == 0 && ClassRegistry::has_signal(get_class_name(), p_name)) {
-		callables.insert(p_name, List<CallableMethod>());
+void Object::_compact_slot(SignalSlot &r_slot) {
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < r_slot.connections.size(); i++) {
+		if (r_slot.connections[i].is_valid()) {
+			if (i != count) {
+				r_slot.connections[count] = r_slot.connections[i];
+			}
+			count++;
+		}
 	}
 
-	List<CallableMethod> *methods = callables.get_ptr(p_name);
-	if (!methods->has(p_method)) {
-		methods->push_back(p_method);
-	} else {
-		ERR_FAIL_MSG_R(vformat("Method already connected to function \'%s\'.", p_name.get_data()), ERR_ALREADY_EXISTS);
+	r_slot.connections.resize(count);
+	r_slot.pending_removal = false;
+}
+
+Error Object::connect(SignalID p_signal, const CallableMethod &p_method) {
+	ERR_FAIL_COND_R(p_method.is_null(), ERR_INVALID_PARAMETER);
+
+	if (!_signals) {
+		uint32_t count = ClassRegistry::get_signal_count(get_class_name());
+		ERR_FAIL_COND_MSG_R(p_signal >= count,
+							vformat("Class \'%s\' has no signal %u.", get_class_name().get_data(), p_signal),
+							ERR_UNAVAILABLE);
+		_signals = vnew_tagged(LocalVector<SignalSlot>, MEMORY_TAG_OBJECT);
+		_signals->resize(count);
+	}
+	ERR_FAIL_COND_MSG_R(p_signal >= _signals->size(),
+						vformat("Class \'%s\' has no signal %u.", get_class_name().get_data(), p_signal),
+						ERR_UNAVAILABLE);
+
+	SignalSlot &slot = (*_signals)[p_signal];
+	for (const CallableMethod &c : slot.connections) {
+		if (c == p_method) {
+			ERR_FAIL_MSG_R(vformat("Method \'%s\' is already connected to signal %u.", p_method.get_name(), p_signal),
+						   ERR_ALREADY_EXISTS);
+		}
 	}
 
+	slot.connections.push_back(p_method);
 	return OK;
 }
 
-Error Object::emit_methodp(const String &p_name, const Variant **p_args, int p_argc) {
-	List<CallableMethod> *list = callables.get_ptr(p_name);
-	if (!list) {
+Error Object::disconnect(SignalID p_signal, const CallableMethod &p_method) {
+	if (!_signals || p_signal >= _signals->size()) {
 		return ERR_UNAVAILABLE;
 	}
 
-	for (const CallableMethod &c : *list) {
+	SignalSlot &slot = (*_signals)[p_signal];
+	for (uint32_t i = 0; i < slot.connections.size(); i++) {
+		if (slot.connections[i] != p_method) {
+			continue;
+		}
+
+		if (slot.emitting > 0) {
+			// Removing it now would move the connections the emission has yet to go through.
+			slot.connections[i] = CallableMethod();
+			slot.pending_removal = true;
+		} else {
+			slot.connections.remove_at(i);
+		}
+		return OK;
+	}
+
+	return ERR_UNAVAILABLE;
+}
+
+bool Object::is_connected(SignalID p_signal, const CallableMethod &p_method) const {
+	if (!_signals || p_signal >= _signals->size()) {
+		return false;
+	}
+
+	for (const CallableMethod &c : (*_signals)[p_signal].connections) {
+		if (c == p_method) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+Error Object::emit_signalp(SignalID p_signal, const Variant **p_args, int p_argc) {
+	if (!_signals || p_signal >= _signals->size()) {
+		return OK;
+	}
+
+	// The slot is looked up again after every call, as connecting can grow the array of connections it holds.
+	uint32_t count = (*_signals)[p_signal].connections.size();
+	if (count == 0) {
+		return OK;
+	}
+
+	(*_signals)[p_signal].emitting++;
+	Error err = OK;
+	for (uint32_t i = 0; i < count; i++) {
+		// Copied so that the method can disconnect itself while it is being called.
+		CallableMethod c = (*_signals)[p_signal].connections[i];
+		if (c.is_null()) {
+			continue;
+		}
+
 		Error ret = OK;
 		c.callp(p_args, ret);
-
 		if (ret != OK) {
-			return ret;
+			err = ret;
 		}
 	}
 
-	return OK;
+	SignalSlot &slot = (*_signals)[p_signal];
+	slot.emitting--;
+	if (slot.emitting == 0 && slot.pending_removal) {
+		_compact_slot(slot);
+	}
+
+	return err;
+}
+
+Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_argcount, Error &r_error) {
+	MethodBind *bind = ClassRegistry::get_method(get_class_name(), p_method);
+	if (!bind) {
+		r_error = ERR_UNAVAILABLE;
+		return Variant();
+	}
+
+	return bind->call(this, p_args, p_argcount, r_error);
+}
+
+SignalID Object::get_signal_id(const StringName &p_name) const {
+	return ClassRegistry::get_signal_id(get_class_name(), p_name);
+}
+
+Error Object::connect_method(const StringName &p_name, const CallableMethod &p_method) {
+	SignalID id = get_signal_id(p_name);
+	ERR_FAIL_COND_MSG_R(id == INVALID_SIGNAL_ID,
+						vformat("Class \'%s\' has no signal \'%s\'.", get_class_name().get_data(), p_name.get_data()),
+						ERR_UNAVAILABLE);
+	return connect(id, p_method);
+}
+
+Error Object::disconnect_method(const StringName &p_name, const CallableMethod &p_method) {
+	SignalID id = get_signal_id(p_name);
+	if (id == INVALID_SIGNAL_ID) {
+		return ERR_UNAVAILABLE;
+	}
+
+	return disconnect(id, p_method);
+}
+
+Error Object::emit_methodp(const StringName &p_name, const Variant **p_args, int p_argc) {
+	SignalID id = get_signal_id(p_name);
+	if (id == INVALID_SIGNAL_ID) {
+		return ERR_UNAVAILABLE;
+	}
+
+	return emit_signalp(id, p_args, p_argc);
 }
 
 void Object::initialize_class() {
@@ -61,7 +187,11 @@ void Object::initialize_class() {
 
 Object::Object() {}
 
-Object::~Object() {}
+Object::~Object() {
+	if (_signals) {
+		vdelete(_signals);
+	}
+}
 
 bool predelete(Object *p_item) {
 	return p_item->_predelete();
@@ -1,11 +1,15 @@
 #pragma once
 
-#include "core/data/hashtable.h"
+#include "core/data/flat_hashtable.h"
 #include "core/data/list.h"
+#include "core/data/local_vector.h"
 #include "core/object/callable_method_pointer.h" // IWYU pragma: keep
+#include "core/string/string_name.h"
 #include "core/string/vstring.h"
 #include "core/typedefs.h"
 
+#include <type_traits>
+
 /**
  * @brief Core definitions for API-level classes.
  * @param m_class The class that is being defined
@@ -16,24 +20,37 @@ private:
 	friend class ClassRegistry;                                                                                       \
                                                                                                                       \
 public:                                                                                                               \
-	virtual String get_class_name() const override {                                                                  \
-		return String(#m_class);                                                                                      \
+	typedef m_class self_type;                                                                                        \
+                                                                                                                      \
+	virtual const StringName &get_class_name() const override {                                                       \
+		return m_class::get_class_name_static();                                                                      \
+	}                                                                                                                 \
+                                                                                                                      \
+	virtual const StringName &get_inherited_class_name() const override {                                             \
+		return m_class::get_inherited_class_name_static();                                                            \
 	}                                                                                                                 \
                                                                                                                       \
-	virtual String get_inherited_class_name() const override {                                                        \
-		return String(#m_inherits);                                                                                   \
+	static const StringName &get_class_name_static() {                                                                \
+		static const StringName name(#m_class);                                                                       \
+		return name;                                                                                                  \
 	}                                                                                                                 \
                                                                                                                       \
-	static FORCE_INLINE String get_class_name_static() {                                                              \
-		return String(#m_class);                                                                                      \
+	static const StringName &get_inherited_class_name_static() {                                                      \
+		static const StringName name(#m_inherits);                                                                    \
+		return name;                                                                                                  \
 	}                                                                                                                 \
                                                                                                                       \
-	static FORCE_INLINE String get_inherited_class_name_static() {                                                    \
-		return String(#m_inherits);                                                                                   \
+	virtual const ClassType &get_class_type() const override {                                                        \
+		return m_class::get_class_type_static();                                                                      \
+	}                                                                                                                 \
+                                                                                                                      \
+	static ClassType &get_class_type_static() {                                                                       \
+		static ClassType type;                                                                                        \
+		return type;                                                                                                  \
 	}                                                                                                                 \
                                                                                                                       \
 protected:                                                                                                            \
-	FORCE_INLINE void (Object::*_get_notification() const)(int) {                                                     \
+	FORCE_INLINE static void (Object::*_get_notification())(int) {                                                    \
 		return (void(Object::*)(int)) & m_class::_notification;                                                       \
 	}                                                                                                                 \
                                                                                                                       \
@@ -41,6 +58,10 @@ protected:
 		return &m_class::_bind_methods;                                                                               \
 	}                                                                                                                 \
                                                                                                                       \
+	FORCE_INLINE static uint32_t (*_get_notification_mask_func())() {                                                 \
+		return &m_class::_get_notification_mask;                                                                      \
+	}                                                                                                                 \
+                                                                                                                      \
 public:                                                                                                               \
 	virtual void _notification_forwardv(int p_what) override {                                                        \
 		m_inherits::_notification_forwardv(p_what);                                                                   \
@@ -56,6 +77,16 @@ public:
 		m_inherits::_notification_forwardv(p_what);                                                                   \
 	}                                                                                                                 \
                                                                                                                       \
+	/* Classes with a `_notification` of their own that do not declare what it handles are sent everything. */        \
+	static uint32_t get_notification_mask_static() {                                                                  \
+		uint32_t mask = m_inherits::get_notification_mask_static();                                                   \
+		if (m_class::_get_notification() != m_inherits::_get_notification()) {                                        \
+			bool declared = m_class::_get_notification_mask_func() != m_inherits::_get_notification_mask_func();      \
+			mask |= declared ? m_class::_get_notification_mask() : NOTIFICATION_MASK_ALL;                             \
+		}                                                                                                             \
+		return mask;                                                                                                  \
+	}                                                                                                                 \
+                                                                                                                      \
 	static void initialize_class() {                                                                                  \
 		static bool class_initialized = false;                                                                        \
 		if (class_initialized) {                                                                                      \
@@ -95,6 +126,53 @@ enum Notification {
 	NOTIFICATION_DRAW,
 };
 
+/**
+ * @brief Every notification, for classes that do not say which ones they handle.
+ */
+static constexpr uint32_t NOTIFICATION_MASK_ALL = UINT32_MAX;
+
+/**
+ * @brief Builds a mask out of the given notifications, as used by `VNOTIFICATIONS`.
+ */
+template <typename... Args>
+constexpr uint32_t notification_mask(Args... p_what) {
+	return ((1u << p_what) | ... | 0u);
+}
+
+/**
+ * @brief Declares the notifications a class's `_notification` handles, so that objects of the class are not sent the
+ * others. Goes after `VREGISTER_CLASS`, and should list every notification in the class's `_notification`.
+ */
+#define VNOTIFICATIONS(...)                                                                                           \
+protected:                                                                                                            \
+	static constexpr uint32_t _get_notification_mask() {                                                              \
+		return notification_mask(__VA_ARGS__);                                                                        \
+	}                                                                                                                 \
+                                                                                                                      \
+private:
+
+/**
+ * @brief Where a class sits in the hierarchy of registered classes, filled in by the `ClassRegistry`. Classes are
+ * numbered in depth-first order, so every class inheriting from another has a number between that class's `pre` and
+ * `post`. All of these are 0 for classes that have not been registered.
+ */
+struct ClassType {
+	uint32_t id = 0;   // Given out in the order classes are registered, and never changes afterwards
+	uint32_t pre = 0;  // The number of the class in depth-first order
+	uint32_t post = 0; // The highest number of any class inheriting from this one, or `pre` if there are none
+
+	// The notifications that objects of the class handle, including those handled by the classes it inherits.
+	uint32_t notification_mask = NOTIFICATION_MASK_ALL;
+};
+
+/**
+ * @brief The index of a signal among all the signals of a class and the classes it inherits, given out by
+ * `ClassRegistry::add_signal`.
+ */
+typedef uint32_t SignalID;
+
+static constexpr SignalID INVALID_SIGNAL_ID = UINT32_MAX;
+
 /**
  * @brief Base class for all API-compliant classes. This class is not ref-counted, nor does it have a tree, so any
  * systems that may be unique from derived classes should use this one instead of other derived classes.
@@ -102,7 +180,21 @@ enum Notification {
 class VAPI Object {
 	friend class ClassRegistry;
 
-	HashTable<String, List<CallableMethod>> callables;
+	// The methods connected to one of the object's signals.
+	struct SignalSlot {
+		LocalVector<CallableMethod> connections;
+		uint32_t emitting = 0;		 // How many emissions of the signal are currently going through the connections
+		bool pending_removal = false; // Whether a connection was disconnected while emitting and left invalid
+	};
+
+	// One slot per signal of the class, indexed by `SignalID`. Only allocated once something connects, as most objects
+	// never have any connections.
+	LocalVector<SignalSlot> *_signals = nullptr;
+
+	/**
+	 * @brief Removes the connections left invalid by disconnecting while the signal was being emitted.
+	 */
+	static void _compact_slot(SignalSlot &r_slot);
 
 public:
 	virtual void _notification_forwardv(int p_what) {}
@@ -113,13 +205,27 @@ public:
 
 	/**
 	 * @brief Non-const casting function. Gives a general method for casting API-compliant classes up and down from
-	 * their values.
+	 * their values. Registered classes are checked against the numbers the `ClassRegistry` gave them, and anything
+	 * else falls back to `dynamic_cast`.
 	 * @param p_object The instance of a class to cast
 	 * @returns The class casted depending on T.
 	 */
 	template <typename T>
 	static T *cast_to(Object *p_object) {
-		return p_object ? dynamic_cast<T *>(p_object) : nullptr;
+		if (!p_object) {
+			return nullptr;
+		}
+
+		// Classes that do not use `VREGISTER_CLASS` share the type of the class they inherit, so cannot be told apart.
+		if constexpr (std::is_same_v<typename T::self_type, T>) {
+			const ClassType &to = T::get_class_type_static();
+			const ClassType &from = p_object->get_class_type();
+			if (to.pre != 0 && from.pre != 0) {
+				return to.pre <= from.pre && from.pre <= to.post ? static_cast<T *>(p_object) : nullptr;
+			}
+		}
+
+		return dynamic_cast<T *>(p_object);
 	}
 
 	/**
@@ -130,20 +236,107 @@ public:
 	 */
 	template <typename T>
 	static const T *cast_to(const Object *p_object) {
-		return p_object ? dynamic_cast<const T *>(p_object) : nullptr;
+		return cast_to<T>(const_cast<Object *>(p_object));
 	}
 
 	/**
 	 * @brief Base notification function. Call on an Object or derived class whenever a notification needs to be sent
-	 * up or down its derived classes.
+	 * up or down its derived classes. Notifications that none of the object's classes handle are dropped straight
+	 * away.
 	 */
 	void notification(int p_what, bool p_reversed = false);
 
-	Error connect_method(const String &p_name, const CallableMethod &p_method);
-	Error emit_methodp(const String &p_name, const Variant **p_args = nullptr, int p_argc = 0);
+	/**
+	 * @brief Checks whether any of the object's classes handles the given notification, going by the notifications
+	 * they declared with `VNOTIFICATIONS`.
+	 */
+	FORCE_INLINE bool handles_notification(int p_what) const {
+		return (uint32_t)p_what >= 32 || (get_class_type().notification_mask & (1u << p_what)) != 0;
+	}
+
+	/**
+	 * @brief Connects a method to one of the object's signals, so that it is called every time the signal is emitted.
+	 * @param p_signal The ID of the signal, as returned by `ClassRegistry::add_signal` or `get_signal_id`.
+	 * @param p_method The method to connect.
+	 * @return `OK` on success, `ERR_UNAVAILABLE` if the object's class has no such signal, and `ERR_ALREADY_EXISTS` if
+	 * the method is already connected to it.
+	 */
+	Error connect(SignalID p_signal, const CallableMethod &p_method);
+
+	/**
+	 * @brief Disconnects a method from one of the object's signals. Methods can be disconnected while the signal is
+	 * being emitted, in which case they are not called for the rest of the emission.
+	 * @return `OK` on success, and `ERR_UNAVAILABLE` if the method is not connected to the signal.
+	 */
+	Error disconnect(SignalID p_signal, const CallableMethod &p_method);
+
+	bool is_connected(SignalID p_signal, const CallableMethod &p_method) const;
+
+	/**
+	 * @brief Calls every method connected to one of the object's signals, in the order they were connected. Methods
+	 * connected while emitting are only called from the next emission.
+	 * @return `OK` if every method was called without error, or the last error a method returned otherwise.
+	 */
+	Error emit_signalp(SignalID p_signal, const Variant **p_args = nullptr, int p_argc = 0);
 
 	template <typename... Args>
-	FORCE_INLINE Error emit_method(const String &p_name, Args... p_args) {
+	FORCE_INLINE Error emit_signal(SignalID p_signal, Args... p_args) {
+		Variant args[sizeof...(p_args) + 1] = {p_args..., Variant()};
+		const Variant *argptrs[sizeof...(p_args) + 1];
+
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+
+		return emit_signalp(p_signal, argptrs, sizeof...(p_args));
+	}
+
+	/**
+	 * @brief Calls a method bound to the object's class or one of the classes it inherits by name, with its arguments
+	 * and return value as `Variant`s. Code that calls the same method often should look it up once through
+	 * `ClassRegistry::get_method` and call it from there instead.
+	 * @param r_error Set to `ERR_UNAVAILABLE` if there is no such method, and to `ERR_INVALID_PARAMETER` if the number
+	 * of arguments is wrong.
+	 * @return What the method returned, or a null `Variant` if it returns nothing.
+	 */
+	Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Error &r_error);
+
+	template <typename... Args>
+	FORCE_INLINE Variant call(const StringName &p_method, Args... p_args) {
+		Variant args[sizeof...(p_args) + 1] = {p_args..., Variant()};
+		const Variant *argptrs[sizeof...(p_args) + 1];
+
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+
+		Error err = OK;
+		return callp(p_method, argptrs, sizeof...(p_args), err);
+	}
+
+	/**
+	 * @brief Obtains the ID of one of the signals of the object's class, or `INVALID_SIGNAL_ID` if it has no such
+	 * signal. Looking the ID up once and using it from then on is much faster than going through the names.
+	 */
+	SignalID get_signal_id(const StringName &p_name) const;
+
+	/**
+	 * @brief Named version of `connect()`, which looks the signal up on every call.
+	 */
+	Error connect_method(const StringName &p_name, const CallableMethod &p_method);
+
+	/**
+	 * @brief Named version of `disconnect()`, which looks the signal up on every call.
+	 */
+	Error disconnect_method(const StringName &p_name, const CallableMethod &p_method);
+
+	/**
+	 * @brief Named version of `emit_signalp()`, which looks the signal up on every call.
+	 */
+	Error emit_methodp(const StringName &p_name, const Variant **p_args = nullptr, int p_argc = 0);
+
+	template <typename... Args>
+	FORCE_INLINE Error emit_method(const StringName &p_name, Args... p_args) {
 		Variant args[sizeof...(p_args) + 1] = {p_args..., Variant()};
 		const Variant *argptrs[sizeof...(p_args) + 1];
 
@@ -155,37 +348,65 @@ public:
 	}
 
 public:
+	typedef Object self_type;
+
 	/**
 	 * @brief Obtains the class name for the given class. Non-static, so classes that have been casted down will still
 	 * display their highest class.
-	 * @returns A String of the class name.
+	 * @returns The class name, which is interned so that it can be compared cheaply.
 	 */
-	virtual String get_class_name() const {
-		return "Object";
+	virtual const StringName &get_class_name() const {
+		return get_class_name_static();
 	}
 
 	/**
 	 * @brief Obtains the inherited classes' name for the given class. Non-static, so classes that have been casted
 	 * down will still display their highest classes' parent.
-	 * @returns A String of the inherited classes' name.
+	 * @returns The inherited classes' name, or an empty name for `Object`.
 	 */
-	virtual String get_inherited_class_name() const {
-		return String();
+	virtual const StringName &get_inherited_class_name() const {
+		return get_inherited_class_name_static();
 	}
 
 	/**
 	 * @brief Obtains the given classes' name. Static method for when the class name alone is needed.
 	 */
-	static String get_class_name_static() {
-		return "Object";
+	static const StringName &get_class_name_static() {
+		static const StringName name("Object");
+		return name;
 	}
 
 	/**
 	 * @brief Obtains the given classes' inherited class name. Static method for when the inherited class name alone is
 	 * needed.
 	 */
-	static String get_inherited_class_name_static() {
-		return String();
+	static const StringName &get_inherited_class_name_static() {
+		static const StringName name;
+		return name;
+	}
+
+	/**
+	 * @brief Obtains where the object's class sits in the class hierarchy. Non-static, so classes that have been
+	 * casted down will still give their highest class.
+	 */
+	virtual const ClassType &get_class_type() const {
+		return get_class_type_static();
+	}
+
+	/**
+	 * @brief Obtains the notifications handled by the class and the classes it inherits, which the `ClassRegistry`
+	 * keeps in the class's `ClassType`.
+	 */
+	static uint32_t get_notification_mask_static() {
+		return 0;
+	}
+
+	/**
+	 * @brief Obtains where the class sits in the class hierarchy. Only the `ClassRegistry` should change it.
+	 */
+	static ClassType &get_class_type_static() {
+		static ClassType type;
+		return type;
 	}
 
 protected:
@@ -201,7 +422,7 @@ protected:
 	 * calls.
 	 * @returns The function pointer to the notification function.
 	 */
-	FORCE_INLINE void (Object::*_get_notification() const)(int) {
+	FORCE_INLINE static void (Object::*_get_notification())(int) {
 		return &Object::_notification;
 	}
 
@@ -209,6 +430,18 @@ protected:
 		return &Object::_bind_methods;
 	}
 
+	/**
+	 * @brief Obtains the notifications the class's `_notification` handles, which `VNOTIFICATIONS` declares. Classes
+	 * that do not declare them are assumed to handle every notification.
+	 */
+	static constexpr uint32_t _get_notification_mask() {
+		return NOTIFICATION_MASK_ALL;
+	}
+
+	FORCE_INLINE static uint32_t (*_get_notification_mask_func())() {
+		return &Object::_get_notification_mask;
+	}
+
 	virtual void _initialize_classv() {
 		initialize_class();
 	}
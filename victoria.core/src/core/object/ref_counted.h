@@ -157,7 +157,7 @@ public:
 	 */
 	template <typename... VarArgs>
 	void instantiate(VarArgs... p_args) {
-		ref(vnew(T(p_args...)));
+		ref(vnew_tagged(T(p_args...), MEMORY_TAG_RESOURCE));
 	}
 
 	/**
@@ -0,0 +1,246 @@
+#include "core/object/task_graph.h"
+
+#include "core/error/error_macros.h"
+#include "core/io/filesystem.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+void TaskGraph::_run_node(void *p_node) {
+	Node *node = (Node *)p_node;
+	TaskGraph *graph = node->graph;
+
+	if (graph->_trace_enabled) {
+		node->trace.thread = graph->_pool->_get_caller_worker_index();
+		node->trace.start_usec = OS::get_singleton()->get_current_time_usec() - graph->_run_start_usec;
+	}
+
+	node->callback(node->userdata);
+
+	if (graph->_trace_enabled) {
+		node->trace.end_usec = OS::get_singleton()->get_current_time_usec() - graph->_run_start_usec;
+	}
+
+	// Whichever dependency finishes last starts the task. As it is pushed from inside this task, it goes onto this
+	// worker's own deque and is the next task the worker runs, unless another worker steals it first.
+	for (TaskID id : node->dependents) {
+		Node *dependent = graph->_nodes[id];
+		if (dependent->pending_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			graph->_push_node(dependent);
+		}
+	}
+}
+
+Error TaskGraph::_validate() {
+	// Kahn's algorithm: repeatedly take a task with no unfinished dependencies. Any task never taken is in a cycle.
+	LocalVector<uint32_t> dependencies;
+	dependencies.resize(_nodes.size());
+	LocalVector<TaskID> ready;
+	_roots.clear();
+	for (uint32_t i = 0; i < _nodes.size(); i++) {
+		dependencies[i] = _nodes[i]->dependency_count;
+		if (dependencies[i] == 0) {
+			_roots.push_back(i);
+			ready.push_back(i);
+		}
+	}
+
+	uint32_t visited = 0;
+	while (!ready.is_empty()) {
+		TaskID id = ready[ready.size() - 1];
+		ready.remove_at(ready.size() - 1);
+		visited++;
+
+		for (TaskID dependent : _nodes[id]->dependents) {
+			if (--dependencies[dependent] == 0) {
+				ready.push_back(dependent);
+			}
+		}
+	}
+
+	ERR_FAIL_COND_MSG_R(visited != _nodes.size(), "The dependencies of the TaskGraph form a cycle.", ERR_INVALID_DATA);
+	_dirty = false;
+	return OK;
+}
+
+void TaskGraph::_push_node(Node *p_node) {
+	_pool->_push_tasks(&p_node->task, 1);
+}
+
+TaskGraph::TaskID TaskGraph::add_task(const String &p_name, Callback p_callback, void *p_userdata) {
+	CRASH_COND_MSG(_running, "Cannot add tasks to a TaskGraph while it is running.");
+	CRASH_COND_NULL(p_callback);
+
+	Node *node = vnew(Node);
+	node->name = p_name;
+	node->callback = p_callback;
+	node->userdata = p_userdata;
+	node->graph = this;
+	node->id = _nodes.size();
+	node->task.callback = &TaskGraph::_run_node;
+	node->task.userdata = node;
+	node->trace.task = node->id;
+
+	_nodes.push_back(node);
+	_dirty = true;
+	return node->id;
+}
+
+void TaskGraph::add_dependency(TaskID p_task, TaskID p_dependency) {
+	ERR_FAIL_COND_MSG(_running, "Cannot add dependencies to a TaskGraph while it is running.");
+	ERR_OUT_OF_BOUNDS(p_task, _nodes.size());
+	ERR_OUT_OF_BOUNDS(p_dependency, _nodes.size());
+	ERR_FAIL_COND_MSG(p_task == p_dependency, "A task cannot depend on itself.");
+
+	LocalVector<TaskID> &dependents = _nodes[p_dependency]->dependents;
+	for (TaskID id : dependents) {
+		if (id == p_task) {
+			return;
+		}
+	}
+
+	dependents.push_back(p_task);
+	_nodes[p_task]->dependency_count++;
+	_dirty = true;
+}
+
+TaskGraph::TaskID TaskGraph::add_continuation(TaskID p_after,
+											  const String &p_name,
+											  Callback p_callback,
+											  void *p_userdata) {
+	TaskID id = add_task(p_name, p_callback, p_userdata);
+	add_dependency(id, p_after);
+	return id;
+}
+
+void TaskGraph::set_userdata(TaskID p_task, void *p_userdata) {
+	ERR_FAIL_COND_MSG(_running, "Cannot change a task of a TaskGraph while it is running.");
+	ERR_OUT_OF_BOUNDS(p_task, _nodes.size());
+	_nodes[p_task]->userdata = p_userdata;
+}
+
+const String &TaskGraph::get_task_name(TaskID p_task) const {
+	CRASH_OUT_OF_BOUNDS(p_task, _nodes.size());
+	return _nodes[p_task]->name;
+}
+
+Error TaskGraph::run(WorkerThreadPool *p_pool) {
+	ERR_FAIL_COND_MSG_R(_running, "The TaskGraph is already running.", FAILED);
+	if (_dirty) {
+		Error err = _validate();
+		ERR_FAIL_COND_R(err != OK, err);
+	}
+	if (_nodes.is_empty()) {
+		return OK;
+	}
+
+	_pool = p_pool ? p_pool : WorkerThreadPool::get_singleton();
+	ERR_COND_NULL_MSG_R(_pool, "There is no WorkerThreadPool to run the TaskGraph on.", ERR_UNAVAILABLE);
+	ERR_FAIL_COND_MSG_R(_pool->get_thread_count() == 0, "The WorkerThreadPool is not initialized.", ERR_UNAVAILABLE);
+
+	_running = true;
+	for (Node *node : _nodes) {
+		node->pending_dependencies.store(node->dependency_count, std::memory_order_relaxed);
+		node->task.completed.store(false, std::memory_order_relaxed);
+	}
+	if (_trace_enabled) {
+		_run_start_usec = OS::get_singleton()->get_current_time_usec();
+	}
+
+	for (TaskID id : _roots) {
+		_push_node(_nodes[id]);
+	}
+
+	// Waiting on every task, rather than on the last one to finish, makes sure the pool is done with all of them
+	// before they can be changed or freed.
+	for (Node *node : _nodes) {
+		_pool->_wait_for(node->task.completed);
+	}
+
+	_running = false;
+	return OK;
+}
+
+void TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(_running, "Cannot clear a TaskGraph while it is running.");
+
+	for (Node *node : _nodes) {
+		vdelete(node);
+	}
+	_nodes.clear();
+	_roots.clear();
+	_dirty = true;
+}
+
+void TaskGraph::set_trace_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(_running, "Cannot enable tracing while the TaskGraph is running.");
+	_trace_enabled = p_enabled;
+
+	for (Node *node : _nodes) {
+		node->trace = TraceEvent();
+		node->trace.task = node->id;
+	}
+}
+
+void TaskGraph::get_trace(LocalVector<TraceEvent> &r_events) const {
+	r_events.clear();
+	for (const Node *node : _nodes) {
+		r_events.push_back(node->trace);
+	}
+}
+
+static void _append_json_string(String &r_json, const String &p_string) {
+	r_json += '"';
+	for (int i = 0; i < p_string.length(); i++) {
+		char c = p_string[i];
+		if (c == '"' || c == '\\') {
+			r_json += '\\';
+		} else if ((unsigned char)c < 0x20) {
+			continue;
+		}
+		r_json += c;
+	}
+	r_json += '"';
+}
+
+String TaskGraph::export_trace() const {
+	// Complete ("X") events, with the thread that called `run()` on row 0 and each worker on the row after it.
+	String json = "{\"traceEvents\":[";
+	int max_thread = -1;
+	for (const Node *node : _nodes) {
+		json += "{\"name\":";
+		_append_json_string(json, node->name);
+		json += vformat(",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%llu,\"dur\":%llu},\n",
+						node->trace.thread + 1,
+						(unsigned long long)node->trace.start_usec,
+						(unsigned long long)(node->trace.end_usec - node->trace.start_usec));
+		if (node->trace.thread > max_thread) {
+			max_thread = node->trace.thread;
+		}
+	}
+
+	// Metadata ("M") events to name each row. The caller's row always exists, so the list never ends in a comma.
+	for (int i = max_thread; i >= -1; i--) {
+		json += vformat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+						i + 1,
+						i == -1 ? "Caller" : vformat("Worker %d", i).get_data());
+		json += i == -1 ? "" : ",\n";
+	}
+
+	json += "]}\n";
+	return json;
+}
+
+Error TaskGraph::save_trace(const String &p_path) const {
+	Ref<FileSystem> file = FileSystem::open(p_path, FileSystem::FILE_ACCESS_WRITE);
+	ERR_FAIL_COND_MSG_R(file.is_null() || !file->is_valid_file(),
+						vformat("Could not open %s to write the trace to.", p_path.get_data()),
+						ERR_FILE_CANT_ACCESS);
+
+	file->store_string(export_trace());
+	file->close();
+	return OK;
+}
+
+TaskGraph::~TaskGraph() {
+	clear();
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "core/data/local_vector.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/string/vstring.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+/**
+ * @brief A set of tasks with dependencies between them, which runs every task on the `WorkerThreadPool` as soon as the
+ * tasks it depends on have finished. Use it to split up work that has to happen in a fixed order overall, but where
+ * the independent parts can run alongside each other.
+ * The graph is meant to be built once and run every frame. Running it again allocates nothing, and the data each task
+ * works on can be swapped between runs with `set_userdata()`.
+ */
+class VAPI TaskGraph {
+public:
+	typedef void (*Callback)(void *p_userdata);
+	// Index of a task in the graph, in the order the tasks were added.
+	typedef uint32_t TaskID;
+
+	/**
+	 * @brief When and where one task ran during the last run of the graph.
+	 */
+	struct TraceEvent {
+		TaskID task = 0;
+		// The index of the worker that ran the task, or -1 for the thread that called `run()`.
+		int thread = -1;
+		// Microseconds since the run started.
+		uint64_t start_usec = 0;
+		uint64_t end_usec = 0;
+	};
+
+private:
+	struct Node {
+		String name;
+		Callback callback = nullptr;
+		void *userdata = nullptr;
+		TaskGraph *graph = nullptr;
+		TaskID id = 0;
+		// The tasks that depend on this one.
+		LocalVector<TaskID> dependents;
+		uint32_t dependency_count = 0;
+		// Counts down as dependencies finish during a run. The task is pushed to the pool when it reaches zero.
+		std::atomic<uint32_t> pending_dependencies = 0;
+		WorkerThreadPool::Task task;
+		TraceEvent trace;
+	};
+
+	LocalVector<Node *> _nodes;
+	// The tasks that depend on nothing, which start each run. Rebuilt whenever the graph changes.
+	LocalVector<TaskID> _roots;
+	bool _dirty = true;
+
+	WorkerThreadPool *_pool = nullptr;
+	bool _running = false;
+
+	bool _trace_enabled = false;
+	uint64_t _run_start_usec = 0;
+
+	static void _run_node(void *p_node);
+
+	Error _validate();
+	void _push_node(Node *p_node);
+
+public:
+	/**
+	 * @brief Adds a task to the graph.
+	 * @param p_name A name for the task, shown in traces.
+	 * @param p_callback The function to call when the task runs.
+	 * @param p_userdata A pointer passed on to the function.
+	 * @return The ID of the task.
+	 */
+	TaskID add_task(const String &p_name, Callback p_callback, void *p_userdata);
+
+	/**
+	 * @brief Makes a task wait for another to finish before it can start.
+	 * @param p_task The task that has to wait.
+	 * @param p_dependency The task that has to finish first.
+	 */
+	void add_dependency(TaskID p_task, TaskID p_dependency);
+
+	/**
+	 * @brief Adds a task that starts once the given task has finished. Same as `add_task()` followed by
+	 * `add_dependency()`.
+	 */
+	TaskID add_continuation(TaskID p_after, const String &p_name, Callback p_callback, void *p_userdata);
+
+	/**
+	 * @brief Changes the pointer passed to a task's function, such as to point it at this frame's data.
+	 */
+	void set_userdata(TaskID p_task, void *p_userdata);
+
+	FORCE_INLINE uint32_t get_task_count() const {
+		return _nodes.size();
+	}
+
+	const String &get_task_name(TaskID p_task) const;
+
+	/**
+	 * @brief Runs every task in the graph and waits for them all to finish. The calling thread runs tasks as well
+	 * while it waits.
+	 * @param p_pool The pool to run the tasks on, or `nullptr` for the global one.
+	 * @return `OK` once every task has finished, or `ERR_INVALID_DATA` if the dependencies form a cycle.
+	 */
+	Error run(WorkerThreadPool *p_pool = nullptr);
+
+	/**
+	 * @brief Removes every task from the graph.
+	 */
+	void clear();
+
+	/**
+	 * @brief Sets whether runs record when each task starts and ends. Off by default, as it reads the clock twice per
+	 * task.
+	 */
+	void set_trace_enabled(bool p_enabled);
+
+	FORCE_INLINE bool is_trace_enabled() const {
+		return _trace_enabled;
+	}
+
+	/**
+	 * @brief Obtains when and where each task ran during the last traced run, in the order the tasks were added.
+	 */
+	void get_trace(LocalVector<TraceEvent> &r_events) const;
+
+	/**
+	 * @brief Formats the last traced run as JSON in the Trace Event Format, which `chrome://tracing` and Perfetto can
+	 * open. Each thread is shown as its own row.
+	 */
+	String export_trace() const;
+
+	/**
+	 * @brief Writes the output of `export_trace()` to a file.
+	 */
+	Error save_trace(const String &p_path) const;
+
+	TaskGraph() {}
+	~TaskGraph();
+
+	TaskGraph(const TaskGraph &) = delete;
+	void operator=(const TaskGraph &) = delete;
+};
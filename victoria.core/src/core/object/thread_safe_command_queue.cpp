@@ -0,0 +1,273 @@
+#include "core/object/thread_safe_command_queue.h"
+
+#include "core/data/atomic_counter.h"
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+#include <stdlib.h>
+
+ThreadSafeCommandQueue *ThreadSafeCommandQueue::singleton = nullptr;
+
+static AtomicCounter<uint64_t> queue_id_counter;
+
+// The producer the calling thread last pushed with, which saves walking the producer list on every push.
+struct ThreadSafeCommandQueueCache {
+	uint64_t queue_id = 0;
+	void *producer = nullptr;
+};
+
+static thread_local ThreadSafeCommandQueueCache producer_cache;
+
+ThreadSafeCommandQueue::Block *ThreadSafeCommandQueue::_allocate_block(uint32_t p_size) {
+	Block *block = nullptr;
+	uint32_t capacity = p_size > BLOCK_CAPACITY ? p_size : BLOCK_CAPACITY;
+	if (capacity == BLOCK_CAPACITY) {
+		MutexLock<BinaryMutex> lock(_block_mutex);
+		if (!_free_blocks.is_empty()) {
+			block = _free_blocks[_free_blocks.size() - 1];
+			_free_blocks.remove_at(_free_blocks.size() - 1);
+		}
+	}
+
+	if (!block) {
+		// Commands too big for a regular block get a block of their own, which is freed as soon as it is called.
+		block = (Block *)Memory::vallocate(sizeof(Block) + capacity);
+		ERR_COND_NULL_R(block, nullptr);
+		vnew_placement(block, Block);
+		block->capacity = capacity;
+	}
+
+	block->next.store(nullptr, std::memory_order_relaxed);
+	block->published.store(0, std::memory_order_relaxed);
+	return block;
+}
+
+void ThreadSafeCommandQueue::_free_block(Block *p_block) {
+	if (p_block->capacity == BLOCK_CAPACITY) {
+		MutexLock<BinaryMutex> lock(_block_mutex);
+		_free_blocks.push_back(p_block);
+		return;
+	}
+
+	Memory::vfree(p_block, sizeof(Block) + p_block->capacity);
+}
+
+ThreadSafeCommandQueue::Producer *ThreadSafeCommandQueue::_find_producer(Thread::ID p_thread) const {
+	for (Producer *p = _producers.load(std::memory_order_acquire); p; p = p->next_producer) {
+		if (p->thread == p_thread) {
+			return p;
+		}
+	}
+	return nullptr;
+}
+
+ThreadSafeCommandQueue::Producer *ThreadSafeCommandQueue::_get_caller_producer() {
+	if (producer_cache.queue_id == _id) {
+		return (Producer *)producer_cache.producer;
+	}
+
+	Thread::ID thread = Thread::get_caller_id();
+	Producer *producer = _find_producer(thread);
+	if (!producer) {
+		Block *block = _allocate_block(0);
+		ERR_COND_NULL_R(block, nullptr);
+
+		producer = vnew(Producer);
+		producer->thread = thread;
+		producer->write_block = block;
+		producer->read_block = block;
+
+		MutexLock<BinaryMutex> lock(_producer_mutex);
+		producer->next_producer = _producers.load(std::memory_order_relaxed);
+		_producers.store(producer, std::memory_order_release);
+	}
+
+	producer_cache.queue_id = _id;
+	producer_cache.producer = producer;
+	return producer;
+}
+
+uint64_t ThreadSafeCommandQueue::_drain_producer(Producer *p_producer, bool p_call) {
+	uint64_t count = 0;
+	while (true) {
+		Block *block = p_producer->read_block;
+		// Loading `next` first means that, if it is set, `published` is already final.
+		Block *next = block->next.load(std::memory_order_acquire);
+		uint32_t end = block->published.load(std::memory_order_acquire);
+
+		if (p_producer->read_offset == end) {
+			if (!next) {
+				break;
+			}
+			p_producer->read_block = next;
+			p_producer->read_offset = 0;
+			_free_block(block);
+			continue;
+		}
+
+		while (p_producer->read_offset < end) {
+			Message *m = (Message *)(block->get_data() + p_producer->read_offset);
+			Variant *args = (Variant *)(m + 1);
+			p_producer->read_offset += sizeof(Message) + sizeof(Variant) * m->argcount;
+
+			if (p_call) {
+				Variant **argptrs = nullptr;
+				if (m->argcount > 0) {
+					argptrs = (Variant **)alloca(sizeof(Variant *) * m->argcount);
+					for (int i = 0; i < m->argcount; i++) {
+						argptrs[i] = &args[i];
+					}
+				}
+
+				Error err;
+				m->callable.callp((const Variant **)argptrs, err);
+				if (err != OK) {
+					OS::get_singleton()->printerr("Callable returned error to queue of \'%s\'.",
+												  get_error_message(err));
+				}
+			}
+
+			for (int i = 0; i < m->argcount; i++) {
+				args[i].~Variant();
+			}
+			m->~Message();
+			count++;
+		}
+	}
+
+	return count;
+}
+
+ThreadSafeCommandQueue *ThreadSafeCommandQueue::get_singleton() {
+	return singleton;
+}
+
+Error ThreadSafeCommandQueue::push_commandp(const CallableMethod &p_method, const Variant **p_args, int p_argcount) {
+	Producer *producer = _get_caller_producer();
+	ERR_COND_NULL_R(producer, ERR_OUT_OF_MEMORY);
+
+	uint32_t size = sizeof(Message) + sizeof(Variant) * p_argcount;
+	Block *block = producer->write_block;
+	if (producer->write_offset + size > block->capacity) {
+		Block *next = _allocate_block(size);
+		ERR_COND_NULL_R(next, ERR_OUT_OF_MEMORY);
+
+		// Everything in the old block is already published, so once the flushing thread sees `next` it can call the
+		// rest of the old block and free it.
+		block->next.store(next, std::memory_order_release);
+		producer->write_block = next;
+		producer->write_offset = 0;
+		block = next;
+	}
+
+	uint8_t *mem = block->get_data() + producer->write_offset;
+	Message *m = vnew_placement(mem, Message);
+	m->callable = p_method;
+	m->argcount = p_argcount;
+
+	Variant *args = (Variant *)(m + 1);
+	for (int i = 0; i < p_argcount; i++) {
+		Variant *v = vnew_placement(&args[i], Variant);
+		*v = *p_args[i];
+	}
+
+	producer->write_offset += size;
+	producer->pushed++;
+	block->published.store(producer->write_offset, std::memory_order_release);
+	return OK;
+}
+
+void ThreadSafeCommandQueue::flush() {
+	ERR_FAIL_COND_MSG(Thread::get_caller_id() != _flush_thread,
+					  "ThreadSafeCommandQueue can only be flushed from the thread that created it.");
+	// Commands that flush the queue themselves would otherwise call the commands after them out of order.
+	if (_flushing) {
+		return;
+	}
+
+	_flushing = true;
+	bool flushed_any = false;
+	for (Producer *p = _producers.load(std::memory_order_acquire); p; p = p->next_producer) {
+		uint64_t count = _drain_producer(p, true);
+		if (count > 0) {
+			p->flushed.fetch_add(count, std::memory_order_seq_cst);
+			flushed_any = true;
+		}
+	}
+	_flushing = false;
+
+	// Both this load and the waiting thread's increment are sequentially consistent, so either this sees the waiting
+	// thread, or the waiting thread sees the updated count before it sleeps.
+	if (flushed_any && _waiting_threads.load(std::memory_order_seq_cst) > 0) {
+		std::lock_guard<std::mutex> lock(_wait_mutex);
+		_wait_condition.notify_all();
+	}
+}
+
+void ThreadSafeCommandQueue::flush_and_wait() {
+	if (Thread::get_caller_id() == _flush_thread) {
+		flush();
+		return;
+	}
+
+	Producer *producer = _find_producer(Thread::get_caller_id());
+	if (!producer) {
+		return;
+	}
+
+	uint64_t target = producer->pushed;
+	_waiting_threads.fetch_add(1, std::memory_order_seq_cst);
+	{
+		std::unique_lock<std::mutex> lock(_wait_mutex);
+		while (producer->flushed.load(std::memory_order_seq_cst) < target) {
+			_wait_condition.wait(lock);
+		}
+	}
+	_waiting_threads.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ThreadSafeCommandQueue::clear() {
+	ERR_FAIL_COND_MSG(Thread::get_caller_id() != _flush_thread,
+					  "ThreadSafeCommandQueue can only be cleared from the thread that created it.");
+
+	for (Producer *p = _producers.load(std::memory_order_acquire); p; p = p->next_producer) {
+		// Counted as flushed so that no thread keeps waiting on them.
+		p->flushed.fetch_add(_drain_producer(p, false), std::memory_order_seq_cst);
+	}
+
+	if (_waiting_threads.load(std::memory_order_seq_cst) > 0) {
+		std::lock_guard<std::mutex> lock(_wait_mutex);
+		_wait_condition.notify_all();
+	}
+}
+
+ThreadSafeCommandQueue::ThreadSafeCommandQueue() {
+	_id = queue_id_counter.increment();
+	_flush_thread = Thread::get_caller_id();
+
+	if (!singleton) {
+		singleton = this;
+	}
+}
+
+ThreadSafeCommandQueue::~ThreadSafeCommandQueue() {
+	clear();
+
+	Producer *p = _producers.load(std::memory_order_acquire);
+	while (p) {
+		Producer *next = p->next_producer;
+		// Draining leaves each producer with only the block it is writing into.
+		Memory::vfree(p->write_block, sizeof(Block) + p->write_block->capacity);
+		vdelete(p);
+		p = next;
+	}
+
+	for (Block *block : _free_blocks) {
+		Memory::vfree(block, BLOCK_SIZE);
+	}
+
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "core/data/local_vector.h"
+#include "core/object/callable_method.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief A command queue that any thread can push methods onto, while one thread (the one that created it) calls them
+ * in `flush()`. Each pushing thread writes into its own list of blocks, so pushes never wait on each other or on the
+ * flushing thread. Commands pushed from one thread are called in the order they were pushed, but there is no order
+ * between commands pushed from different threads.
+ */
+class VAPI ThreadSafeCommandQueue {
+	static ThreadSafeCommandQueue *singleton;
+
+	// A given message pushed to the queue, followed by its arguments.
+	struct Message {
+		CallableMethod callable;
+		int32_t argcount;
+	};
+
+	// A chunk of memory that messages are written into, with the messages starting right after the header.
+	struct Block {
+		// The block the producer moved on to once this one was full, set after the last message here was published.
+		std::atomic<Block *> next;
+		// The number of bytes of messages in this block that are fully written and can be called.
+		std::atomic<uint32_t> published;
+		uint32_t capacity;
+
+		FORCE_INLINE uint8_t *get_data() {
+			return (uint8_t *)(this + 1);
+		}
+	};
+
+	enum {
+		BLOCK_SIZE = 4096, // Size of a block including its header, so that it fills a 4 KiB page.
+		BLOCK_CAPACITY = BLOCK_SIZE - sizeof(Block),
+	};
+
+	// The blocks written by a single thread. The pushing thread owns the write position and the flushing thread owns
+	// the read position, so the only thing they share is each block's `next` and `published`.
+	struct Producer {
+		Thread::ID thread = Thread::UNASSIGNED_ID;
+		Producer *next_producer = nullptr;
+
+		Block *write_block = nullptr;
+		uint32_t write_offset = 0;
+		uint64_t pushed = 0;
+
+		Block *read_block = nullptr;
+		uint32_t read_offset = 0;
+		std::atomic<uint64_t> flushed = 0;
+	};
+
+	// Producers are only ever added, at the front, so the list can be walked without locking.
+	std::atomic<Producer *> _producers = nullptr;
+	BinaryMutex _producer_mutex;
+	// Tells this queue apart from one that was later allocated at the same address, for the per-thread cache.
+	uint64_t _id = 0;
+
+	// Blocks that were fully called, ready to be reused by any producer.
+	BinaryMutex _block_mutex;
+	LocalVector<Block *> _free_blocks;
+
+	Thread::ID _flush_thread = Thread::UNASSIGNED_ID;
+	bool _flushing = false;
+
+	std::mutex _wait_mutex;
+	std::condition_variable _wait_condition;
+	std::atomic<uint32_t> _waiting_threads = 0;
+
+	Block *_allocate_block(uint32_t p_size);
+	void _free_block(Block *p_block);
+
+	Producer *_find_producer(Thread::ID p_thread) const;
+	Producer *_get_caller_producer();
+
+	/**
+	 * @brief Goes through every message the producer has published so far, including ones pushed by the calls
+	 * themselves, and frees the blocks it is done with.
+	 * @param p_call Whether to call the messages, or only destruct them.
+	 * @return The number of messages gone through.
+	 */
+	uint64_t _drain_producer(Producer *p_producer, bool p_call);
+
+public:
+	/**
+	 * @brief Obtains the first queue that was created, which `SceneTree` flushes once per frame.
+	 */
+	static ThreadSafeCommandQueue *get_singleton();
+
+	/**
+	 * @brief Pushes a command onto the queue from any thread. It is advised to not call this method directly and
+	 * instead call `call_deferred()` instead.
+	 * @param p_method The callable to queue up
+	 * @param p_args An array of argument pointers which are copied into the queue.
+	 * @param p_argcount The number of elements in the argument pointer array.
+	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` if no more memory can be allocated.
+	 */
+	Error push_commandp(const CallableMethod &p_method, const Variant **p_args, int p_argcount);
+
+	/**
+	 * @brief Pushes a command onto the queue from any thread, to be later executed by a call to `flush()` on the
+	 * thread that created the queue.
+	 * @param p_method The callable to queue for being fired.
+	 * @param p_args Variadic list of arguments that can be converted to `Variant`.
+	 * @return `OK` on success, and `ERR_OUT_OF_MEMORY` if no more memory can be allocated.
+	 */
+	template <typename... Args>
+	FORCE_INLINE Error push_command(const CallableMethod &p_method, Args... p_args) {
+		Variant args[sizeof...(p_args) + 1] = {p_args..., Variant()};
+		const Variant *argptrs[sizeof...(p_args) + 1];
+
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+
+		return push_commandp(p_method, sizeof...(p_args) == 0 ? nullptr : argptrs, sizeof...(p_args));
+	}
+
+	/**
+	 * @brief Calls every command pushed so far. Must be called from the thread that created the queue.
+	 */
+	void flush();
+
+	/**
+	 * @brief Blocks until every command the calling thread has pushed so far has been called, which lets a thread
+	 * make a synchronous call on the flushing thread. On the flushing thread itself this is the same as `flush()`.
+	 * Waits forever if the flushing thread never flushes again, so it should not be used where that thread could be
+	 * waiting on the caller.
+	 */
+	void flush_and_wait();
+
+	/**
+	 * @brief Destructs every command left on the queue without calling them. Must be called from the thread that
+	 * created the queue, while no other thread is pushing to it.
+	 */
+	void clear();
+
+	ThreadSafeCommandQueue();
+	~ThreadSafeCommandQueue();
+
+	ThreadSafeCommandQueue(const ThreadSafeCommandQueue &) = delete;
+	void operator=(const ThreadSafeCommandQueue &) = delete;
+};
@@ -0,0 +1,430 @@
+#include "core/object/worker_thread_pool.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/os/thread.h"
+#include "core/string/vstring.h"
+
+/**
+ * @brief A Chase-Lev work-stealing deque with a fixed capacity. Only the worker that owns the deque pushes and pops at
+ * the bottom, without any locks, while any other thread may steal from the top. Taking the last task is the only
+ * case where the owner and a thief race, which a single compare-and-swap on `top` settles.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+	// A power of two, so that indices wrap with a mask. Tasks that do not fit go to the pool's shared queue.
+	static constexpr int64_t CAPACITY = 4096;
+
+private:
+	std::atomic<T *> _buffer[CAPACITY];
+	std::atomic<int64_t> _top = 0;
+	// Keeps `_top` and `_bottom` on separate cache lines, as they are written by different threads.
+	uint8_t _padding[64];
+	std::atomic<int64_t> _bottom = 0;
+
+public:
+	/**
+	 * @brief Pushes a task to the bottom of the deque. Only the owner may call this.
+	 * @return `false` if the deque is full.
+	 */
+	bool push(T *p_task) {
+		int64_t bottom = _bottom.load(std::memory_order_relaxed);
+		int64_t top = _top.load(std::memory_order_acquire);
+		if (bottom - top >= CAPACITY) {
+			return false;
+		}
+
+		_buffer[bottom & (CAPACITY - 1)].store(p_task, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * @brief Takes the most recently pushed task. Only the owner may call this.
+	 */
+	T *pop() {
+		int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+		_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = _top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			// Empty.
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T *task = _buffer[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (top == bottom) {
+			// The last task, which a thief may be stealing at the same time.
+			if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				task = nullptr;
+			}
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return task;
+	}
+
+	/**
+	 * @brief Takes the oldest task. Any thread may call this.
+	 * @return The task, or `nullptr` if the deque was empty or another thread took the task first.
+	 */
+	T *steal() {
+		int64_t top = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = _bottom.load(std::memory_order_acquire);
+		if (top >= bottom) {
+			return nullptr;
+		}
+
+		T *task = _buffer[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+		return task;
+	}
+};
+
+struct WorkerThreadPool::Worker {
+	WorkerThreadPool *pool = nullptr;
+	int index = 0;
+	Thread thread;
+	WorkStealingDeque<Task> deque;
+};
+
+// The pool and worker index of the calling thread, if it is a worker.
+static thread_local WorkerThreadPool *current_pool = nullptr;
+static thread_local int current_worker = -1;
+
+WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
+
+WorkerThreadPool *WorkerThreadPool::get_singleton() {
+	return singleton;
+}
+
+void WorkerThreadPool::_thread_function(void *p_worker) {
+	Worker *worker = (Worker *)p_worker;
+	WorkerThreadPool *pool = worker->pool;
+	current_pool = pool;
+	current_worker = worker->index;
+
+	while (true) {
+		Task *task = pool->_next_task(worker->index);
+		if (task) {
+			pool->_run_task(task);
+			continue;
+		}
+
+		// Pending tasks are always run before exiting, so that nothing waiting on them is left hanging.
+		if (pool->_exiting.load(std::memory_order_acquire)) {
+			break;
+		}
+		pool->_work_semaphore.wait();
+	}
+
+	current_pool = nullptr;
+	current_worker = -1;
+}
+
+int WorkerThreadPool::_get_caller_worker_index() const {
+	return current_pool == this ? current_worker : -1;
+}
+
+void WorkerThreadPool::_push_tasks(Task *p_task, uint32_t p_count) {
+	int worker = _get_caller_worker_index();
+	uint32_t pushed = 0;
+	if (worker != -1) {
+		while (pushed < p_count && _workers[worker]->deque.push(p_task)) {
+			pushed++;
+		}
+	}
+
+	if (pushed < p_count) {
+		MutexLock<BinaryMutex> lock(_queue_mutex);
+		for (; pushed < p_count; pushed++) {
+			_queue.push_back(p_task);
+		}
+		_queue_count.set(_queue.size() - _queue_head);
+	}
+
+	_work_semaphore.post(p_count);
+	_notify_waiting_threads();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_next_task(int p_worker) {
+	// Our own tasks first, newest first, as whatever they touch is most likely to still be in the cache.
+	if (p_worker != -1) {
+		Task *task = _workers[p_worker]->deque.pop();
+		if (task) {
+			return task;
+		}
+	}
+
+	if (_queue_count.get() > 0) {
+		MutexLock<BinaryMutex> lock(_queue_mutex);
+		if (_queue_head < _queue.size()) {
+			Task *task = _queue[_queue_head++];
+			if (_queue_head == _queue.size()) {
+				_queue.clear();
+				_queue_head = 0;
+			}
+			_queue_count.set(_queue.size() - _queue_head);
+			return task;
+		}
+	}
+
+	// Steal the oldest task of another worker, starting with the next one along so that thieves spread out.
+	uint32_t worker_count = _workers.size();
+	for (uint32_t i = 1; i <= worker_count; i++) {
+		uint32_t victim = (p_worker + i) % worker_count;
+		if ((int)victim == p_worker) {
+			continue;
+		}
+
+		Task *task = _workers[victim]->deque.steal();
+		if (task) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+void WorkerThreadPool::_run_task(Task *p_task) {
+	Group *group = p_task->group;
+	if (!group) {
+		p_task->callback(p_task->userdata);
+		p_task->completed.store(true, std::memory_order_release);
+		_notify_waiting_threads();
+		return;
+	}
+
+	while (true) {
+		uint32_t from = group->next_index.fetch_add(group->batch, std::memory_order_relaxed);
+		if (from >= group->count) {
+			break;
+		}
+
+		uint32_t to = group->count - from < group->batch ? group->count : from + group->batch;
+		for (uint32_t i = from; i < to; i++) {
+			group->callback(group->userdata, i);
+		}
+	}
+
+	if (group->tasks_finished.increment() == group->task_count) {
+		group->completed.store(true, std::memory_order_release);
+		_notify_waiting_threads();
+	}
+}
+
+void WorkerThreadPool::_notify_waiting_threads() {
+	_wait_events.increment();
+	// Pairs with the fence in `_wait_for`, so that either this thread sees the waiter or the waiter sees the event.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_waiting_threads.get() > 0) {
+		// Taking the lock makes sure that a thread about to sleep either sees the new event or is woken by it.
+		{ std::lock_guard<std::mutex> lock(_wait_mutex); }
+		_wait_condition.notify_all();
+	}
+}
+
+void WorkerThreadPool::_wait_for(const std::atomic<bool> &p_completed) {
+	int worker = _get_caller_worker_index();
+	while (!p_completed.load(std::memory_order_acquire)) {
+		uint64_t events = _wait_events.get();
+
+		// Rather than sleep, help with whatever is pending. This is what lets a task wait on tasks it added itself.
+		Task *task = _next_task(worker);
+		if (task) {
+			_run_task(task);
+			continue;
+		}
+
+		_waiting_threads.increment();
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		{
+			std::unique_lock<std::mutex> lock(_wait_mutex);
+			while (!p_completed.load(std::memory_order_acquire) && _wait_events.get() == events) {
+				_wait_condition.wait(lock);
+			}
+		}
+		_waiting_threads.decrement();
+	}
+}
+
+void WorkerThreadPool::init(int p_thread_count) {
+	ERR_FAIL_COND_MSG(!_workers.is_empty(), "The WorkerThreadPool has already been initialized.");
+
+	if (p_thread_count < 0) {
+		p_thread_count = (int)Thread::get_hardware_concurrency() - 1;
+	}
+	if (p_thread_count < 1) {
+		p_thread_count = 1;
+	}
+
+	_exiting.store(false, std::memory_order_release);
+	for (int i = 0; i < p_thread_count; i++) {
+		Worker *worker = vnew(Worker);
+		worker->pool = this;
+		worker->index = i;
+		_workers.push_back(worker);
+	}
+
+	// Only start the threads once every worker exists, as they steal from each other straight away.
+	for (Worker *worker : _workers) {
+		worker->thread.start(&WorkerThreadPool::_thread_function, worker);
+	}
+}
+
+void WorkerThreadPool::finish() {
+	if (_workers.is_empty()) {
+		return;
+	}
+
+	_exiting.store(true, std::memory_order_release);
+	_work_semaphore.post(_workers.size());
+	for (Worker *worker : _workers) {
+		worker->thread.wait_to_finish();
+	}
+	for (Worker *worker : _workers) {
+		vdelete(worker);
+	}
+	_workers.reset();
+
+	MutexLock<BinaryMutex> lock(_task_mutex);
+	if (!_tasks.is_empty() || !_groups.is_empty()) {
+		ERR_WARN(vformat("%u tasks and %u group tasks were never waited on.", _tasks.size(), _groups.size()));
+	}
+	for (KeyValue<TaskID, Task *> &kv : _tasks) {
+		_task_allocator.delete_allocation(kv.value);
+	}
+	for (KeyValue<GroupID, Group *> &kv : _groups) {
+		_group_allocator.delete_allocation(kv.value);
+	}
+	_tasks.clear();
+	_groups.clear();
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task(TaskCallback p_callback, void *p_userdata) {
+	ERR_COND_NULL_R(p_callback, INVALID_TASK_ID);
+	ERR_FAIL_COND_MSG_R(_workers.is_empty(), "The WorkerThreadPool has not been initialized.", INVALID_TASK_ID);
+
+	Task *task = nullptr;
+	TaskID id = INVALID_TASK_ID;
+	{
+		MutexLock<BinaryMutex> lock(_task_mutex);
+		task = _task_allocator.new_allocation();
+		id = ++_last_id;
+		_tasks.insert(id, task);
+	}
+
+	task->callback = p_callback;
+	task->userdata = p_userdata;
+	_push_tasks(task, 1);
+	return id;
+}
+
+bool WorkerThreadPool::is_task_completed(TaskID p_task) const {
+	MutexLock<BinaryMutex> lock(_task_mutex);
+	Task *const *task = _tasks.get_ptr(p_task);
+	ERR_COND_NULL_MSG_R(task, vformat("No pending task has the ID %lli.", (long long)p_task), false);
+	return (*task)->completed.load(std::memory_order_acquire);
+}
+
+Error WorkerThreadPool::wait_for_task_completion(TaskID p_task) {
+	Task *task = nullptr;
+	{
+		MutexLock<BinaryMutex> lock(_task_mutex);
+		Task **ptr = _tasks.get_ptr(p_task);
+		ERR_COND_NULL_MSG_R(ptr,
+							vformat("No pending task has the ID %lli.", (long long)p_task),
+							ERR_INVALID_PARAMETER);
+		task = *ptr;
+		// Removed straight away, so that no other thread can wait on it as well.
+		_tasks.erase(p_task);
+	}
+
+	_wait_for(task->completed);
+
+	MutexLock<BinaryMutex> lock(_task_mutex);
+	_task_allocator.delete_allocation(task);
+	return OK;
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(GroupCallback p_callback,
+														   void *p_userdata,
+														   uint32_t p_count,
+														   int p_tasks) {
+	ERR_COND_NULL_R(p_callback, INVALID_TASK_ID);
+	ERR_FAIL_COND_MSG_R(_workers.is_empty(), "The WorkerThreadPool has not been initialized.", INVALID_TASK_ID);
+
+	// The thread that waits on the group runs its tasks as well.
+	uint32_t task_count = p_tasks > 0 ? p_tasks : _workers.size() + 1;
+	if (task_count > p_count) {
+		task_count = p_count > 0 ? p_count : 1;
+	}
+
+	Group *group = nullptr;
+	GroupID id = INVALID_TASK_ID;
+	{
+		MutexLock<BinaryMutex> lock(_task_mutex);
+		group = _group_allocator.new_allocation();
+		id = ++_last_id;
+		_groups.insert(id, group);
+	}
+
+	group->callback = p_callback;
+	group->userdata = p_userdata;
+	group->count = p_count;
+	// Small enough that the indices still spread evenly when some calls take longer than others.
+	group->batch = p_count / (task_count * 16);
+	if (group->batch < 1) {
+		group->batch = 1;
+	}
+	group->task_count = task_count;
+	group->task.group = group;
+	_push_tasks(&group->task, task_count);
+	return id;
+}
+
+bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
+	MutexLock<BinaryMutex> lock(_task_mutex);
+	Group *const *group = _groups.get_ptr(p_group);
+	ERR_COND_NULL_MSG_R(group, vformat("No pending group task has the ID %lli.", (long long)p_group), false);
+	return (*group)->completed.load(std::memory_order_acquire);
+}
+
+Error WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
+	Group *group = nullptr;
+	{
+		MutexLock<BinaryMutex> lock(_task_mutex);
+		Group **ptr = _groups.get_ptr(p_group);
+		ERR_COND_NULL_MSG_R(ptr,
+							vformat("No pending group task has the ID %lli.", (long long)p_group),
+							ERR_INVALID_PARAMETER);
+		group = *ptr;
+		_groups.erase(p_group);
+	}
+
+	_wait_for(group->completed);
+
+	MutexLock<BinaryMutex> lock(_task_mutex);
+	_group_allocator.delete_allocation(group);
+	return OK;
+}
+
+WorkerThreadPool::WorkerThreadPool() {
+	if (!singleton) {
+		singleton = this;
+	}
+}
+
+WorkerThreadPool::~WorkerThreadPool() {
+	finish();
+
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "core/data/atomic_counter.h"
+#include "core/data/hashtable.h"
+#include "core/data/local_vector.h"
+#include "core/data/paged_allocator.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief A pool of worker threads that run tasks in the background. Each worker keeps its own deque of tasks: tasks
+ * added from inside a task go onto the deque of the worker running it, which runs them newest first, and idle workers
+ * steal the oldest tasks from the others, so workers rarely contend on shared state. Tasks added from any other thread
+ * go to a shared queue.
+ * Every task and group task that is added has to be waited on with `wait_for_task_completion()` or
+ * `wait_for_group_task_completion()`, which also frees it. A thread that is waiting runs other pending tasks in the
+ * meantime, so tasks can safely wait on tasks they added themselves.
+ */
+class VAPI WorkerThreadPool {
+	// Pushes and waits on tasks it owns directly, so that running a graph again does not allocate.
+	friend class TaskGraph;
+
+public:
+	typedef void (*TaskCallback)(void *p_userdata);
+	typedef void (*GroupCallback)(void *p_userdata, uint32_t p_index);
+	typedef int64_t TaskID;
+	typedef int64_t GroupID;
+
+	enum : int64_t {
+		INVALID_TASK_ID = -1,
+	};
+
+private:
+	static WorkerThreadPool *singleton;
+
+	struct Group;
+	struct Worker;
+
+	struct Task {
+		TaskCallback callback = nullptr;
+		void *userdata = nullptr;
+		// Set for the tasks that make up a group task, which all run the group's callback instead.
+		Group *group = nullptr;
+		std::atomic<bool> completed = false;
+	};
+
+	struct Group {
+		GroupCallback callback = nullptr;
+		void *userdata = nullptr;
+		uint32_t count = 0;
+		// The number of indices each task claims at once, so that short callbacks do not all contend on `next_index`.
+		uint32_t batch = 1;
+		std::atomic<uint32_t> next_index = 0;
+		// The number of tasks the group was split into, and how many of them have finished.
+		uint32_t task_count = 0;
+		AtomicCounter<uint32_t> tasks_finished;
+		// Pushed to the queues once for each task in the group.
+		Task task;
+		std::atomic<bool> completed = false;
+	};
+
+	LocalVector<Worker *> _workers;
+	// Posted once for each task added, to wake up a sleeping worker.
+	Semaphore _work_semaphore;
+	std::atomic<bool> _exiting = false;
+
+	// Tasks added from threads outside of the pool. Read from `_queue_head` onwards.
+	BinaryMutex _queue_mutex;
+	LocalVector<Task *> _queue;
+	uint32_t _queue_head = 0;
+	AtomicCounter<uint32_t> _queue_count;
+
+	// Every task and group that has not been waited on yet, by ID.
+	BinaryMutex _task_mutex;
+	HashTable<TaskID, Task *> _tasks;
+	HashTable<GroupID, Group *> _groups;
+	PagedAllocator<Task> _task_allocator;
+	PagedAllocator<Group> _group_allocator;
+	int64_t _last_id = 0;
+
+	// Threads waiting for a task to complete sleep on this, and are woken whenever a task completes or is added.
+	std::mutex _wait_mutex;
+	std::condition_variable _wait_condition;
+	AtomicCounter<uint32_t> _waiting_threads;
+	AtomicCounter<uint64_t> _wait_events;
+
+	static void _thread_function(void *p_worker);
+
+	int _get_caller_worker_index() const;
+	void _push_tasks(Task *p_task, uint32_t p_count);
+	Task *_next_task(int p_worker);
+	void _run_task(Task *p_task);
+	void _notify_waiting_threads();
+	void _wait_for(const std::atomic<bool> &p_completed);
+
+public:
+	static WorkerThreadPool *get_singleton();
+
+	/**
+	 * @brief Starts the worker threads. Tasks can only be added once the pool has been initialized.
+	 * @param p_thread_count The number of worker threads, or -1 for one fewer than the hardware can run at once, since
+	 * the thread adding the tasks also runs them while it waits.
+	 */
+	void init(int p_thread_count = -1);
+
+	/**
+	 * @brief Runs every task still pending and stops the worker threads.
+	 */
+	void finish();
+
+	FORCE_INLINE uint32_t get_thread_count() const {
+		return _workers.size();
+	}
+
+	/**
+	 * @brief Adds a task that calls the given function once.
+	 * @param p_callback The function to call.
+	 * @param p_userdata A pointer passed on to the function.
+	 * @return The ID of the task, to wait on with `wait_for_task_completion()`.
+	 */
+	TaskID add_task(TaskCallback p_callback, void *p_userdata);
+
+	bool is_task_completed(TaskID p_task) const;
+
+	/**
+	 * @brief Waits for a task to complete and frees it. The ID cannot be used after this.
+	 * @return `OK` once the task has completed, or `ERR_INVALID_PARAMETER` if no pending task has that ID.
+	 */
+	Error wait_for_task_completion(TaskID p_task);
+
+	/**
+	 * @brief Adds a group task, which calls the given function once for each index from 0 to `p_count - 1` across as
+	 * many threads as are free, like a parallel for loop. The calls happen in no particular order.
+	 * @param p_callback The function to call for each index.
+	 * @param p_userdata A pointer passed on to the function.
+	 * @param p_count The number of indices.
+	 * @param p_tasks The number of tasks to split the indices between, or -1 for one per thread that can run them.
+	 * @return The ID of the group task, to wait on with `wait_for_group_task_completion()`.
+	 */
+	GroupID add_group_task(GroupCallback p_callback, void *p_userdata, uint32_t p_count, int p_tasks = -1);
+
+	bool is_group_task_completed(GroupID p_group) const;
+
+	/**
+	 * @brief Waits for every call of a group task to return and frees it. The ID cannot be used after this.
+	 * @return `OK` once the group has completed, or `ERR_INVALID_PARAMETER` if no pending group has that ID.
+	 */
+	Error wait_for_group_task_completion(GroupID p_group);
+
+	WorkerThreadPool();
+	~WorkerThreadPool();
+};
@@ -0,0 +1,165 @@
+#include "core/os/frame_allocator.h"
+
+#include "core/data/atomic_counter.h"
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+
+// The size of the first block allocated by each arena buffer.
+static constexpr uint64_t FRAME_ARENA_MIN_BLOCK_SIZE = 64 * 1024;
+
+struct FrameArenaBlock {
+	// The block that was filled before this one, or `nullptr` if this is the first block of the buffer.
+	FrameArenaBlock *prev = nullptr;
+	uint64_t size = 0;
+	uint64_t used = 0;
+
+	FORCE_INLINE uint8_t *get_data() {
+		return (uint8_t *)(this + 1);
+	}
+};
+
+struct FrameArenaBuffer {
+	// The block currently being allocated from. Earlier blocks are reached through `prev`.
+	FrameArenaBlock *block = nullptr;
+	// Bytes handed out since the buffer was last reset, including any padding used for alignment.
+	uint64_t used = 0;
+
+	FrameArenaBlock *_allocate_block(uint64_t p_size) {
+		FrameArenaBlock *b =
+			(FrameArenaBlock *)Memory::vallocate(sizeof(FrameArenaBlock) + p_size, MEMORY_TAG_FRAME_ARENA);
+		CRASH_COND_MSG(!b, "Out of memory when allocating a new block for a FrameAllocator.");
+		vnew_placement(b, FrameArenaBlock);
+		b->size = p_size;
+		return b;
+	}
+
+	void _free_blocks() {
+		while (block) {
+			FrameArenaBlock *prev = block->prev;
+			Memory::vfree(block, sizeof(FrameArenaBlock) + block->size);
+			block = prev;
+		}
+	}
+
+	void *allocate(uint64_t p_size, uint64_t p_alignment) {
+		if (likely(block)) {
+			uintptr_t base = (uintptr_t)block->get_data();
+			uintptr_t address = (base + block->used + p_alignment - 1) & ~(uintptr_t)(p_alignment - 1);
+			if (likely(address + p_size <= base + block->size)) {
+				used += address + p_size - (base + block->used);
+				block->used = address + p_size - base;
+				return (void *)address;
+			}
+		}
+
+		// Each new block is at least double the size of the last, so that the number of blocks stays small.
+		uint64_t size = block ? block->size * 2 : FRAME_ARENA_MIN_BLOCK_SIZE;
+		if (size < p_size + p_alignment) {
+			size = p_size + p_alignment;
+		}
+
+		FrameArenaBlock *b = _allocate_block(size);
+		b->prev = block;
+		block = b;
+
+		uintptr_t base = (uintptr_t)block->get_data();
+		uintptr_t address = (base + p_alignment - 1) & ~(uintptr_t)(p_alignment - 1);
+		block->used = address + p_size - base;
+		used += block->used;
+		return (void *)address;
+	}
+
+	bool extend(void *p_block, uint64_t p_size, uint64_t p_new_size) {
+		if (!block || p_new_size < p_size) {
+			return false;
+		}
+
+		uintptr_t base = (uintptr_t)block->get_data();
+		uintptr_t address = (uintptr_t)p_block;
+		// Only the last allocation in the current block can be grown.
+		if (address + p_size != base + block->used || address + p_new_size > base + block->size) {
+			return false;
+		}
+
+		block->used += p_new_size - p_size;
+		used += p_new_size - p_size;
+		return true;
+	}
+
+	void reset() {
+		if (block && block->prev) {
+			// Merge every block into a single one that can hold the whole of the last frame.
+			uint64_t size = 0;
+			for (FrameArenaBlock *b = block; b; b = b->prev) {
+				size += b->size;
+			}
+
+			_free_blocks();
+			block = _allocate_block(size);
+		} else if (block) {
+			block->used = 0;
+		}
+
+		used = 0;
+	}
+
+	~FrameArenaBuffer() {
+		_free_blocks();
+	}
+};
+
+struct FrameArena {
+	FrameArenaBuffer buffers[2];
+	// The buffer that allocations are made from in the current frame.
+	uint32_t current = 0;
+	// The frame that the current buffer belongs to.
+	uint64_t frame = 0;
+
+	/**
+	 * @brief Brings the arena up to date with the current frame, swapping buffers and resetting the one that is about
+	 * to be reused.
+	 */
+	FORCE_INLINE FrameArenaBuffer &get_buffer(uint64_t p_frame) {
+		if (unlikely(frame != p_frame)) {
+			FrameArenaBuffer &last = buffers[current];
+			Memory::frame_arena_max_usage.exchange_if_greater(last.used);
+
+			// If more than one frame has passed, the previous buffer is also out of date.
+			if (p_frame - frame > 1) {
+				last.reset();
+			}
+
+			current ^= 1;
+			buffers[current].reset();
+			frame = p_frame;
+		}
+
+		return buffers[current];
+	}
+};
+
+static AtomicCounter<uint64_t> frame_index;
+static thread_local FrameArena arena;
+
+void FrameAllocator::begin_frame() {
+	frame_index.increment();
+}
+
+uint64_t FrameAllocator::get_frame() {
+	return frame_index.get();
+}
+
+void *FrameAllocator::allocate(uint64_t p_size, uint64_t p_alignment) {
+	ERR_FAIL_COND_MSG_R(p_alignment == 0 || (p_alignment & (p_alignment - 1)) != 0,
+						"FrameAllocator alignment must be a power of two.",
+						nullptr);
+	return arena.get_buffer(frame_index.get()).allocate(p_size, p_alignment);
+}
+
+bool FrameAllocator::extend(void *p_block, uint64_t p_size, uint64_t p_new_size) {
+	return arena.get_buffer(frame_index.get()).extend(p_block, p_size, p_new_size);
+}
+
+uint64_t FrameAllocator::get_thread_usage() {
+	return arena.get_buffer(frame_index.get()).used;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Linear allocator for scratch memory that only needs to live for the current frame. Every thread owns its own
+ * arena, so allocating is a pointer bump with no locking, and nothing is ever freed individually. Instead, the whole
+ * arena is reset at once when a new frame begins.
+ * Arenas are double-buffered: memory handed out during a frame stays valid until the end of the next frame, after
+ * which it is reused. Objects that need to live any longer must not use this allocator.
+ * Arenas start out small and grow as needed. Once a frame needs more than one block, the blocks are merged into one
+ * large enough for the whole frame when the buffer is next reset, so that a steady workload settles on a single block.
+ */
+class VAPI FrameAllocator {
+public:
+	/**
+	 * @brief Starts a new frame, allowing the memory from two frames ago to be reused. Called once per frame by the
+	 * main loop. Each thread picks up the change the next time it allocates.
+	 */
+	static void begin_frame();
+
+	/**
+	 * @brief Obtains the index of the current frame, which is increased every time `begin_frame()` is called.
+	 */
+	static uint64_t get_frame();
+
+	/**
+	 * @brief Allocates memory from the calling thread's arena. The memory is not zeroed, and must not be freed.
+	 * @param p_size The number of bytes to allocate.
+	 * @param p_alignment The alignment of the returned pointer. Must be a power of two.
+	 * @return A pointer to the memory, which stays valid until the end of the next frame.
+	 */
+	static void *allocate(uint64_t p_size, uint64_t p_alignment = alignof(max_align_t));
+
+	/**
+	 * @brief Attempts to grow the most recent allocation of the calling thread in place, which avoids copying when an
+	 * array is built up one element at a time.
+	 * @param p_block The block to grow.
+	 * @param p_size The current size of the block, in bytes.
+	 * @param p_new_size The size to grow the block to, in bytes.
+	 * @return Whether the block was grown. If false, the block is left as it was.
+	 */
+	static bool extend(void *p_block, uint64_t p_size, uint64_t p_new_size);
+
+	/**
+	 * @brief Obtains the number of bytes the calling thread has allocated in the current frame.
+	 */
+	static uint64_t get_thread_usage();
+};
@@ -1,73 +1,568 @@
 #include "core/os/memory.h"
 
+#include "core/error/error_macros.h"
+#include "core/string/vstring.h"
+
 #include <stdlib.h>
 #include <string.h>
 
-AtomicCounter<uint64_t> Memory::current_mem_usage;
-AtomicCounter<uint64_t> Memory::max_mem_usage;
+#ifdef DEBUG_ENABLED
+#	include <mutex>
+#else
+#	include <atomic>
+#	if PLATFORM_WINDOWS || PLATFORM_LINUX
+#		include <malloc.h>
+#	elif defined(__APPLE__)
+#		include <malloc/malloc.h>
+#	endif
+#endif
+
+AtomicCounter<uint64_t> Memory::frame_arena_max_usage;
+
+static const char *memory_tag_names[MEMORY_TAG_MAX] = {
+	"General",
+	"Container",
+	"String",
+	"Variant",
+	"Object",
+	"Resource",
+	"Rendering",
+	"Frame arena",
+};
+
+#ifdef DEBUG_ENABLED
+
+static AtomicCounter<uint64_t> memory_usage;
+static AtomicCounter<uint64_t> memory_max_usage;
+
+struct MemoryHeader {
+	// The size of the block, with its tag in the top byte and its flags in the bits just below.
+	uint64_t info;
+	// The distance from the start of the underlying allocation to the block. Only differs from the header size for
+	// aligned blocks.
+	uint64_t offset;
+};
+
+static_assert(sizeof(MemoryHeader) == Memory::DATA_OFFSET, "The header must fill the space reserved for it.");
+
+static constexpr uint64_t MEMORY_TAG_SHIFT = 56;
+// Set for blocks allocated through `vallocate_unsized`.
+static constexpr uint64_t MEMORY_FLAG_UNSIZED = 1ULL << 55;
+// Set for blocks allocated through `vallocate_aligned`.
+static constexpr uint64_t MEMORY_FLAG_ALIGNED = 1ULL << 54;
+static constexpr uint64_t MEMORY_FLAGS_MASK = MEMORY_FLAG_UNSIZED | MEMORY_FLAG_ALIGNED;
+static constexpr uint64_t MEMORY_SIZE_MASK = (1ULL << 54) - 1;
+
+struct MemoryTagCounters {
+	AtomicCounter<uint64_t> live_bytes;
+	AtomicCounter<uint64_t> peak_bytes;
+	AtomicCounter<uint64_t> allocation_count;
+	AtomicCounter<uint64_t> live_allocation_count;
+};
+
+static MemoryTagCounters memory_tag_counters[MEMORY_TAG_MAX];
+
+static FORCE_INLINE void _memory_count_allocation(uint64_t p_size, MemoryTag p_tag) {
+	memory_max_usage.exchange_if_greater(memory_usage.add(p_size) + p_size);
+
+	MemoryTagCounters &c = memory_tag_counters[p_tag];
+	c.peak_bytes.exchange_if_greater(c.live_bytes.add(p_size) + p_size);
+	c.allocation_count.increment();
+	c.live_allocation_count.increment();
+}
+
+static FORCE_INLINE void _memory_count_resize(uint64_t p_old_size, uint64_t p_new_size, MemoryTag p_tag) {
+	MemoryTagCounters &c = memory_tag_counters[p_tag];
+
+	// Cannot add/subtract with unsigned values
+	if (p_old_size < p_new_size) {
+		memory_max_usage.exchange_if_greater(memory_usage.add(p_new_size - p_old_size) + p_new_size - p_old_size);
+		c.peak_bytes.exchange_if_greater(c.live_bytes.add(p_new_size - p_old_size) + p_new_size - p_old_size);
+	} else if (p_old_size > p_new_size) {
+		memory_usage.sub(p_old_size - p_new_size);
+		c.live_bytes.sub(p_old_size - p_new_size);
+	}
+}
+
+static FORCE_INLINE void _memory_count_free(uint64_t p_size, MemoryTag p_tag) {
+	memory_usage.sub(p_size);
+
+	MemoryTagCounters &c = memory_tag_counters[p_tag];
+	c.live_bytes.sub(p_size);
+	c.live_allocation_count.decrement();
+}
+
+/**
+ * @brief Fills in the header in front of a new block and accounts for it.
+ * @param p_base The start of the underlying allocation.
+ * @param p_offset The distance from `p_base` to the block itself.
+ * @return The block.
+ */
+static void *_memory_init_block(uint8_t *p_base,
+								uint64_t p_offset,
+								uint64_t p_size,
+								MemoryTag p_tag,
+								uint64_t p_flags) {
+	uint8_t *block = p_base + p_offset;
+	MemoryHeader *header = (MemoryHeader *)(block - Memory::DATA_OFFSET);
+	header->info = p_size | p_flags | ((uint64_t)p_tag << MEMORY_TAG_SHIFT);
+	header->offset = p_offset;
+
+	_memory_count_allocation(p_size, p_tag);
+	return block;
+}
+
+/**
+ * @brief Obtains the header of a block that is about to be freed or reallocated, checking that it is being released
+ * the same way it was allocated.
+ * @param p_size The size the block is being freed with. Ignored for unsized blocks.
+ * @param p_flags The flags the block is expected to have been allocated with.
+ */
+static MemoryHeader *_memory_get_header(void *p_block, uint64_t p_size, uint64_t p_flags) {
+	MemoryHeader *header = (MemoryHeader *)((uint8_t *)p_block - Memory::DATA_OFFSET);
+	CRASH_COND_MSG((header->info & MEMORY_FLAGS_MASK) != p_flags,
+				   "Memory block was released through a different function than the one it was allocated with.");
+	CRASH_COND_MSG(!(p_flags & MEMORY_FLAG_UNSIZED) && (header->info & MEMORY_SIZE_MASK) != p_size,
+				   "Memory block was released with a different size than it was allocated with.");
+	return header;
+}
+
+// Allocation sizes are sorted into power-of-two buckets, from 16 bytes or less up to anything over 32KiB.
+static constexpr uint32_t MEMORY_HISTOGRAM_BUCKETS = 13;
+// The number of call sites that are tracked. Any further call sites are counted together under one entry.
+static constexpr uint32_t MEMORY_MAX_CALL_SITES = 1024;
+// The number of call sites listed in `Memory::get_report()`.
+static constexpr uint32_t MEMORY_REPORT_CALL_SITES = 16;
+
+struct MemoryCallSite {
+	const char *description = nullptr;
+	uint64_t allocation_count = 0;
+	uint64_t bytes = 0;
+	uint64_t size_histogram[MEMORY_HISTOGRAM_BUCKETS] = {};
+};
+
+// Call sites are stored in a fixed open-addressed table keyed by the address of their description, as allocating
+// from here would recurse back into the allocator.
+static MemoryCallSite memory_call_sites[MEMORY_MAX_CALL_SITES];
+static MemoryCallSite memory_call_site_overflow;
+static std::mutex memory_call_site_mutex;
+
+static void _memory_record_call_site(const char *p_description, uint64_t p_size) {
+	if (!p_description || !p_description[0]) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(memory_call_site_mutex);
+
+	uintptr_t hash = (uintptr_t)p_description;
+	hash ^= hash >> 17;
+	hash *= 0x9E3779B97F4A7C15ULL;
+	hash ^= hash >> 29;
+
+	MemoryCallSite *site = &memory_call_site_overflow;
+	for (uint32_t i = 0; i < MEMORY_MAX_CALL_SITES; i++) {
+		MemoryCallSite &s = memory_call_sites[(hash + i) % MEMORY_MAX_CALL_SITES];
+		if (s.description == p_description || s.description == nullptr) {
+			s.description = p_description;
+			site = &s;
+			break;
+		}
+	}
+
+	uint32_t bucket = p_size <= 16 ? 0 : find_log2((uint32_t)(p_size - 1)) - 3;
+	if (p_size > UINT32_MAX || bucket >= MEMORY_HISTOGRAM_BUCKETS) {
+		bucket = MEMORY_HISTOGRAM_BUCKETS - 1;
+	}
+
+	site->allocation_count++;
+	site->bytes += p_size;
+	site->size_histogram[bucket]++;
+}
+
+#else // DEBUG_ENABLED
+
+// Each thread counts the bytes it allocates and frees in its own cache line. Counters are never freed, and are handed
+// to a new thread once their owner exits, so the totals stay correct without threads touching any shared state.
+struct alignas(64) MemoryThreadCounters {
+	std::atomic<uint64_t> allocated{0};
+	std::atomic<uint64_t> freed{0};
+	std::atomic<bool> in_use{true};
+	MemoryThreadCounters *next = nullptr;
+};
+
+static std::atomic<MemoryThreadCounters *> memory_thread_counters_list{nullptr};
+static AtomicCounter<uint64_t> memory_max_usage;
+// Counts what threads allocate and free after handing their own counters back, from the destructors of thread-locals
+// that run later. Any thread can write to these, so they are updated atomically.
+static MemoryThreadCounters memory_exited_thread_counters;
+static thread_local MemoryThreadCounters *memory_thread_counters = nullptr;
+static thread_local bool memory_thread_exited = false;
+
+// Hands the counters of a thread back when it exits. Once another thread takes them over, this thread must no longer
+// write to them, so its later allocations and frees go to `memory_exited_thread_counters`.
+struct MemoryThreadCountersRelease {
+	MemoryThreadCounters *counters = nullptr;
+
+	~MemoryThreadCountersRelease() {
+		memory_thread_counters = nullptr;
+		memory_thread_exited = true;
+		if (counters) {
+			counters->in_use.store(false, std::memory_order_release);
+		}
+	}
+};
+
+static thread_local MemoryThreadCountersRelease memory_thread_counters_release;
+
+static void *_memory_system_allocate_aligned(uint64_t p_size, uint64_t p_alignment) {
+#	if PLATFORM_WINDOWS
+	return _aligned_malloc(p_size, p_alignment);
+#	else
+	void *block = nullptr;
+	if (posix_memalign(&block, p_alignment < sizeof(void *) ? sizeof(void *) : p_alignment, p_size) != 0) {
+		return nullptr;
+	}
+	return block;
+#	endif
+}
+
+static void _memory_system_free_aligned(void *p_block) {
+#	if PLATFORM_WINDOWS
+	_aligned_free(p_block);
+#	else
+	free(p_block);
+#	endif
+}
+
+static FORCE_INLINE uint64_t _memory_system_get_size(void *p_block) {
+#	if PLATFORM_WINDOWS
+	return _msize(p_block);
+#	elif defined(__APPLE__)
+	return malloc_size(p_block);
+#	else
+	return malloc_usable_size(p_block);
+#	endif
+}
+
+static MemoryThreadCounters *_memory_acquire_thread_counters() {
+	MemoryThreadCounters *counters = nullptr;
+	for (MemoryThreadCounters *c = memory_thread_counters_list.load(std::memory_order_acquire); c; c = c->next) {
+		bool expected = false;
+		if (c->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+			counters = c;
+			break;
+		}
+	}
+
+	if (!counters) {
+		counters = (MemoryThreadCounters *)_memory_system_allocate_aligned(sizeof(MemoryThreadCounters),
+																			 alignof(MemoryThreadCounters));
+		CRASH_COND_MSG(!counters, "Out of memory when allocating memory counters for a new thread.");
+		vnew_placement(counters, MemoryThreadCounters);
+
+		counters->next = memory_thread_counters_list.load(std::memory_order_relaxed);
+		while (!memory_thread_counters_list.compare_exchange_weak(
+				counters->next, counters, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+	}
+
+	memory_thread_counters = counters;
+	memory_thread_counters_release.counters = counters;
+	return counters;
+}
+
+// Counts an allocation and a free for a thread that has no counters yet, or has handed them back.
+static void _memory_count_without_counters(uint64_t p_allocated, uint64_t p_freed) {
+	if (memory_thread_exited) {
+		memory_exited_thread_counters.allocated.fetch_add(p_allocated, std::memory_order_relaxed);
+		memory_exited_thread_counters.freed.fetch_add(p_freed, std::memory_order_relaxed);
+		return;
+	}
+
+	MemoryThreadCounters *c = _memory_acquire_thread_counters();
+	c->allocated.store(c->allocated.load(std::memory_order_relaxed) + p_allocated, std::memory_order_relaxed);
+	c->freed.store(c->freed.load(std::memory_order_relaxed) + p_freed, std::memory_order_relaxed);
+}
+
+// Only the owning thread ever writes to its counters, so they can be updated with a plain load and store.
+static FORCE_INLINE void _memory_count_allocation(uint64_t p_size, MemoryTag) {
+	MemoryThreadCounters *c = memory_thread_counters;
+	if (unlikely(!c)) {
+		_memory_count_without_counters(p_size, 0);
+		return;
+	}
+	c->allocated.store(c->allocated.load(std::memory_order_relaxed) + p_size, std::memory_order_relaxed);
+}
+
+static FORCE_INLINE void _memory_count_free(uint64_t p_size, MemoryTag) {
+	MemoryThreadCounters *c = memory_thread_counters;
+	if (unlikely(!c)) {
+		_memory_count_without_counters(0, p_size);
+		return;
+	}
+	c->freed.store(c->freed.load(std::memory_order_relaxed) + p_size, std::memory_order_relaxed);
+}
+
+static FORCE_INLINE void _memory_count_resize(uint64_t p_old_size, uint64_t p_new_size, MemoryTag) {
+	MemoryThreadCounters *c = memory_thread_counters;
+	if (unlikely(!c)) {
+		_memory_count_without_counters(p_new_size, p_old_size);
+		return;
+	}
+	c->allocated.store(c->allocated.load(std::memory_order_relaxed) + p_new_size, std::memory_order_relaxed);
+	c->freed.store(c->freed.load(std::memory_order_relaxed) + p_old_size, std::memory_order_relaxed);
+}
+
+#endif // DEBUG_ENABLED
 
 uint64_t Memory::get_memory_usage() {
-	return current_mem_usage.get();
+#ifdef DEBUG_ENABLED
+	return memory_usage.get();
+#else
+	uint64_t allocated = memory_exited_thread_counters.allocated.load(std::memory_order_relaxed);
+	uint64_t freed = memory_exited_thread_counters.freed.load(std::memory_order_relaxed);
+	for (MemoryThreadCounters *c = memory_thread_counters_list.load(std::memory_order_acquire); c; c = c->next) {
+		allocated += c->allocated.load(std::memory_order_relaxed);
+		freed += c->freed.load(std::memory_order_relaxed);
+	}
+
+	// The counters are read one by one while other threads keep allocating, so frees may be seen before the
+	// allocations they belong to.
+	uint64_t usage = allocated > freed ? allocated - freed : 0;
+	memory_max_usage.exchange_if_greater(usage);
+	return usage;
+#endif
 }
+
 uint64_t Memory::get_mem_max_usage() {
-	return max_mem_usage.get();
+#ifndef DEBUG_ENABLED
+	get_memory_usage();
+#endif
+	return memory_max_usage.get();
 }
 
-void *Memory::vallocate(uint64_t p_size) {
-	uint8_t *data = (uint8_t *)malloc(p_size + DATA_OFFSET);
+uint64_t Memory::get_frame_arena_max_usage() {
+	return frame_arena_max_usage.get();
+}
 
-	uint64_t *s = (uint64_t *)data;
-	*s = p_size;
+const char *Memory::get_tag_name(MemoryTag p_tag) {
+	ERR_OUT_OF_BOUNDS_R(p_tag, MEMORY_TAG_MAX, "Invalid");
+	return memory_tag_names[p_tag];
+}
+
+MemoryTagStats Memory::get_tag_stats(MemoryTag p_tag) {
+	MemoryTagStats stats;
+#ifdef DEBUG_ENABLED
+	ERR_OUT_OF_BOUNDS_R(p_tag, MEMORY_TAG_MAX, stats);
+	const MemoryTagCounters &c = memory_tag_counters[p_tag];
+	stats.live_bytes = c.live_bytes.get();
+	stats.peak_bytes = c.peak_bytes.get();
+	stats.allocation_count = c.allocation_count.get();
+	stats.live_allocation_count = c.live_allocation_count.get();
+#endif
+	return stats;
+}
 
-	uint64_t max = current_mem_usage.add(p_size);
-	max_mem_usage.exchange_if_greater(max);
+String Memory::get_report() {
+	String report = vformat("Memory usage: %llu bytes (peak %llu bytes)\n",
+							(unsigned long long)get_memory_usage(),
+							(unsigned long long)get_mem_max_usage());
+	report += vformat("Frame arena peak: %llu bytes\n", (unsigned long long)get_frame_arena_max_usage());
 
-	return data + DATA_OFFSET;
+#ifdef DEBUG_ENABLED
+	report += vformat("%-12s %14s %14s %12s %12s\n", "Tag", "Live bytes", "Peak bytes", "Allocations", "Live");
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		MemoryTagStats stats = get_tag_stats((MemoryTag)i);
+		report += vformat("%-12s %14llu %14llu %12llu %12llu\n",
+						  memory_tag_names[i],
+						  (unsigned long long)stats.live_bytes,
+						  (unsigned long long)stats.peak_bytes,
+						  (unsigned long long)stats.allocation_count,
+						  (unsigned long long)stats.live_allocation_count);
+	}
+
+	// Copy out the call sites with the most bytes allocated before formatting, since formatting allocates as well.
+	MemoryCallSite top[MEMORY_REPORT_CALL_SITES];
+	uint32_t top_count = 0;
+	{
+		std::lock_guard<std::mutex> lock(memory_call_site_mutex);
+		for (uint32_t i = 0; i <= MEMORY_MAX_CALL_SITES; i++) {
+			const MemoryCallSite &site = i < MEMORY_MAX_CALL_SITES ? memory_call_sites[i] : memory_call_site_overflow;
+			if (site.allocation_count == 0) {
+				continue;
+			}
+
+			uint32_t pos = top_count < MEMORY_REPORT_CALL_SITES ? top_count++ : MEMORY_REPORT_CALL_SITES;
+			while (pos > 0 && top[pos - 1].bytes < site.bytes) {
+				if (pos < MEMORY_REPORT_CALL_SITES) {
+					top[pos] = top[pos - 1];
+				}
+				pos--;
+			}
+			if (pos < MEMORY_REPORT_CALL_SITES) {
+				top[pos] = site;
+			}
+		}
+	}
+
+	report += "Top call sites by bytes allocated (sizes bucketed by powers of two from <=16B to >32KiB):\n";
+	for (uint32_t i = 0; i < top_count; i++) {
+		const MemoryCallSite &site = top[i];
+		report += vformat("  %s: %llu allocations, %llu bytes\n    [",
+						  site.description ? site.description : "<other call sites>",
+						  (unsigned long long)site.allocation_count,
+						  (unsigned long long)site.bytes);
+		for (uint32_t j = 0; j < MEMORY_HISTOGRAM_BUCKETS; j++) {
+			report += vformat(j == 0 ? "%llu" : " %llu", (unsigned long long)site.size_histogram[j]);
+		}
+		report += "]\n";
+	}
+#else
+	report += "Memory tags are only tracked in debug builds.\n";
+#endif
+
+	return report;
 }
 
-void *Memory::vallocate_zeroed(uint64_t p_size) {
-	void *ret = vallocate(p_size);
-	vzero(ret, p_size);
-	return ret;
+void *Memory::vallocate(uint64_t p_size, MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	uint8_t *data = (uint8_t *)malloc(p_size + DATA_OFFSET);
+	if (unlikely(!data)) {
+		return nullptr;
+	}
+	return _memory_init_block(data, DATA_OFFSET, p_size, p_tag, 0);
+#else
+	void *data = malloc(p_size);
+	_memory_count_allocation(p_size, p_tag);
+	return data;
+#endif
 }
 
-void *Memory::vreallocate(void *p_block, uint64_t p_new_size) {
-	if (!p_block) {
-		return vallocate(p_new_size);
+void *Memory::vallocate_zeroed(uint64_t p_size, MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	void *ret = vallocate(p_size, p_tag);
+	if (ret) {
+		vzero(ret, p_size);
 	}
+	return ret;
+#else
+	void *data = calloc(1, p_size);
+	_memory_count_allocation(p_size, p_tag);
+	return data;
+#endif
+}
 
-	uint8_t *data = (uint8_t *)p_block;
-	data -= DATA_OFFSET;
+void *Memory::vallocate_aligned(uint64_t p_size, uint64_t p_alignment, MemoryTag p_tag) {
+	ERR_FAIL_COND_MSG_R(p_alignment == 0 || (p_alignment & (p_alignment - 1)) != 0,
+						"Memory alignment must be a power of two.",
+						nullptr);
 
-	data = (uint8_t *)realloc(data, p_new_size + DATA_OFFSET);
+#ifdef DEBUG_ENABLED
+	// Over-allocate so that there is always room for the header between the start of the allocation and the first
+	// aligned address after it.
+	uint64_t alignment = p_alignment < DATA_OFFSET ? DATA_OFFSET : p_alignment;
+	uint8_t *data = (uint8_t *)malloc(p_size + alignment + DATA_OFFSET);
+	if (unlikely(!data)) {
+		return nullptr;
+	}
 
-	uint64_t *s = (uint64_t *)data;
+	uintptr_t address = ((uintptr_t)data + DATA_OFFSET + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	return _memory_init_block(data, address - (uintptr_t)data, p_size, p_tag, MEMORY_FLAG_ALIGNED);
+#else
+	void *data = _memory_system_allocate_aligned(p_size, p_alignment);
+	_memory_count_allocation(p_size, p_tag);
+	return data;
+#endif
+}
 
-	// Cannot add/subtract with unsigned values
-	if (*s < p_new_size) {
-		uint64_t max = current_mem_usage.add(p_new_size - *s);
-		max_mem_usage.exchange_if_greater(max);
-	} else if (*s > p_new_size) {
-		current_mem_usage.sub(*s - p_new_size);
+void *Memory::vreallocate(void *p_block, uint64_t p_old_size, uint64_t p_new_size, MemoryTag p_tag) {
+	if (!p_block) {
+		return vallocate(p_new_size, p_tag);
 	}
 
-	*s = p_new_size;
+#ifdef DEBUG_ENABLED
+	MemoryHeader *header = _memory_get_header(p_block, p_old_size, 0);
+	MemoryTag tag = (MemoryTag)(header->info >> MEMORY_TAG_SHIFT);
+
+	uint8_t *data = (uint8_t *)realloc(header, p_new_size + DATA_OFFSET);
+	if (unlikely(!data)) {
+		return nullptr;
+	}
 
+	// Keep the tag the block was first allocated with, so that it is subtracted from the same counter when freed.
+	((MemoryHeader *)data)->info = p_new_size | ((uint64_t)tag << MEMORY_TAG_SHIFT);
+	_memory_count_resize(p_old_size, p_new_size, tag);
 	return data + DATA_OFFSET;
+#else
+	void *data = realloc(p_block, p_new_size);
+	if (likely(data)) {
+		_memory_count_resize(p_old_size, p_new_size, p_tag);
+	}
+	return data;
+#endif
 }
 
-void Memory::vfree(void *p_block) {
+void Memory::vfree(void *p_block, uint64_t p_size) {
 	// If the block and/or its size are 0 then there shouldn't need to be a reason to free it
 	if (!p_block) {
 		return;
 	}
 
-	uint64_t *data = (uint64_t *)p_block;
-	data -= (DATA_OFFSET / sizeof(size_t));
+#ifdef DEBUG_ENABLED
+	MemoryHeader *header = _memory_get_header(p_block, p_size, 0);
+	_memory_count_free(p_size, (MemoryTag)(header->info >> MEMORY_TAG_SHIFT));
+	free(header);
+#else
+	_memory_count_free(p_size, MEMORY_TAG_GENERAL);
+	free(p_block);
+#endif
+}
+
+void Memory::vfree_aligned(void *p_block, uint64_t p_size) {
+	if (!p_block) {
+		return;
+	}
+
+#ifdef DEBUG_ENABLED
+	MemoryHeader *header = _memory_get_header(p_block, p_size, MEMORY_FLAG_ALIGNED);
+	_memory_count_free(p_size, (MemoryTag)(header->info >> MEMORY_TAG_SHIFT));
+	free((uint8_t *)p_block - header->offset);
+#else
+	_memory_count_free(p_size, MEMORY_TAG_GENERAL);
+	_memory_system_free_aligned(p_block);
+#endif
+}
+
+void *Memory::vallocate_unsized(uint64_t p_size, MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	uint8_t *data = (uint8_t *)malloc(p_size + DATA_OFFSET);
+	if (unlikely(!data)) {
+		return nullptr;
+	}
+	return _memory_init_block(data, DATA_OFFSET, p_size, p_tag, MEMORY_FLAG_UNSIZED);
+#else
+	// The size the system reports is counted rather than the one asked for, as that is all that is known when freeing.
+	void *data = malloc(p_size);
+	if (likely(data)) {
+		_memory_count_allocation(_memory_system_get_size(data), p_tag);
+	}
+	return data;
+#endif
+}
 
-	current_mem_usage.sub(*data);
+void Memory::vfree_unsized(void *p_block) {
+	if (!p_block) {
+		return;
+	}
 
-	free(data);
+#ifdef DEBUG_ENABLED
+	MemoryHeader *header = _memory_get_header(p_block, 0, MEMORY_FLAG_UNSIZED);
+	_memory_count_free(header->info & MEMORY_SIZE_MASK, (MemoryTag)(header->info >> MEMORY_TAG_SHIFT));
+	free(header);
+#else
+	_memory_count_free(_memory_system_get_size(p_block), MEMORY_TAG_GENERAL);
+	free(p_block);
+#endif
 }
 
 void Memory::vzero(void *p_block, uint64_t p_size) {
@@ -87,11 +582,22 @@ void *Memory::vmemmove(void *p_dest, const void *p_source, size_t p_count) {
 }
 
 void *operator new(size_t p_size, const char *p_description) {
-	return Memory::vallocate(p_size);
+	return operator new(p_size, p_description, MEMORY_TAG_GENERAL);
+}
+
+void *operator new(size_t p_size, const char *p_description, MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	_memory_record_call_site(p_description, p_size);
+#endif
+	return Memory::vallocate_unsized(p_size, p_tag);
 }
 
 #ifdef _MSC_VER
 void operator delete(void *p_mem, const char *p_description) {
 	CRASH_NOW_MSG("Calling to our delete override is forbidden, these are here to silence MSVC warnings.");
 }
-#endif
\ No newline at end of file
+
+void operator delete(void *p_mem, const char *p_description, MemoryTag p_tag) {
+	CRASH_NOW_MSG("Calling to our delete override is forbidden, these are here to silence MSVC warnings.");
+}
+#endif
@@ -3,20 +3,104 @@
 #include "core/data/atomic_counter.h"
 #include "core/typedefs.h"
 
+#include <new>
+
+class String;
+
+/**
+ * @brief Categories that allocations can be tagged with, so that memory usage can be broken down by the part of the
+ * engine that owns it. Tags are only tracked in debug builds, and are ignored entirely in release builds.
+ */
+enum MemoryTag : uint8_t {
+	MEMORY_TAG_GENERAL,
+	MEMORY_TAG_CONTAINER,
+	MEMORY_TAG_STRING,
+	MEMORY_TAG_VARIANT,
+	MEMORY_TAG_OBJECT,
+	MEMORY_TAG_RESOURCE,
+	MEMORY_TAG_RENDERING,
+	MEMORY_TAG_FRAME_ARENA,
+	MEMORY_TAG_MAX,
+};
+
+/**
+ * @brief Statistics for a single `MemoryTag`, as returned by `Memory::get_tag_stats()`.
+ */
+struct MemoryTagStats {
+	// The number of bytes currently allocated under the tag.
+	uint64_t live_bytes = 0;
+	// The highest `live_bytes` has ever been.
+	uint64_t peak_bytes = 0;
+	// The number of allocations made under the tag since the program started.
+	uint64_t allocation_count = 0;
+	// The number of allocations under the tag that have not been freed yet.
+	uint64_t live_allocation_count = 0;
+};
+
+/**
+ * @brief The engine's allocator. Raw blocks are allocated through `vallocate` and must be freed through `vfree` with
+ * the same size they were allocated (or last reallocated) with, which allows release builds to skip storing a header
+ * in front of each block. Objects created with `vnew`, whose size may not be known when they are deleted, go through
+ * `vallocate_unsized` and `vfree_unsized` instead.
+ * Debug builds keep a header in front of every block, which holds its size and tag and is used to check that blocks
+ * are freed with the right size. Release builds have no header, and count memory usage per thread so that allocating
+ * does not touch any shared cache lines. The counters are only summed up when usage is queried.
+ */
 class VAPI Memory {
 public:
-	static AtomicCounter<uint64_t> current_mem_usage;
-	static AtomicCounter<uint64_t> max_mem_usage;
-
-	static constexpr size_t DATA_OFFSET = sizeof(size_t);
+	// The most memory any single thread has used from its `FrameAllocator` arena in one frame.
+	static AtomicCounter<uint64_t> frame_arena_max_usage;
+
+#ifdef DEBUG_ENABLED
+	// The size of the header in front of each block. Kept at 16 bytes so that blocks have the same alignment that
+	// `malloc` gives.
+	static constexpr size_t DATA_OFFSET = 16;
+#else
+	static constexpr size_t DATA_OFFSET = 0;
+#endif
 
 	static uint64_t get_memory_usage();
+	/**
+	 * @brief Obtains the highest memory usage seen so far. In release builds, usage is only sampled whenever it is
+	 * queried, so short-lived peaks may be missed.
+	 */
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_frame_arena_max_usage();
+
+	static const char *get_tag_name(MemoryTag p_tag);
+	/**
+	 * @brief Obtains the statistics for the given tag. Always returns zeroes in release builds.
+	 */
+	static MemoryTagStats get_tag_stats(MemoryTag p_tag);
+	/**
+	 * @brief Builds a human-readable report of the memory used by each tag, and in debug builds, the call sites that
+	 * have allocated the most memory through `vnew` along with a histogram of their allocation sizes.
+	 */
+	static String get_report();
+
+	static void *vallocate(uint64_t p_size, MemoryTag p_tag = MEMORY_TAG_GENERAL);
+	static void *vallocate_zeroed(uint64_t p_size, MemoryTag p_tag = MEMORY_TAG_GENERAL);
+	/**
+	 * @brief Allocates a block whose address is a multiple of the given alignment, for data that is accessed with
+	 * aligned SIMD loads. The block must be freed through `vfree_aligned`, and cannot be reallocated.
+	 * @param p_size The size of the block, in bytes.
+	 * @param p_alignment The alignment of the block. Must be a power of two.
+	 * @param p_tag The tag to account the block under.
+	 */
+	static void *vallocate_aligned(uint64_t p_size, uint64_t p_alignment, MemoryTag p_tag = MEMORY_TAG_GENERAL);
+	// The tag is only used when `p_block` is null, as existing blocks keep the tag they were allocated with.
+	static void *vreallocate(void *p_block,
+							 uint64_t p_old_size,
+							 uint64_t p_new_size,
+							 MemoryTag p_tag = MEMORY_TAG_GENERAL);
+	static void vfree(void *p_block, uint64_t p_size);
+	static void vfree_aligned(void *p_block, uint64_t p_size);
+
+	// Used by `vnew` and `vdelete`. Release builds ask the system allocator for the size of the block when it is
+	// freed, which is slower than a sized free, but works for objects that are deleted through a base class.
+	static void *vallocate_unsized(uint64_t p_size, MemoryTag p_tag = MEMORY_TAG_GENERAL);
+	static void vfree_unsized(void *p_block);
 
-	static void *vallocate(uint64_t p_size);
-	static void *vallocate_zeroed(uint64_t p_size);
-	static void *vreallocate(void *p_block, uint64_t p_new_size);
-	static void vfree(void *p_block);
 	static void vzero(void *p_block, uint64_t p_size);
 	static void vset_memory(void *p_block, int p_value, uint64_t p_size);
 	static void *vcopy_memory(void *p_dest, const void *p_source, uint64_t p_size);
@@ -24,9 +108,20 @@ public:
 };
 
 VAPI void *operator new(size_t p_size, const char *p_description);
+VAPI void *operator new(size_t p_size, const char *p_description, MemoryTag p_tag);
 
 #ifdef _MSC_VER
 VAPI void operator delete(void *p_mem, const char *p_description);
+VAPI void operator delete(void *p_mem, const char *p_description, MemoryTag p_tag);
+#endif
+
+// Debug builds pass the file and line of each `vnew` to the allocator, so that allocations can be traced back to
+// where they were made.
+#ifdef DEBUG_ENABLED
+#	define _MEMORY_STR(m_x) _STR(m_x)
+#	define MEMORY_CALL_SITE __FILE__ ":" _MEMORY_STR(__LINE__)
+#else
+#	define MEMORY_CALL_SITE ""
 #endif
 
 template <typename T>
@@ -34,8 +129,10 @@ ALWAYS_INLINE T *_postinit(T *p_obj) {
 	return p_obj;
 }
 
-#define vnew(m_class) _postinit(::new ("") m_class)
-#define vnew_placement(m_placement, m_class) _postinit(::new (m_placement) m_class)
+#define vnew(m_class) _postinit(::new (MEMORY_CALL_SITE, MEMORY_TAG_GENERAL) m_class)
+#define vnew_tagged(m_class, m_tag) _postinit(::new (MEMORY_CALL_SITE, m_tag) m_class)
+// The cast keeps `char` buffers from matching the `const char *` description overloads above.
+#define vnew_placement(m_placement, m_class) _postinit(::new ((void *)(m_placement)) m_class)
 
 ALWAYS_INLINE bool predelete(void *) {
 	return true;
@@ -55,7 +152,7 @@ void vdelete(T *p_class) {
 		p_class->~T();
 	}
 
-	Memory::vfree(p_class);
+	Memory::vfree_unsized(p_class);
 }
 
 template <typename T>
@@ -74,7 +171,7 @@ class DefaultTypedAllocator {
 public:
 	template <typename... Args>
 	FORCE_INLINE T *new_allocation(Args &&...p_args) {
-		return vnew(T(p_args...));
+		return vnew_tagged(T(p_args...), MEMORY_TAG_CONTAINER);
 	}
 
 	FORCE_INLINE void delete_allocation(T *p_allocation) {
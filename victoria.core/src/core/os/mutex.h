@@ -0,0 +1,57 @@
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <mutex>
+
+/**
+ * @brief A lock that only one thread can hold at a time, wrapping the standard library's mutex types. Prefer locking
+ * through a `MutexLock`, which unlocks the mutex again when it goes out of scope.
+ */
+template <typename StdMutexT>
+class MutexImpl {
+	mutable StdMutexT _mutex;
+
+public:
+	FORCE_INLINE void lock() const {
+		_mutex.lock();
+	}
+
+	FORCE_INLINE void unlock() const {
+		_mutex.unlock();
+	}
+
+	/**
+	 * @brief Locks the mutex if no other thread holds it, without waiting.
+	 * @return `true` if the mutex was locked.
+	 */
+	FORCE_INLINE bool try_lock() const {
+		return _mutex.try_lock();
+	}
+};
+
+// A mutex that the thread holding it can lock again, as long as it unlocks it the same number of times.
+typedef MutexImpl<std::recursive_mutex> Mutex;
+// A mutex that cannot be locked again by the thread holding it, which makes it cheaper to lock than `Mutex`.
+typedef MutexImpl<std::mutex> BinaryMutex;
+
+/**
+ * @brief Holds a mutex locked for as long as it is in scope.
+ */
+template <typename MutexT>
+class MutexLock {
+	const MutexT &_mutex;
+
+public:
+	explicit MutexLock(const MutexT &p_mutex) :
+		_mutex(p_mutex) {
+		_mutex.lock();
+	}
+
+	~MutexLock() {
+		_mutex.unlock();
+	}
+
+	MutexLock(const MutexLock &) = delete;
+	void operator=(const MutexLock &) = delete;
+};
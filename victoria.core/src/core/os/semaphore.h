@@ -0,0 +1,64 @@
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief A counter that threads can wait on until it is above zero. Each call to `post()` raises the count and lets
+ * one waiting thread through, which lowers it again. Use it to hand out units of work to sleeping threads, or to
+ * signal that something has finished.
+ */
+class Semaphore {
+	mutable std::mutex _mutex;
+	mutable std::condition_variable _condition;
+	mutable uint32_t _count = 0;
+
+public:
+	/**
+	 * @brief Raises the count, waking up to that many waiting threads.
+	 * @param p_count The amount to raise the count by.
+	 */
+	FORCE_INLINE void post(uint32_t p_count = 1) const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_count += p_count;
+		if (p_count == 1) {
+			_condition.notify_one();
+		} else {
+			_condition.notify_all();
+		}
+	}
+
+	/**
+	 * @brief Waits until the count is above zero, then lowers it by one.
+	 */
+	FORCE_INLINE void wait() const {
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (_count == 0) {
+			_condition.wait(lock);
+		}
+		_count--;
+	}
+
+	/**
+	 * @brief Lowers the count by one if it is above zero, without waiting.
+	 * @return `true` if the count was lowered.
+	 */
+	FORCE_INLINE bool try_wait() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_count == 0) {
+			return false;
+		}
+		_count--;
+		return true;
+	}
+
+	/**
+	 * @brief Obtains the current count. Other threads may change it straight after, so only use it for debugging.
+	 */
+	FORCE_INLINE uint32_t get() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _count;
+	}
+};
@@ -0,0 +1,49 @@
+#include "core/os/thread.h"
+
+#include "core/data/atomic_counter.h"
+#include "core/error/error_macros.h"
+
+// Static initializers run on the thread that loads the library, which is the main thread.
+static const std::thread::id main_thread_id = std::this_thread::get_id();
+static AtomicCounter<Thread::ID> id_counter(Thread::MAIN_ID);
+static thread_local Thread::ID caller_id = Thread::UNASSIGNED_ID;
+
+void Thread::_callback(ID p_id, Callback p_callback, void *p_userdata) {
+	caller_id = p_id;
+	p_callback(p_userdata);
+}
+
+void Thread::start(Callback p_callback, void *p_userdata) {
+	ERR_FAIL_COND_MSG(is_started(), "Cannot start a thread that is already running. Wait for it to finish first.");
+	ERR_COND_NULL(p_callback);
+
+	_id = id_counter.increment();
+	_thread = std::thread(&Thread::_callback, _id, p_callback, p_userdata);
+}
+
+void Thread::wait_to_finish() {
+	ERR_FAIL_COND_MSG(!is_started(), "Cannot wait on a thread that was never started.");
+	ERR_FAIL_COND_MSG(get_caller_id() == _id, "A thread cannot wait for itself to finish.");
+
+	_thread.join();
+	_id = UNASSIGNED_ID;
+}
+
+Thread::ID Thread::get_caller_id() {
+	if (unlikely(caller_id == UNASSIGNED_ID)) {
+		caller_id = std::this_thread::get_id() == main_thread_id ? MAIN_ID : id_counter.increment();
+	}
+	return caller_id;
+}
+
+uint32_t Thread::get_hardware_concurrency() {
+	uint32_t count = std::thread::hardware_concurrency();
+	return count > 0 ? count : 1;
+}
+
+Thread::~Thread() {
+	if (is_started()) {
+		ERR_WARN("A thread was destroyed while it was still running. Waiting for it to finish.");
+		wait_to_finish();
+	}
+}
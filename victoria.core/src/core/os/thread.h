@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <thread>
+
+/**
+ * @brief A thread of execution, which runs a single function from start to finish. Every thread that is started has
+ * to be waited on with `wait_to_finish()` before the `Thread` is destroyed.
+ */
+class VAPI Thread {
+public:
+	typedef void (*Callback)(void *p_userdata);
+	// Identifies a thread for as long as the program runs. IDs are never reused.
+	typedef uint64_t ID;
+
+	enum : ID {
+		UNASSIGNED_ID = 0,
+		MAIN_ID = 1,
+	};
+
+private:
+	ID _id = UNASSIGNED_ID;
+	std::thread _thread;
+
+	static void _callback(ID p_id, Callback p_callback, void *p_userdata);
+
+public:
+	/**
+	 * @brief Obtains the ID of the thread, or `UNASSIGNED_ID` if it has not been started.
+	 */
+	FORCE_INLINE ID get_id() const {
+		return _id;
+	}
+
+	FORCE_INLINE bool is_started() const {
+		return _id != UNASSIGNED_ID;
+	}
+
+	/**
+	 * @brief Starts running the given function on the thread.
+	 * @param p_callback The function to run.
+	 * @param p_userdata A pointer passed on to the function.
+	 */
+	void start(Callback p_callback, void *p_userdata);
+
+	/**
+	 * @brief Waits for the function the thread is running to return. The thread can then be started again.
+	 */
+	void wait_to_finish();
+
+	/**
+	 * @brief Obtains the ID of the thread calling this function. Threads not started through a `Thread` are given an
+	 * ID the first time they call it, and the main thread always has `MAIN_ID`.
+	 */
+	static ID get_caller_id();
+
+	FORCE_INLINE static bool is_main_thread() {
+		return get_caller_id() == MAIN_ID;
+	}
+
+	/**
+	 * @brief Obtains the number of threads the hardware can run at once, which is at least 1.
+	 */
+	static uint32_t get_hardware_concurrency();
+
+	Thread() {}
+	~Thread();
+
+	Thread(const Thread &) = delete;
+	void operator=(const Thread &) = delete;
+};
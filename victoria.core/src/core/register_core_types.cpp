@@ -15,4 +15,6 @@ void register_core_types() {
 	REGISTER_CLASS(FileSystem);
 }
 
-void unregister_core_types() {}
\ No newline at end of file
+void unregister_core_types() {
+	ClassRegistry::cleanup();
+}
\ No newline at end of file
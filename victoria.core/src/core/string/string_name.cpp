@@ -0,0 +1,90 @@
+#include "core/string/string_name.h"
+
+#include "core/os/memory.h"
+
+#include <string.h>
+
+#include <mutex>
+
+StringName::_Data *StringName::_table[StringName::TABLE_SIZE] = {};
+
+static uint32_t string_name_count = 0;
+static std::mutex string_name_mutex;
+
+StringName::_Data *StringName::_intern(const char *p_name, int p_length) {
+	if (!p_name || p_length == 0) {
+		return nullptr;
+	}
+
+	uint32_t hash = hash_string(p_name, p_length);
+	uint32_t idx = hash & (TABLE_SIZE - 1);
+
+	std::lock_guard<std::mutex> lock(string_name_mutex);
+	for (_Data *d = _table[idx]; d; d = d->next) {
+		if (d->hash == hash && d->name.length() == p_length && memcmp(d->name.get_data(), p_name, p_length) == 0) {
+			return d;
+		}
+	}
+
+	_Data *d = vnew_tagged(_Data, MEMORY_TAG_STRING);
+	d->name = p_name;
+	d->hash = hash;
+	d->next = _table[idx];
+	_table[idx] = d;
+	string_name_count++;
+	return d;
+}
+
+bool StringName::operator==(const String &p_right) const {
+	if (!_data) {
+		return p_right.is_empty();
+	}
+	return _data->name == p_right;
+}
+
+bool StringName::operator==(const char *p_right) const {
+	if (!_data) {
+		return !p_right || !p_right[0];
+	}
+	return p_right && strcmp(_data->name.get_data(), p_right) == 0;
+}
+
+bool StringName::operator!=(const String &p_right) const {
+	return !(*this == p_right);
+}
+
+bool StringName::operator!=(const char *p_right) const {
+	return !(*this == p_right);
+}
+
+StringName StringName::search(const char *p_name) {
+	StringName ret;
+	if (!p_name || !p_name[0]) {
+		return ret;
+	}
+
+	int length = strlen(p_name);
+	uint32_t hash = hash_string(p_name, length);
+	std::lock_guard<std::mutex> lock(string_name_mutex);
+	for (_Data *d = _table[hash & (TABLE_SIZE - 1)]; d; d = d->next) {
+		if (d->hash == hash && d->name.length() == length && memcmp(d->name.get_data(), p_name, length) == 0) {
+			ret._data = d;
+			break;
+		}
+	}
+
+	return ret;
+}
+
+uint32_t StringName::get_interned_count() {
+	std::lock_guard<std::mutex> lock(string_name_mutex);
+	return string_name_count;
+}
+
+StringName::StringName(const char *p_name) {
+	_data = _intern(p_name, p_name ? strlen(p_name) : 0);
+}
+
+StringName::StringName(const String &p_name) {
+	_data = _intern(p_name.get_data(), p_name.length());
+}
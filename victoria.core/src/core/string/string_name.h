@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/data/hashfuncs.h"
+#include "core/string/vstring.h"
+#include "core/typedefs.h"
+
+/**
+ * @brief An interned string, for names that are compared or looked up far more often than they are created, such as
+ * class, signal and uniform names. Every distinct name is stored once in a global table, so a `StringName` is just a
+ * pointer to its entry: copying, comparing and hashing it never touch the characters. Creating one from a string has
+ * to look it up in the table, so names used on hot paths should be created once and kept, or obtained with `SNAME`.
+ * Entries are never freed, which keeps copies free of reference counting. This is fine for the fixed set of names an
+ * engine uses, but means `StringName` should not be used for arbitrary user data.
+ */
+class VAPI StringName {
+	struct _Data {
+		String name;
+		uint32_t hash = 0;
+		// The next entry in the same bucket of the intern table.
+		_Data *next = nullptr;
+	};
+
+	// The number of buckets in the intern table. Each bucket holds a chain of entries, so the table never grows.
+	static constexpr uint32_t TABLE_SIZE = 4096;
+	// Constant-initialized, so names can safely be interned from static initializers in other files.
+	static _Data *_table[TABLE_SIZE];
+
+	_Data *_data = nullptr;
+
+	static _Data *_intern(const char *p_name, int p_length);
+
+public:
+	/**
+	 * @brief Obtains the name as a C string. Empty names return an empty string.
+	 */
+	FORCE_INLINE const char *get_data() const {
+		return _data ? _data->name.get_data() : "";
+	}
+
+	FORCE_INLINE const String &get_string() const {
+		static const String empty;
+		return _data ? _data->name : empty;
+	}
+
+	/**
+	 * @brief Obtains the hash of the name, which is calculated once when it is first interned.
+	 */
+	FORCE_INLINE uint32_t hash() const {
+		return _data ? _data->hash : 0;
+	}
+
+	FORCE_INLINE bool is_empty() const {
+		return _data == nullptr;
+	}
+
+	FORCE_INLINE bool operator==(const StringName &p_right) const {
+		return _data == p_right._data;
+	}
+
+	FORCE_INLINE bool operator!=(const StringName &p_right) const {
+		return _data != p_right._data;
+	}
+
+	// Orders names by their address, which is stable for as long as the program runs but unrelated to their contents.
+	FORCE_INLINE bool operator<(const StringName &p_right) const {
+		return _data < p_right._data;
+	}
+
+	bool operator==(const String &p_right) const;
+	bool operator==(const char *p_right) const;
+	bool operator!=(const String &p_right) const;
+	bool operator!=(const char *p_right) const;
+
+	operator String() const {
+		return get_string();
+	}
+
+	/**
+	 * @brief Looks up a name without interning it.
+	 * @param p_name The name to look for.
+	 * @return The name if it has already been interned, or an empty `StringName` otherwise.
+	 */
+	static StringName search(const char *p_name);
+
+	/**
+	 * @brief Obtains the number of distinct names that have been interned.
+	 */
+	static uint32_t get_interned_count();
+
+	StringName(const char *p_name);
+	StringName(const String &p_name);
+	StringName() {}
+};
+
+uint32_t HasherDefault::hash(const StringName &p_key) {
+	return p_key.hash();
+}
+
+/**
+ * @brief Obtains a `StringName` for a string literal, which is only interned the first time the expression runs. Use
+ * it instead of passing a literal wherever a `StringName` is expected on a hot path.
+ */
+#define SNAME(m_name)                                                                                                 \
+	([]() -> const StringName & {                                                                                     \
+		static const StringName sname(m_name);                                                                        \
+		return sname;                                                                                                 \
+	})()
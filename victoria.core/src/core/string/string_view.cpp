@@ -0,0 +1,209 @@
+#include "core/string/string_view.h"
+
+#include "core/math/math_funcs.h"
+
+#include <string.h>
+
+void StringView::SplitRange::Iterator::_advance(int p_from) {
+	if (!_range) {
+		return;
+	}
+
+	const StringView &source = _range->_source;
+	while (p_from >= 0 && p_from <= source._length) {
+		int end = source.find(_range->_delimiter, p_from);
+		int next = 0;
+		if (end == -1) {
+			end = source._length;
+			// One past the end, so that the next call finishes the range.
+			next = source._length + 1;
+		} else {
+			next = end + _range->_delimiter._length;
+		}
+
+		if (end > p_from || _range->_allow_empty) {
+			_current = StringView(source._ptr + p_from, end - p_from);
+			_next = next;
+			return;
+		}
+
+		p_from = next;
+	}
+
+	_current = StringView();
+	_next = -1;
+}
+
+int StringView::SplitRange::size() const {
+	int count = 0;
+	for (Iterator it = begin(); it != end(); ++it) {
+		count++;
+	}
+	return count;
+}
+
+bool StringView::operator==(const StringView &p_right) const {
+	return _length == p_right._length && (_length == 0 || memcmp(_ptr, p_right._ptr, _length) == 0);
+}
+
+int StringView::find(const StringView &p_what, int p_from) const {
+	if (p_what._length == 0 || p_from < 0) {
+		return -1;
+	}
+
+	const char first = p_what._ptr[0];
+	const int last = _length - p_what._length;
+	for (int i = p_from; i <= last; i++) {
+		const char *c = (const char *)memchr(_ptr + i, first, last - i + 1);
+		if (!c) {
+			return -1;
+		}
+
+		i = c - _ptr;
+		if (memcmp(c + 1, p_what._ptr + 1, p_what._length - 1) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int StringView::find_char(char p_what, int p_from) const {
+	if (p_from < 0 || p_from >= _length) {
+		return -1;
+	}
+
+	const char *c = (const char *)memchr(_ptr + p_from, p_what, _length - p_from);
+	return c ? c - _ptr : -1;
+}
+
+bool StringView::begins_with(const StringView &p_string) const {
+	return p_string._length <= _length && memcmp(_ptr, p_string._ptr, p_string._length) == 0;
+}
+
+bool StringView::ends_with(const StringView &p_string) const {
+	return p_string._length <= _length &&
+		   memcmp(_ptr + _length - p_string._length, p_string._ptr, p_string._length) == 0;
+}
+
+StringView StringView::substr(int p_from, int p_chars) const {
+	if (p_from < 0) {
+		p_from = 0;
+	}
+	if (p_from >= _length) {
+		return StringView(_ptr + _length, 0);
+	}
+	if (p_chars < 0 || p_chars > _length - p_from) {
+		p_chars = _length - p_from;
+	}
+
+	return StringView(_ptr + p_from, p_chars);
+}
+
+StringView StringView::left(int p_count) const {
+	if (p_count < 0) {
+		p_count = _length + p_count < 0 ? 0 : _length + p_count;
+	}
+	return substr(0, p_count);
+}
+
+StringView StringView::right(int p_count) const {
+	if (p_count < 0) {
+		return substr(-p_count);
+	}
+	return substr(p_count < _length ? _length - p_count : 0);
+}
+
+static FORCE_INLINE bool is_space(char p_char) {
+	return p_char == ' ' || p_char == '\t' || p_char == '\r' || p_char == '\n';
+}
+
+StringView StringView::strip_edges() const {
+	int from = 0;
+	int to = _length;
+	while (from < to && is_space(_ptr[from])) {
+		from++;
+	}
+	while (to > from && is_space(_ptr[to - 1])) {
+		to--;
+	}
+
+	return StringView(_ptr + from, to - from);
+}
+
+static FORCE_INLINE bool is_digit(char p_char) {
+	return p_char >= '0' && p_char <= '9';
+}
+
+int64_t StringView::to_int() const {
+	int i = 0;
+	bool negative = false;
+	if (i < _length && (_ptr[i] == '-' || _ptr[i] == '+')) {
+		negative = _ptr[i] == '-';
+		i++;
+	}
+
+	uint64_t ret = 0;
+	for (; i < _length && is_digit(_ptr[i]); i++) {
+		ret = ret * 10 + (_ptr[i] - '0');
+	}
+
+	return negative ? -(int64_t)ret : (int64_t)ret;
+}
+
+// Every power of ten up to 10^22 is exact as a double, so numbers with a short mantissa are scaled without rounding.
+static const double powers_of_ten[] = {1e0,	 1e1,  1e2,	 1e3,  1e4,	 1e5,  1e6,	 1e7,  1e8,	 1e9,  1e10, 1e11,
+									   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+double StringView::to_float() const {
+	int i = 0;
+	bool negative = false;
+	if (i < _length && (_ptr[i] == '-' || _ptr[i] == '+')) {
+		negative = _ptr[i] == '-';
+		i++;
+	}
+
+	// Digits are gathered into an integer and scaled once at the end, which is faster and more accurate than adding
+	// each digit's contribution separately. Digits past what fits in the mantissa only affect the exponent.
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	for (; i < _length && is_digit(_ptr[i]); i++) {
+		if (digits < 19) {
+			mantissa = mantissa * 10 + (_ptr[i] - '0');
+			digits += mantissa != 0;
+		} else {
+			exponent++;
+		}
+	}
+
+	if (i < _length && _ptr[i] == '.') {
+		for (i++; i < _length && is_digit(_ptr[i]); i++) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (_ptr[i] - '0');
+				digits += mantissa != 0;
+				exponent--;
+			}
+		}
+	}
+
+	if (i + 1 < _length && (_ptr[i] == 'e' || _ptr[i] == 'E')) {
+		exponent += substr(i + 1).to_int();
+	}
+
+	double ret = (double)mantissa;
+	if (exponent < 0 && exponent >= -22) {
+		ret /= powers_of_ten[-exponent];
+	} else if (exponent > 0 && exponent <= 22) {
+		ret *= powers_of_ten[exponent];
+	} else if (exponent != 0) {
+		ret *= Math::pow(10.0, exponent);
+	}
+
+	return negative ? -ret : ret;
+}
+
+StringView::StringView(const char *p_str) {
+	_ptr = p_str;
+	_length = p_str ? strlen(p_str) : 0;
+}
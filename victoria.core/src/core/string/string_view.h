@@ -0,0 +1,179 @@
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+
+class String;
+
+/**
+ * @brief A non-owning view into a run of characters, such as part of a `String` or a string literal. Taking a
+ * substring of a view or splitting it never allocates, which makes views the right tool for parsers that only need to
+ * look at each piece of a string before converting it into something else.
+ * A view does not keep the string it points into alive, and is not null-terminated, so it must not outlive or be
+ * passed anywhere that expects a C string. Use `String(view)` to make an owning copy.
+ */
+class VAPI StringView {
+	const char *_ptr = nullptr;
+	int _length = 0;
+
+public:
+	class SplitRange;
+
+	FORCE_INLINE const char *ptr() const {
+		return _ptr;
+	}
+
+	FORCE_INLINE int length() const {
+		return _length;
+	}
+
+	FORCE_INLINE bool is_empty() const {
+		return _length == 0;
+	}
+
+	FORCE_INLINE char operator[](int p_index) const {
+		CRASH_OUT_OF_BOUNDS(p_index, _length);
+		return _ptr[p_index];
+	}
+
+	FORCE_INLINE const char *begin() const {
+		return _ptr;
+	}
+
+	FORCE_INLINE const char *end() const {
+		return _ptr + _length;
+	}
+
+	bool operator==(const StringView &p_right) const;
+	FORCE_INLINE bool operator!=(const StringView &p_right) const {
+		return !(*this == p_right);
+	}
+
+	/**
+	 * @brief Finds the first occurence of the given string in the view. The search is case-sensitive.
+	 * @param p_what The string to look for.
+	 * @param p_from The index to start looking from.
+	 * @returns The index of the first character of the match, or `-1` if there was no match.
+	 */
+	int find(const StringView &p_what, int p_from = 0) const;
+	int find_char(char p_what, int p_from = 0) const;
+
+	FORCE_INLINE bool contains(const StringView &p_what) const {
+		return find(p_what) != -1;
+	}
+
+	bool begins_with(const StringView &p_string) const;
+	bool ends_with(const StringView &p_string) const;
+
+	/**
+	 * @brief Obtains a view of part of this view. The range is clamped to the view, so it never reads outside of it.
+	 * @param p_from The index of the first character.
+	 * @param p_chars The number of characters, or -1 for every character up to the end.
+	 */
+	StringView substr(int p_from, int p_chars = -1) const;
+	// Like `String::left`, a negative count removes characters from the end instead.
+	StringView left(int p_count) const;
+	// Like `String::right`, a negative count removes characters from the start instead.
+	StringView right(int p_count) const;
+	// Removes any spaces, tabs and line breaks from both ends.
+	StringView strip_edges() const;
+
+	/**
+	 * @brief Splits the view into the pieces between each occurence of the delimiter.
+	 * @param p_delimiter The string that separates each piece.
+	 * @param p_allow_empty Whether to include empty pieces, such as those between two delimiters in a row.
+	 */
+	SplitRange split(const StringView &p_delimiter, bool p_allow_empty = true) const;
+
+	/**
+	 * @brief Parses an integer from the start of the view, with an optional sign. Parsing stops at the first character
+	 * that is not a digit.
+	 */
+	int64_t to_int() const;
+	/**
+	 * @brief Parses a decimal number from the start of the view, with an optional sign, fraction and exponent.
+	 * Parsing stops at the first character that cannot be part of the number.
+	 */
+	double to_float() const;
+
+	StringView(const char *p_str);
+	StringView(const char *p_str, int p_length) {
+		_ptr = p_str;
+		_length = p_length;
+	}
+	// Defined in `vstring.h`.
+	StringView(const String &p_str);
+	StringView() {}
+};
+
+/**
+ * @brief A lazily evaluated range over the pieces of a view, separated by a delimiter. Iterating it yields each
+ * piece in turn as a `StringView`, without allocating.
+ */
+class VAPI StringView::SplitRange {
+	StringView _source;
+	StringView _delimiter;
+	bool _allow_empty = true;
+
+public:
+	class VAPI Iterator {
+		const SplitRange *_range = nullptr;
+		StringView _current;
+		// The offset into the source of the character after the current piece, or -1 once the range is done.
+		int _next = -1;
+
+		void _advance(int p_from);
+
+	public:
+		FORCE_INLINE const StringView &operator*() const {
+			return _current;
+		}
+
+		FORCE_INLINE const StringView *operator->() const {
+			return &_current;
+		}
+
+		FORCE_INLINE Iterator &operator++() {
+			_advance(_next);
+			return *this;
+		}
+
+		FORCE_INLINE bool operator==(const Iterator &p_other) const {
+			return _next == p_other._next && _current._ptr == p_other._current._ptr;
+		}
+
+		FORCE_INLINE bool operator!=(const Iterator &p_other) const {
+			return !(*this == p_other);
+		}
+
+		Iterator(const SplitRange *p_range, int p_from) {
+			_range = p_range;
+			_advance(p_from);
+		}
+
+		Iterator() {}
+	};
+
+	FORCE_INLINE Iterator begin() const {
+		return Iterator(this, 0);
+	}
+
+	FORCE_INLINE Iterator end() const {
+		return Iterator();
+	}
+
+	/**
+	 * @brief Counts the number of pieces in the range. Walks the whole range, so prefer iterating it directly.
+	 */
+	int size() const;
+
+	SplitRange(const StringView &p_source, const StringView &p_delimiter, bool p_allow_empty) {
+		_source = p_source;
+		_delimiter = p_delimiter;
+		_allow_empty = p_allow_empty;
+	}
+};
+
+FORCE_INLINE StringView::SplitRange StringView::split(const StringView &p_delimiter, bool p_allow_empty) const {
+	return SplitRange(*this, p_delimiter, p_allow_empty);
+}
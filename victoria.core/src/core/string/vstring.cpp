@@ -6,22 +6,129 @@
 #include <stdio.h>
 #include <string.h>
 
+void String::_copy(const String &p_from) {
+	_hash = p_from._hash;
+	_inline_size = p_from._inline_size;
+	if (p_from._is_heap()) {
+		vnew_placement(&_heap, CoWData<char>(p_from._heap));
+	} else {
+		// Copying the whole buffer is cheaper than working out how much of it is in use.
+		Memory::vcopy_memory(_inline, p_from._inline, INLINE_CAPACITY + 1);
+	}
+}
+
+void String::_move(String &p_from) {
+	_hash = p_from._hash;
+	_inline_size = p_from._inline_size;
+	if (p_from._is_heap()) {
+		vnew_placement(&_heap, CoWData<char>(std::move(p_from._heap)));
+		p_from._heap.~CoWData<char>();
+	} else {
+		Memory::vcopy_memory(_inline, p_from._inline, INLINE_CAPACITY + 1);
+	}
+
+	p_from._inline[0] = 0;
+	p_from._inline_size = 0;
+	p_from._hash = 0;
+}
+
+void String::_free_heap() {
+	if (_is_heap()) {
+		_heap.~CoWData<char>();
+		_inline[0] = 0;
+		_inline_size = 0;
+		_hash = 0;
+	}
+}
+
 /**
- * @brief Returns the raw data of a string for applying in specific C++ circumstances.
+ * @brief Moves an inline string onto the heap, keeping its contents.
+ * @param p_capacity The number of characters, including the null terminator, to reserve memory for.
  */
-const char *String::get_data() const {
-	if (size()) {
-		return &operator[](0);
-	} else {
-		return "";
+Error String::_move_to_heap(int p_capacity) {
+	char contents[INLINE_CAPACITY + 1];
+	const int current_size = _inline_size;
+	Memory::vcopy_memory(contents, _inline, current_size);
+
+	vnew_placement(&_heap, CoWData<char>);
+	_inline_size = HEAP;
+
+	Error err = _heap.reserve(p_capacity > current_size ? p_capacity : current_size);
+	ERR_FAIL_COND_R(err != OK, err);
+	if (current_size) {
+		_heap.resize(current_size);
+		Memory::vcopy_memory(_heap.ptrw(), contents, current_size);
+	}
+
+	return OK;
+}
+
+Error String::resize(int p_size) {
+	ERR_FAIL_COND_R(p_size < 0, ERR_INVALID_PARAMETER);
+	_hash = 0;
+
+	if (_is_heap()) {
+		return _heap.resize(p_size);
+	}
+
+	if (p_size <= INLINE_CAPACITY + 1) {
+		if (p_size > _inline_size) {
+			Memory::vzero(_inline + _inline_size, p_size - _inline_size);
+		}
+		_inline_size = p_size;
+		return OK;
 	}
+
+	Error err = _move_to_heap(p_size);
+	ERR_FAIL_COND_R(err != OK, err);
+	return _heap.resize(p_size);
+}
+
+Error String::reserve(int p_length) {
+	if (_is_heap()) {
+		return _heap.reserve(p_length + 1);
+	}
+
+	if (p_length <= INLINE_CAPACITY) {
+		return OK;
+	}
+
+	return _move_to_heap(p_length + 1);
+}
+
+void String::shrink_to_fit() {
+	if (!_is_heap()) {
+		return;
+	}
+
+	const int current_size = _heap.size();
+	if (current_size > INLINE_CAPACITY + 1) {
+		_heap.shrink_to_fit();
+		return;
+	}
+
+	// Small enough to move back inline. The contents do not change, so neither does the hash.
+	char contents[INLINE_CAPACITY + 1];
+	Memory::vcopy_memory(contents, _heap.ptr(), current_size);
+	_heap.~CoWData<char>();
+	Memory::vcopy_memory(_inline, contents, current_size);
+	_inline_size = current_size;
+}
+
+void String::clear() {
+	_free_heap();
+	_inline[0] = 0;
+	_inline_size = 0;
+	_hash = 0;
 }
 
 void String::operator=(const String &p_right) {
-	if (*this == p_right) {
-		return; // Don't copy if they're pretty much the same.
+	if (this == &p_right) {
+		return;
 	}
-	_data = p_right._data;
+
+	_free_heap();
+	_copy(p_right);
 }
 
 void String::operator=(const char *p_right) {
@@ -29,37 +136,28 @@ void String::operator=(const char *p_right) {
 }
 
 bool String::operator==(const String &p_right) const {
-	if (!_data.ptr()) {
+	const int len = length();
+	if (len != p_right.length()) {
 		return false;
 	}
 
-	if (!p_right.ptr()) {
+	// Strings that have both been hashed already can usually be told apart without comparing them.
+	if (_hash && p_right._hash && _hash != p_right._hash) {
 		return false;
 	}
 
-	if (size() != p_right.size()) {
-		return false;
-	}
-
-	for (int i = 0; i < size(); i++) {
-		if (_data._ptr[i] != p_right._data._ptr[i]) {
-			return false;
-		}
-	}
-
-	return true;
+	return len == 0 || memcmp(ptr(), p_right.ptr(), len) == 0;
 }
 
 bool String::operator==(const char *p_right) const {
-	String rhs = p_right;
-	return *this == rhs;
+	if (!p_right) {
+		return is_empty();
+	}
+	return strcmp(get_data(), p_right) == 0;
 }
 
 bool String::operator==(const char p_right) const {
-	if (length() > 1) {
-		return false;
-	}
-	return _data.get(0) == p_right;
+	return length() == 1 && ptr()[0] == p_right;
 }
 
 bool String::operator!=(const String &p_right) const {
@@ -75,40 +173,33 @@ bool String::operator!=(const char p_right) const {
 }
 
 String &String::operator+=(const String &p_right) {
-	if (length() == 0) {
-		*this = p_right;
+	const int rhs_len = p_right.length();
+	if (rhs_len == 0) {
 		return *this;
 	}
 
-	if (p_right.length() == 0) {
+	if (is_empty()) {
+		*this = p_right;
 		return *this;
 	}
 
-	int lhs_len = length();
-	int rhs_len = p_right.length();
+	const int lhs_len = length();
+	resize(lhs_len + rhs_len + 1);
 
-	const char *rhs_ptr = p_right.ptr();
-
-	// Resize, so the pointer is large enough
-	_data.resize(lhs_len + rhs_len + 1);
-
-	char *lhs_ptr = ptrw();
-	for (int i = 0; i < rhs_len; i++) {
-		lhs_ptr[lhs_len + i] = rhs_ptr[i];
-	}
-
-	_data.set('\0', lhs_len + rhs_len);
+	// Read the other string after resizing, in case it is this string.
+	char *dest = ptrw();
+	Memory::vcopy_memory(dest + lhs_len, p_right.ptr(), rhs_len);
+	dest[lhs_len + rhs_len] = 0;
 	return *this;
 }
 
 String &String::operator+=(const char p_right) {
-	const int size = length();
-
-	_data.resize(size + 2);
-
-	_data._ptr[size] = p_right;
-	_data._ptr[size + 1] = 0;
+	const int len = length();
+	resize(len + 2);
 
+	char *dest = ptrw();
+	dest[len] = p_right;
+	dest[len + 1] = 0;
 	return *this;
 }
 
@@ -272,27 +363,20 @@ bool String::begins_with(const String &p_string) const {
  * @returns `true if the current string does end with the given string
  */
 bool String::ends_with(const String &p_string) const {
-	if (!_data.size()) {
+	const int t_len = length();
+	if (!t_len) {
 		return false;
 	}
-	int t_len = length();
-	int s_len = p_string.length();
 
+	const int s_len = p_string.length();
 	if (s_len == 0) {
 		return true;
 	}
-
-	int counter = 0;
-	for (int i = t_len; i > (t_len - s_len - 1); i--) {
-		if (_data._ptr[i] == p_string[counter]) {
-			counter++;
-			if (counter == s_len) {
-				return true;
-			}
-		}
+	if (s_len > t_len) {
+		return false;
 	}
 
-	return false;
+	return memcmp(ptr() + t_len - s_len, p_string.ptr(), s_len) == 0;
 }
 
 /**
@@ -354,31 +438,9 @@ Vector<String> String::split(const String &delimiter) const {
 		return ret;
 	}
 
-	if (delimiter.is_empty()) {
-		ret.push_back(String(*this));
-		return ret;
-	}
-
-	int similarity = 0;
-	int from = 0;
-	int chars = 0;
-	for (int i = 0; i <= length(); i++) {
-		// Check if the characters in the string are the same, yes then we substr and append the new item
-		if (operator[](i) == delimiter[similarity]) {
-			similarity++;
-			if (similarity == delimiter.length()) {
-				ret.push_back(substr(from, chars));
-				from = i + 1;
-				chars = 0;
-				similarity = 0;
-				continue;
-			}
-		}
-		chars++;
+	for (const StringView &piece : view().split(delimiter)) {
+		ret.push_back(String(piece));
 	}
-	// At the end of the process, we need to add the other string in. - 1 is for the offset to prevent including 2 null
-	// terminators
-	ret.push_back(substr(from, chars - 1));
 
 	return ret;
 }
@@ -445,30 +507,12 @@ String String::get_file_extension() const {
 }
 
 /**
- * @brief Takes a string and turns it into an integer. This applies universally to a string, so any non-numerical
- * characters will still be read as a number, which can confuse the function and give a non-intended result.
+ * @brief Takes a string and turns it into an integer, with an optional sign. Parsing stops at the first character that
+ * is not a digit.
  * @returns The given string as an integer.
  */
 int64_t String::to_int() const {
-	String self = *this;
-	int64_t ret = 0;
-	// Get length of the string
-	// Assume the value is only a number
-	int len = length();
-	int sign = 1;
-
-	if (begins_with("-")) {
-		self = right(-1);
-		len -= 1;
-		sign = -1;
-	}
-
-	for (int i = 0; i < len; i++) {
-		char val = self[i];
-		uint8_t num = (uint8_t)(val > 0 ? val : 48) - 48;
-		ret += (num * Math::pow(10, len - i - 1));
-	}
-	return ret * sign;
+	return view().to_int();
 }
 
 /**
@@ -476,36 +520,11 @@ int64_t String::to_int() const {
  * @returns The current string as a floating-point number
  */
 double String::to_float() const {
-	double ret = 0.0;
-
-	// Maybe not the best way to do this, but we'll stick at it for now.
-	Vector<String> v = split(".");
-	ret += (double)(v[0].to_int());
-
-	for (int i = 0; i < v[1].length(); i++) {
-		char c = v[1].get(i);
-		uint8_t n = (uint8_t)(c > 0 ? c : 48) - 48;
-		ret += (double)(n * Math::pow(10, -(i + 1)));
-	}
-
-	return ret;
+	return view().to_float();
 }
 
 void String::append(const String &p_string) {
-	int len = length();
-	if (!p_string.length()) {
-		return;
-	}
-
-	if (!len) {
-		*this = p_string;
-		return;
-	}
-
-	_data.resize(len + p_string.length() + 1);
-	for (int i = len; i < len + p_string.length(); i++) {
-		_data._ptr[i] = p_string[i - len];
-	}
+	*this += p_string;
 }
 
 /**
@@ -606,17 +625,10 @@ String ftos(double p_double) {
 	return buf;
 }
 
-/**
- * @brief Class constructor for a string.
- */
-String::String(const String &p_from) {
-	_data._ref(p_from._data);
-}
-
 String::String(const char p_from) {
-	resize(2);
-	_data._ptr[0] = p_from;
-	_data._ptr[1] = 0;
+	_inline[0] = p_from;
+	_inline[1] = 0;
+	_inline_size = 2;
 }
 
 /**
@@ -628,23 +640,12 @@ void String::copy_from(const char *p_str) {
 	}
 
 	const int len = strlen(p_str);
-
 	if (len == 0) {
 		resize(0);
 		return;
 	}
 
-	resize(len + 1);
-	char *dest = ptrw();
-
-	for (int i = 0; i <= len; i++) {
-		uint8_t c = p_str[i];
-		if (c == 0 && i < len) {
-			dest[i] = ' ';
-		} else {
-			dest[i] = c;
-		}
-	}
+	copy_from_unchecked(p_str, len);
 }
 
 /**
@@ -656,32 +657,33 @@ void String::copy_from(const char *p_str) {
 void String::copy_from_unchecked(const char *p_str, const int p_length) {
 	resize(p_length + 1);
 	char *data = ptrw();
+	Memory::vmemmove(data, p_str, p_length);
 	data[p_length] = 0;
-
-	for (int i = 0; i < p_length; i++) {
-		data[i] = p_str[i];
-	}
 }
 
 String vformat(const char *p_string, ...) {
-	char cstr[32000];
-	memset(cstr, 0, 32000);
+	// Most formatted strings are short, so format into the stack first and only format again if it was too small.
+	char cstr[1024];
 
 	va_list arg_ptr;
 	va_start(arg_ptr, p_string);
-	vsnprintf(cstr, 32000, p_string, arg_ptr);
+	int len = vsnprintf(cstr, sizeof(cstr), p_string, arg_ptr);
 	va_end(arg_ptr);
 
-	int n_size = 0;
-	while (cstr[n_size]) {
-		n_size++;
-	}
 	String ret;
-	ret.resize(n_size + 1);
-	for (int i = 0; i < n_size; i++) {
-		ret[i] = cstr[i];
+	if (len <= 0) {
+		return ret;
+	}
+
+	if (len < (int)sizeof(cstr)) {
+		ret.copy_from_unchecked(cstr, len);
+		return ret;
 	}
-	ret[n_size] = 0;
+
+	ret.resize(len + 1);
+	va_start(arg_ptr, p_string);
+	vsnprintf(ret.ptrw(), len + 1, p_string, arg_ptr);
+	va_end(arg_ptr);
 	return ret;
 }
 
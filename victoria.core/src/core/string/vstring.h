@@ -1,7 +1,9 @@
 #pragma once
 
 #include "core/data/cowdata.h"
+#include "core/data/hashfuncs.h"
 #include "core/data/vector.h"
+#include "core/string/string_view.h"
 #include "core/typedefs.h"
 
 /**
@@ -10,43 +12,91 @@
  *      for localization to other languages (and proper Unicode support)
  */
 
+/**
+ * @brief An 8-bit string. Strings of up to `INLINE_CAPACITY` characters are stored inside the object itself, so the
+ * short names and labels that make up most strings in the engine never allocate. Longer strings are stored on the heap
+ * in a `CoWData<char>`, and are shared between copies until one of them is written to. Once a string has moved to the
+ * heap it stays there until it is cleared or shrunk to fit, so that a string being built up does not move back and
+ * forth.
+ * The hash of a string is calculated the first time it is needed and kept until the string changes, so looking up the
+ * same string in several hash tables only hashes it once.
+ */
 class VAPI String {
+public:
+	// The longest string, not counting the null terminator, that is stored without allocating.
+	static constexpr int INLINE_CAPACITY = 23;
+
 private:
-	CoWData<char> _data;
+	// Stored in `_inline_size` when the string is on the heap.
+	static constexpr uint8_t HEAP = 0xFF;
+
+	union {
+		char _inline[INLINE_CAPACITY + 1];
+		CoWData<char> _heap;
+	};
+	// The hash of the string, or 0 if it has not been calculated since the string last changed. Writing it from a
+	// const method is fine as every thread that hashes the same string would write the same value.
+	mutable uint32_t _hash = 0;
+	// The size of an inline string including its null terminator, which is 0 for an empty string, or `HEAP`.
+	uint8_t _inline_size = 0;
+
+	FORCE_INLINE bool _is_heap() const {
+		return _inline_size == HEAP;
+	}
+
+	void _copy(const String &p_from);
+	void _move(String &p_from);
+	void _free_heap();
+	Error _move_to_heap(int p_capacity);
 
 public:
 	FORCE_INLINE char *ptrw() {
-		return _data.ptrw();
+		_hash = 0;
+		if (_is_heap()) {
+			return _heap.ptrw();
+		}
+		return _inline_size ? _inline : nullptr;
 	}
 	FORCE_INLINE const char *ptr() const {
-		return _data.ptr();
-	}
-	FORCE_INLINE Error resize(int p_size) {
-		return _data.resize(p_size);
+		if (_is_heap()) {
+			return _heap.ptr();
+		}
+		return _inline_size ? _inline : nullptr;
 	}
+	Error resize(int p_size);
+	/**
+	 * @brief Reserves memory for a string of the given length (plus its null terminator), so that appending to the
+	 * string does not reallocate until that length is exceeded.
+	 * @param p_length The number of characters to reserve memory for
+	 * @return `OK` on success, and an error code if the memory could not be allocated.
+	 */
+	Error reserve(int p_length);
+	void shrink_to_fit();
 
 	FORCE_INLINE char get(int index) const {
-		return _data.get(index);
+		CRASH_OUT_OF_BOUNDS(index, size());
+		return ptr()[index];
 	}
 	FORCE_INLINE void set(int index, char p_item) {
-		_data.set(p_item, index);
+		CRASH_OUT_OF_BOUNDS(index, size());
+		ptrw()[index] = p_item;
 	}
 	FORCE_INLINE int size() const {
-		return _data.size();
-	}
-	FORCE_INLINE void clear() {
-		_data.clear();
+		return _is_heap() ? _heap.size() : _inline_size;
 	}
+	void clear();
 	FORCE_INLINE bool is_empty() const {
 		return length() == 0;
 	}
 
 	FORCE_INLINE char &operator[](int index) {
-		return _data.get(index);
+		CRASH_OUT_OF_BOUNDS(index, size());
+		return ptrw()[index];
 	}
 
 	FORCE_INLINE const char &operator[](int index) const {
-		return _data.get(index);
+		CRASH_OUT_OF_BOUNDS(index, size());
+		return ptr()[index];
 	}
 
 	FORCE_INLINE int length() const {
@@ -54,13 +104,38 @@ public:
 		return s ? (s - 1) : 0;
 	}
 
-	const char *get_data() const;
+	/**
+	 * @brief Obtains the hash of the string, calculating it only if the string has changed since it was last hashed.
+	 */
+	FORCE_INLINE uint32_t hash() const {
+		if (unlikely(_hash == 0)) {
+			_hash = hash_string(get_data(), length());
+		}
+		return _hash;
+	}
+
+	/**
+	 * @brief Whether the string is currently stored inline rather than on the heap.
+	 */
+	FORCE_INLINE bool is_inline() const {
+		return !_is_heap();
+	}
+
+	FORCE_INLINE const char *get_data() const {
+		const char *p = ptr();
+		return p ? p : "";
+	}
 
 	void operator=(const String &p_right);
 	void operator=(const char *p_right);
 
 	void operator=(String &&p_right) {
-		_data = std::move(p_right._data);
+		if (this == &p_right) {
+			return;
+		}
+
+		_free_heap();
+		_move(p_right);
 	}
 
 	bool operator==(const String &p_right) const;
@@ -90,6 +165,28 @@ public:
 	Vector<String> split(const String &delimiter) const;
 	String substr(int p_from, int p_chars) const;
 
+	/**
+	 * @brief Obtains a view of the whole string. The view is only valid until the string is next modified or freed.
+	 */
+	FORCE_INLINE StringView view() const {
+		return StringView(get_data(), length());
+	}
+
+	// Counterparts of the methods above that return views into the string instead of allocating new strings.
+
+	FORCE_INLINE StringView left_view(int p_count) const {
+		return view().left(p_count);
+	}
+	FORCE_INLINE StringView right_view(int p_count) const {
+		return view().right(p_count);
+	}
+	FORCE_INLINE StringView substr_view(int p_from, int p_chars = -1) const {
+		return view().substr(p_from, p_chars);
+	}
+	FORCE_INLINE StringView::SplitRange split_view(const StringView &p_delimiter, bool p_allow_empty = true) const {
+		return view().split(p_delimiter, p_allow_empty);
+	}
+
 	void replace(char p_value, char p_replacement);
 
 	String get_file() const;
@@ -104,22 +201,50 @@ public:
 		return get_data();
 	}
 
-	String(const String &p_from);
+	String(const String &p_from) {
+		_copy(p_from);
+	}
+	String(String &&p_from) {
+		_move(p_from);
+	}
 	String(const char *p_from) {
+		_inline[0] = 0;
 		copy_from(p_from);
 	}
 	String(const char p_from);
-	String() {}
+	explicit String(const StringView &p_from) {
+		_inline[0] = 0;
+		if (p_from.length() > 0) {
+			copy_from_unchecked(p_from.ptr(), p_from.length());
+		}
+	}
+	String() {
+		_inline[0] = 0;
+	}
+	~String() {
+		_free_heap();
+	}
 
 protected:
 	void copy_from(const char *p_str);
 	void copy_from_unchecked(const char *p_str, const int p_length);
+
+	friend String vformat(const char *p_string, ...);
 };
 
+FORCE_INLINE StringView::StringView(const String &p_str) {
+	_ptr = p_str.get_data();
+	_length = p_str.length();
+}
+
+uint32_t HasherDefault::hash(const String &p_key) {
+	return p_key.hash();
+}
+
 VAPI String operator+(const char *p_lhs, const String &p_rhs);
 VAPI String itos(int64_t p_int);
 VAPI String ftos(double p_double);
 
 VAPI String vformat(const char *p_string, ...);
 
-VAPI bool vstring_compare(const char *p_lhs, const char *p_rhs);
\ No newline at end of file
+VAPI bool vstring_compare(const char *p_lhs, const char *p_rhs);
@@ -187,7 +187,7 @@ Array::Array(const Array &p_from) {
 }
 
 Array::Array() {
-	_data = vnew(ArrayData);
+	_data = vnew_tagged(ArrayData, MEMORY_TAG_VARIANT);
 	_data->ref_count.set(1);
 }
 
@@ -1,39 +1,58 @@
 #include "core/variant/variant.h"
 
-void Variant::_clear_internals() {
-	switch (type) {
-		case STRING: {
-			reinterpret_cast<String *>(_data._mem)->~String();
-		} break;
-		case ARRAY: {
-			reinterpret_cast<Array *>(_data._mem)->~Array();
-		} break;
-		case BYTE_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case INT32_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case INT64_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case FLOAT32_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case FLOAT64_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case VECTOR2_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case VECTOR3_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		case VECTOR4_ARRAY: {
-			ArrayRefBase::destroy(_data._array);
-		} break;
-		default: {
-		} break;
+#include "core/variant/variant_internal.h"
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+typedef void (*VariantConstructFunc)(Variant &r_variant);
+typedef void (*VariantCopyFunc)(Variant &r_variant, const Variant &p_from);
+typedef void (*VariantDestroyFunc)(Variant &r_variant);
+typedef String (*VariantStringifyFunc)(const Variant &p_variant, int recursion_count);
+typedef uint32_t (*VariantHashFunc)(const Variant &p_variant, int recursion_count);
+typedef bool (*VariantEqualFunc)(const Variant &p_a, const Variant &p_b, int recursion_count);
+typedef void (*VariantConvertFunc)(const Variant &p_from, void *r_to);
+typedef bool (*VariantEvaluateFunc)(const Variant &p_a, const Variant &p_b, Variant &r_ret);
+
+template <Variant::Type T>
+using VariantType = typename VariantTypeInfo<T>::Type;
+
+static constexpr bool variant_is_number(Variant::Type p_type) {
+	return p_type == Variant::BOOL || p_type == Variant::INT || p_type == Variant::FLOAT;
+}
+
+static constexpr bool variant_is_vector(Variant::Type p_type) {
+	return p_type >= Variant::VECTOR2 && p_type <= Variant::VECTOR4I;
+}
+
+static constexpr bool variant_is_typed_array(Variant::Type p_type) {
+	return p_type >= Variant::BYTE_ARRAY && p_type < Variant::VARIANT_MAX;
+}
+
+// The type and number of the components of a vector type.
+template <typename V>
+using VectorComponent = std::remove_all_extents_t<decltype(V::elements)>;
+
+template <typename V>
+static constexpr int vector_size_v = sizeof(V::elements) / sizeof(V::elements[0]);
+
+template <typename T>
+static constexpr bool is_math_vector_v = std::is_same_v<T, Vector2> || std::is_same_v<T, Vector2i> ||
+										 std::is_same_v<T, Vector3> || std::is_same_v<T, Vector3i> ||
+										 std::is_same_v<T, Vector4> || std::is_same_v<T, Vector4i>;
+
+template <typename T>
+static FORCE_INLINE bool values_equal(const T &p_a, const T &p_b) {
+	if constexpr (is_math_vector_v<T>) {
+		for (int i = 0; i < vector_size_v<T>; i++) {
+			if (p_a.elements[i] != p_b.elements[i]) {
+				return false;
+			}
+		}
+		return true;
+	} else {
+		return p_a == p_b;
 	}
 }
 
@@ -57,420 +76,400 @@ String stringify_vector(const T &p_vec, int recursion_count) {
 	return ret;
 }
 
-String Variant::stringify(int recursion_count) const {
-	switch (type) {
-		case NIL:
-			return "<null>";
-		case BOOL:
-			return _data._bool ? "true" : "false";
-		case INT:
-			return itos(_data._int);
-		case FLOAT:
-			return ftos(_data._float);
-		case STRING:
-			return *reinterpret_cast<const String *>(_data._mem);
-		case VECTOR2:
-			return operator Vector2();
-		case VECTOR2I:
-			return operator Vector2i();
-		case VECTOR3:
-			return operator Vector3();
-		case VECTOR3I:
-			return operator Vector3i();
-		case VECTOR4:
-			return operator Vector4();
-		case VECTOR4I:
-			return operator Vector4i();
-		case ARRAY: {
-			ERR_FAIL_COND_MSG_R(recursion_count > 1024, "Do not self-assign arrays.", String());
-
-			recursion_count++;
-			return stringify_vector(operator Array(), recursion_count);
-		}
-		case BYTE_ARRAY:
-			return stringify_vector(operator ByteArray(), recursion_count);
-		case INT32_ARRAY:
-			return stringify_vector(operator Int32Array(), recursion_count);
-		case INT64_ARRAY:
-			return stringify_vector(operator Int64Array(), recursion_count);
-		case FLOAT32_ARRAY:
-			return stringify_vector(operator Float32Array(), recursion_count);
-		case FLOAT64_ARRAY:
-			return stringify_vector(operator Float64Array(), recursion_count);
-		case VECTOR2_ARRAY:
-			return stringify_vector(operator Vector2Array(), recursion_count);
-		case VECTOR3_ARRAY:
-			return stringify_vector(operator Vector3Array(), recursion_count);
-		case VECTOR4_ARRAY:
-			return stringify_vector(operator Vector4Array(), recursion_count);
-		default:
-			return "";
+/* Functions for each type, which are put into the tables below */
+
+template <Variant::Type T>
+static String variant_stringify(const Variant &p_variant, int recursion_count) {
+	if constexpr (T == Variant::NIL) {
+		return "<null>";
+	} else if constexpr (T == Variant::BOOL) {
+		return *VariantInternal::get_ptr<T>(p_variant) ? "true" : "false";
+	} else if constexpr (T == Variant::INT) {
+		return itos(*VariantInternal::get_ptr<T>(p_variant));
+	} else if constexpr (T == Variant::FLOAT) {
+		return ftos(*VariantInternal::get_ptr<T>(p_variant));
+	} else if constexpr (T == Variant::STRING || variant_is_vector(T)) {
+		return *VariantInternal::get_ptr<T>(p_variant);
+	} else if constexpr (T == Variant::ARRAY) {
+		ERR_FAIL_COND_MSG_R(recursion_count > 1024, "Do not self-assign arrays.", String());
+
+		recursion_count++;
+		return stringify_vector(*VariantInternal::get_ptr<T>(p_variant), recursion_count);
+	} else {
+		return stringify_vector(*VariantInternal::get_ptr<T>(p_variant), recursion_count);
 	}
 }
 
-void Variant::_ref(const Variant &p_other) {
-	clear();
+template <Variant::Type T>
+static uint32_t variant_hash(const Variant &p_variant, int recursion_count) {
+	if constexpr (T == Variant::NIL) {
+		return 0;
+	} else if constexpr (T == Variant::BOOL) {
+		return HasherDefault::hash((uint32_t)*VariantInternal::get_ptr<T>(p_variant));
+	} else if constexpr (T == Variant::ARRAY) {
+		ERR_FAIL_COND_MSG_R(recursion_count > 1024, "Do not self-assign arrays.", 0);
 
-	type = p_other.type;
+		const Array &array = *VariantInternal::get_ptr<T>(p_variant);
+		uint64_t h = HASH_SECRET[0];
+		for (int64_t i = 0; i < array.size(); i++) {
+			h = hash_combine(h, array[i].recursive_hash(recursion_count + 1));
+		}
+		return hash_fold(h);
+	} else if constexpr (variant_is_typed_array(T)) {
+		const VariantType<T> &array = *VariantInternal::get_ptr<T>(p_variant);
+		uint64_t h = HASH_SECRET[0];
+		for (int64_t i = 0; i < array.size(); i++) {
+			h = hash_combine(h, HasherDefault::hash(array[i]));
+		}
+		return hash_fold(h);
+	} else {
+		return HasherDefault::hash(*VariantInternal::get_ptr<T>(p_variant));
+	}
+}
 
-	switch (type) {
-		case NIL: {
-		} break;
-		case BOOL: {
-			_data._bool = p_other._data._bool;
-		} break;
-		case INT: {
-			_data._int = p_other._data._int;
-		} break;
-		case FLOAT: {
-			_data._float = p_other._data._float;
-		} break;
-		case STRING: {
-			vnew_placement(_data._mem, String(*reinterpret_cast<const String *>(p_other._data._mem)));
-		} break;
-		case VECTOR2: {
-			vnew_placement(_data._mem, Vector2(*reinterpret_cast<const Vector2 *>(p_other._data._mem)));
-		} break;
-		case VECTOR2I: {
-			vnew_placement(_data._mem, Vector2i(*reinterpret_cast<const Vector2i *>(p_other._data._mem)));
-		} break;
-		case VECTOR3: {
-			vnew_placement(_data._mem, Vector3(*reinterpret_cast<const Vector3 *>(p_other._data._mem)));
-		} break;
-		case VECTOR3I: {
-			vnew_placement(_data._mem, Vector3i(*reinterpret_cast<const Vector3i *>(p_other._data._mem)));
-		} break;
-		case VECTOR4: {
-			vnew_placement(_data._mem, Vector4(*reinterpret_cast<const Vector4 *>(p_other._data._mem)));
-		} break;
-		case VECTOR4I: {
-			vnew_placement(_data._mem, Vector4i(*reinterpret_cast<const Vector4i *>(p_other._data._mem)));
-		} break;
-
-		case ARRAY: {
-			vnew_placement(_data._mem, Array(*reinterpret_cast<const Array *>(p_other._data._mem)));
-		} break;
-		case BYTE_ARRAY: {
-			_data._array = static_cast<ArrayRef<uint8_t> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<uint8_t>::create();
-			}
-		} break;
-		case INT32_ARRAY: {
-			_data._array = static_cast<ArrayRef<int32_t> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<int32_t>::create();
-			}
-		} break;
-		case INT64_ARRAY: {
-			_data._array = static_cast<ArrayRef<int64_t> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<int64_t>::create();
-			}
-		} break;
-		case FLOAT32_ARRAY: {
-			_data._array = static_cast<ArrayRef<float> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<float>::create();
-			}
-		} break;
-		case FLOAT64_ARRAY: {
-			_data._array = static_cast<ArrayRef<double> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<double>::create();
-			}
-		} break;
-		case VECTOR2_ARRAY: {
-			_data._array = static_cast<ArrayRef<Vector2> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<Vector2>::create();
-			}
-		} break;
-		case VECTOR3_ARRAY: {
-			_data._array = static_cast<ArrayRef<Vector3> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<Vector3>::create();
-			}
-		} break;
-		case VECTOR4_ARRAY: {
-			_data._array = static_cast<ArrayRef<Vector4> *>(p_other._data._array)->reference();
-			if (!_data._array) {
-				_data._array = ArrayRef<Vector4>::create();
+// Values of different types are never equal, so only the functions on the diagonal of the table compare anything.
+template <Variant::Type A, Variant::Type B>
+static bool variant_equal(const Variant &p_a, const Variant &p_b, int recursion_count) {
+	if constexpr (A != B) {
+		return false;
+	} else if constexpr (A == Variant::NIL) {
+		return true;
+	} else if constexpr (A == Variant::ARRAY) {
+		return VariantInternal::get_ptr<A>(p_a)->is_equal(*VariantInternal::get_ptr<B>(p_b));
+	} else if constexpr (variant_is_typed_array(A)) {
+		const VariantType<A> &l = *VariantInternal::get_ptr<A>(p_a);
+		const VariantType<B> &r = *VariantInternal::get_ptr<B>(p_b);
+		if (l.size() != r.size()) {
+			return false;
+		}
+		for (int64_t i = 0; i < l.size(); i++) {
+			if (!values_equal(l[i], r[i])) {
+				return false;
 			}
-		} break;
-		default: {
 		}
+		return true;
+	} else {
+		return values_equal(*VariantInternal::get_ptr<A>(p_a), *VariantInternal::get_ptr<B>(p_b));
 	}
 }
 
-void Variant::operator=(const Variant &p_var) {
-	if (type != p_var.type) {
-		_ref(p_var);
-		return;
+static constexpr bool variant_can_convert(Variant::Type p_to, Variant::Type p_from) {
+	if (p_to == Variant::NIL || p_from == Variant::NIL) {
+		return p_to == Variant::STRING;
+	}
+	if (p_to == p_from || p_to == Variant::STRING) {
+		return true;
 	}
-	type = p_var.type;
-
-	switch (p_var.type) {
-		case NIL: {
-			_data._ptr = nullptr;
-		} break;
-		case BOOL: {
-			_data._bool = p_var._data._bool;
-		} break;
-		case INT: {
-			_data._int = p_var._data._int;
-		} break;
-		case FLOAT: {
-			_data._float = p_var._data._float;
-		} break;
-		case STRING: {
-			*reinterpret_cast<String *>(_data._mem) = *reinterpret_cast<const String *>(p_var._data._mem);
-		} break;
-		case VECTOR2: {
-			*reinterpret_cast<Vector2 *>(_data._mem) = *reinterpret_cast<const Vector2 *>(p_var._data._mem);
-		} break;
-		case VECTOR2I: {
-			*reinterpret_cast<Vector2i *>(_data._mem) = *reinterpret_cast<const Vector2i *>(p_var._data._mem);
-		} break;
-		case VECTOR3: {
-			*reinterpret_cast<Vector3 *>(_data._mem) = *reinterpret_cast<const Vector3 *>(p_var._data._mem);
-		} break;
-		case VECTOR3I: {
-			*reinterpret_cast<Vector3i *>(_data._mem) = *reinterpret_cast<const Vector3i *>(p_var._data._mem);
-		} break;
-		case VECTOR4: {
-			*reinterpret_cast<Vector4 *>(_data._mem) = *reinterpret_cast<const Vector4 *>(p_var._data._mem);
-		} break;
-		case VECTOR4I: {
-			*reinterpret_cast<Vector4i *>(_data._mem) = *reinterpret_cast<const Vector4i *>(p_var._data._mem);
-		} break;
-		// NOTE: We use reinterpret_cast because the various datatypes that exist share the same memory area, therefore
-		// we need to set it to an array pointer before we copy in the data to its location. If the data isn't an array
-		// pointer, we can't use it in its current form and so the casting needs to happen first.
-		case ARRAY: {
-			*reinterpret_cast<Array *>(_data._mem) = *reinterpret_cast<const Array *>(p_var._data._mem);
-		} break;
-		default:
-			break;
+	if (variant_is_number(p_to) && variant_is_number(p_from)) {
+		return true;
 	}
+	return variant_is_vector(p_to) && variant_is_vector(p_from);
 }
 
-bool Variant::operator==(const Variant &other) const {
-	return hash_compare(other, 0);
+// Writes the value of `p_from` converted to the type `TO` into `r_to`, which already holds the default value of `TO`.
+template <Variant::Type TO, Variant::Type FROM>
+static void variant_convert(const Variant &p_from, void *r_to) {
+	VariantType<TO> &to = *static_cast<VariantType<TO> *>(r_to);
+	if constexpr (TO == Variant::STRING) {
+		to = variant_stringify<FROM>(p_from, 0);
+	} else if constexpr (TO == FROM) {
+		to = *VariantInternal::get_ptr<FROM>(p_from);
+	} else if constexpr (TO == Variant::BOOL) {
+		to = *VariantInternal::get_ptr<FROM>(p_from) ? true : false;
+	} else if constexpr (variant_is_number(TO)) {
+		to = (VariantType<TO>)*VariantInternal::get_ptr<FROM>(p_from);
+	} else {
+		// Components the source does not have are left at zero.
+		typedef VariantType<TO> To;
+		typedef VariantType<FROM> From;
+		const From &from = *VariantInternal::get_ptr<FROM>(p_from);
+		constexpr int size = vector_size_v<To> < vector_size_v<From> ? vector_size_v<To> : vector_size_v<From>;
+		for (int i = 0; i < size; i++) {
+			to.elements[i] = (VectorComponent<To>)from.elements[i];
+		}
+	}
 }
 
-bool Variant::hash_compare(const Variant &p_other, int recursion_count) const {
-	if (type != p_other.type) {
-		return false;
-	}
+static void variant_convert_none(const Variant &p_from, void *r_to) {}
 
-	switch (type) {
-		case BOOL: {
-			return _data._bool == p_other._data._bool;
-		} break;
-		case INT: {
-			return _data._int == p_other._data._int;
-		} break;
-		case FLOAT: {
-			return _data._float == p_other._data._float;
-		} break;
-		case ARRAY: {
-			const Array &l = *(reinterpret_cast<const Array *>(_data._mem));
-			const Array &r = *(reinterpret_cast<const Array *>(p_other._data._mem));
-			if (!l.is_equal(r)) {
+// Applies an operator to two values of the same arithmetic type. Integer division by zero cannot be done, and neither
+// can dividing the smallest signed integer by -1, as the result does not fit.
+template <Variant::Operator OP, typename T>
+static FORCE_INLINE bool apply_operator(T p_a, T p_b, T &r_ret) {
+	if constexpr (OP == Variant::OP_ADD) {
+		r_ret = p_a + p_b;
+	} else if constexpr (OP == Variant::OP_SUBTRACT) {
+		r_ret = p_a - p_b;
+	} else if constexpr (OP == Variant::OP_MULTIPLY) {
+		r_ret = p_a * p_b;
+	} else {
+		if constexpr (std::is_integral_v<T>) {
+			if (p_b == 0) {
 				return false;
 			}
-
-			return true;
-		} break;
-		case STRING: {
-			const String &l = *(reinterpret_cast<const String *>(_data._mem));
-			const String &r = *(reinterpret_cast<const String *>(p_other._data._mem));
-			if (l != r) {
-				return false;
+			if constexpr (std::is_signed_v<T>) {
+				if (p_a == std::numeric_limits<T>::min() && p_b == -1) {
+					return false;
+				}
 			}
+		}
+		r_ret = p_a / p_b;
+	}
+	return true;
+}
 
-			return true;
-		} break;
-		default:
-			return false;
+template <Variant::Operator OP, Variant::Type A, Variant::Type B>
+static bool variant_evaluate_numbers(const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+	typedef std::conditional_t<A == Variant::INT && B == Variant::INT, int64_t, double> R;
+	R ret;
+	if (!apply_operator<OP, R>((R)*VariantInternal::get_ptr<A>(p_a),
+							   (R)*VariantInternal::get_ptr<B>(p_b),
+							   ret)) {
+		return false;
 	}
+
+	r_ret = ret;
+	return true;
 }
 
-Variant::operator bool() const {
-	switch (type) {
-		case NIL:
-			return false;
-		case BOOL:
-			return _data._bool;
-		case INT:
-			return _data._int ? true : false;
-		case FLOAT:
-			return _data._float ? true : false;
-		default: {
+static bool variant_evaluate_strings(const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+	String ret = *VariantInternal::get_ptr<Variant::STRING>(p_a);
+	ret += *VariantInternal::get_ptr<Variant::STRING>(p_b);
+	r_ret = ret;
+	return true;
+}
+
+template <Variant::Operator OP, Variant::Type V>
+static bool variant_evaluate_vectors(const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+	typedef VariantType<V> Vec;
+	const Vec &a = *VariantInternal::get_ptr<V>(p_a);
+	const Vec &b = *VariantInternal::get_ptr<V>(p_b);
+	Vec ret;
+	for (int i = 0; i < vector_size_v<Vec>; i++) {
+		if (!apply_operator<OP, VectorComponent<Vec>>(a.elements[i], b.elements[i], ret.elements[i])) {
 			return false;
 		}
 	}
+
+	r_ret = ret;
+	return true;
 }
 
-Variant::operator int8_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
+// Applies the operator to each component of a vector and a number. The vector keeps its type, so integer vectors
+// scaled by a float are truncated.
+template <Variant::Operator OP, Variant::Type V, Variant::Type S, bool SCALAR_FIRST>
+static bool variant_evaluate_vector_scalar(const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+	typedef VariantType<V> Vec;
+	typedef VectorComponent<Vec> C;
+	typedef std::conditional_t<std::is_integral_v<C> && S == Variant::INT, int64_t, double> R;
+	const Vec &v = *VariantInternal::get_ptr<V>(SCALAR_FIRST ? p_b : p_a);
+	const R s = (R)*VariantInternal::get_ptr<S>(SCALAR_FIRST ? p_a : p_b);
+	Vec ret;
+	for (int i = 0; i < vector_size_v<Vec>; i++) {
+		R value;
+		if (!apply_operator<OP, R>((R)v.elements[i], s, value)) {
+			return false;
 		}
+		ret.elements[i] = (C)value;
+	}
+
+	r_ret = ret;
+	return true;
+}
+
+template <Variant::Operator OP, Variant::Type A, Variant::Type B>
+static constexpr VariantEvaluateFunc get_evaluate_func() {
+	constexpr bool a_number = A == Variant::INT || A == Variant::FLOAT;
+	constexpr bool b_number = B == Variant::INT || B == Variant::FLOAT;
+	constexpr bool scales = OP == Variant::OP_MULTIPLY || OP == Variant::OP_DIVIDE;
+	if constexpr (a_number && b_number) {
+		return &variant_evaluate_numbers<OP, A, B>;
+	} else if constexpr (OP == Variant::OP_ADD && A == Variant::STRING && B == Variant::STRING) {
+		return &variant_evaluate_strings;
+	} else if constexpr (variant_is_vector(A) && A == B) {
+		return &variant_evaluate_vectors<OP, A>;
+	} else if constexpr (variant_is_vector(A) && b_number && scales) {
+		return &variant_evaluate_vector_scalar<OP, A, B, false>;
+	} else if constexpr (a_number && variant_is_vector(B) && OP == Variant::OP_MULTIPLY) {
+		return &variant_evaluate_vector_scalar<OP, B, A, true>;
+	} else {
+		return nullptr;
 	}
 }
 
-Variant::operator int16_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
+template <Variant::Type TO, Variant::Type FROM>
+static constexpr VariantConvertFunc get_convert_func() {
+	if constexpr (variant_can_convert(TO, FROM)) {
+		return &variant_convert<TO, FROM>;
+	} else {
+		return &variant_convert_none;
+	}
+}
+
+/* Dispatch tables */
+
+// Every table is filled in at compile time from the templates above, so they are ready before any static `Variant` is
+// constructed and dispatching on a type is a single indirect call instead of a `switch`.
+
+struct VariantTypeFuncs {
+	VariantConstructFunc construct[Variant::VARIANT_MAX];
+	VariantCopyFunc copy_construct[Variant::VARIANT_MAX];
+	VariantCopyFunc assign[Variant::VARIANT_MAX];
+	VariantDestroyFunc destroy[Variant::VARIANT_MAX];
+	VariantStringifyFunc stringify[Variant::VARIANT_MAX];
+	VariantHashFunc hash[Variant::VARIANT_MAX];
+};
+
+struct VariantTypePairFuncs {
+	VariantEqualFunc equal[Variant::VARIANT_MAX][Variant::VARIANT_MAX];		// Indexed by [left][right]
+	VariantConvertFunc convert[Variant::VARIANT_MAX][Variant::VARIANT_MAX];	// Indexed by [to][from]
+};
+
+struct VariantOperatorFuncs {
+	// Indexed by [operator][left][right], and `nullptr` where the operator does not apply to the types.
+	VariantEvaluateFunc evaluate[Variant::OP_MAX][Variant::VARIANT_MAX][Variant::VARIANT_MAX];
+};
+
+template <std::size_t... Is>
+static constexpr VariantTypeFuncs make_type_funcs(std::index_sequence<Is...>) {
+	return VariantTypeFuncs{
+		{&VariantInternal::construct<(Variant::Type)Is>...},
+		{&VariantInternal::copy_construct<(Variant::Type)Is>...},
+		{&VariantInternal::assign<(Variant::Type)Is>...},
+		{&VariantInternal::destroy<(Variant::Type)Is>...},
+		{&variant_stringify<(Variant::Type)Is>...},
+		{&variant_hash<(Variant::Type)Is>...},
+	};
+}
+
+template <std::size_t... Is>
+static constexpr VariantTypePairFuncs make_type_pair_funcs(std::index_sequence<Is...>) {
+	return VariantTypePairFuncs{
+		{&variant_equal<(Variant::Type)(Is / Variant::VARIANT_MAX), (Variant::Type)(Is % Variant::VARIANT_MAX)>...},
+		{get_convert_func<(Variant::Type)(Is / Variant::VARIANT_MAX),
+						  (Variant::Type)(Is % Variant::VARIANT_MAX)>()...},
+	};
+}
+
+template <std::size_t... Is>
+static constexpr VariantOperatorFuncs make_operator_funcs(std::index_sequence<Is...>) {
+	constexpr std::size_t pairs = Variant::VARIANT_MAX * Variant::VARIANT_MAX;
+	return VariantOperatorFuncs{
+		{get_evaluate_func<(Variant::Operator)(Is / pairs),
+						   (Variant::Type)(Is % pairs / Variant::VARIANT_MAX),
+						   (Variant::Type)(Is % Variant::VARIANT_MAX)>()...},
+	};
+}
+
+static constexpr VariantTypeFuncs type_funcs = make_type_funcs(std::make_index_sequence<Variant::VARIANT_MAX>());
+static constexpr VariantTypePairFuncs type_pair_funcs =
+	make_type_pair_funcs(std::make_index_sequence<Variant::VARIANT_MAX * Variant::VARIANT_MAX>());
+static constexpr VariantOperatorFuncs operator_funcs =
+	make_operator_funcs(std::make_index_sequence<Variant::OP_MAX * Variant::VARIANT_MAX * Variant::VARIANT_MAX>());
+
+template <Variant::Type T>
+static FORCE_INLINE VariantType<T> convert_to(const Variant &p_variant) {
+	VariantType<T> ret = VariantType<T>();
+	type_pair_funcs.convert[T][p_variant.get_type()](p_variant, &ret);
+	return ret;
+}
+
+void Variant::_clear_internals() {
+	type_funcs.destroy[type](*this);
+}
+
+String Variant::stringify(int recursion_count) const {
+	return type_funcs.stringify[type](*this, recursion_count);
+}
+
+Variant Variant::construct(Type p_type) {
+	Variant ret;
+	ERR_FAIL_COND_R(p_type < NIL || p_type >= VARIANT_MAX, ret);
+	type_funcs.construct[p_type](ret);
+	ret.type = p_type;
+	return ret;
+}
+
+bool Variant::evaluate(Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+	ERR_FAIL_COND_R(p_op < OP_ADD || p_op >= OP_MAX, false);
+	VariantEvaluateFunc func = operator_funcs.evaluate[p_op][p_a.type][p_b.type];
+	return func && func(p_a, p_b, r_ret);
+}
+
+uint32_t Variant::hash() const {
+	return recursive_hash(0);
+}
+
+uint32_t Variant::recursive_hash(int recursion_count) const {
+	return type_funcs.hash[type](*this, recursion_count);
+}
+
+void Variant::_ref(const Variant &p_other) {
+	clear();
+
+	type_funcs.copy_construct[p_other.type](*this, p_other);
+	type = p_other.type;
+}
+
+void Variant::operator=(const Variant &p_var) {
+	if (type != p_var.type) {
+		_ref(p_var);
+		return;
 	}
+
+	type_funcs.assign[type](*this, p_var);
+}
+
+bool Variant::operator==(const Variant &other) const {
+	return hash_compare(other, 0);
+}
+
+bool Variant::hash_compare(const Variant &p_other, int recursion_count) const {
+	return type_pair_funcs.equal[type][p_other.type](*this, p_other, recursion_count);
+}
+
+Variant::operator bool() const {
+	return convert_to<BOOL>(*this);
+}
+
+Variant::operator int8_t() const {
+	return convert_to<INT>(*this);
+}
+
+Variant::operator int16_t() const {
+	return convert_to<INT>(*this);
 }
 
 Variant::operator int32_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
-	}
+	return convert_to<INT>(*this);
 }
 
 Variant::operator int64_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
-	}
+	return convert_to<INT>(*this);
 }
 
 Variant::operator uint64_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
-	}
+	return convert_to<INT>(*this);
 }
 
 Variant::operator uint32_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
-	}
+	return convert_to<INT>(*this);
 }
 
 Variant::operator uint16_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
-	}
+	return convert_to<INT>(*this);
 }
 
 Variant::operator uint8_t() const {
-	switch (type) {
-		case NIL:
-			return 0;
-		case BOOL:
-			return _data._bool ? 1 : 0;
-		case INT:
-			return _data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0;
-		}
-	}
+	return convert_to<INT>(*this);
 }
 
 Variant::operator float() const {
-	switch (type) {
-		case NIL:
-			return 0.0;
-		case BOOL:
-			return _data._bool ? 1.0 : 0.0;
-		case INT:
-			return (float)_data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0.0;
-		}
-	}
+	return convert_to<FLOAT>(*this);
 }
 
 Variant::operator double() const {
-	switch (type) {
-		case NIL:
-			return 0.0;
-		case BOOL:
-			return _data._bool ? 1.0 : 0.0;
-		case INT:
-			return (double)_data._int;
-		case FLOAT:
-			return _data._float;
-		default: {
-			return 0.0;
-		}
-	}
+	return convert_to<FLOAT>(*this);
 }
 
 Variant::operator String() const {
@@ -478,279 +477,63 @@ Variant::operator String() const {
 }
 
 Variant::operator Vector2() const {
-	switch (type) {
-		case VECTOR2: {
-			return *reinterpret_cast<const Vector2 *>(_data._mem);
-		};
-		case VECTOR2I: {
-			return *reinterpret_cast<const Vector2i *>(_data._mem);
-		};
-		case VECTOR3: {
-			return Vector2(reinterpret_cast<const Vector3 *>(_data._mem)->x,
-						   reinterpret_cast<const Vector3 *>(_data._mem)->y);
-		};
-		case VECTOR3I: {
-			return Vector2(reinterpret_cast<const Vector3i *>(_data._mem)->x,
-						   reinterpret_cast<const Vector3i *>(_data._mem)->y);
-		};
-		case VECTOR4: {
-			return Vector2(reinterpret_cast<const Vector4 *>(_data._mem)->x,
-						   reinterpret_cast<const Vector4 *>(_data._mem)->y);
-		};
-		case VECTOR4I: {
-			return Vector2(reinterpret_cast<const Vector4i *>(_data._mem)->x,
-						   reinterpret_cast<const Vector4i *>(_data._mem)->y);
-		};
-		default: {
-			return Vector2();
-		};
-	}
+	return convert_to<VECTOR2>(*this);
 }
 
 Variant::operator Vector2i() const {
-	switch (type) {
-		case VECTOR2: {
-			return *reinterpret_cast<const Vector2 *>(_data._mem);
-		};
-		case VECTOR2I: {
-			return *reinterpret_cast<const Vector2i *>(_data._mem);
-		};
-		case VECTOR3: {
-			return Vector2i(reinterpret_cast<const Vector3 *>(_data._mem)->x,
-							reinterpret_cast<const Vector3 *>(_data._mem)->y);
-		};
-		case VECTOR3I: {
-			return Vector2i(reinterpret_cast<const Vector3i *>(_data._mem)->x,
-							reinterpret_cast<const Vector3i *>(_data._mem)->y);
-		};
-		case VECTOR4: {
-			return Vector2i(reinterpret_cast<const Vector4 *>(_data._mem)->x,
-							reinterpret_cast<const Vector4 *>(_data._mem)->y);
-		};
-		case VECTOR4I: {
-			return Vector2i(reinterpret_cast<const Vector4i *>(_data._mem)->x,
-							reinterpret_cast<const Vector4i *>(_data._mem)->y);
-		};
-		default: {
-			return Vector2i();
-		};
-	}
+	return convert_to<VECTOR2I>(*this);
 }
 
 Variant::operator Vector3() const {
-	switch (type) {
-		case VECTOR2: {
-			return Vector3(reinterpret_cast<const Vector2 *>(_data._mem)->x,
-						   reinterpret_cast<const Vector2 *>(_data._mem)->y,
-						   0.0);
-		};
-		case VECTOR2I: {
-			return Vector3(reinterpret_cast<const Vector2i *>(_data._mem)->x,
-						   reinterpret_cast<const Vector2i *>(_data._mem)->y,
-						   0.0);
-		};
-		case VECTOR3: {
-			return *reinterpret_cast<const Vector3 *>(_data._mem);
-		};
-		case VECTOR3I: {
-			return *reinterpret_cast<const Vector3i *>(_data._mem);
-		};
-		case VECTOR4: {
-			return Vector3(reinterpret_cast<const Vector4 *>(_data._mem)->x,
-						   reinterpret_cast<const Vector4 *>(_data._mem)->y,
-						   reinterpret_cast<const Vector4 *>(_data._mem)->z);
-		};
-		case VECTOR4I: {
-			return Vector3(reinterpret_cast<const Vector4i *>(_data._mem)->x,
-						   reinterpret_cast<const Vector4i *>(_data._mem)->y,
-						   reinterpret_cast<const Vector4i *>(_data._mem)->z);
-		};
-		default: {
-			return Vector3();
-		}
-	}
+	return convert_to<VECTOR3>(*this);
 }
 
 Variant::operator Vector3i() const {
-	switch (type) {
-		case VECTOR2: {
-			return Vector3i(reinterpret_cast<const Vector2 *>(_data._mem)->x,
-							reinterpret_cast<const Vector2 *>(_data._mem)->y,
-							0);
-		};
-		case VECTOR2I: {
-			return Vector3i(reinterpret_cast<const Vector2i *>(_data._mem)->x,
-							reinterpret_cast<const Vector2i *>(_data._mem)->y,
-							0);
-		};
-		case VECTOR3: {
-			return *reinterpret_cast<const Vector3 *>(_data._mem);
-		};
-		case VECTOR3I: {
-			return *reinterpret_cast<const Vector3i *>(_data._mem);
-		};
-		case VECTOR4: {
-			return Vector3i(reinterpret_cast<const Vector4 *>(_data._mem)->x,
-							reinterpret_cast<const Vector4 *>(_data._mem)->y,
-							reinterpret_cast<const Vector4 *>(_data._mem)->z);
-		};
-		case VECTOR4I: {
-			return Vector3i(reinterpret_cast<const Vector4i *>(_data._mem)->x,
-							reinterpret_cast<const Vector4i *>(_data._mem)->y,
-							reinterpret_cast<const Vector4i *>(_data._mem)->z);
-		};
-		default: {
-			return Vector3i();
-		}
-	}
+	return convert_to<VECTOR3I>(*this);
 }
 
 Variant::operator Vector4() const {
-	switch (type) {
-		case VECTOR2: {
-			return Vector4(reinterpret_cast<const Vector2 *>(_data._mem)->x,
-						   reinterpret_cast<const Vector2 *>(_data._mem)->y,
-						   0.0,
-						   0.0);
-		};
-		case VECTOR2I: {
-			return Vector4(reinterpret_cast<const Vector2i *>(_data._mem)->x,
-						   reinterpret_cast<const Vector2i *>(_data._mem)->y,
-						   0.0,
-						   0.0);
-		};
-		case VECTOR3: {
-			return Vector4(reinterpret_cast<const Vector3 *>(_data._mem)->x,
-						   reinterpret_cast<const Vector3 *>(_data._mem)->y,
-						   reinterpret_cast<const Vector3 *>(_data._mem)->z,
-						   0.0);
-		};
-		case VECTOR3I: {
-			return Vector4(reinterpret_cast<const Vector3i *>(_data._mem)->x,
-						   reinterpret_cast<const Vector3i *>(_data._mem)->y,
-						   reinterpret_cast<const Vector3i *>(_data._mem)->z,
-						   0.0);
-		};
-		case VECTOR4: {
-			return *reinterpret_cast<const Vector4 *>(_data._mem);
-		};
-		case VECTOR4I: {
-			return *reinterpret_cast<const Vector4i *>(_data._mem);
-		};
-		default: {
-			return Vector4();
-		}
-	}
+	return convert_to<VECTOR4>(*this);
 }
 
 Variant::operator Vector4i() const {
-	switch (type) {
-		case VECTOR2: {
-			return Vector4i(reinterpret_cast<const Vector2 *>(_data._mem)->x,
-							reinterpret_cast<const Vector2 *>(_data._mem)->y,
-							0,
-							0);
-		};
-		case VECTOR2I: {
-			return Vector4i(reinterpret_cast<const Vector2i *>(_data._mem)->x,
-							reinterpret_cast<const Vector2i *>(_data._mem)->y,
-							0,
-							0);
-		};
-		case VECTOR3: {
-			return Vector4i(reinterpret_cast<const Vector3 *>(_data._mem)->x,
-							reinterpret_cast<const Vector3 *>(_data._mem)->y,
-							reinterpret_cast<const Vector3 *>(_data._mem)->z,
-							0);
-		};
-		case VECTOR3I: {
-			return Vector4i(reinterpret_cast<const Vector3i *>(_data._mem)->x,
-							reinterpret_cast<const Vector3i *>(_data._mem)->y,
-							reinterpret_cast<const Vector3i *>(_data._mem)->z,
-							0);
-		};
-		case VECTOR4: {
-			return *reinterpret_cast<const Vector4 *>(_data._mem);
-		};
-		case VECTOR4I: {
-			return *reinterpret_cast<const Vector4i *>(_data._mem);
-		};
-		default: {
-			return Vector4i();
-		}
-	}
+	return convert_to<VECTOR4I>(*this);
 }
 
 Variant::operator Array() const {
-	if (type == ARRAY) {
-		return *reinterpret_cast<const Array *>(_data._mem);
-	} else {
-		return Array();
-	}
+	return convert_to<ARRAY>(*this);
 }
 
 Variant::operator ByteArray() const {
-	if (type == BYTE_ARRAY) {
-		return static_cast<ArrayRef<uint8_t> *>(_data._array)->array;
-	} else {
-		return Vector<uint8_t>();
-	}
+	return convert_to<BYTE_ARRAY>(*this);
 }
 
 Variant::operator Int32Array() const {
-	if (type == INT32_ARRAY) {
-		return static_cast<ArrayRef<int32_t> *>(_data._array)->array;
-	} else {
-		return Vector<int32_t>();
-	}
+	return convert_to<INT32_ARRAY>(*this);
 }
 
 Variant::operator Int64Array() const {
-	if (type == INT64_ARRAY) {
-		return static_cast<ArrayRef<int64_t> *>(_data._array)->array;
-	} else {
-		return Vector<int64_t>();
-	}
+	return convert_to<INT64_ARRAY>(*this);
 }
 
 Variant::operator Float32Array() const {
-	if (type == FLOAT32_ARRAY) {
-		return static_cast<ArrayRef<float> *>(_data._array)->array;
-	} else {
-		return Vector<float>();
-	}
+	return convert_to<FLOAT32_ARRAY>(*this);
 }
 
 Variant::operator Float64Array() const {
-	if (type == FLOAT64_ARRAY) {
-		return static_cast<ArrayRef<double> *>(_data._array)->array;
-	} else {
-		return Vector<double>();
-	}
+	return convert_to<FLOAT64_ARRAY>(*this);
 }
 
 Variant::operator Vector2Array() const {
-	if (type == VECTOR2_ARRAY) {
-		return static_cast<ArrayRef<Vector2> *>(_data._array)->array;
-	} else {
-		return Vector<Vector2>();
-	}
+	return convert_to<VECTOR2_ARRAY>(*this);
 }
 
 Variant::operator Vector3Array() const {
-	if (type == VECTOR3_ARRAY) {
-		return static_cast<ArrayRef<Vector3> *>(_data._array)->array;
-	} else {
-		return Vector<Vector3>();
-	}
+	return convert_to<VECTOR3_ARRAY>(*this);
 }
 
 Variant::operator Vector4Array() const {
-	if (type == VECTOR4_ARRAY) {
-		return static_cast<ArrayRef<Vector4> *>(_data._array)->array;
-	} else {
-		return Vector<Vector4>();
-	}
+	return convert_to<VECTOR4_ARRAY>(*this);
 }
 
 Variant::Variant(int8_t p_int) {
@@ -882,42 +665,43 @@ Variant::Variant(const Array &p_array) {
 }
 
 Variant::Variant(const ByteArray &p_byte_array) {
-	_data._array = ArrayRef<uint8_t>::create(p_byte_array);
+	vnew_placement(_data._mem, ByteArray(p_byte_array));
 	type = BYTE_ARRAY;
 }
 
 Variant::Variant(const Int32Array &p_int32_array) {
-	_data._array = ArrayRef<int32_t>::create(p_int32_array);
+	vnew_placement(_data._mem, Int32Array(p_int32_array));
 	type = INT32_ARRAY;
 }
 
 Variant::Variant(const Int64Array &p_int64_array) {
-	_data._array = ArrayRef<int64_t>::create(p_int64_array);
+	vnew_placement(_data._mem, Int64Array(p_int64_array));
 	type = INT64_ARRAY;
 }
 
 Variant::Variant(const Float32Array &p_float32_array) {
-	_data._array = ArrayRef<float>::create(p_float32_array);
+	vnew_placement(_data._mem, Float32Array(p_float32_array));
 	type = FLOAT32_ARRAY;
 }
 
 Variant::Variant(const Float64Array &p_float64_array) {
-	_data._array = ArrayRef<double>::create(p_float64_array);
+	vnew_placement(_data._mem, Float64Array(p_float64_array));
 	type = FLOAT64_ARRAY;
 }
 
 Variant::Variant(const Vector2Array &p_vector2_array) {
-	_data._array = ArrayRef<Vector2>::create(p_vector2_array);
+	vnew_placement(_data._mem, Vector2Array(p_vector2_array));
 	type = VECTOR2_ARRAY;
 }
 
 Variant::Variant(const Vector3Array &p_vector3_array) {
-	_data._array = ArrayRef<Vector3>::create(p_vector3_array);
+	vnew_placement(_data._mem, Vector3Array(p_vector3_array));
 	type = VECTOR3_ARRAY;
 }
 
 Variant::Variant(const Vector4Array &p_vector4_array) {
-	_data._array = ArrayRef<Vector4>::create(p_vector4_array);
+	vnew_placement(_data._mem, Vector4Array(p_vector4_array));
+	type = VECTOR4_ARRAY;
 }
 
 Variant::Variant(const Variant &p_other) {
@@ -53,78 +53,36 @@ public:
 		VARIANT_MAX
 	};
 
-private:
-	Type type = NIL;
-
-	struct ArrayRefBase {
-		Refcount ref_count;
-		FORCE_INLINE ArrayRefBase *reference() {
-			if (ref_count.ref()) {
-				return this;
-			} else {
-				return nullptr;
-			}
-		}
-
-		static FORCE_INLINE ArrayRefBase *reference_from(ArrayRefBase *p_arr, ArrayRefBase *p_from) {
-			if (p_arr == p_from) {
-				return p_arr;
-			}
-
-			if (p_from->reference()) {
-				if (p_arr->ref_count.unref()) {
-					vdelete(p_arr);
-				}
-				return p_from;
-			} else {
-				return p_arr;
-			}
-		}
+	enum Operator {
+		OP_ADD,
+		OP_SUBTRACT,
+		OP_MULTIPLY,
+		OP_DIVIDE,
 
-		static FORCE_INLINE void destroy(ArrayRefBase *p_arr) {
-			if (p_arr->ref_count.unref()) {
-				vdelete(p_arr);
-			}
-		}
-		FORCE_INLINE virtual ~ArrayRefBase() {}
+		OP_MAX
 	};
 
-	template <typename T>
-	struct ArrayRef : public ArrayRefBase {
-		Vector<T> array;
-		static FORCE_INLINE ArrayRef<T> *create() {
-			return vnew(ArrayRef<T>);
-		}
-
-		static FORCE_INLINE ArrayRef<T> *create(const Vector<T> &p_from) {
-			return vnew(ArrayRef<T>(p_from));
-		}
-
-		static FORCE_INLINE Vector<T> &get_array(ArrayRefBase *p_from) {
-			return static_cast<const ArrayRef<T> *>(p_from)->array;
-		}
-
-		FORCE_INLINE ArrayRef() {
-			ref_count.set(1);
-		}
+private:
+	friend class VariantInternal;
 
-		FORCE_INLINE ArrayRef(const Vector<T> &p_from) {
-			array = p_from;
-			ref_count.set(1);
-		}
-	};
+	Type type = NIL;
 
 	union {
 		bool _bool;
 		int64_t _int;
 		double _float;
-		ArrayRefBase *_array;
 		void *_ptr; // General pointer type
 		uint8_t _mem[sizeof(double) * 4]{0};
 	} _data alignas(8);
 
+	static_assert(sizeof(String) <= sizeof(_data._mem), "Strings must fit inside a Variant without allocating.");
+	static_assert(sizeof(Vector4) <= sizeof(_data._mem) && sizeof(Vector4i) <= sizeof(_data._mem),
+				  "Vectors must fit inside a Variant without allocating.");
+	// Typed arrays are held as the `Vector` itself, which shares its buffer with every copy until one is written to.
+	static_assert(sizeof(Vector<Vector4>) <= sizeof(_data._mem), "Typed arrays must fit inside a Variant.");
+
 	FORCE_INLINE void clear() {
-		bool needs_freeing[VARIANT_MAX] = {
+		static constexpr bool needs_freeing[VARIANT_MAX] = {
 			false, // NIL
 			false, // BOOL
 			false, // INT
@@ -161,10 +119,35 @@ private:
 public:
 	String stringify(int recursion_count = 0) const;
 
-	Type get_type() {
+	Type get_type() const {
 		return type;
 	}
 
+	/**
+	 * @brief Creates a `Variant` holding the default value of the given type, such as `0` for `INT` or an empty array
+	 * for `FLOAT32_ARRAY`.
+	 */
+	static Variant construct(Type p_type);
+
+	/**
+	 * @brief Applies an arithmetic operator to two `Variant`s. Integers and floats can be mixed, with the result being
+	 * a float unless both are integers. Vectors can be combined with a vector of the same type, and multiplied or
+	 * divided by a number. Strings can be added together.
+	 * @param p_op The operator to apply.
+	 * @param p_a The left-hand side of the operator.
+	 * @param p_b The right-hand side of the operator.
+	 * @param r_ret Set to the result of the operator. Left untouched if the operator cannot be applied.
+	 * @return Whether the operator could be applied to the types given, which is not the case for an integer division
+	 * by zero either.
+	 */
+	static bool evaluate(Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret);
+
+	/**
+	 * @brief Obtains a hash of the value held, so that values which compare equal hash the same.
+	 */
+	uint32_t hash() const;
+	uint32_t recursive_hash(int recursion_count) const;
+
 	void _ref(const Variant &p_other);
 	void operator=(const Variant &p_var);
 	void operator=(Variant &&p_var) {
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "core/variant/variant.h"
+
+#include <cstddef>
+
+/**
+ * @brief How a type is kept inside a `Variant`.
+ */
+enum VariantStorage {
+	VARIANT_STORAGE_NONE,	// Nothing is stored, as for `NIL`
+	VARIANT_STORAGE_BOOL,	// Stored in `_data._bool`
+	VARIANT_STORAGE_INT,	// Stored in `_data._int`
+	VARIANT_STORAGE_FLOAT,	// Stored in `_data._float`
+	VARIANT_STORAGE_INLINE, // Constructed in place inside `_data._mem`
+};
+
+/**
+ * @brief Maps each `Variant::Type` to the C++ type it holds and to how that type is stored, so that the code working
+ * on each type can be generated from templates instead of being written out for every type.
+ */
+template <Variant::Type T>
+struct VariantTypeInfo;
+
+#define VARIANT_TYPE_INFO(m_type, m_class, m_storage)                                                                 \
+	template <>                                                                                                       \
+	struct VariantTypeInfo<Variant::m_type> {                                                                         \
+		typedef m_class Type;                                                                                         \
+		static constexpr VariantStorage storage = m_storage;                                                          \
+	};
+
+#define VARIANT_TYPED_ARRAY_INFO(m_type, m_element)                                                                   \
+	template <>                                                                                                       \
+	struct VariantTypeInfo<Variant::m_type> {                                                                         \
+		typedef Vector<m_element> Type;                                                                               \
+		typedef m_element Element;                                                                                    \
+		static constexpr VariantStorage storage = VARIANT_STORAGE_INLINE;                                             \
+	};
+
+VARIANT_TYPE_INFO(NIL, std::nullptr_t, VARIANT_STORAGE_NONE)
+VARIANT_TYPE_INFO(BOOL, bool, VARIANT_STORAGE_BOOL)
+VARIANT_TYPE_INFO(INT, int64_t, VARIANT_STORAGE_INT)
+VARIANT_TYPE_INFO(FLOAT, double, VARIANT_STORAGE_FLOAT)
+VARIANT_TYPE_INFO(STRING, String, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(VECTOR2, Vector2, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(VECTOR2I, Vector2i, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(VECTOR3, Vector3, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(VECTOR3I, Vector3i, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(VECTOR4, Vector4, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(VECTOR4I, Vector4i, VARIANT_STORAGE_INLINE)
+VARIANT_TYPE_INFO(ARRAY, Array, VARIANT_STORAGE_INLINE)
+VARIANT_TYPED_ARRAY_INFO(BYTE_ARRAY, uint8_t)
+VARIANT_TYPED_ARRAY_INFO(INT32_ARRAY, int32_t)
+VARIANT_TYPED_ARRAY_INFO(INT64_ARRAY, int64_t)
+VARIANT_TYPED_ARRAY_INFO(FLOAT32_ARRAY, float)
+VARIANT_TYPED_ARRAY_INFO(FLOAT64_ARRAY, double)
+VARIANT_TYPED_ARRAY_INFO(VECTOR2_ARRAY, Vector2)
+VARIANT_TYPED_ARRAY_INFO(VECTOR3_ARRAY, Vector3)
+VARIANT_TYPED_ARRAY_INFO(VECTOR4_ARRAY, Vector4)
+
+#undef VARIANT_TYPE_INFO
+#undef VARIANT_TYPED_ARRAY_INFO
+
+/**
+ * @brief Direct access to the value inside a `Variant`, for the code that implements it. None of these check the type
+ * the `Variant` holds, so the caller has to know it already.
+ */
+class VariantInternal {
+public:
+	template <Variant::Type T>
+	using Type = typename VariantTypeInfo<T>::Type;
+
+	FORCE_INLINE static void set_type(Variant &r_variant, Variant::Type p_type) {
+		r_variant.type = p_type;
+	}
+
+	/**
+	 * @brief Obtains a pointer to the value of type `T` held by the `Variant`.
+	 */
+	template <Variant::Type T>
+	FORCE_INLINE static Type<T> *get_ptr(Variant &r_variant) {
+		constexpr VariantStorage storage = VariantTypeInfo<T>::storage;
+		static_assert(storage != VARIANT_STORAGE_NONE, "A null Variant holds no value.");
+		if constexpr (storage == VARIANT_STORAGE_BOOL) {
+			return &r_variant._data._bool;
+		} else if constexpr (storage == VARIANT_STORAGE_INT) {
+			return &r_variant._data._int;
+		} else if constexpr (storage == VARIANT_STORAGE_FLOAT) {
+			return &r_variant._data._float;
+		} else {
+			return reinterpret_cast<Type<T> *>(r_variant._data._mem);
+		}
+	}
+
+	template <Variant::Type T>
+	FORCE_INLINE static const Type<T> *get_ptr(const Variant &p_variant) {
+		return get_ptr<T>(const_cast<Variant &>(p_variant));
+	}
+
+	/**
+	 * @brief Constructs the default value of type `T` in a `Variant` that holds nothing, without setting its type.
+	 */
+	template <Variant::Type T>
+	FORCE_INLINE static void construct(Variant &r_variant) {
+		constexpr VariantStorage storage = VariantTypeInfo<T>::storage;
+		if constexpr (storage == VARIANT_STORAGE_INLINE) {
+			vnew_placement(r_variant._data._mem, Type<T>());
+		} else if constexpr (storage != VARIANT_STORAGE_NONE) {
+			*get_ptr<T>(r_variant) = Type<T>();
+		}
+	}
+
+	/**
+	 * @brief Copies the value of `p_from`, which is of type `T`, into a `Variant` that holds nothing, without setting
+	 * its type. Typed arrays share their buffer with the copy until either is written to.
+	 */
+	template <Variant::Type T>
+	FORCE_INLINE static void copy_construct(Variant &r_variant, const Variant &p_from) {
+		constexpr VariantStorage storage = VariantTypeInfo<T>::storage;
+		if constexpr (storage == VARIANT_STORAGE_INLINE) {
+			vnew_placement(r_variant._data._mem, Type<T>(*get_ptr<T>(p_from)));
+		} else if constexpr (storage != VARIANT_STORAGE_NONE) {
+			*get_ptr<T>(r_variant) = *get_ptr<T>(p_from);
+		}
+	}
+
+	/**
+	 * @brief Assigns the value of `p_from` to a `Variant` that already holds a value of the same type `T`.
+	 */
+	template <Variant::Type T>
+	FORCE_INLINE static void assign(Variant &r_variant, const Variant &p_from) {
+		if constexpr (VariantTypeInfo<T>::storage != VARIANT_STORAGE_NONE) {
+			*get_ptr<T>(r_variant) = *get_ptr<T>(p_from);
+		}
+	}
+
+	/**
+	 * @brief Frees the value of type `T` held by the `Variant`, without setting its type.
+	 */
+	template <Variant::Type T>
+	FORCE_INLINE static void destroy(Variant &r_variant) {
+		if constexpr (VariantTypeInfo<T>::storage == VARIANT_STORAGE_INLINE) {
+			typedef Type<T> Held;
+			get_ptr<T>(r_variant)->~Held();
+		}
+	}
+};
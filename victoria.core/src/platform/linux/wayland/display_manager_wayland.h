@@ -12,8 +12,9 @@
 #	include "protocols/pointer_warp.gen.h"
 #	include "protocols/relative_pointer.gen.h"
 
-#	include "core/os/display_manager.h"
+#	include "core/data/flat_hashtable.h"
 #	include "core/io/input.h"
+#	include "core/os/display_manager.h"
 
 #	include <wayland-client-core.h>
 #	include <wayland-egl-core.h>
@@ -92,7 +93,7 @@ private:
 		struct xkb_state *xkb_state = nullptr;
 		void *keymap_buffer = nullptr;
 		uint64_t keymap_buffer_size = 0;
-		HashTable<xkb_keycode_t, Key> pressed_keys;
+		FlatHashTable<xkb_keycode_t, Key> pressed_keys;
 
 		bool frame_recieved = false;
 		uint8_t active_window = INVALID_WINDOW_ID;
@@ -18,7 +18,7 @@ void DisplayManagerWindows::finalize() {
 
 	if (window) {
 		destroy_window(window->id);
-		Memory::vfree(window); // Freeing here, because otherwise the function is called twice.
+		Memory::vfree(window, sizeof(WindowData)); // Freeing here, because otherwise the function is called twice.
 		window = nullptr;
 	}
 }
@@ -51,12 +51,12 @@ Ref<Resource> ResourceFormatImporterFont::_import(const String &p_file, int p_ar
 	if (p_argc >= 1 && p_args[0].operator bool() == true) {
 		// Load font into a larger bitmap image
 
-		RBMap<int, char> char_map;
+		FlatMap<int, char> char_map;
 		for (uint8_t c = 32; c < 127; c++) {
 			char_map.insert(c, (char)c);
 		}
 
-		uint8_t *bitmap = (uint8_t *)Memory::vallocate_zeroed(bitmap_size * bitmap_size);
+		uint8_t *bitmap = (uint8_t *)Memory::vallocate_zeroed(bitmap_size * bitmap_size, MEMORY_TAG_RESOURCE);
 		uint32_t max_x = 0;
 		uint32_t max_y = 0;
 		uint32_t max_row = 0;
@@ -151,7 +151,7 @@ Ref<Resource> ResourceFormatImporterFont::_import(const String &p_file, int p_ar
 
 		rm->texture_set_from_data(r, bitmap, bitmap_size, bitmap_size, RM::FORMAT_R, RM::MASK_FILTER_NEAREST);
 
-		Memory::vfree(bitmap);
+		Memory::vfree(bitmap, bitmap_size * bitmap_size);
 	} else {
 		for (uint8_t c = 0; c < 128; c++) {
 			ERR_FAIL_COND_MSG_R(FT_Load_Char(face, c, FT_LOAD_RENDER) != 0,
@@ -54,20 +54,28 @@ Ref<Resource> ResourceFormatImporterOBJ::_import(const String &p_path, int p_arg
 	Vector<Vector3> normals;
 	Vector<Vector2> uvs;
 
-	while (fs->get_position() < fs->get_length()) {
-		String line = fs->get_line();
+	// Read the whole file at once and parse it through views, so that no line or token is ever copied.
+	String contents = fs->get_contents_as_string();
 
+	for (StringView line : contents.split_view("\n")) {
 		// Ignore comments in code
-		if (line.begins_with("#")) {
-			continue;
+		int comment = line.find_char('#');
+		if (comment != -1) {
+			line = line.left(comment);
 		}
 
-		// Split the string
-		Vector<String> sline = line.split(" ");
+		// Split the line into its tokens. No element uses more than a keyword and three values.
+		StringView sline[4];
+		int token_count = 0;
+		for (const StringView &token : line.strip_edges().split(" ", false)) {
+			if (token_count == 4) {
+				break;
+			}
+			sline[token_count++] = token;
+		}
 
-		int comment = sline[sline.size() - 1].find("#");
-		if (comment != -1) {
-			sline[sline.size() - 1].left(comment);
+		if (token_count == 0) {
+			continue;
 		}
 
 		if (sline[0] == "v") {
@@ -89,15 +97,19 @@ Ref<Resource> ResourceFormatImporterOBJ::_import(const String &p_path, int p_arg
 		// WARNING: We automatically assume that the user has vertex/vertex coords/vertex normals for their face
 		// elements. TODO: Note this in the docs.
 		if (sline[0] == "f") {
-			for (int i = 0; i < 3; i++) {
-				Vector<String> substr = sline[i + 1].split("/");
-				if (substr.is_empty()) {
-					continue;
+			for (int i = 1; i < token_count; i++) {
+				StringView substr[3];
+				int count = 0;
+				for (const StringView &part : sline[i].split("/")) {
+					if (count == 3) {
+						break;
+					}
+					substr[count++] = part;
 				}
 
-				if (substr.size() < 3) {
+				if (count < 3) {
 					ERR_WARN(vformat("Given vertex indicies (%s) were not in the format v/vt/vn.",
-									 sline[i + 1].get_data()));
+									 String(sline[i]).get_data()));
 					continue;
 				}
 
@@ -1,5 +1,6 @@
 #include "rendering/opengl/rendering_manager_gl.h"
 
+#include <core/data/frame_vector.h>
 #include <core/io/input.h>
 #include <core/math/mat4.h>
 #include <core/math/math_funcs.h>
@@ -124,20 +125,20 @@ void RenderingManagerGL::finalize() {
 	shaders.canvas_shader.shader_delete();
 	shaders.copy_shader.shader_delete();
 
-	Memory::vfree(scene_data.point_lights);
+	Memory::vfree(scene_data.point_lights, sizeof(SceneData::PointLight) * 32);
 	utils->free_buffer(GL_UNIFORM_BUFFER, sizeof(SceneData::PointLight) * 32, &scene_data.point_light_buffer);
 
-	Memory::vfree(scene_data.directional_lights);
+	Memory::vfree(scene_data.directional_lights, sizeof(SceneData::DirectionalLight) * 32);
 	utils->free_buffer(GL_UNIFORM_BUFFER,
 					   sizeof(SceneData::DirectionalLight) * 32,
 					   &scene_data.directional_light_buffer);
 
-	Memory::vfree(scene_data.spot_lights);
+	Memory::vfree(scene_data.spot_lights, sizeof(SceneData::SpotLight) * 32);
 	utils->free_buffer(GL_UNIFORM_BUFFER, sizeof(SceneData::SpotLight) * 32, &scene_data.spot_light_buffer);
 
 	utils->free_buffer(GL_UNIFORM_BUFFER, sizeof(SceneData::UBO), &scene_data.ubo_buffer);
 
-	Memory::vfree(canvas_data.canvas_instance_data);
+	Memory::vfree(canvas_data.canvas_instance_data, sizeof(CanvasInstanceData) * MAX_INSTANCE_DATA_COUNT);
 	utils->free_buffer(GL_ARRAY_BUFFER,
 					   sizeof(CanvasInstanceData) * MAX_INSTANCE_DATA_COUNT,
 					   &canvas_data.canvas_instance_data_buffer);
@@ -264,14 +265,15 @@ void RenderingManagerGL::_render_scene(RenderData *r_data, Viewport *p_viewport,
 
 		shaders.scene_shader.shader_set_active();
 
-		Vector<GeometryData> geom_instances;
+		FrameVector<GeometryData> geom_instances;
 		uint32_t point_light_count = 0;
 		uint32_t directional_light_count = 0;
 		uint32_t spot_light_count = 0;
-		Vector<GLShader::Uniform> scene_uniforms = shaders.scene_shader.uniforms;
+		const LocalVector<GLShader::Uniform> &scene_uniforms = shaders.scene_shader.uniforms;
 
-		Vector<RID> instance_list;
+		FrameVector<RID> instance_list;
 		instance_owner.get_owned_list(&instance_list);
+		geom_instances.reserve(instance_list.size());
 
 		// Loop over each instance to check its data
 		for (const RID &rid : instance_list) {
@@ -403,15 +405,15 @@ void RenderingManagerGL::_render_scene(RenderData *r_data, Viewport *p_viewport,
 
 		// Bind item-independent uniforms
 		for (const GLShader::Uniform &u : scene_uniforms) {
-			if (vstring_compare(u.name, "view_pos")) {
+			if (u.name == SNAME("view_pos")) {
 				// Get position data (since the camera is already inverted position-wise, invert it again)
 				Vector3 pos = cam->view.position.inverse();
 				set_uniform_vec3(u.loc, pos);
 			}
-			if (vstring_compare(u.name, "point_lights_used")) {
+			if (u.name == SNAME("point_lights_used")) {
 				glUniform1ui(u.loc, scene_data.point_light_count);
 			}
-			if (vstring_compare(u.name, "spot_lights_used")) {
+			if (u.name == SNAME("spot_lights_used")) {
 				glUniform1ui(u.loc, scene_data.spot_light_count);
 			}
 		}
@@ -425,7 +427,7 @@ void RenderingManagerGL::_render_scene(RenderData *r_data, Viewport *p_viewport,
 			}
 
 			for (const GLShader::Uniform &u : scene_uniforms) {
-				if (vstring_compare(u.name, "transform")) {
+				if (u.name == SNAME("transform")) {
 					set_uniform_mat4(u.loc, inst.transform.get_model());
 					break;
 				}
@@ -738,8 +740,8 @@ void RenderingManagerGL::_render_viewport(RenderData *r_data, Viewport *p_viewpo
 	shaders.copy_shader.shader_set_active();
 
 	int offset_size_loc = -1;
-	for (int i = 0; i < shaders.copy_shader.uniforms.size(); i++) {
-		if (vstring_compare(shaders.copy_shader.uniforms[i].name, "offset_size")) {
+	for (uint32_t i = 0; i < shaders.copy_shader.uniforms.size(); i++) {
+		if (shaders.copy_shader.uniforms[i].name == SNAME("offset_size")) {
 			offset_size_loc = shaders.copy_shader.uniforms[i].loc;
 			break;
 		}
@@ -909,6 +911,7 @@ void RenderingManagerGL::mesh_set_from_data(RID p_mesh, const MeshData &p_data)
 	if (p_data.format & FORMAT_USE_2D_VERTICES) {
 		stride = 2 * sizeof(float);
 		verts_per_coord = 2;
+		vertex_data.reserve(p_data.vertex_data.size() * 2 + p_data.uv_data.size() * 2);
 
 		// Load data for a 2D format (Vector3 will not use the z coordinate)
 		for (int i = 0; i < p_data.vertex_data.size(); i++) {
@@ -925,6 +928,7 @@ void RenderingManagerGL::mesh_set_from_data(RID p_mesh, const MeshData &p_data)
 	} else {
 		stride = 3 * sizeof(float);
 		verts_per_coord = 3;
+		vertex_data.reserve(p_data.vertex_data.size() * 3 + p_data.normal_data.size() * 3 + p_data.uv_data.size() * 2);
 
 		int i;
 		for (i = 0; i < p_data.vertex_data.size(); i++) {
@@ -1011,7 +1015,7 @@ void RenderingManagerGL::material_set_colour(RID p_material, const Vector4 &p_co
 	ERR_COND_NULL(m);
 
 	if (!m->data) {
-		m->data = vnew(MaterialData);
+		m->data = vnew_tagged(MaterialData, MEMORY_TAG_RENDERING);
 	}
 	GL::Utilities::store_vec4(p_colour, &m->data->diffuse[0]);
 	GL::Utilities::store_vec4(p_colour, &m->data->ambient[0]);
@@ -1022,7 +1026,7 @@ void RenderingManagerGL::material_set_specular(RID p_material, const Vector3 &p_
 	Material *m = material_owner.get_or_null(p_material);
 
 	if (!m->data) {
-		m->data = vnew(MaterialData);
+		m->data = vnew_tagged(MaterialData, MEMORY_TAG_RENDERING);
 	}
 	GL::Utilities::store_vec3(p_specular, &m->data->specular[0]);
 }
@@ -1137,7 +1141,7 @@ void RenderingManagerGL::item_set_parent(RID p_item, RID p_parent) {
 		Canvas *c = canvas_owner.get_or_null(p_parent);
 		ERR_COND_NULL_MSG(c, "Parent RID was valid, but was not a canvas.");
 
-		int idx = c->child_items.find(i);
+		int64_t idx = c->child_items.find(i);
 		ERR_FAIL_COND_MSG(idx == -1, "Canvas was valid, but did not contain the item.");
 
 		c->child_items.remove_at(idx);
@@ -1546,7 +1550,7 @@ RenderingManagerGL::RenderingManagerGL() {
 	}
 	ERR_FAIL_COND_MSG(!glad_loaded, "GLAD was unable to be loaded.");
 
-	utils = vnew(GL::Utilities);
+	utils = vnew_tagged(GL::Utilities, MEMORY_TAG_RENDERING);
 	stbi_set_flip_vertically_on_load(true);
 
 	// Query device info
@@ -1622,8 +1626,8 @@ RenderingManagerGL::RenderingManagerGL() {
 	// Setup lights
 
 	// Directional lights
-	scene_data.directional_lights =
-		(SceneData::DirectionalLight *)Memory::vallocate(sizeof(SceneData::DirectionalLight) * 32);
+	scene_data.directional_lights = (SceneData::DirectionalLight *)Memory::vallocate(
+		sizeof(SceneData::DirectionalLight) * 32, MEMORY_TAG_RENDERING);
 	Memory::vzero(scene_data.directional_lights, sizeof(SceneData::DirectionalLight) * 32);
 	glGenBuffers(1, &scene_data.directional_light_buffer);
 	glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_DIRECTIONAL_LIGHT_DATA, scene_data.directional_light_buffer);
@@ -1632,7 +1636,8 @@ RenderingManagerGL::RenderingManagerGL() {
 	print_verbose("Allocated 32 directional lights to the scene");
 
 	// Point lights
-	scene_data.point_lights = (SceneData::PointLight *)Memory::vallocate(sizeof(SceneData::PointLight) * 32);
+	scene_data.point_lights =
+		(SceneData::PointLight *)Memory::vallocate(sizeof(SceneData::PointLight) * 32, MEMORY_TAG_RENDERING);
 	Memory::vzero(scene_data.point_lights, sizeof(SceneData::PointLight) * 32);
 	glGenBuffers(1, &scene_data.point_light_buffer);
 	glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT_LIGHT_DATA, scene_data.point_light_buffer);
@@ -1641,7 +1646,8 @@ RenderingManagerGL::RenderingManagerGL() {
 	print_verbose("Allocated 32 point lights to the scene");
 
 	// Spot lights
-	scene_data.spot_lights = (SceneData::SpotLight *)Memory::vallocate(sizeof(SceneData::SpotLight) * 32);
+	scene_data.spot_lights =
+		(SceneData::SpotLight *)Memory::vallocate(sizeof(SceneData::SpotLight) * 32, MEMORY_TAG_RENDERING);
 	Memory::vzero(scene_data.spot_lights, sizeof(SceneData::SpotLight) * 32);
 	glGenBuffers(1, &scene_data.spot_light_buffer);
 	glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_SPOT_LIGHT_DATA, scene_data.spot_light_buffer);
@@ -1747,8 +1753,8 @@ RenderingManagerGL::RenderingManagerGL() {
 
 	// Allocate canvas instance UBO
 	print_verbose("Creating CanvasInstanceData UBO");
-	canvas_data.canvas_instance_data =
-		(CanvasInstanceData *)Memory::vallocate(sizeof(CanvasInstanceData) * MAX_INSTANCE_DATA_COUNT);
+	canvas_data.canvas_instance_data = (CanvasInstanceData *)Memory::vallocate(
+		sizeof(CanvasInstanceData) * MAX_INSTANCE_DATA_COUNT, MEMORY_TAG_RENDERING);
 	Memory::vzero(canvas_data.canvas_instance_data, sizeof(CanvasInstanceData) * MAX_INSTANCE_DATA_COUNT);
 	glGenBuffers(1, &canvas_data.canvas_instance_data_buffer);
 	glBindBuffer(GL_ARRAY_BUFFER, canvas_data.canvas_instance_data_buffer);
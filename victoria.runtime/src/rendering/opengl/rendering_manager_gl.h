@@ -7,6 +7,7 @@
 #include "rendering/opengl/shaders/scene.gen.h"
 #include "rendering/rendering_manager.h"
 
+#include <core/data/local_vector.h>
 #include <core/data/rid_owner.h>
 
 class RenderingManagerGL : public RenderingManager {
@@ -210,7 +211,7 @@ private:
 				return; // Already allocated
 			}
 
-			base = vnew(T);
+			base = vnew_tagged(T, MEMORY_TAG_RENDERING);
 		}
 
 		~Item() {
@@ -222,7 +223,7 @@ private:
 	RIDOwner<Item> canvas_item_owner;
 
 	struct Canvas {
-		Vector<Item *> child_items;
+		LocalVector<Item *> child_items;
 	};
 
 	RIDOwner<Canvas> canvas_owner;
@@ -265,7 +266,7 @@ private:
 		UBO ubo;
 		uint32_t canvas_buffer = 0;
 
-		Vector<CanvasBatch> batches;
+		LocalVector<CanvasBatch> batches;
 		uint32_t current_batch = 0;
 
 		CanvasInstanceData *canvas_instance_data = nullptr;
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <core/data/vector.h>
+#include <core/data/local_vector.h>
+#include <core/string/string_name.h>
 #include <core/string/vstring.h>
 
 class GLShader {
@@ -10,7 +11,8 @@ class GLShader {
 
 public:
 	struct Uniform {
-		const char *name;
+		// Interned so that looking a uniform up by name while rendering is a pointer comparison.
+		StringName name;
 		int loc;
 	};
 
@@ -19,10 +21,8 @@ public:
 		int index;
 	};
 
-	// NOTE: A FixedVector of some description would be better to avoid CoW semantics
-
-	Vector<Uniform> uniforms;
-	Vector<UBO> ubos;
+	LocalVector<Uniform> uniforms;
+	LocalVector<UBO> ubos;
 
 	void shader_set_active();
 	void shader_delete();
@@ -11,6 +11,7 @@
 #include <core/io/input.h>
 #include <core/io/resource_importer.h>
 #include <core/os/display_manager.h>
+#include <core/os/frame_allocator.h>
 #include <core/os/os.h>
 
 static MainLoop *main_loop = nullptr;
@@ -72,6 +73,8 @@ bool runtime_iteration() {
 
 	frame_count++;
 	frame_time_start = OS::get_singleton()->get_os_running_time();
+	// Scratch memory from two frames ago is no longer in use, so it can be handed out again.
+	FrameAllocator::begin_frame();
 
 	// Return early from a quit request, to prevent calling on NULL items in the DisplayManager
 	if (should_quit) {
@@ -88,6 +91,10 @@ bool runtime_iteration() {
 								   rd->render_time * 1000);
 	}
 
+	if (Input::get_singleton()->is_key_just_pressed(Key::F3)) {
+		OS::get_singleton()->print("%s", Memory::get_report().get_data());
+	}
+
 	RenderingManager::get_singleton()->draw();
 	DisplayManager::get_singleton()->swap_buffers();
 
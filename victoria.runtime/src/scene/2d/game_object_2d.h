@@ -6,6 +6,7 @@
 
 class VAPI GameObject2D : public CanvasItem {
 	VREGISTER_CLASS(GameObject2D, CanvasItem);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_TRANSFORM_CHANGED);
 
 	Transform2D transform;
 
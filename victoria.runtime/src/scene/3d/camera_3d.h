@@ -7,6 +7,7 @@
 
 class VAPI Camera3D : public GameObject3D {
 	VREGISTER_CLASS(Camera3D, GameObject3D);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_EXIT_TREE, NOTIFICATION_TRANSFORM_CHANGED);
 
 	float fovy = 70.0 * Math::DEG_TO_RAD_MULTIPLIER;
 	float near_plane = 0.1;
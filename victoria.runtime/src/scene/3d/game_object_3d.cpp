@@ -5,7 +5,7 @@ void GameObject3D::_propagate_transform_changed(GameObject3D *p_object) {
 		return;
 	}
 
-	List<GameObject *> children = get_children();
+	FrameVector<GameObject *> children = get_children();
 
 	for (GameObject *&obj : children) {
 		GameObject3D *c = Object::cast_to<GameObject3D>(obj);
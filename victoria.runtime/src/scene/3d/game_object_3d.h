@@ -6,6 +6,7 @@
 
 class VAPI GameObject3D : public GameObject {
 	VREGISTER_CLASS(GameObject3D, GameObject);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE);
 
 	struct Data {
 		mutable Transform3D local_transform;
@@ -6,6 +6,7 @@
 
 class VAPI VisualInstance3D : public GameObject3D {
 	VREGISTER_CLASS(VisualInstance3D, GameObject3D);
+	VNOTIFICATIONS(NOTIFICATION_TRANSFORM_CHANGED);
 
 	RID instance;
 	RID base;
@@ -4,6 +4,7 @@
 
 class VAPI ColourRect : public UIObject {
 	VREGISTER_CLASS(ColourRect, UIObject);
+	VNOTIFICATIONS(NOTIFICATION_DRAW);
 
 	Vector4 colour;
 
@@ -4,6 +4,7 @@
 
 class VAPI Panel : public UIObject {
 	VREGISTER_CLASS(Panel, UIObject);
+	VNOTIFICATIONS(NOTIFICATION_DRAW);
 
 	Vector4 colour;
 
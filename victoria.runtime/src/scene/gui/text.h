@@ -5,6 +5,7 @@
 
 class VAPI Text : public UIObject {
 	VREGISTER_CLASS(Text, UIObject);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_TRANSFORM_CHANGED);
 
 	struct Character {
 		RID id;
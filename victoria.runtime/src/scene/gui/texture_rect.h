@@ -5,6 +5,7 @@
 
 class VAPI TextureRect : public UIObject {
 	VREGISTER_CLASS(TextureRect, UIObject);
+	VNOTIFICATIONS(NOTIFICATION_DRAW);
 
 	Ref<Texture> texture;
 
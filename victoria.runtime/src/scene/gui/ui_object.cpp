@@ -146,13 +146,22 @@ void UIObject::_notification(int p_what) {
 
 			Viewport *v = get_viewport();
 			if (v) {
-				v->connect_method("size_changed", callable_mp(this, &UIObject::_size_changed));
+				v->connect_method(SNAME("size_changed"), callable_mp(this, &UIObject::_size_changed));
+				data.size_viewport = v;
 			}
 
 			_update_minimum_size();
 			_size_changed();
 			_update_anchors(anchor_location, true);
 		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			// The viewport has already been unset by the time this is sent, so the one we connected to is kept around.
+			if (data.size_viewport) {
+				data.size_viewport->disconnect_method(SNAME("size_changed"),
+													  callable_mp(this, &UIObject::_size_changed));
+				data.size_viewport = nullptr;
+			}
+		} break;
 		case NOTIFICATION_DRAW: {
 			// Can't update anchors, because queue_redraw is called to do that anyway.
 			_update_canvas_item_transform();
@@ -234,5 +243,5 @@ Vector2i UIObject::get_parent_rect() const {
 }
 
 void UIObject::_bind_methods() {
-	ClassRegistry::add_signal(get_class_name_static(), "size_changed");
+	ClassRegistry::add_signal(get_class_name_static(), SNAME("size_changed"));
 }
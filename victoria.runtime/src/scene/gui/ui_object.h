@@ -6,6 +6,7 @@
 
 class VAPI UIObject : public CanvasItem {
 	VREGISTER_CLASS(UIObject, CanvasItem);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_EXIT_TREE, NOTIFICATION_DRAW);
 
 public:
 	enum Anchor {
@@ -37,6 +38,7 @@ private:
 		Vector2i offsets;					  // Offset from the initial anchor position.
 
 		UIObject *ui_parent = nullptr;
+		Viewport *size_viewport = nullptr; // The viewport whose size changes we are connected to
 	} data;
 
 	void _size_changed();
@@ -1,7 +1,7 @@
 #include "scene/gui/vbox_container.h"
 
 void VBoxContainer::_resize() {
-	List<GameObject *> children = get_children();
+	FrameVector<GameObject *> children = get_children();
 	Vector2 parent_size = get_size();
 	Vector2 parent_pos = get_transform().position;
 	Vector2 cumulative_child_size = Vector2(parent_size.x, 0);
@@ -24,7 +24,7 @@ void VBoxContainer::_resize() {
 		}
 
 		// Add separation and reposition child
-		if (child != children.front()->get()) {
+		if (child != children[0]) {
 			cumulative_child_size.y += 4;
 		}
 
@@ -4,6 +4,7 @@
 
 class VAPI VBoxContainer : public Container {
 	VREGISTER_CLASS(VBoxContainer, Container);
+	VNOTIFICATIONS(NOTIFICATION_CHILD_ENTERED_TREE);
 
 	void _resize();
 
@@ -5,6 +5,7 @@
 
 class VAPI ViewportContainer : public Container {
 	VREGISTER_CLASS(ViewportContainer, Container);
+	VNOTIFICATIONS(NOTIFICATION_CHILD_ENTERED_TREE, NOTIFICATION_DRAW);
 
 	Ref<ViewportTexture> viewport_texture;
 
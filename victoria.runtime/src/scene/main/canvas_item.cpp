@@ -3,6 +3,9 @@
 #include "rendering/rendering_manager.h"
 #include "scene/main/viewport.h"
 
+#include <core/object/command_queue.h>
+#include <core/os/thread.h>
+
 void CanvasItem::_redraw_callback() {
 	notification(NOTIFICATION_DRAW);
 }
@@ -16,7 +19,7 @@ void CanvasItem::_propagate_transform_changed(CanvasItem *p_canvas_item) {
 		return;
 	}
 
-	List<GameObject *> children = get_children();
+	FrameVector<GameObject *> children = get_children();
 
 	for (GameObject *&obj : children) {
 		CanvasItem *c = Object::cast_to<CanvasItem>(obj);
@@ -79,7 +82,14 @@ void CanvasItem::queue_redraw() {
 	}
 
 	has_queued_redraw = true;
-	callable_mp(this, &CanvasItem::_redraw_callback).call_deferred();
+	// The global queue can only be pushed to from the main thread, so other threads go through `call_deferred()`,
+	// which hands the call to the thread-safe queue.
+	if (!Thread::is_main_thread()) {
+		callable_mp(this, &CanvasItem::_redraw_callback).call_deferred();
+		return;
+	}
+
+	GlobalCommandQueue::get_singleton()->push_call(this, &CanvasItem::_redraw_callback);
 }
 
 void CanvasItem::canvas_set_colour(const Vector4 &p_colour) {
@@ -7,6 +7,7 @@
 
 class VAPI CanvasItem : public GameObject {
 	VREGISTER_CLASS(CanvasItem, GameObject);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_TRANSFORM_CHANGED);
 
 	RID item;
 
@@ -16,6 +16,10 @@ void GameObject::_propagate_enter_tree() {
 	}
 
 	notification(NOTIFICATION_ENTER_TREE, true);
+	if (data.tree) {
+		data.subscribed_tree = data.tree;
+		data.tree->_add_subscriber(this);
+	}
 
 	for (GameObject *child : data.children) {
 		child->_propagate_enter_tree();
@@ -26,6 +30,10 @@ void GameObject::_propagate_exit_tree() {
 	data.is_inside_tree = false;
 
 	data.viewport = nullptr;
+	if (data.subscribed_tree) {
+		data.subscribed_tree->_remove_subscriber(this);
+		data.subscribed_tree = nullptr;
+	}
 
 	notification(NOTIFICATION_EXIT_TREE, true);
 
@@ -77,9 +85,15 @@ int GameObject::get_child_count() const {
 	return data.children.size();
 }
 
-List<GameObject *> GameObject::get_children() const {
-	// construct new list from old
-	return List<GameObject *>(data.children);
+FrameVector<GameObject *> GameObject::get_children() const {
+	// The copy only lives for as long as the caller iterates over it, so it is taken from the frame's scratch memory.
+	FrameVector<GameObject *> children;
+	children.reserve(data.children.size());
+	for (GameObject *c : data.children) {
+		children.push_back(c);
+	}
+
+	return children;
 }
 
 void GameObject::add_child(GameObject *p_child) {
@@ -91,20 +105,25 @@ void GameObject::add_child(GameObject *p_child) {
 
 	// Set name of children
 	if (p_child->get_name().is_empty()) {
+		const StringName &class_name = p_child->get_class_name();
 		if (data.children.size() == 0) {
-			p_child->set_name(p_child->get_class_name());
+			p_child->set_name(class_name.get_string());
 		} else {
 			int count = 0;
-			List<GameObject *>::Element *c = data.children.front();
+			ChildList::Element *c = data.children.front();
 			while (c) {
-				if (c->get()->get_class_name() == p_child->get_class_name()) {
+				if (c->get()->get_class_name() == class_name) {
 					count++;
 				}
 
 				c = c->next();
 			}
 
-			p_child->set_name(p_child->get_class_name() + (count > 0 ? itos(count) : ""));
+			String name = class_name.get_string();
+			if (count > 0) {
+				name += itos(count);
+			}
+			p_child->set_name(name);
 		}
 	}
 
@@ -211,6 +230,9 @@ void GameObject::propagate_notification(int p_what) {
 GameObject::GameObject() {}
 
 GameObject::~GameObject() {
+	if (data.subscribed_tree) {
+		data.subscribed_tree->_remove_subscriber(this);
+	}
 	data.children.clear();
 	data.parent = nullptr;
 }
\ No newline at end of file
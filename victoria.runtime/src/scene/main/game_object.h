@@ -2,7 +2,9 @@
 
 #include "scene/main/scene_tree.h"
 
+#include <core/data/frame_vector.h>
 #include <core/data/list.h>
+#include <core/data/paged_allocator.h>
 #include <core/object/object.h>
 #include <core/string/vstring.h>
 
@@ -14,9 +16,16 @@ class Window;
  */
 class VAPI GameObject : public Object {
 	VREGISTER_CLASS(GameObject, Object);
+	VNOTIFICATIONS(NOTIFICATION_PREDELETE);
+
+	// Children are added and removed often while the tree changes, so their list elements come from small pages
+	// owned by the object rather than from the global allocator.
+	typedef List<GameObject *, PagedAllocator<ListElement<GameObject *>, 16>> ChildList;
+
+	static constexpr uint32_t NOT_SUBSCRIBED = UINT32_MAX;
 
 	struct Data {
-		List<GameObject *> children;
+		ChildList children;
 		GameObject *parent = nullptr;
 		Viewport *viewport = nullptr;
 
@@ -24,6 +33,10 @@ class VAPI GameObject : public Object {
 		String name = "";
 
 		SceneTree *tree = nullptr;
+		SceneTree *subscribed_tree = nullptr; // The tree whose lists of interested objects this object is on
+
+		// Where the object is in each of the tree's lists of interested objects.
+		uint32_t subscriber_index[SceneTree::SUBSCRIPTION_MAX] = {NOT_SUBSCRIBED};
 	} data;
 
 	friend class SceneTree;
@@ -47,7 +60,7 @@ public:
 	Window *get_window() const;
 
 	GameObject *get_child(int p_index) const;
-	List<GameObject *> get_children() const;
+	FrameVector<GameObject *> get_children() const;
 	int get_child_count() const;
 	void add_child(GameObject *p_child);
 	void remove_child(GameObject *p_child);
@@ -4,6 +4,7 @@
 #include "scene/main/window.h"
 
 #include <core/object/command_queue.h>
+#include <core/object/thread_safe_command_queue.h>
 
 SceneTree *SceneTree::singleton = nullptr;
 
@@ -23,8 +24,92 @@ void SceneTree::flush_delete_queue() {
 	queued_nodes_for_deletion.clear();
 }
 
+SceneTree::Subscription SceneTree::_get_subscription(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_UPDATE:
+			return SUBSCRIPTION_UPDATE;
+		default:
+			return SUBSCRIPTION_MAX;
+	}
+}
+
+void SceneTree::_add_subscriber(GameObject *p_object) {
+	static const int notifications[SUBSCRIPTION_MAX] = {
+		NOTIFICATION_UPDATE,
+	};
+
+	for (int i = 0; i < SUBSCRIPTION_MAX; i++) {
+		if (p_object->data.subscriber_index[i] != GameObject::NOT_SUBSCRIBED ||
+			!p_object->handles_notification(notifications[i])) {
+			continue;
+		}
+
+		p_object->data.subscriber_index[i] = subscribers[i].objects.size();
+		subscribers[i].objects.push_back(p_object);
+	}
+}
+
+void SceneTree::_remove_subscriber(GameObject *p_object) {
+	for (int i = 0; i < SUBSCRIPTION_MAX; i++) {
+		uint32_t idx = p_object->data.subscriber_index[i];
+		if (idx == GameObject::NOT_SUBSCRIBED) {
+			continue;
+		}
+
+		// Left as a gap so that the objects after it keep their places, even while the list is being propagated.
+		SubscriberList &list = subscribers[i];
+		list.objects[idx] = nullptr;
+		list.removed++;
+		p_object->data.subscriber_index[i] = GameObject::NOT_SUBSCRIBED;
+
+		if (list.propagating == 0 && list.removed * 2 > list.objects.size()) {
+			_compact_subscribers((Subscription)i);
+		}
+	}
+}
+
+void SceneTree::_compact_subscribers(Subscription p_subscription) {
+	SubscriberList &list = subscribers[p_subscription];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < list.objects.size(); i++) {
+		GameObject *o = list.objects[i];
+		if (o) {
+			o->data.subscriber_index[p_subscription] = count;
+			list.objects[count++] = o;
+		}
+	}
+
+	list.objects.resize(count);
+	list.removed = 0;
+}
+
 void SceneTree::propagate_tree_notification(int p_what) {
-	root->propagate_notification(p_what);
+	Subscription subscription = _get_subscription(p_what);
+	if (subscription == SUBSCRIPTION_MAX) {
+		root->propagate_notification(p_what);
+		return;
+	}
+
+	SubscriberList &list = subscribers[subscription];
+	if (list.removed > 0 && list.propagating == 0) {
+		_compact_subscribers(subscription);
+	}
+
+	// Objects that enter the tree while propagating are only sent the notification the next time around.
+	uint32_t count = list.objects.size();
+	list.propagating++;
+	for (uint32_t i = 0; i < count; i++) {
+		GameObject *o = list.objects[i];
+		if (o) {
+			o->notification(p_what);
+		}
+	}
+	list.propagating--;
+}
+
+uint32_t SceneTree::get_subscriber_count(Subscription p_subscription) const {
+	ERR_FAIL_COND_R(p_subscription >= SUBSCRIPTION_MAX, 0);
+	return subscribers[p_subscription].objects.size() - subscribers[p_subscription].removed;
 }
 
 void SceneTree::set_active_camera(Camera3D *p_camera) {
@@ -60,6 +145,10 @@ void SceneTree::update(double p_delta) {
 
 	// Flush command queue once updated
 	GlobalCommandQueue::get_singleton()->flush();
+	// Then the calls deferred from other threads.
+	if (ThreadSafeCommandQueue::get_singleton()) {
+		ThreadSafeCommandQueue::get_singleton()->flush();
+	}
 
 	flush_delete_queue();
 }
@@ -71,7 +160,7 @@ void SceneTree::finalize() {
 SceneTree::SceneTree() {
 	singleton = this;
 
-	root = vnew(Window);
+	root = vnew_tagged(Window, MEMORY_TAG_OBJECT);
 	root->set_minimum_size(Vector2i(64, 64));
 	root->set_name("root");
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <core/data/list.h>
+#include <core/data/local_vector.h>
 #include <core/object/main_loop.h>
 
 #ifdef Window
@@ -24,6 +25,44 @@ private:
 
 	List<GameObject *> queued_nodes_for_deletion;
 
+public:
+	// The notifications that the tree keeps lists of interested objects for, so that sending them to the whole tree
+	// does not go through every object. Only notifications the tree actually sends to every object are listed, as
+	// keeping the lists costs something each time an object enters or exits the tree.
+	enum Subscription {
+		SUBSCRIPTION_UPDATE,
+		SUBSCRIPTION_MAX,
+	};
+
+private:
+	struct SubscriberList {
+		LocalVector<GameObject *> objects; // In the order they entered the tree, with `nullptr` for removed ones
+		uint32_t removed = 0;			   // The number of objects that were removed and left as `nullptr`
+		uint32_t propagating = 0;		   // How many propagations are currently going through the list
+	};
+
+	SubscriberList subscribers[SUBSCRIPTION_MAX];
+
+	/**
+	 * @brief Obtains the list the tree keeps for a notification, or `SUBSCRIPTION_MAX` if it does not keep one.
+	 */
+	static Subscription _get_subscription(int p_what);
+
+	/**
+	 * @brief Adds the object to the list of every notification it handles. Called when it enters the tree.
+	 */
+	void _add_subscriber(GameObject *p_object);
+
+	/**
+	 * @brief Takes the object off every list it is on. Called when it exits the tree.
+	 */
+	void _remove_subscriber(GameObject *p_object);
+
+	/**
+	 * @brief Removes the gaps left by removed objects from a list, and gives the objects their new places in it.
+	 */
+	void _compact_subscribers(Subscription p_subscription);
+
 public:
 	static SceneTree *get_singleton();
 
@@ -36,8 +75,17 @@ public:
 
 	double get_update_time() const;
 
+	/**
+	 * @brief Sends a notification to every object in the tree. `NOTIFICATION_UPDATE` only goes to the objects that
+	 * handle it, in the order they entered the tree, while every other notification goes down the tree from the root.
+	 */
 	void propagate_tree_notification(int p_what);
 
+	/**
+	 * @brief Obtains the number of objects that handle a notification the tree keeps a list for.
+	 */
+	uint32_t get_subscriber_count(Subscription p_subscription) const;
+
 	friend class Camera3D;
 	void set_active_camera(Camera3D *p_camera);
 	Camera3D *get_active_camera();
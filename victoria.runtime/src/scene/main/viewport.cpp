@@ -7,6 +7,8 @@
 
 #include <core/object/class_registry.h>
 
+SignalID Viewport::size_changed_signal = INVALID_SIGNAL_ID;
+
 void Viewport::_size_changed() {
 	texture_proxy->texture = RM::get_singleton()->viewport_get_texture(viewport);
 	texture_proxy->format = Texture::FORMAT_RGBA;
@@ -70,7 +72,7 @@ void Viewport::_propagate_size_changed(GameObject *p_object) {
 }
 
 void Viewport::_bind_methods() {
-	ClassRegistry::add_signal(get_class_name_static(), "size_changed");
+	size_changed_signal = ClassRegistry::add_signal(get_class_name_static(), SNAME("size_changed"));
 }
 
 Camera3D *Viewport::get_camera_3d() const {
@@ -105,7 +107,7 @@ void Viewport::set_viewport_size(const Vector2i &p_size) {
 	// Change viewport texture prior to notifying canvas items in case they need the texture
 	_size_changed();
 
-	emit_method(String("size_changed"));
+	emit_signal(size_changed_signal);
 
 	_propagate_size_changed(this);
 }
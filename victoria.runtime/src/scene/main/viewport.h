@@ -21,6 +21,7 @@ public:
 
 class VAPI Viewport : public GameObject {
 	VREGISTER_CLASS(Viewport, GameObject);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_EXIT_TREE);
 
 	RID viewport;
 	RID canvas;
@@ -37,6 +38,8 @@ class VAPI Viewport : public GameObject {
 		Vector2i min_size;
 	} data;
 
+	static SignalID size_changed_signal;
+
 	void _size_changed();
 
 protected:
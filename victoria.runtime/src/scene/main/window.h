@@ -6,6 +6,7 @@
 
 class VAPI Window : public Viewport {
 	VREGISTER_CLASS(Window, Viewport);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE);
 
 	uint8_t window_id = DisplayManager::INVALID_WINDOW_ID;
 
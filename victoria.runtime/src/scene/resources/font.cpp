@@ -1,9 +1,9 @@
 #include "scene/resources/font.h"
 
 Font::Character Font::get_character(char c) const {
-	RBMap<char, Character>::Element *e = font_map.find(c);
-	ERR_COND_NULL_R(e, Font::Character());
-	return e->value();
+	const Character *ch = font_map.get_ptr(c);
+	ERR_COND_NULL_R(ch, Font::Character());
+	return *ch;
 }
 
 void Font::set_character(char c, const Character &p_char) {
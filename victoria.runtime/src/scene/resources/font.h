@@ -1,6 +1,6 @@
 #pragma once
 
-#include <core/data/rb_map.h>
+#include <core/data/flat_map.h>
 #include <core/io/resource.h>
 #include <core/math/vector2i.h>
 
@@ -20,7 +20,11 @@ public:
 	void set_character(char c, const Character &p_char);
 
 protected:
-	RBMap<char, Character> font_map;
+	// Every glyph is inserted in order when the font is imported, and then looked up once per character of every text
+	// that uses the font, so the map is kept in sorted arrays.
+	typedef FlatMap<char, Character> CharacterMap;
+
+	CharacterMap font_map;
 	uint32_t font_size = 48;
 	uint32_t bitmap_size = 256;
 	uint32_t max_font_height = 0;
@@ -6,6 +6,7 @@
 
 class EditorCamera : public Camera3D {
 	VREGISTER_CLASS(EditorCamera, Camera3D);
+	VNOTIFICATIONS(NOTIFICATION_ENTER_TREE, NOTIFICATION_UPDATE);
 
 	Vector3 direction;
 	Vector3 o_position;
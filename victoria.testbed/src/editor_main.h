@@ -9,6 +9,7 @@
 
 class Editor : public GameObject {
 	VREGISTER_CLASS(Editor, GameObject);
+	VNOTIFICATIONS(NOTIFICATION_UPDATE);
 
 	Vector<Ref<Font>> editor_fonts;
 
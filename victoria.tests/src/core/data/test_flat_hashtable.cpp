@@ -0,0 +1,179 @@
+#include "core/data/test_flat_hashtable.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/flat_hashtable.h>
+#include <core/data/hashtable.h>
+#include <core/string/vstring.h>
+
+// The shared get/insert/erase tests are ran from `test_hashtable.cpp`. These check the behaviour specific to the flat
+// layout.
+
+static bool flat_hashtable_test_capacity() {
+	FlatHashTable<int, int> h(12);
+	TEST_EQ(h.size(), 0);
+	TEST_EQ(h.get_capacity(), 16); // Smallest capacity is a single group
+
+	for (int i = 0; i < 14; i++) {
+		h.insert(i, i);
+	}
+	TEST_EQ(h.get_capacity(), 16);
+	h.insert(14, 14);
+	TEST_EQ(h.get_capacity(), 32);
+
+	h.clear();
+	TEST_EQ(h.size(), 0);
+	TEST_EQ(h.get_capacity(), 32);
+	TEST_EQ(h.has(0), false);
+	return true;
+}
+
+// Fill enough keys that groups overflow into each other, then erase and reinsert them to leave deleted slots behind.
+static bool flat_hashtable_test_many_keys() {
+	FlatHashTable<int, int> h;
+	for (int i = 0; i < 10000; i++) {
+		h[i * 7] = i;
+	}
+	TEST_EQ(h.size(), 10000);
+
+	for (int i = 0; i < 10000; i += 2) {
+		TEST_EQ(h.erase(i * 7), true);
+	}
+	TEST_EQ(h.size(), 5000);
+	TEST_EQ(h.erase(0), false);
+
+	for (int i = 0; i < 10000; i++) {
+		const int *value = h.get_ptr(i * 7);
+		if (i % 2 == 0) {
+			TEST_EQ(value, nullptr);
+		} else {
+			TEST_NEQ(value, nullptr);
+			TEST_EQ(*value, i);
+		}
+	}
+
+	// Repeated erase/insert cycles of the same size should reuse deleted slots rather than grow the table
+	const int64_t capacity = h.get_capacity();
+	for (int cycle = 0; cycle < 8; cycle++) {
+		for (int i = 0; i < 10000; i += 2) {
+			h.insert(-1 - i - cycle * 10000, i);
+		}
+		for (int i = 0; i < 10000; i += 2) {
+			h.erase(-1 - i - cycle * 10000);
+		}
+	}
+	TEST_EQ(h.size(), 5000);
+	TEST_EQ(h.get_capacity(), capacity);
+
+	int64_t count = 0;
+	for (const KeyValue<int, int> &kv : h) {
+		TEST_EQ(kv.key, kv.value * 7);
+		count++;
+	}
+	TEST_EQ(count, 5000);
+	return true;
+}
+
+static bool flat_hashtable_test_strings() {
+	FlatHashTable<String, int> h;
+	for (int i = 0; i < 256; i++) {
+		h.insert(vformat("key_%d", i), i);
+	}
+	TEST_EQ(h.size(), 256);
+	TEST_EQ(h.get("key_0"), 0);
+	TEST_EQ(h.get("key_255"), 255);
+	TEST_EQ(h.has("key_256"), false);
+
+	h.insert("key_12", 400);
+	TEST_EQ(h.size(), 256);
+	TEST_EQ(h["key_12"], 400);
+	return true;
+}
+
+// Inserting values that live in the table itself, which has to keep working when the insert grows the table and
+// moves its elements.
+static bool flat_hashtable_test_aliasing() {
+	FlatHashTable<String, String> h;
+	h.insert("key_0", "value_0");
+	for (int i = 1; i < 256; i++) {
+		h.insert(vformat("key_%d", i), h["key_0"]);
+		h.insert(vformat("copy_%d", i), h.get(vformat("key_%d", i)));
+	}
+
+	TEST_EQ(h.size(), 511);
+	for (const KeyValue<String, String> &kv : h) {
+		TEST_EQ(kv.value, "value_0");
+	}
+	return true;
+}
+
+void flat_hashtable_register_tests() {
+	register_test(flat_hashtable_test_capacity, "FlatHashTable growing and clearing its capacity");
+	register_test(flat_hashtable_test_many_keys, "FlatHashTable inserting, erasing and reusing many keys");
+	register_test(flat_hashtable_test_strings, "FlatHashTable insertion and lookup with String keys");
+	register_test(flat_hashtable_test_aliasing, "FlatHashTable insertion of keys and values held by the table itself");
+}
+
+static constexpr int FLAT_HASHTABLE_BENCH_ELEMENTS = 100000;
+static constexpr int FLAT_HASHTABLE_BENCH_LOOKUPS = 1000000;
+// Lookups step through the keys by a prime stride, so that they are not made in insertion order. Chained tables
+// allocate their elements in insertion order, which would otherwise give them an unrealistically warm cache.
+static constexpr int FLAT_HASHTABLE_BENCH_STRIDE = 7919;
+
+template <typename TTable>
+static void flat_hashtable_bench_int(const char *p_label) {
+	TTable h;
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < FLAT_HASHTABLE_BENCH_ELEMENTS; i++) {
+		h.insert(i * 31, i);
+	}
+	benchmark_report(
+		vformat("%s insert (int)", p_label), FLAT_HASHTABLE_BENCH_ELEMENTS, benchmark_get_time_usec() - start);
+
+	int64_t found = 0;
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < FLAT_HASHTABLE_BENCH_LOOKUPS; i++) {
+		// Half of the lookups miss
+		int key = (int)(((int64_t)i * FLAT_HASHTABLE_BENCH_STRIDE) % (FLAT_HASHTABLE_BENCH_ELEMENTS * 2));
+		found += h.get_ptr(key * 31) != nullptr;
+	}
+	benchmark_report(
+		vformat("%s lookup (int)", p_label), FLAT_HASHTABLE_BENCH_LOOKUPS, benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(found == 0);
+}
+
+template <typename TTable>
+static void flat_hashtable_bench_string(const char *p_label) {
+	Vector<String> keys;
+	keys.reserve(FLAT_HASHTABLE_BENCH_ELEMENTS);
+	for (int i = 0; i < FLAT_HASHTABLE_BENCH_ELEMENTS; i++) {
+		keys.push_back(vformat("GameObject%d", i));
+	}
+
+	TTable h;
+	for (int i = 0; i < FLAT_HASHTABLE_BENCH_ELEMENTS; i++) {
+		h.insert(keys[i], i);
+	}
+
+	int64_t found = 0;
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < FLAT_HASHTABLE_BENCH_LOOKUPS; i++) {
+		int idx = (int)(((int64_t)i * FLAT_HASHTABLE_BENCH_STRIDE) % FLAT_HASHTABLE_BENCH_ELEMENTS);
+		found += h.get_ptr(keys[idx]) != nullptr;
+	}
+	benchmark_report(
+		vformat("%s lookup (String)", p_label), FLAT_HASHTABLE_BENCH_LOOKUPS, benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(found == 0);
+}
+
+static void flat_hashtable_bench_lookup() {
+	flat_hashtable_bench_int<HashTable<int, int>>("HashTable");
+	flat_hashtable_bench_int<FlatHashTable<int, int>>("FlatHashTable");
+	flat_hashtable_bench_string<HashTable<String, int>>("HashTable");
+	flat_hashtable_bench_string<FlatHashTable<String, int>>("FlatHashTable");
+}
+
+void flat_hashtable_register_benchmarks() {
+	register_benchmark(flat_hashtable_bench_lookup, "FlatHashTable against HashTable for insertion and lookup");
+}
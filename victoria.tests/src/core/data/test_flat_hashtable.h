@@ -0,0 +1,5 @@
+#pragma once
+
+void flat_hashtable_register_tests();
+
+void flat_hashtable_register_benchmarks();
@@ -0,0 +1,183 @@
+#include "core/data/test_flat_map.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/flat_map.h>
+#include <core/data/local_vector.h>
+#include <core/data/rb_map.h>
+
+static bool flat_map_test_insert() {
+	FlatMap<int, int> m;
+	TEST_EQ(m.is_empty(), true);
+	TEST_EQ(m.get_ptr(1), nullptr);
+
+	int keys[] = {5, 1, 9, 3, 7};
+	for (int key : keys) {
+		m.insert(key, key * 10);
+	}
+	m.insert(3, 33); // Overwrites
+	TEST_EQ(m.size(), 5);
+	TEST_EQ(m[3], 33);
+	TEST_EQ(*m.get_ptr(9), 90);
+	TEST_EQ(m.has(4), false);
+
+	// Iteration is in key order, like `RBMap`
+	int last = -1;
+	for (const FlatMap<int, int>::Element &kv : m) {
+		TEST_EQ((kv.key > last), true);
+		last = kv.key;
+	}
+	TEST_EQ(last, 9);
+
+	FlatMap<int, int>::Iterator it = m.find(5);
+	TEST_EQ((bool)it, true);
+	TEST_EQ(it.value(), 50);
+	it.value() = 55;
+	TEST_EQ(m[5], 55);
+	++it;
+	TEST_EQ(it.key(), 7);
+	--it;
+	--it;
+	TEST_EQ(it.key(), 3);
+	TEST_EQ((bool)m.find(4), false);
+	TEST_EQ((m.find(4) == m.end()), true);
+
+	TEST_EQ(m.erase(1), true);
+	TEST_EQ(m.erase(1), false);
+	TEST_EQ(m.size(), 4);
+	TEST_EQ(m.begin().key(), 3);
+
+	FlatMap<int, int> copy(m);
+	m.clear();
+	TEST_EQ(m.is_empty(), true);
+	TEST_EQ(copy.size(), 4);
+	FlatMap<int, int> moved = std::move(copy);
+	TEST_EQ(moved[9], 90);
+	TEST_EQ(copy.size(), 0);
+	return true;
+}
+
+static bool flat_map_test_bulk() {
+	// Unsorted input with duplicates, of which the last value is kept
+	FlatMap<int, char> m = {{4, 'a'}, {2, 'b'}, {4, 'c'}, {1, 'd'}, {2, 'e'}};
+	TEST_EQ(m.size(), 3);
+	TEST_EQ(m[1], 'd');
+	TEST_EQ(m[2], 'e');
+	TEST_EQ(m[4], 'c');
+
+	LocalVector<int> keys;
+	LocalVector<int> values;
+	uint32_t state = 7;
+	for (int i = 0; i < 1000; i++) {
+		state = state * 1664525 + 1013904223;
+		keys.push_back((state >> 8) % 5000);
+		values.push_back(i);
+	}
+
+	FlatMap<int, int> big;
+	big.assign(keys.ptr(), values.ptr(), keys.size());
+	RBMap<int, int> reference;
+	for (uint32_t i = 0; i < keys.size(); i++) {
+		reference.insert(keys[i], values[i]);
+	}
+	TEST_EQ(big.size(), reference.size());
+
+	RBMap<int, int>::Iterator ref = reference.begin();
+	for (const FlatMap<int, int>::Element &kv : big) {
+		TEST_EQ(kv.key, (*ref).key);
+		TEST_EQ(kv.value, (*ref).value);
+		++ref;
+	}
+	return true;
+}
+
+static bool flat_map_test_search_index() {
+	// Every size up to a few full levels of the implicit tree, with every key present and every gap missing
+	for (int size = 0; size < 70; size++) {
+		FlatMap<int, int> m;
+		for (int i = 0; i < size; i++) {
+			m.insert(i * 2 + 1, i);
+		}
+		m.build_search_index();
+		TEST_EQ(m.has_search_index(), (size > 0));
+
+		for (int i = 0; i <= size * 2 + 1; i++) {
+			const int *value = m.get_ptr(i);
+			if (i & 1 && i < size * 2) {
+				TEST_NEQ(value, nullptr);
+				TEST_EQ(*value, i / 2);
+			} else {
+				TEST_EQ(value, nullptr);
+			}
+		}
+	}
+
+	FlatMap<int, int> m = {{1, 1}, {2, 2}};
+	m.build_search_index();
+	m.insert(3, 3);
+	TEST_EQ(m.has_search_index(), false);
+	TEST_EQ(m[3], 3);
+	return true;
+}
+
+void flat_map_register_tests() {
+	register_test(flat_map_test_insert, "FlatMap insertion, ordered iteration and erasure");
+	register_test(flat_map_test_bulk, "FlatMap bulk construction from unsorted keys with duplicates");
+	register_test(flat_map_test_search_index, "FlatMap lookups through the Eytzinger search index");
+}
+
+static constexpr int FLAT_MAP_BENCH_LOOKUPS = 2000000;
+
+static void flat_map_bench_lookup_size(int p_size) {
+	RBMap<int, int> rb;
+	FlatMap<int, int> flat;
+	// Inserted in a scattered order, as RBMap degrades badly when filled with keys that are already sorted.
+	LocalVector<int> keys;
+	LocalVector<int> values;
+	for (int i = 0; i < p_size; i++) {
+		int key = (int)(((int64_t)i * 7919) % p_size) * 3;
+		rb.insert(key, i);
+		keys.push_back(key);
+		values.push_back(i);
+	}
+	flat.assign(keys.ptr(), values.ptr(), keys.size());
+
+	int64_t sum = 0;
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < FLAT_MAP_BENCH_LOOKUPS; i++) {
+		RBMap<int, int>::Element *e = rb.find((int)(((int64_t)i * 7919) % p_size) * 3);
+		sum += e->value();
+	}
+	benchmark_report(vformat("RBMap find, %d elements", p_size),
+					 FLAT_MAP_BENCH_LOOKUPS,
+					 benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < FLAT_MAP_BENCH_LOOKUPS; i++) {
+		sum += *flat.get_ptr((int)(((int64_t)i * 7919) % p_size) * 3);
+	}
+	benchmark_report(vformat("FlatMap find, %d elements", p_size),
+					 FLAT_MAP_BENCH_LOOKUPS,
+					 benchmark_get_time_usec() - start);
+
+	flat.build_search_index();
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < FLAT_MAP_BENCH_LOOKUPS; i++) {
+		sum += *flat.get_ptr((int)(((int64_t)i * 7919) % p_size) * 3);
+	}
+	benchmark_report(vformat("FlatMap find (Eytzinger), %d elements", p_size),
+					 FLAT_MAP_BENCH_LOOKUPS,
+					 benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(sum == 0);
+}
+
+static void flat_map_bench_lookup() {
+	// About the size of a font's glyph table, and a map far larger than the cache.
+	flat_map_bench_lookup_size(95);
+	flat_map_bench_lookup_size(100000);
+}
+
+void flat_map_register_benchmarks() {
+	register_benchmark(flat_map_bench_lookup, "FlatMap against RBMap for looking up keys");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void flat_map_register_tests();
+
+void flat_map_register_benchmarks();
@@ -0,0 +1,151 @@
+#include "core/data/test_hashfuncs.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/flat_hashtable.h>
+#include <core/data/hashfuncs.h>
+#include <core/data/hashtable.h>
+#include <core/data/rid.h>
+#include <core/math/vector2.h>
+#include <core/math/vector2i.h>
+#include <core/math/vector3i.h>
+#include <core/math/vector4.h>
+#include <core/string/vstring.h>
+
+static bool hashfuncs_test_bytes() {
+	uint8_t data[256];
+	for (int i = 0; i < 256; i++) {
+		data[i] = (uint8_t)(i * 37 + 11);
+	}
+
+	// Every length takes a different path through the hash, and every prefix must hash differently.
+	HashTable<uint64_t, int> seen;
+	for (int len = 0; len <= 256; len++) {
+		uint64_t h = hash_bytes(data, len);
+		TEST_EQ(h, hash_bytes(data, len));
+		TEST_EQ(seen.has(h), false);
+		seen.insert(h, len);
+	}
+
+	// Trailing zeros are part of the hash, since the length is.
+	uint8_t zeros[8] = {0};
+	TEST_EQ((hash_bytes(zeros, 3) != hash_bytes(zeros, 4)), true);
+	TEST_EQ((hash_bytes(data, 64) != hash_bytes(data, 64, 1)), true);
+
+	// Flipping any single bit changes the hash.
+	for (int len = 1; len <= 100; len += 33) {
+		uint64_t h = hash_bytes(data, len);
+		for (int bit = 0; bit < len * 8; bit++) {
+			data[bit / 8] ^= 1 << (bit % 8);
+			uint64_t flipped = hash_bytes(data, len);
+			data[bit / 8] ^= 1 << (bit % 8);
+			TEST_EQ((flipped != h), true);
+		}
+	}
+
+	TEST_EQ(HasherDefault::hash("key"), hash_string("key", 3));
+	TEST_EQ(HasherDefault::hash(String("key")), hash_string("key", 3));
+
+	return true;
+}
+
+static bool hashfuncs_test_mix() {
+	// Sequential keys must spread over the low bits, which are the ones used to pick a bucket.
+	bool buckets[256] = {false};
+	int used = 0;
+	for (uint64_t i = 0; i < 256; i++) {
+		uint32_t h = HasherDefault::hash(i << 32);
+		used += !buckets[h & 255];
+		buckets[h & 255] = true;
+	}
+	TEST_EQ((used > 140), true);
+
+	TEST_EQ((HasherDefault::hash((int64_t)-1) != HasherDefault::hash((int64_t)1)), true);
+	TEST_EQ(HasherDefault::hash(0.0), HasherDefault::hash(-0.0));
+	TEST_EQ((HasherDefault::hash(1.0) != HasherDefault::hash(2.0)), true);
+	TEST_EQ((hash_combine(hash_combine(HASH_SECRET[0], 1), 2) != hash_combine(hash_combine(HASH_SECRET[0], 2), 1)),
+			true);
+
+	return true;
+}
+
+static bool hashfuncs_test_keys() {
+	HashTable<Vector2i, int> cells;
+	for (int i = 0; i < 64; i++) {
+		cells.insert(Vector2i(i % 8, i / 8), i);
+	}
+	TEST_EQ(cells.size(), 64);
+	TEST_EQ(cells[Vector2i(3, 5)], 43);
+	TEST_EQ((HasherDefault::hash(Vector2i(1, 2)) != HasherDefault::hash(Vector2i(2, 1))), true);
+	TEST_EQ((HasherDefault::hash(Vector3i(1, 2, 3)) != HasherDefault::hash(Vector3i(3, 2, 1))), true);
+	TEST_EQ(HasherDefault::hash(Vector2(0.0, 1.5)), HasherDefault::hash(Vector2(-0.0, 1.5)));
+	TEST_EQ((HasherDefault::hash(Vector4(1, 2, 3, 4)) != HasherDefault::hash(Vector4(1, 2, 4, 3))), true);
+
+	int values[4] = {0};
+	FlatHashTable<const int *, int> pointers;
+	for (int i = 0; i < 4; i++) {
+		pointers.insert(&values[i], i);
+	}
+	TEST_EQ(pointers[&values[2]], 2);
+
+	HashTable<RID, int> rids;
+	rids.insert(RID(), 1);
+	TEST_EQ(rids[RID()], 1);
+
+	FlatHashTable<int64_t, int> wide;
+	wide.insert(-5, 1);
+	wide.insert(1ll << 40, 2);
+	TEST_EQ(wide[-5], 1);
+	TEST_EQ(wide[1ll << 40], 2);
+
+	return true;
+}
+
+void hashfuncs_register_tests() {
+	register_test(hashfuncs_test_bytes, "Hashing bytes of every length and detecting single-bit changes");
+	register_test(hashfuncs_test_mix, "Hashing integers, floats and combined values");
+	register_test(hashfuncs_test_keys, "Hashing vectors, pointers, RIDs and 64-bit integers as hash table keys");
+}
+
+static constexpr uint64_t HASHFUNCS_BENCH_BYTES = 64 * 1024 * 1024;
+
+static void hashfuncs_bench_bytes() {
+	constexpr int sizes[] = {8, 24, 64, 256, 4096};
+	char data[4097];
+	for (int i = 0; i < 4096; i++) {
+		data[i] = 'a' + (i * 7) % 26;
+	}
+
+	uint64_t sum = 0;
+	for (int size : sizes) {
+		// djb2 reads up to a terminator, so the buffer is cut at the length being measured.
+		data[size] = 0;
+		uint64_t iterations = HASHFUNCS_BENCH_BYTES / size;
+
+		uint64_t start = benchmark_get_time_usec();
+		for (uint64_t i = 0; i < iterations; i++) {
+			data[0] = 'a' + (i & 15);
+			sum += hash_djb2((uint8_t *)data);
+		}
+		benchmark_report_bytes(vformat("hash_djb2, %d bytes", size),
+							   iterations * size,
+							   benchmark_get_time_usec() - start);
+
+		start = benchmark_get_time_usec();
+		for (uint64_t i = 0; i < iterations; i++) {
+			data[0] = 'a' + (i & 15);
+			sum += hash_bytes(data, size);
+		}
+		benchmark_report_bytes(vformat("hash_bytes, %d bytes", size),
+							   iterations * size,
+							   benchmark_get_time_usec() - start);
+
+		data[size] = 'a' + (size * 7) % 26;
+	}
+	ERR_FAIL_COND(sum == 0);
+}
+
+void hashfuncs_register_benchmarks() {
+	register_benchmark(hashfuncs_bench_bytes, "Bytes hashed per second by hash_djb2 and hash_bytes");
+}
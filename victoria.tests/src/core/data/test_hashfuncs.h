@@ -0,0 +1,5 @@
+#pragma once
+
+void hashfuncs_register_tests();
+
+void hashfuncs_register_benchmarks();
@@ -3,19 +3,34 @@
 #include "test_macros.h"
 #include "test_manager.h"
 
+#include <core/data/flat_hashtable.h>
 #include <core/data/hashtable.h>
 
+#include <type_traits>
+
 struct hashstruct1 {
 	bool used;
 	int i;
 };
 
+// The generic tests are ran against every hashtable implementation. Capacities and pointer stability differ between
+// them, so those are only checked by the tests for each implementation.
+template <typename TKey, typename TValue>
+using HashTableDefault = HashTable<TKey, TValue>;
+
+template <typename TKey, typename TValue>
+using FlatHashTableDefault = FlatHashTable<TKey, TValue>;
+
+template <template <typename, typename> class THashTable>
+static constexpr bool is_chained_hashtable = std::is_same_v<THashTable<int, int>, HashTable<int, int>>;
+
 // Initializer/assignment tests
 // We test for assignment operators where possible simply because their constructor is identical bar a handful of
 // guards.
 
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_init_empty() {
-	HashTable<int, int> h;
+	THashTable<int, int> h;
 	TEST_EQ(h.size(), 0);
 	TEST_EQ(h.is_empty(), true);
 	return true;
@@ -28,39 +43,43 @@ static bool hashtable_test_init_capacity() {
 	return true;
 }
 
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_init_initializer() {
-	HashTable<int, int> h{{1, 1}, {2, 2}, {3, 3}};
+	THashTable<int, int> h{{1, 1}, {2, 2}, {3, 3}};
 	TEST_EQ(h.size(), 3);
 	h = {{4, 4}, {5, 5}};
 	TEST_EQ(h.size(), 2);
 	return true;
 }
 
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_init_copy_from() {
-	HashTable<int, bool> h = {{0, true}, {1, false}};
+	THashTable<int, bool> h = {{0, true}, {1, false}};
 	TEST_EQ(h.size(), 2);
-	HashTable<int, bool> h2 = HashTable<int, bool>(h); // Require explicit creation
+	THashTable<int, bool> h2 = THashTable<int, bool>(h); // Require explicit creation
 	TEST_EQ(h2.size(), 2);
-	HashTable<int, bool> h3(h2);
+	THashTable<int, bool> h3(h2);
 	TEST_EQ(h3.size(), 2);
 	return true;
 }
 
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_move() {
-	HashTable<int, bool> h = {{0, true}, {1, false}, {2, true}};
+	THashTable<int, bool> h = {{0, true}, {1, false}, {2, true}};
 	TEST_EQ(h.size(), 3);
-	HashTable<int, bool> h2 = std::move(h);
+	THashTable<int, bool> h2 = std::move(h);
 	TEST_EQ(h2.size(), 3);
 	TEST_EQ(h.size(), 0);
-	HashTable<int, bool> h3(std::move(h2));
+	THashTable<int, bool> h3(std::move(h2));
 	TEST_EQ(h3.size(), 3);
 	TEST_EQ(h2.size(), 0);
 	return true;
 }
 
 // Test for if referenced data is actually mutable and consistent without hashing.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_get() {
-	HashTable<int, bool> h = {{0, true}, {1, false}, {2, false}};
+	THashTable<int, bool> h = {{0, true}, {1, false}, {2, false}};
 	bool &value = h.get(1);
 	TEST_EQ(value, false);
 	const bool &value2 = h.get(1);
@@ -72,8 +91,9 @@ static bool hashtable_test_get() {
 }
 
 // Test for if pointers to data are the same for const and non-const pointers.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_get_ptr() {
-	HashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
+	THashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
 	bool *value = h.get_ptr(0);
 	TEST_NEQ(value, nullptr);
 	TEST_EQ(*value, true);
@@ -88,8 +108,9 @@ static bool hashtable_test_get_ptr() {
 }
 
 // Test if operator[] returns the correct data, and if that data is properly referenced.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_bracket_operator() {
-	HashTable<int, int> h = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+	THashTable<int, int> h = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
 	int &x = h[2];
 	TEST_EQ(x, 2);
 	const int &x2 = h[2];
@@ -101,8 +122,9 @@ static bool hashtable_test_bracket_operator() {
 }
 
 // Test if our Iterator and ConstIterator struct function correctly.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_iterator() {
-	HashTable<int, int> h = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+	THashTable<int, int> h = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
 	for (KeyValue<int, int> &kv : h) {
 		TEST_EQ(kv.key, kv.value);
 		kv.value += 2;
@@ -115,8 +137,9 @@ static bool hashtable_test_iterator() {
 }
 
 // Test if the `has()` function works correctly.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_has() {
-	HashTable<int, bool> h = {{0, true}, {2, false}, {4, false}, {6, true}};
+	THashTable<int, bool> h = {{0, true}, {2, false}, {4, false}, {6, true}};
 	TEST_EQ(h.has(0), true);
 	TEST_EQ(h.has(6), true);
 	TEST_EQ(h.has(10), false);
@@ -125,26 +148,30 @@ static bool hashtable_test_has() {
 }
 
 // Test if the `insert()` function works on pre-existing data as well as initializing data.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_insert() {
-	HashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
+	THashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
 	h.insert(6, false);
 	TEST_EQ(h.size(), 5);
 	TEST_EQ(h.get(6), false);
-	HashTable<int, bool> h2;
+	THashTable<int, bool> h2;
 	h2.insert(1, false);
 	TEST_EQ(h2.size(), 1);
-	TEST_EQ(h2.get_capacity(), 5);
+	if constexpr (is_chained_hashtable<THashTable>) {
+		TEST_EQ(h2.get_capacity(), 5);
+	}
 	TEST_EQ(h2.get(1), false);
 	return true;
 }
 
 // Test if `operator[]` actually inserts data as expected by user code.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_bracket_insert() {
-	HashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
+	THashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
 	h[6] = false;
 	TEST_EQ(h.size(), 5);
 	TEST_EQ(h[6], false);
-	HashTable<int, bool> h2;
+	THashTable<int, bool> h2;
 	h2[12] = true;
 	TEST_EQ(h2.size(), 1);
 	TEST_EQ(h2[12], true);
@@ -180,8 +207,9 @@ static bool hashtable_test_pointer_info() {
 }
 
 // Test if data is properly erased when requested.
+template <template <typename, typename> class THashTable>
 static bool hashtable_test_erase() {
-	HashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
+	THashTable<int, bool> h = {{0, true}, {1, false}, {2, false}, {3, true}};
 	h.erase(0);
 	TEST_EQ(h.has(0), false);
 	TEST_EQ(h.size(), 3);
@@ -201,21 +229,212 @@ static bool hashtable_test_erase_rehash() {
 	return true;
 }
 
+// Sends every key to one of two slots at the very end of a table with a capacity of 97, so that probe sequences are
+// long and wrap around to the start of the table.
+struct HasherWrapping {
+	static uint32_t hash(int p_key) {
+		return 95 + (p_key & 1);
+	}
+};
+
+// Gives every key the same hash, so that only comparing the keys themselves can tell them apart.
+struct HasherConstant {
+	static uint32_t hash(int p_key) {
+		return 12345;
+	}
+};
+
+// Maps every key onto the same few slots for most capacities the table passes through.
+struct HasherMultiples {
+	static uint32_t hash(int p_key) {
+		return (uint32_t)(p_key & 7) * 3 * 5 * 11 * 29 * 97 + 1;
+	}
+};
+
+template <typename TTable>
+static uint32_t hashtable_get_histogram_total(const TTable &p_table, uint32_t &r_max_distance) {
+	uint32_t histogram[16];
+	r_max_distance = p_table.get_probe_histogram(histogram, 16);
+	uint32_t total = 0;
+	for (uint32_t count : histogram) {
+		total += count;
+	}
+	return total;
+}
+
+static bool hashtable_test_wraparound() {
+	HashTable<int, int, HasherWrapping> h(97);
+	TEST_EQ(h.get_capacity(), 97);
+	for (int i = 0; i < 40; i++) {
+		h.insert(i, i * 2);
+	}
+	TEST_EQ(h.get_capacity(), 97);
+
+	uint32_t max_distance = 0;
+	TEST_EQ(hashtable_get_histogram_total(h, max_distance), 40);
+	TEST_EQ((max_distance >= 38), true);
+
+	for (int i = 0; i < 40; i += 3) {
+		TEST_EQ(h.erase(i), true);
+	}
+	for (int i = 0; i < 40; i++) {
+		TEST_EQ(h.has(i), (i % 3 != 0));
+		if (i % 3 != 0) {
+			TEST_EQ(h[i], i * 2);
+		}
+	}
+	TEST_EQ(h.erase(0), false);
+	TEST_EQ(hashtable_get_histogram_total(h, max_distance), h.size());
+
+	// Erasing everything must leave every slot empty again
+	for (int i = 0; i < 40; i++) {
+		h.erase(i);
+	}
+	TEST_EQ(h.size(), 0);
+	TEST_EQ(hashtable_get_histogram_total(h, max_distance), 0);
+	TEST_EQ(max_distance, 0);
+	return true;
+}
+
+static bool hashtable_test_collisions() {
+	HashTable<int, int, HasherConstant> h;
+	for (int i = 0; i < 200; i++) {
+		h.insert(i, i);
+	}
+	TEST_EQ(h.size(), 200);
+	h.insert(100, -1); // Inserting an existing key overwrites it
+	TEST_EQ(h.size(), 200);
+	TEST_EQ(h[100], -1);
+	for (int i = 0; i < 200; i += 2) {
+		h.erase(i);
+	}
+	for (int i = 0; i < 200; i++) {
+		TEST_EQ(h.has(i), ((i & 1) == 1));
+	}
+	TEST_EQ(h.has(200), false);
+	return true;
+}
+
+static bool hashtable_test_stress() {
+	constexpr int key_count = 512;
+	bool present[key_count] = {false};
+	int values[key_count] = {0};
+	int64_t present_count = 0;
+
+	HashTable<int, int, HasherMultiples> h;
+	uint32_t state = 12345;
+	for (int i = 0; i < 20000; i++) {
+		state = state * 1664525 + 1013904223;
+		int key = (state >> 8) % key_count;
+		if ((state >> 28) < 10) {
+			if (!present[key]) {
+				present_count++;
+			}
+			h[key] = i;
+			present[key] = true;
+			values[key] = i;
+		} else {
+			TEST_EQ(h.erase(key), present[key]);
+			present_count -= present[key];
+			present[key] = false;
+		}
+	}
+
+	TEST_EQ(h.size(), present_count);
+	for (int i = 0; i < key_count; i++) {
+		TEST_EQ(h.has(i), present[i]);
+		if (present[i]) {
+			TEST_EQ(h[i], values[i]);
+		}
+	}
+
+	int64_t iterated = 0;
+	for (const KeyValue<int, int> &kv : h) {
+		TEST_EQ(present[kv.key], true);
+		iterated++;
+	}
+	TEST_EQ(iterated, present_count);
+
+	uint32_t max_distance = 0;
+	TEST_EQ(hashtable_get_histogram_total(h, max_distance), present_count);
+	return true;
+}
+
+static bool hashtable_test_load_factor() {
+	HashTable<int, int> h = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+	h[4] = 4;
+	TEST_EQ(h.get_capacity(), 11);
+	h.set_max_load_factor(0.5f);
+	TEST_EQ(h.get_capacity(), 11);
+	h[5] = 5;
+	TEST_EQ(h.get_capacity(), 29);
+
+	// Lowering the limit below the current load grows the table straight away
+	h.set_max_load_factor(0.1f);
+	TEST_EQ(h.get_capacity(), 97);
+	TEST_EQ(h[3], 3);
+
+	h.set_max_load_factor(2.0f);
+	TEST_EQ(h.get_max_load_factor(), 0.1f);
+
+	HashTable<int, int> h2 = HashTable<int, int>(h);
+	TEST_EQ(h2.get_max_load_factor(), 0.1f);
+	TEST_EQ(h2.size(), 6);
+
+	HashTable<int, int> h3;
+	for (int i = 0; i < 1000; i++) {
+		h3.insert(i, i);
+	}
+	uint32_t max_distance = 0;
+	TEST_EQ(hashtable_get_histogram_total(h3, max_distance), 1000);
+	return true;
+}
+
 void hashtable_register_tests() {
-	register_test(hashtable_test_init_empty, "Hashtable construction with no parameters");
+	register_test(hashtable_test_init_empty<HashTableDefault>, "Hashtable construction with no parameters");
 	register_test(hashtable_test_init_capacity, "Hashtable creation with a predetermined capacity");
-	register_test(hashtable_test_init_initializer, "Hashtable creation and assignment using std::initializer_list");
-	register_test(hashtable_test_init_copy_from, "Hashtable contruction with copy-from assignment");
-	register_test(hashtable_test_move, "Hashtable construction from std::move operations");
-	register_test(hashtable_test_get, "Hashtable get function using regular and constant values");
-	register_test(hashtable_test_get_ptr, "Hashtable get_ptr function using regular and constant values");
-	register_test(hashtable_test_bracket_operator, "Hashtable reading and modifying data using the [] operator");
-	register_test(hashtable_test_iterator, "Hashtable reading using constant and non-constant iterators");
-	register_test(hashtable_test_has, "Hashtable entry checking using the has function");
-	register_test(hashtable_test_insert, "Hashtable insertion from empty and with existing elements");
-	register_test(hashtable_test_bracket_insert, "Hashtable insertion using the [] operator");
+	register_test(hashtable_test_init_initializer<HashTableDefault>,
+				  "Hashtable creation and assignment using std::initializer_list");
+	register_test(hashtable_test_init_copy_from<HashTableDefault>, "Hashtable contruction with copy-from assignment");
+	register_test(hashtable_test_move<HashTableDefault>, "Hashtable construction from std::move operations");
+	register_test(hashtable_test_get<HashTableDefault>, "Hashtable get function using regular and constant values");
+	register_test(hashtable_test_get_ptr<HashTableDefault>,
+				  "Hashtable get_ptr function using regular and constant values");
+	register_test(hashtable_test_bracket_operator<HashTableDefault>,
+				  "Hashtable reading and modifying data using the [] operator");
+	register_test(hashtable_test_iterator<HashTableDefault>,
+				  "Hashtable reading using constant and non-constant iterators");
+	register_test(hashtable_test_has<HashTableDefault>, "Hashtable entry checking using the has function");
+	register_test(hashtable_test_insert<HashTableDefault>,
+				  "Hashtable insertion from empty and with existing elements");
+	register_test(hashtable_test_bracket_insert<HashTableDefault>, "Hashtable insertion using the [] operator");
 	register_test(hashtable_test_reference_info, "Hashtable reading and writing after a rehash using references");
 	register_test(hashtable_test_pointer_info, "Hashtable reading and writing after a reshash using pointers");
-	register_test(hashtable_test_erase, "Hashtable erasing individual information");
+	register_test(hashtable_test_erase<HashTableDefault>, "Hashtable erasing individual information");
 	register_test(hashtable_test_erase_rehash, "Hashtable erasing and re-inserting over a remap boundary");
+	register_test(hashtable_test_wraparound, "Hashtable probing and erasing across the end of the table");
+	register_test(hashtable_test_collisions, "Hashtable telling apart keys that share a hash");
+	register_test(hashtable_test_stress, "Hashtable random insertion and erasure with clustered hashes");
+	register_test(hashtable_test_load_factor, "Hashtable maximum load factor and probe histogram");
+
+	register_test(hashtable_test_init_empty<FlatHashTableDefault>, "FlatHashTable construction with no parameters");
+	register_test(hashtable_test_init_initializer<FlatHashTableDefault>,
+				  "FlatHashTable creation and assignment using std::initializer_list");
+	register_test(hashtable_test_init_copy_from<FlatHashTableDefault>,
+				  "FlatHashTable contruction with copy-from assignment");
+	register_test(hashtable_test_move<FlatHashTableDefault>, "FlatHashTable construction from std::move operations");
+	register_test(hashtable_test_get<FlatHashTableDefault>,
+				  "FlatHashTable get function using regular and constant values");
+	register_test(hashtable_test_get_ptr<FlatHashTableDefault>,
+				  "FlatHashTable get_ptr function using regular and constant values");
+	register_test(hashtable_test_bracket_operator<FlatHashTableDefault>,
+				  "FlatHashTable reading and modifying data using the [] operator");
+	register_test(hashtable_test_iterator<FlatHashTableDefault>,
+				  "FlatHashTable reading using constant and non-constant iterators");
+	register_test(hashtable_test_has<FlatHashTableDefault>, "FlatHashTable entry checking using the has function");
+	register_test(hashtable_test_insert<FlatHashTableDefault>,
+				  "FlatHashTable insertion from empty and with existing elements");
+	register_test(hashtable_test_bracket_insert<FlatHashTableDefault>,
+				  "FlatHashTable insertion using the [] operator");
+	register_test(hashtable_test_erase<FlatHashTableDefault>, "FlatHashTable erasing individual information");
 }
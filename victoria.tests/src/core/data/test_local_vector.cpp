@@ -0,0 +1,168 @@
+#include "core/data/test_local_vector.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/local_vector.h>
+#include <core/data/vector.h>
+#include <core/string/vstring.h>
+
+struct localvectortest1 {
+	uint32_t start = 0;
+	uint32_t count = 0;
+	int ysort = 0;
+};
+
+static bool local_vector_test_basic() {
+	LocalVector<int> vec;
+	TEST_EQ(vec.size(), 0u);
+	TEST_EQ(vec.ptr(), nullptr);
+
+	vec.push_back(1);
+	vec.push_back(2);
+	vec.push_back(3);
+	TEST_EQ(vec.size(), 3u);
+	TEST_EQ(vec[0], 1);
+	TEST_EQ(vec[1], 2);
+	TEST_EQ(vec[2], 3);
+
+	// Clearing should keep the buffer around for reuse
+	const int *ptr = vec.ptr();
+	uint32_t capacity = vec.get_capacity();
+	vec.clear();
+	TEST_EQ(vec.size(), 0u);
+	TEST_EQ(vec.get_capacity(), capacity);
+	vec.push_back(4);
+	TEST_EQ(vec.ptr(), ptr);
+
+	vec.reset();
+	TEST_EQ(vec.get_capacity(), 0u);
+	TEST_EQ(vec.ptr(), nullptr);
+
+	// Constructing into a `char *` must not be mistaken for a tagged allocation
+	LocalVector<char> chars;
+	chars.push_back('a');
+	chars.insert('b', 0);
+	TEST_EQ(chars[0], 'b');
+	TEST_EQ(chars[1], 'a');
+
+	return true;
+}
+
+static bool local_vector_test_insert_remove() {
+	LocalVector<int> vec = {2, 4, 6};
+	vec.insert(1, 0);
+	vec.insert(5, 3);
+	vec.insert(7, 5);
+	TEST_EQ(vec.size(), 6u);
+	TEST_EQ(vec[0], 1);
+	TEST_EQ(vec[3], 5);
+	TEST_EQ(vec[5], 7);
+
+	vec.remove_at(0);
+	TEST_EQ(vec[0], 2);
+	TEST_EQ(vec.find(7), 4);
+	TEST_EQ(vec.find(1), -1);
+
+	vec.remove_at_unordered(0);
+	TEST_EQ(vec[0], 7);
+	TEST_EQ(vec.size(), 4u);
+	TEST_EQ(vec.has(2), false);
+
+	return true;
+}
+
+static bool local_vector_test_nontrivial() {
+	LocalVector<String> vec;
+	for (int i = 0; i < 32; i++) {
+		vec.push_back(itos(i));
+	}
+	TEST_EQ(vec[0], "0");
+	TEST_EQ(vec[31], "31");
+
+	vec.insert("start", 0);
+	TEST_EQ(vec[0], "start");
+	TEST_EQ(vec[32], "31");
+	vec.remove_at(0);
+	TEST_EQ(vec[0], "0");
+
+	vec.resize(2);
+	TEST_EQ(vec.size(), 2u);
+	vec.shrink_to_fit();
+	TEST_EQ(vec.get_capacity(), 2u);
+	TEST_EQ(vec[1], "1");
+
+	return true;
+}
+
+static bool local_vector_test_move() {
+	LocalVector<int> vec = {1, 2, 3};
+	const int *ptr = vec.ptr();
+
+	LocalVector<int> other = std::move(vec);
+	TEST_EQ(other.ptr(), ptr);
+	TEST_EQ(other.size(), 3u);
+	TEST_EQ(vec.size(), 0u);
+	TEST_EQ(vec.ptr(), nullptr);
+
+	vec = std::move(other);
+	TEST_EQ(vec.ptr(), ptr);
+
+	int count = 1;
+	for (const int &i : vec) {
+		TEST_EQ(i, count);
+		count++;
+	}
+
+	return true;
+}
+
+void local_vector_register_tests() {
+	register_test(local_vector_test_basic, "LocalVector reading, writing and clearing with atomic datatypes");
+	register_test(local_vector_test_insert_remove, "LocalVector inserting and removing items");
+	register_test(local_vector_test_nontrivial, "LocalVector reading, writing and resizing with a nontrivial class");
+	register_test(local_vector_test_move, "LocalVector moving ownership and iterators");
+}
+
+static constexpr int LOCAL_VECTOR_BENCH_FRAMES = 10000;
+static constexpr int LOCAL_VECTOR_BENCH_BATCHES = 256;
+
+// Mimics how the canvas renderer fills its batch array every frame: the array is cleared, refilled, and every batch is
+// modified by index as items are added to it.
+template <typename TVector>
+static void local_vector_bench_frame(TVector &r_batches) {
+	for (int frame = 0; frame < LOCAL_VECTOR_BENCH_FRAMES; frame++) {
+		r_batches.clear();
+		for (int i = 0; i < LOCAL_VECTOR_BENCH_BATCHES; i++) {
+			localvectortest1 b;
+			b.start = i;
+			r_batches.push_back(b);
+			for (int j = 0; j < 4; j++) {
+				r_batches[i].count++;
+			}
+			r_batches[i].ysort = LOCAL_VECTOR_BENCH_BATCHES - i;
+		}
+	}
+}
+
+static void local_vector_bench_scratch() {
+	const uint64_t operations = (uint64_t)LOCAL_VECTOR_BENCH_FRAMES * LOCAL_VECTOR_BENCH_BATCHES;
+
+	uint64_t start = benchmark_get_time_usec();
+	{
+		Vector<localvectortest1> batches;
+		local_vector_bench_frame(batches);
+	}
+	benchmark_report("Vector batches", operations, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	{
+		LocalVector<localvectortest1> batches;
+		local_vector_bench_frame(batches);
+	}
+	benchmark_report("LocalVector batches", operations, benchmark_get_time_usec() - start);
+}
+
+void local_vector_register_benchmarks() {
+	register_benchmark(local_vector_bench_scratch, "LocalVector against Vector as a per-frame scratch array");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void local_vector_register_tests();
+
+void local_vector_register_benchmarks();
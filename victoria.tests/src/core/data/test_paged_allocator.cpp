@@ -0,0 +1,227 @@
+#include "core/data/test_paged_allocator.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/hashtable.h>
+#include <core/data/list.h>
+#include <core/data/paged_allocator.h>
+#include <core/data/rb_map.h>
+#include <core/string/vstring.h>
+
+typedef List<int, PagedAllocator<ListElement<int>, 8>> PagedList;
+typedef RBMap<int, String, PagedAllocator<RBMapElement<int, String>, 8>> PagedRBMap;
+typedef HashTable<int, int, HasherDefault, PagedAllocator<HashTableElement<int, int>>> PagedHashTable;
+
+static bool paged_allocator_test_reuse() {
+	PagedAllocator<String, 4> allocator;
+	TEST_EQ(allocator.get_page_count(), 0u);
+
+	String *strings[4];
+	for (int i = 0; i < 4; i++) {
+		strings[i] = allocator.new_allocation(itos(i));
+	}
+	TEST_EQ(allocator.get_page_count(), 1u);
+	TEST_EQ(allocator.get_allocation_count(), 4u);
+	TEST_EQ(*strings[3], "3");
+
+	// A freed slot should be handed out again before a new page is allocated
+	String *freed = strings[1];
+	allocator.delete_allocation(strings[1]);
+	strings[1] = allocator.new_allocation("reused");
+	TEST_EQ(strings[1], freed);
+	TEST_EQ(allocator.get_page_count(), 1u);
+
+	String *extra = allocator.new_allocation("extra");
+	TEST_EQ(allocator.get_page_count(), 2u);
+	TEST_EQ(*extra, "extra");
+
+	allocator.delete_allocation(extra);
+	for (int i = 0; i < 4; i++) {
+		allocator.delete_allocation(strings[i]);
+	}
+	TEST_EQ(allocator.get_allocation_count(), 0u);
+
+	allocator.reset();
+	TEST_EQ(allocator.get_page_count(), 0u);
+
+	return true;
+}
+
+static bool paged_allocator_test_list() {
+	PagedList list;
+	for (int i = 0; i < 20; i++) {
+		list.push_back(i);
+	}
+	TEST_EQ(list.size(), 20);
+	TEST_EQ(list.get(19), 19);
+
+	list.erase(5);
+	list.push_front(-1);
+	TEST_EQ(list.front()->get(), -1);
+	TEST_EQ(list.get(6), 6);
+
+	// Moving the list has to take the pages along with the elements
+	const PagedList::Element *front = list.front();
+	PagedList other = std::move(list);
+	TEST_EQ(other.front(), front);
+	TEST_EQ(other.size(), 20);
+	TEST_EQ(list.size(), 0);
+
+	list.push_back(100);
+	TEST_EQ(list.front()->get(), 100);
+
+	list = std::move(other);
+	TEST_EQ(list.size(), 20);
+	TEST_EQ(list.back()->get(), 19);
+
+	PagedList copy(list);
+	TEST_EQ(copy.size(), 20);
+	TEST_EQ(copy.get(0), -1);
+
+	return true;
+}
+
+static bool paged_allocator_test_rb_map() {
+	PagedRBMap map;
+	for (int i = 0; i < 32; i++) {
+		map.insert((i * 7) % 32, itos(i));
+	}
+	TEST_EQ(map.size(), 32u);
+	TEST_EQ(map[7], "1");
+
+	TEST_EQ(map.erase(7), true);
+	TEST_EQ(map.erase(7), false);
+	TEST_EQ(map.find(7), nullptr);
+	TEST_EQ(map.size(), 31u);
+
+	int last = -1;
+	for (const KeyValue<int, String> &kv : map) {
+		TEST_EQ((kv.key > last), true);
+		last = kv.key;
+	}
+
+	PagedRBMap copy(map);
+	TEST_EQ(copy.size(), 31u);
+	TEST_EQ(copy[14], "2");
+
+	const PagedRBMap::Element *front = map.front();
+	PagedRBMap other = std::move(map);
+	TEST_EQ(other.front(), front);
+	TEST_EQ(other[31], "9");
+	TEST_EQ(map.is_empty(), true);
+	TEST_EQ(map.find(0), nullptr);
+
+	// The moved-from map should still be usable
+	map.insert(1, "one");
+	TEST_EQ(map[1], "one");
+
+	map = std::move(other);
+	TEST_EQ(map.size(), 31u);
+	TEST_EQ(map.back()->key(), 31);
+
+	map.clear();
+	TEST_EQ(map.size(), 0u);
+	TEST_EQ(map.front(), nullptr);
+
+	return true;
+}
+
+static bool paged_allocator_test_hashtable() {
+	PagedHashTable table;
+	for (int i = 0; i < 64; i++) {
+		table.insert(i, i * 2);
+	}
+	TEST_EQ(table.size(), 64);
+
+	const int *ptr = table.get_ptr(10);
+	PagedHashTable other = std::move(table);
+	TEST_EQ(other.get_ptr(10), ptr);
+	TEST_EQ(other[63], 126);
+
+	other.erase(10);
+	other.insert(100, 200);
+	TEST_EQ(other.has(10), false);
+	TEST_EQ(other[100], 200);
+
+	table = std::move(other);
+	TEST_EQ(table.size(), 64);
+
+	return true;
+}
+
+void paged_allocator_register_tests() {
+	register_test(paged_allocator_test_reuse, "PagedAllocator reusing freed slots and allocating pages");
+	register_test(paged_allocator_test_list, "List with a PagedAllocator inserting, erasing, moving and copying");
+	register_test(paged_allocator_test_rb_map, "RBMap with a PagedAllocator inserting, erasing, moving and copying");
+	register_test(paged_allocator_test_hashtable, "HashTable with a PagedAllocator moving elements between tables");
+}
+
+static constexpr int PAGED_ALLOCATOR_BENCH_ROUNDS = 20000;
+static constexpr int PAGED_ALLOCATOR_BENCH_CHILDREN = 64;
+
+// Mimics children being added to and removed from an object as the scene tree changes: every round, the list is
+// filled up, then emptied from the front.
+template <typename TList>
+static void paged_allocator_bench_churn(TList &r_list) {
+	for (int round = 0; round < PAGED_ALLOCATOR_BENCH_ROUNDS; round++) {
+		for (int i = 0; i < PAGED_ALLOCATOR_BENCH_CHILDREN; i++) {
+			r_list.push_back(i);
+		}
+
+		while (r_list.front()) {
+			r_list.erase(r_list.front());
+		}
+	}
+}
+
+static void paged_allocator_bench_list() {
+	const uint64_t operations = (uint64_t)PAGED_ALLOCATOR_BENCH_ROUNDS * PAGED_ALLOCATOR_BENCH_CHILDREN;
+
+	uint64_t start = benchmark_get_time_usec();
+	{
+		List<int> list;
+		paged_allocator_bench_churn(list);
+	}
+	benchmark_report("List push/erase (DefaultTypedAllocator)", operations, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	{
+		List<int, PagedAllocator<ListElement<int>>> list;
+		paged_allocator_bench_churn(list);
+	}
+	benchmark_report("List push/erase (PagedAllocator)", operations, benchmark_get_time_usec() - start);
+}
+
+static void paged_allocator_bench_rb_map() {
+	const uint64_t operations = (uint64_t)PAGED_ALLOCATOR_BENCH_ROUNDS * PAGED_ALLOCATOR_BENCH_CHILDREN;
+
+	uint64_t start = benchmark_get_time_usec();
+	{
+		RBMap<int, int> map;
+		for (int round = 0; round < PAGED_ALLOCATOR_BENCH_ROUNDS; round++) {
+			for (int i = 0; i < PAGED_ALLOCATOR_BENCH_CHILDREN; i++) {
+				map.insert(i, round);
+			}
+			map.clear();
+		}
+	}
+	benchmark_report("RBMap insert/clear (DefaultTypedAllocator)", operations, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	{
+		RBMap<int, int, PagedAllocator<RBMapElement<int, int>>> map;
+		for (int round = 0; round < PAGED_ALLOCATOR_BENCH_ROUNDS; round++) {
+			for (int i = 0; i < PAGED_ALLOCATOR_BENCH_CHILDREN; i++) {
+				map.insert(i, round);
+			}
+			map.clear();
+		}
+	}
+	benchmark_report("RBMap insert/clear (PagedAllocator)", operations, benchmark_get_time_usec() - start);
+}
+
+void paged_allocator_register_benchmarks() {
+	register_benchmark(paged_allocator_bench_list, "List element allocation with and without a PagedAllocator");
+	register_benchmark(paged_allocator_bench_rb_map, "RBMap element allocation with and without a PagedAllocator");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void paged_allocator_register_tests();
+
+void paged_allocator_register_benchmarks();
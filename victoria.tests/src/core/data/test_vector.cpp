@@ -191,6 +191,58 @@ static bool vector_test_iterators_constructors() {
 	return true;
 }
 
+static bool vector_test_capacity() {
+	Vector<int> vec;
+	TEST_EQ(vec.get_capacity(), 0);
+
+	vec.reserve(16);
+	TEST_EQ(vec.size(), 0);
+	TEST_EQ(vec.get_capacity(), 16);
+
+	const int *ptr = vec.ptr();
+	for (int i = 0; i < 16; i++) {
+		vec.push_back(i);
+	}
+	// Reserved memory should not be reallocated
+	TEST_EQ(ptr, vec.ptr());
+	TEST_EQ(vec.size(), 16);
+
+	vec.push_back(16);
+	TEST_EQ(vec.size(), 17);
+	TEST_EQ((vec.get_capacity() > 17), true);
+	for (int i = 0; i < 17; i++) {
+		TEST_EQ(vec[i], i);
+	}
+
+	vec.remove_at(0);
+	TEST_EQ(vec[0], 1);
+	TEST_EQ((vec.get_capacity() > 16), true);
+
+	vec.shrink_to_fit();
+	TEST_EQ(vec.get_capacity(), 16);
+	TEST_EQ(vec[15], 16);
+
+	// Reserving on a shared vector should copy it
+	Vector<int> other = vec;
+	other.reserve(64);
+	TEST_EQ(other.get_reference_count(), 1);
+	TEST_EQ(vec.get_reference_count(), 1);
+	TEST_EQ(other.get_capacity(), 64);
+	TEST_EQ(other, vec);
+
+	vec.resize(4);
+	TEST_EQ(vec.size(), 4);
+	TEST_EQ(vec[3], 4);
+
+	Vector<int> appended = {1, 2};
+	appended.append_array(vec);
+	TEST_EQ(appended.size(), 6);
+	TEST_EQ(appended[2], 1);
+	TEST_EQ(appended[5], 4);
+
+	return true;
+}
+
 void vector_register_tests() {
 	register_test(vector_test_basic, "Vector reading, writing and clearing with atomic datatypes");
 	register_test(vector_test_lifetimes, "Vector refcounting lifetimes");
@@ -200,4 +252,41 @@ void vector_register_tests() {
 	register_test(vector_test_push_pop, "Vector pushing and popping");
 	register_test(vector_test_pointers, "Vector reading and writing to direct pointers");
 	register_test(vector_test_iterators_constructors, "Vector constructors, destructors and iterators");
+	register_test(vector_test_capacity, "Vector reserving, growing and shrinking capacity");
+}
+
+static constexpr int VECTOR_BENCH_ELEMENTS = 1000000;
+
+static void vector_bench_push_back() {
+	uint64_t start = benchmark_get_time_usec();
+	{
+		Vector<int> vec;
+		for (int i = 0; i < VECTOR_BENCH_ELEMENTS; i++) {
+			vec.push_back(i);
+		}
+	}
+	benchmark_report("push_back (int)", VECTOR_BENCH_ELEMENTS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	{
+		Vector<vectortest1> vec;
+		for (int i = 0; i < VECTOR_BENCH_ELEMENTS; i++) {
+			vec.push_back({i, true});
+		}
+	}
+	benchmark_report("push_back (struct)", VECTOR_BENCH_ELEMENTS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	{
+		Vector<int> vec;
+		vec.reserve(VECTOR_BENCH_ELEMENTS);
+		for (int i = 0; i < VECTOR_BENCH_ELEMENTS; i++) {
+			vec.push_back(i);
+		}
+	}
+	benchmark_report("push_back (int, reserved)", VECTOR_BENCH_ELEMENTS, benchmark_get_time_usec() - start);
+}
+
+void vector_register_benchmarks() {
+	register_benchmark(vector_bench_push_back, "Vector push_back throughput for 1M elements");
 }
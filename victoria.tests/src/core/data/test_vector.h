@@ -1,3 +1,5 @@
 #pragma once
 
 void vector_register_tests();
+
+void vector_register_benchmarks();
\ No newline at end of file
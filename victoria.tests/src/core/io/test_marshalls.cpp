@@ -0,0 +1,262 @@
+#include "core/io/test_marshalls.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/io/marshalls.h>
+#include <core/string/vstring.h>
+#include <core/variant/variant.h>
+
+// One value of every type, with the edge cases of the compact encoding.
+static Array marshalls_sample_values() {
+	ByteArray bytes;
+	Int32Array ints32;
+	Int64Array ints64;
+	Float32Array floats32;
+	Float64Array floats64;
+	Vector2Array vectors2;
+	Vector3Array vectors3;
+	Vector4Array vectors4;
+	for (int i = 0; i < 3; i++) {
+		bytes.push_back(i * 120);
+		ints32.push_back(i - 100000);
+		ints64.push_back(((int64_t)i << 40) - 1);
+		floats32.push_back(i * 0.25f);
+		floats64.push_back(i * 0.1);
+		vectors2.push_back(Vector2(i, -i));
+		vectors3.push_back(Vector3(i, 0.5, -i));
+		vectors4.push_back(Vector4(i, 0.5, -i, 1.0));
+	}
+
+	Array nested;
+	nested.push_back(1);
+	nested.push_back("two");
+	nested.push_back(Array());
+
+	Array values;
+	values.push_back(Variant());
+	values.push_back(true);
+	values.push_back(-12);
+	values.push_back((int64_t)1 << 40);
+	values.push_back(1.5);
+	values.push_back(0.1);
+	values.push_back("Hello, World!");
+	values.push_back(String());
+	values.push_back(Vector2(1.5, -2.0));
+	values.push_back(Vector2i(3, -4));
+	values.push_back(Vector3(1.0, 2.0, 3.0));
+	values.push_back(Vector3i(-1, 0, (int64_t)1 << 50));
+	values.push_back(Vector4(0.1, 0.2, 0.3, 0.4));
+	values.push_back(Vector4i(1, 2, 3, 4));
+	values.push_back(nested);
+	values.push_back(bytes);
+	values.push_back(ints32);
+	values.push_back(ints64);
+	values.push_back(floats32);
+	values.push_back(Float32Array());
+	values.push_back(floats64);
+	values.push_back(vectors2);
+	values.push_back(vectors3);
+	values.push_back(vectors4);
+	return values;
+}
+
+// Encodes the value and checks that decoding it gives the same value back, using up every byte written.
+static bool marshalls_round_trip(const Variant &p_variant) {
+	Vector<uint8_t> buffer;
+	TEST_EQ(encode_variant(p_variant, buffer), OK);
+	int64_t len = 0;
+	TEST_EQ(encode_variant(p_variant, nullptr, len), OK);
+	TEST_EQ(len, buffer.size());
+
+	Variant decoded;
+	int64_t used = 0;
+	TEST_EQ(decode_variant(decoded, buffer.ptr(), buffer.size(), &used), OK);
+	TEST_EQ(used, buffer.size());
+	TEST_EQ(decoded.get_type(), p_variant.get_type());
+	TEST_EQ((decoded == p_variant), true);
+	return true;
+}
+
+static bool marshalls_test_round_trip() {
+	const Array values = marshalls_sample_values();
+	for (int64_t i = 0; i < values.size(); i++) {
+		if (!marshalls_round_trip(values[i])) {
+			return false;
+		}
+	}
+
+	return marshalls_round_trip(values);
+}
+
+static bool marshalls_test_compact() {
+	int64_t len = 0;
+	TEST_EQ(encode_variant(Variant(), nullptr, len), OK);
+	TEST_EQ(len, 1);
+	TEST_EQ(encode_variant(-12, nullptr, len), OK);
+	TEST_EQ(len, 5);
+	TEST_EQ(encode_variant((int64_t)1 << 40, nullptr, len), OK);
+	TEST_EQ(len, 9);
+	TEST_EQ(encode_variant(1.5, nullptr, len), OK);
+	TEST_EQ(len, 5);
+	TEST_EQ(encode_variant(0.1, nullptr, len), OK);
+	TEST_EQ(len, 9);
+
+	Float32Array floats;
+	floats.resize(100);
+	TEST_EQ(encode_variant(floats, nullptr, len), OK);
+	TEST_EQ(len, 1 + 4 + 100 * 4);
+	return true;
+}
+
+static bool marshalls_test_sequence() {
+	// Values appended one after the other are decoded one after the other.
+	Vector<uint8_t> buffer;
+	TEST_EQ(encode_variant("first", buffer), OK);
+	TEST_EQ(encode_variant(Vector3i(1, 2, 3), buffer), OK);
+
+	Variant decoded;
+	int64_t used = 0;
+	TEST_EQ(decode_variant(decoded, buffer.ptr(), buffer.size(), &used), OK);
+	TEST_EQ(decoded, "first");
+	int64_t offset = used;
+	TEST_EQ(decode_variant(decoded, buffer.ptr() + offset, buffer.size() - offset, &used), OK);
+	TEST_EQ((decoded == Variant(Vector3i(1, 2, 3))), true);
+	TEST_EQ(offset + used, buffer.size());
+
+	// Every value cut short is rejected.
+	buffer.clear();
+	TEST_EQ(encode_variant(marshalls_sample_values(), buffer), OK);
+	for (int64_t len = 0; len < buffer.size(); len++) {
+		TEST_EQ(decode_variant(decoded, buffer.ptr(), len), ERR_INVALID_DATA);
+	}
+	return true;
+}
+
+static bool marshalls_test_fuzz() {
+	Vector<uint8_t> valid;
+	TEST_EQ(encode_variant(marshalls_sample_values(), valid), OK);
+
+	uint32_t state = 12345;
+	int decoded_count = 0;
+	for (int i = 0; i < 20000; i++) {
+		Vector<uint8_t> buffer;
+		if (i & 1) {
+			// Random bytes, which mostly start with a valid type so that decoding gets past the first byte.
+			state = state * 1664525 + 1013904223;
+			buffer.resize(1 + (state >> 24) % 64);
+			for (int64_t j = 0; j < buffer.size(); j++) {
+				state = state * 1664525 + 1013904223;
+				buffer.ptrw()[j] = state >> 24;
+			}
+			buffer.ptrw()[0] %= Variant::VARIANT_MAX + 1;
+		} else {
+			// A valid encoding with a few bytes changed.
+			buffer = valid;
+			for (int j = 0; j < 3; j++) {
+				state = state * 1664525 + 1013904223;
+				buffer.ptrw()[(state >> 8) % buffer.size()] = state >> 24;
+			}
+		}
+
+		Variant decoded;
+		int64_t used = 0;
+		if (decode_variant(decoded, buffer.ptr(), buffer.size(), &used) != OK) {
+			continue;
+		}
+		decoded_count++;
+		TEST_EQ((used <= buffer.size()), true);
+
+		// Whatever was decoded has to encode to bytes that decode and encode to the same bytes again.
+		Vector<uint8_t> first;
+		Vector<uint8_t> second;
+		Variant again;
+		TEST_EQ(encode_variant(decoded, first), OK);
+		TEST_EQ(decode_variant(again, first.ptr(), first.size()), OK);
+		TEST_EQ(encode_variant(again, second), OK);
+		TEST_EQ((first == second), true);
+	}
+
+	TEST_EQ((decoded_count > 0), true);
+	return true;
+}
+
+void marshalls_register_tests() {
+	register_test(marshalls_test_round_trip, "Variant encoding and decoding of every type");
+	register_test(marshalls_test_compact, "Variant encoding of small integers and floats in 32 bits");
+	register_test(marshalls_test_sequence, "Variant decoding of consecutive and truncated values");
+	register_test(marshalls_test_fuzz, "Variant decoding of random and corrupted data");
+}
+
+static constexpr int64_t MARSHALLS_BENCH_BYTES = 256 * 1024 * 1024;
+
+static void marshalls_bench_throughput() {
+	Float32Array floats;
+	floats.resize(1024 * 1024);
+	float *float_ptr = floats.ptrw();
+	for (int i = 0; i < floats.size(); i++) {
+		float_ptr[i] = i * 0.5f;
+	}
+
+	Vector3Array vectors;
+	vectors.resize(256 * 1024);
+	Vector3 *vector_ptr = vectors.ptrw();
+	for (int i = 0; i < vectors.size(); i++) {
+		vector_ptr[i] = Vector3(i, i * 0.5, -i);
+	}
+
+	Array mixed;
+	for (int i = 0; i < 64 * 1024; i++) {
+		switch (i & 3) {
+			case 0:
+				mixed.push_back(i);
+				break;
+			case 1:
+				mixed.push_back(i * 0.1);
+				break;
+			case 2:
+				mixed.push_back("name");
+				break;
+			default:
+				mixed.push_back(Vector3(i, 0.0, 1.0));
+				break;
+		}
+	}
+
+	const char *labels[3] = {"Float32Array", "Vector3Array", "Array of mixed values"};
+	const Variant values[3] = {floats, vectors, mixed};
+	int64_t sum = 0;
+	for (int v = 0; v < 3; v++) {
+		Vector<uint8_t> buffer;
+		encode_variant(values[v], buffer);
+		const int64_t size = buffer.size();
+		const int64_t iterations = MARSHALLS_BENCH_BYTES / size;
+
+		uint8_t *ptr = buffer.ptrw();
+		uint64_t start = benchmark_get_time_usec();
+		for (int64_t i = 0; i < iterations; i++) {
+			int64_t len = 0;
+			encode_variant(values[v], ptr, len);
+			sum += len;
+		}
+		benchmark_report_bytes(vformat("encode_variant, %s", labels[v]),
+							   iterations * size,
+							   benchmark_get_time_usec() - start);
+
+		start = benchmark_get_time_usec();
+		for (int64_t i = 0; i < iterations; i++) {
+			Variant decoded;
+			decode_variant(decoded, buffer.ptr(), size);
+			sum += decoded.get_type();
+		}
+		benchmark_report_bytes(vformat("decode_variant, %s", labels[v]),
+							   iterations * size,
+							   benchmark_get_time_usec() - start);
+	}
+
+	ERR_FAIL_COND(sum == 0);
+}
+
+void marshalls_register_benchmarks() {
+	register_benchmark(marshalls_bench_throughput, "Bytes encoded and decoded per second by encode_variant");
+}
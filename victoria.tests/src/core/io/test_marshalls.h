@@ -0,0 +1,5 @@
+#pragma once
+
+void marshalls_register_tests();
+
+void marshalls_register_benchmarks();
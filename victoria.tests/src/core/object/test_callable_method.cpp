@@ -0,0 +1,136 @@
+#include "core/object/test_callable_method.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/local_vector.h>
+#include <core/object/callable_method_pointer.h>
+#include <core/os/memory.h>
+#include <core/string/vstring.h>
+
+struct callablemethodtest1 {
+	int value = 0;
+
+	void add(int p_value) {
+		value += p_value;
+	}
+
+	void subtract(int p_value) {
+		value -= p_value;
+	}
+};
+
+static int callable_method_test_static_value = 0;
+
+static void callable_method_test_set(int p_value) {
+	callable_method_test_static_value = p_value;
+}
+
+static uint64_t callable_method_test_allocation_count() {
+	uint64_t count = 0;
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		count += Memory::get_tag_stats((MemoryTag)i).allocation_count;
+	}
+	return count;
+}
+
+static bool callable_method_test_inline() {
+	callablemethodtest1 first;
+	callablemethodtest1 second;
+
+	// Creating, copying and calling method pointers never allocates.
+	uint64_t allocations = callable_method_test_allocation_count();
+	CallableMethod add = callable_mp(&first, &callablemethodtest1::add);
+	CallableMethod copy = add;
+	CallableMethod assigned;
+	assigned = copy;
+	TEST_EQ(add.call(2), OK);
+	TEST_EQ(copy.call(3), OK);
+	TEST_EQ(assigned.call(4), OK);
+	TEST_EQ(callable_method_test_allocation_count(), allocations);
+	TEST_EQ(first.value, 9);
+
+	CallableMethod set = static_callable_mp(&callable_method_test_set);
+	TEST_EQ(set.call(5), OK);
+	TEST_EQ(callable_method_test_static_value, 5);
+
+	// Callables are equal when they call the same method on the same object, however they were made.
+	TEST_EQ((add == callable_mp(&first, &callablemethodtest1::add)), true);
+	TEST_EQ((add != callable_mp(&second, &callablemethodtest1::add)), true);
+	TEST_EQ((add != callable_mp(&first, &callablemethodtest1::subtract)), true);
+	TEST_EQ((add != set), true);
+	TEST_EQ((set == static_callable_mp(&callable_method_test_set)), true);
+	TEST_EQ((CallableMethod() == CallableMethod()), true);
+	TEST_EQ((add != CallableMethod()), true);
+
+	TEST_EQ(add.get_name(), "callablemethodtest1::add");
+	TEST_EQ(set.get_name(), "callable_method_test_set");
+	TEST_EQ(CallableMethod().get_name(), "");
+
+	// Assigning a null callable empties the other one.
+	assigned = CallableMethod();
+	TEST_EQ(assigned.is_null(), true);
+	TEST_EQ(copy.is_valid(), true);
+
+	return true;
+}
+
+void callable_method_register_tests() {
+	register_test(callable_method_test_inline, "CallableMethod storing method pointers inline and comparing them");
+}
+
+static constexpr int CALLABLE_METHOD_BENCH_COUNT = 1000000;
+
+struct callablemethodbench1 {
+	int64_t sum = 0;
+
+	void add(int p_value) {
+		sum += p_value;
+	}
+};
+
+static void callable_method_bench_costs() {
+	callablemethodbench1 target;
+	LocalVector<CallableMethod> callables;
+	callables.resize(CALLABLE_METHOD_BENCH_COUNT);
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < CALLABLE_METHOD_BENCH_COUNT; i++) {
+		callables[i] = callable_mp(&target, &callablemethodbench1::add);
+	}
+	benchmark_report("Create with callable_mp", CALLABLE_METHOD_BENCH_COUNT, benchmark_get_time_usec() - start);
+
+	CallableMethod copy;
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < CALLABLE_METHOD_BENCH_COUNT; i++) {
+		copy = callables[i];
+	}
+	benchmark_report("Copy", CALLABLE_METHOD_BENCH_COUNT, benchmark_get_time_usec() - start);
+
+	Variant arg = 1;
+	const Variant *argptrs[1] = {&arg};
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < CALLABLE_METHOD_BENCH_COUNT; i++) {
+		Error err;
+		callables[i].callp(argptrs, err);
+	}
+	benchmark_report("Call with one argument", CALLABLE_METHOD_BENCH_COUNT, benchmark_get_time_usec() - start);
+
+	// Callables made separately for the same method, as happens when connecting and disconnecting.
+	int equal = 0;
+	start = benchmark_get_time_usec();
+	for (int i = 1; i < CALLABLE_METHOD_BENCH_COUNT; i++) {
+		equal += callables[i] == callables[i - 1];
+	}
+	benchmark_report(vformat("Compare (%d equal)", equal),
+					 CALLABLE_METHOD_BENCH_COUNT - 1,
+					 benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	callables.reset();
+	benchmark_report("Destroy", CALLABLE_METHOD_BENCH_COUNT, benchmark_get_time_usec() - start);
+}
+
+void callable_method_register_benchmarks() {
+	register_benchmark(callable_method_bench_costs, "CallableMethod create, copy, call and compare costs");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void callable_method_register_tests();
+
+void callable_method_register_benchmarks();
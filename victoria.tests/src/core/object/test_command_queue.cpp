@@ -0,0 +1,238 @@
+#include "core/object/test_command_queue.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/object/callable_method_pointer.h>
+#include <core/object/command_queue.h>
+#include <core/os/memory.h>
+#include <core/string/vstring.h>
+
+struct commandqueuetest1 {
+	String log;
+
+	void append(const String &p_text, int p_number) {
+		log += vformat("%s%d ", p_text.get_data(), p_number);
+	}
+
+	void append_variant(int p_number) {
+		log += vformat("v%d ", p_number);
+	}
+};
+
+// Counts how many copies of itself exist, to check that the queue destructs every argument it stores.
+struct commandqueuetest2 {
+	static int live;
+
+	commandqueuetest2() {
+		live++;
+	}
+	commandqueuetest2(const commandqueuetest2 &) {
+		live++;
+	}
+	~commandqueuetest2() {
+		live--;
+	}
+};
+
+int commandqueuetest2::live = 0;
+
+static int command_queue_test_calls = 0;
+
+static void command_queue_test_take(const commandqueuetest2 &p_tracker) {
+	command_queue_test_calls++;
+}
+
+static bool command_queue_test_typed_calls() {
+	CommandQueue queue;
+	commandqueuetest1 target;
+	CallableMethod append_variant = callable_mp(&target, &commandqueuetest1::append_variant);
+
+	// Typed and Variant commands are called in the order they were pushed, across many pages.
+	String expected;
+	for (int i = 0; i < 500; i++) {
+		TEST_EQ(queue.push_call(&target, &commandqueuetest1::append, String("a"), i), OK);
+		TEST_EQ(queue.push_command(append_variant, i), OK);
+		expected += vformat("a%d v%d ", i, i);
+	}
+	TEST_EQ(target.log, "");
+	queue.flush();
+	TEST_EQ(target.log, expected);
+
+	// The queue is empty after flushing.
+	queue.flush();
+	TEST_EQ(target.log, expected);
+
+	command_queue_test_calls = 0;
+	{
+		commandqueuetest2 tracker;
+		TEST_EQ(queue.push_call(&command_queue_test_take, tracker), OK);
+		TEST_EQ(queue.push_call(&command_queue_test_take, tracker), OK);
+	}
+	TEST_EQ(commandqueuetest2::live, 2);
+	queue.flush();
+	TEST_EQ(command_queue_test_calls, 2);
+	TEST_EQ(commandqueuetest2::live, 0);
+
+	// Clearing destructs the arguments without calling anything.
+	TEST_EQ(queue.push_call(&command_queue_test_take, commandqueuetest2()), OK);
+	queue.clear();
+	TEST_EQ(command_queue_test_calls, 2);
+	TEST_EQ(commandqueuetest2::live, 0);
+
+	return true;
+}
+
+struct commandqueuetest3 {
+	CommandQueue *queue = nullptr;
+	String log;
+	int64_t sum = 0;
+
+	void add(int p_value) {
+		sum += p_value;
+	}
+
+	void count(int p_value) {
+		log += vformat("%d ", p_value);
+	}
+
+	void push_more(int p_remaining) {
+		log += "push ";
+		// Pushed while the queue is being flushed, which must not move the command being called.
+		for (int i = 0; i < 300; i++) {
+			queue->push_call(this, &commandqueuetest3::count, i);
+		}
+		if (p_remaining > 0) {
+			queue->push_call(this, &commandqueuetest3::push_more, p_remaining - 1);
+		}
+	}
+
+	void many_arguments(const Variant &p_first) {
+		log += vformat("large%d ", (int)p_first);
+	}
+};
+
+static uint64_t command_queue_test_allocation_count() {
+	uint64_t count = 0;
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		count += Memory::get_tag_stats((MemoryTag)i).allocation_count;
+	}
+	return count;
+}
+
+static bool command_queue_test_paging() {
+	CommandQueue queue;
+	commandqueuetest3 target;
+	target.queue = &queue;
+
+	// Commands pushed during a flush are called in the same flush.
+	String expected;
+	for (int round = 0; round < 3; round++) {
+		expected += "push ";
+		for (int i = 0; i < 300; i++) {
+			expected += vformat("%d ", i);
+		}
+	}
+	queue.push_call(&target, &commandqueuetest3::push_more, 2);
+	queue.flush();
+	TEST_EQ(target.log, expected);
+
+	// A command larger than a page gets a page of its own, between the commands around it.
+	LocalVector<Variant> args;
+	LocalVector<const Variant *> argptrs;
+	args.resize(200);
+	for (uint32_t i = 0; i < args.size(); i++) {
+		args[i] = (int)i + 7;
+		argptrs.push_back(&args[i]);
+	}
+	target.log = "";
+	CallableMethod many_arguments = callable_mp(&target, &commandqueuetest3::many_arguments);
+	queue.push_call(&target, &commandqueuetest3::count, 1);
+	TEST_EQ(queue.push_commandp(many_arguments, argptrs.ptrw(), args.size()), OK);
+	queue.push_call(&target, &commandqueuetest3::count, 2);
+	queue.flush();
+	TEST_EQ(target.log, "1 large7 2 ");
+	TEST_NEQ(queue.get_high_water_mark(), 0u);
+
+	// The same amount of work every frame reuses the pages of the first frame, without allocating anything.
+	CommandQueue frames;
+	commandqueuetest3 counter;
+	for (int i = 0; i < 2000; i++) {
+		frames.push_call(&counter, &commandqueuetest3::add, i);
+	}
+	frames.clear();
+	uint32_t high_water_mark = frames.get_high_water_mark();
+	uint32_t page_count = frames.get_page_count();
+	uint64_t allocations = command_queue_test_allocation_count();
+	for (int frame = 0; frame < 10; frame++) {
+		for (int i = 0; i < 2000; i++) {
+			frames.push_call(&counter, &commandqueuetest3::add, i);
+		}
+		frames.flush();
+	}
+	TEST_EQ(command_queue_test_allocation_count(), allocations);
+	TEST_EQ(counter.sum, 10 * (1999 * 2000 / 2));
+	TEST_EQ(frames.get_high_water_mark(), high_water_mark);
+	TEST_EQ(frames.get_page_count(), page_count);
+
+	// Reserving for a known peak allocates every page up front.
+	CommandQueue reserved;
+	reserved.reserve(high_water_mark);
+	TEST_EQ(reserved.get_page_count(), page_count);
+	for (int i = 0; i < 2000; i++) {
+		reserved.push_call(&counter, &commandqueuetest3::add, i);
+	}
+	reserved.clear();
+	TEST_EQ(reserved.get_page_count(), page_count);
+
+	return true;
+}
+
+void command_queue_register_tests() {
+	register_test(command_queue_test_typed_calls, "CommandQueue calling typed and Variant commands in order");
+	register_test(command_queue_test_paging, "CommandQueue keeping commands in place and reusing pages");
+}
+
+static constexpr int COMMAND_QUEUE_BENCH_CALLS = 100000;
+static constexpr int COMMAND_QUEUE_BENCH_FRAMES = 20;
+
+struct commandqueuebench1 {
+	int64_t sum = 0;
+
+	void add(int p_a, float p_b) {
+		sum += p_a + (int64_t)p_b;
+	}
+};
+
+static void command_queue_bench_deferred_calls() {
+	CommandQueue queue;
+	commandqueuebench1 target;
+	CallableMethod add = callable_mp(&target, &commandqueuebench1::add);
+
+	// Each frame pushes every call and then flushes them, as call_deferred is used in a game.
+	uint64_t start = benchmark_get_time_usec();
+	for (int frame = 0; frame < COMMAND_QUEUE_BENCH_FRAMES; frame++) {
+		for (int i = 0; i < COMMAND_QUEUE_BENCH_CALLS; i++) {
+			queue.push_command(add, i, 1.0f);
+		}
+		queue.flush();
+	}
+	benchmark_report("push_command and flush through Variant",
+					 (uint64_t)COMMAND_QUEUE_BENCH_CALLS * COMMAND_QUEUE_BENCH_FRAMES,
+					 benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int frame = 0; frame < COMMAND_QUEUE_BENCH_FRAMES; frame++) {
+		for (int i = 0; i < COMMAND_QUEUE_BENCH_CALLS; i++) {
+			queue.push_call(&target, &commandqueuebench1::add, i, 1.0f);
+		}
+		queue.flush();
+	}
+	benchmark_report("push_call and flush with typed arguments",
+					 (uint64_t)COMMAND_QUEUE_BENCH_CALLS * COMMAND_QUEUE_BENCH_FRAMES,
+					 benchmark_get_time_usec() - start);
+}
+
+void command_queue_register_benchmarks() {
+	register_benchmark(command_queue_bench_deferred_calls, "CommandQueue deferred calls per second");
+}
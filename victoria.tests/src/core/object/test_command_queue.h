@@ -0,0 +1,5 @@
+#pragma once
+
+void command_queue_register_tests();
+
+void command_queue_register_benchmarks();
@@ -0,0 +1,177 @@
+#include "core/object/test_method_bind.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/object/class_registry.h>
+#include <core/object/method_bind.h>
+#include <core/string/vstring.h>
+
+class MethodBindTestObject : public Object {
+	VREGISTER_CLASS(MethodBindTestObject, Object);
+
+	int value = 0;
+
+public:
+	static MethodID add_method;
+	static MethodID set_value_method;
+
+	void set_value(int p_value) {
+		value = p_value;
+	}
+
+	int get_value() const {
+		return value;
+	}
+
+	int add(int p_a, int p_b) {
+		return p_a + p_b;
+	}
+
+	String describe(const String &p_prefix) const {
+		return p_prefix + itos(value);
+	}
+
+protected:
+	static void _bind_methods() {
+		set_value_method = ClassRegistry::bind_method(&MethodBindTestObject::set_value, SNAME("set_value"), "value");
+		ClassRegistry::bind_method(&MethodBindTestObject::get_value, SNAME("get_value"));
+		add_method = ClassRegistry::bind_method(&MethodBindTestObject::add, SNAME("add"), "a", "b");
+		ClassRegistry::bind_method(&MethodBindTestObject::describe, SNAME("describe"), "prefix");
+	}
+};
+
+MethodID MethodBindTestObject::add_method = INVALID_METHOD_ID;
+MethodID MethodBindTestObject::set_value_method = INVALID_METHOD_ID;
+
+class MethodBindTestChild : public MethodBindTestObject {
+	VREGISTER_CLASS(MethodBindTestChild, MethodBindTestObject);
+};
+
+static void method_bind_test_register_classes() {
+	// The engine registers `Object` when starting up, which the tests do not do.
+	ClassRegistry::register_class<Object>();
+	ClassRegistry::register_class<MethodBindTestObject>();
+	ClassRegistry::register_class<MethodBindTestChild>();
+}
+
+static bool method_bind_test_lookup() {
+	method_bind_test_register_classes();
+	const StringName &cname = MethodBindTestObject::get_class_name_static();
+
+	TEST_EQ((MethodBindTestObject::add_method != INVALID_METHOD_ID), true);
+	TEST_EQ(ClassRegistry::get_method_id(cname, SNAME("add")), MethodBindTestObject::add_method);
+	TEST_EQ(ClassRegistry::get_method_id(cname, SNAME("missing")), INVALID_METHOD_ID);
+
+	// Methods bound to a class can be found through the classes inheriting it.
+	const StringName &child = MethodBindTestChild::get_class_name_static();
+	TEST_EQ(ClassRegistry::get_method_id(child, SNAME("add")), MethodBindTestObject::add_method);
+
+	MethodBind *add = ClassRegistry::get_method(MethodBindTestObject::add_method);
+	TEST_EQ((add == ClassRegistry::get_method(cname, SNAME("add"))), true);
+	TEST_EQ((add->get_name() == SNAME("add")), true);
+	TEST_EQ((add->get_class_name() == cname), true);
+	TEST_EQ(add->get_argument_count(), 2);
+	TEST_EQ((add->get_argument_name(1) == SNAME("b")), true);
+	TEST_EQ((add->get_argument_name(2) == StringName()), true);
+	TEST_EQ(add->has_return_value(), true);
+	TEST_EQ(ClassRegistry::get_method(MethodBindTestObject::set_value_method)->has_return_value(), false);
+	TEST_EQ((ClassRegistry::get_method(INVALID_METHOD_ID) == nullptr), true);
+
+	// The same name cannot be bound twice to one class.
+	TEST_EQ(ClassRegistry::bind_method(&MethodBindTestObject::add, SNAME("add")), INVALID_METHOD_ID);
+
+	return true;
+}
+
+static bool method_bind_test_call() {
+	method_bind_test_register_classes();
+	MethodBindTestChild obj;
+	const StringName &cname = MethodBindTestObject::get_class_name_static();
+
+	// Through `Variant`s, by name.
+	Error err = OK;
+	TEST_EQ((int)obj.call(SNAME("add"), 2, 3), 5);
+	obj.call(SNAME("set_value"), 7);
+	TEST_EQ((int)obj.call(SNAME("get_value")), 7);
+	TEST_EQ((obj.call(SNAME("describe"), "value: ").operator String() == "value: 7"), true);
+
+	TEST_EQ(obj.callp(SNAME("missing"), nullptr, 0, err).get_type(), Variant::NIL);
+	TEST_EQ(err, ERR_UNAVAILABLE);
+	obj.callp(SNAME("add"), nullptr, 0, err);
+	TEST_EQ(err, ERR_INVALID_PARAMETER);
+
+	// Objects of other classes are turned away.
+	Object other;
+	Variant one = 1;
+	const Variant *args[2] = {&one, &one};
+	ClassRegistry::get_method(cname, SNAME("add"))->call(&other, args, 2, err);
+	TEST_EQ(err, ERR_INVALID_PARAMETER);
+
+	// Without `Variant`s, through the ID.
+	int a = 40;
+	int b = 2;
+	int ret = 0;
+	const void *ptrargs[2] = {&a, &b};
+	ClassRegistry::get_method(MethodBindTestObject::add_method)->ptrcall(&obj, ptrargs, &ret);
+	TEST_EQ(ret, 42);
+
+	const void *value_args[1] = {&b};
+	ClassRegistry::get_method(MethodBindTestObject::set_value_method)->ptrcall(&obj, value_args, nullptr);
+	TEST_EQ(obj.get_value(), 2);
+
+	String prefix = "got ";
+	String described;
+	const void *describe_args[1] = {&prefix};
+	ClassRegistry::get_method(cname, SNAME("describe"))->ptrcall(&obj, describe_args, &described);
+	TEST_EQ((described == "got 2"), true);
+
+	return true;
+}
+
+void method_bind_register_tests() {
+	register_test(method_bind_test_lookup, "MethodBind looking up bound methods by name and by ID");
+	register_test(method_bind_test_call, "MethodBind calling bound methods with and without Variant");
+}
+
+static constexpr int METHOD_BIND_BENCH_CALLS = 1000000;
+
+static void method_bind_bench_call() {
+	method_bind_test_register_classes();
+	MethodBindTestObject obj;
+	MethodBind *add = ClassRegistry::get_method(MethodBindTestObject::add_method);
+	const StringName name = SNAME("add");
+	int64_t sum = 0;
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < METHOD_BIND_BENCH_CALLS; i++) {
+		sum += (int)obj.call(name, i, 1);
+	}
+	benchmark_report("By name with Variant", METHOD_BIND_BENCH_CALLS, benchmark_get_time_usec() - start);
+
+	Variant one = 1;
+	Error err = OK;
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < METHOD_BIND_BENCH_CALLS; i++) {
+		Variant value = i;
+		const Variant *args[2] = {&value, &one};
+		sum += (int)add->call(&obj, args, 2, err);
+	}
+	benchmark_report("By ID with Variant", METHOD_BIND_BENCH_CALLS, benchmark_get_time_usec() - start);
+
+	int b = 1;
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < METHOD_BIND_BENCH_CALLS; i++) {
+		int ret = 0;
+		const void *args[2] = {&i, &b};
+		add->ptrcall(&obj, args, &ret);
+		sum += ret;
+	}
+	benchmark_report("By ID with ptrcall", METHOD_BIND_BENCH_CALLS, benchmark_get_time_usec() - start);
+
+	ERR_FAIL_COND(sum == 0);
+}
+
+void method_bind_register_benchmarks() {
+	register_benchmark(method_bind_bench_call, "MethodBind calling a method with two arguments");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void method_bind_register_tests();
+
+void method_bind_register_benchmarks();
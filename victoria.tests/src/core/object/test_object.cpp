@@ -0,0 +1,405 @@
+#include "core/object/test_object.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/object/callable_method_pointer.h>
+#include <core/object/class_registry.h>
+#include <core/object/object.h>
+#include <core/string/vstring.h>
+
+class ObjectTestEmitter : public Object {
+	VREGISTER_CLASS(ObjectTestEmitter, Object);
+
+public:
+	static SignalID changed_signal;
+	static SignalID value_signal;
+
+protected:
+	static void _bind_methods() {
+		changed_signal = ClassRegistry::add_signal(get_class_name_static(), SNAME("changed"));
+		value_signal = ClassRegistry::add_signal(get_class_name_static(), SNAME("value"));
+	}
+};
+
+SignalID ObjectTestEmitter::changed_signal = INVALID_SIGNAL_ID;
+SignalID ObjectTestEmitter::value_signal = INVALID_SIGNAL_ID;
+
+class ObjectTestEmitterChild : public ObjectTestEmitter {
+	VREGISTER_CLASS(ObjectTestEmitterChild, ObjectTestEmitter);
+
+public:
+	static SignalID finished_signal;
+
+protected:
+	static void _bind_methods() {
+		finished_signal = ClassRegistry::add_signal(get_class_name_static(), SNAME("finished"));
+	}
+};
+
+SignalID ObjectTestEmitterChild::finished_signal = INVALID_SIGNAL_ID;
+
+// Never registered, so casts to it have to go through `dynamic_cast`.
+class ObjectTestUnregistered : public ObjectTestEmitter {
+	VREGISTER_CLASS(ObjectTestUnregistered, ObjectTestEmitter);
+};
+
+// A chain of classes for casting through deep hierarchies.
+class ObjectTestLevel1 : public Object {
+	VREGISTER_CLASS(ObjectTestLevel1, Object);
+};
+
+class ObjectTestLevel2 : public ObjectTestLevel1 {
+	VREGISTER_CLASS(ObjectTestLevel2, ObjectTestLevel1);
+};
+
+class ObjectTestLevel3 : public ObjectTestLevel2 {
+	VREGISTER_CLASS(ObjectTestLevel3, ObjectTestLevel2);
+};
+
+class ObjectTestLevel4 : public ObjectTestLevel3 {
+	VREGISTER_CLASS(ObjectTestLevel4, ObjectTestLevel3);
+};
+
+class ObjectTestLevel5 : public ObjectTestLevel4 {
+	VREGISTER_CLASS(ObjectTestLevel5, ObjectTestLevel4);
+};
+
+class ObjectTestLevel6 : public ObjectTestLevel5 {
+	VREGISTER_CLASS(ObjectTestLevel6, ObjectTestLevel5);
+};
+
+// Handles one notification and says so.
+class ObjectTestNotifiedDeclared : public ObjectTestLevel6 {
+	VREGISTER_CLASS(ObjectTestNotifiedDeclared, ObjectTestLevel6);
+	VNOTIFICATIONS(NOTIFICATION_READY);
+
+protected:
+	void _notification(int p_what) {
+		received++;
+	}
+
+public:
+	int received = 0;
+};
+
+// Sent every notification, as it handles some without saying which.
+class ObjectTestNotifiedUndeclared : public ObjectTestLevel6 {
+	VREGISTER_CLASS(ObjectTestNotifiedUndeclared, ObjectTestLevel6);
+
+protected:
+	void _notification(int p_what) {
+		received++;
+	}
+
+public:
+	int received = 0;
+};
+
+// Has no `_notification` of its own, so only handles what the class it inherits does.
+class ObjectTestNotifiedChild : public ObjectTestNotifiedDeclared {
+	VREGISTER_CLASS(ObjectTestNotifiedChild, ObjectTestNotifiedDeclared);
+};
+
+static void object_test_register_classes() {
+	// Registering again would lose the signals, as the classes only bind their methods once.
+	static bool registered = false;
+	if (registered) {
+		return;
+	}
+
+	// The engine registers `Object` when starting up, which the tests do not do.
+	ClassRegistry::register_class<Object>();
+	ClassRegistry::register_class<ObjectTestEmitter>();
+	ClassRegistry::register_class<ObjectTestEmitterChild>();
+	ClassRegistry::register_class<ObjectTestLevel1>();
+	ClassRegistry::register_class<ObjectTestLevel2>();
+	ClassRegistry::register_class<ObjectTestLevel3>();
+	ClassRegistry::register_class<ObjectTestLevel4>();
+	ClassRegistry::register_class<ObjectTestLevel5>();
+	ClassRegistry::register_class<ObjectTestLevel6>();
+	ClassRegistry::register_class<ObjectTestNotifiedDeclared>();
+	ClassRegistry::register_class<ObjectTestNotifiedUndeclared>();
+	ClassRegistry::register_class<ObjectTestNotifiedChild>();
+	registered = true;
+}
+
+struct objecttest1 {
+	Object *emitter = nullptr;
+	objecttest1 *other = nullptr; // Disconnected by `disconnect_other` while the signal is being emitted
+	int calls = 0;
+	int value = 0;
+
+	void count() {
+		calls++;
+	}
+
+	void set_value(int p_value) {
+		value = p_value;
+		calls++;
+	}
+
+	void disconnect_self() {
+		calls++;
+		emitter->disconnect(ObjectTestEmitter::changed_signal, callable_mp(this, &objecttest1::disconnect_self));
+	}
+
+	void disconnect_other() {
+		calls++;
+		emitter->disconnect(ObjectTestEmitter::changed_signal, callable_mp(other, &objecttest1::count));
+	}
+
+	void connect_self() {
+		calls++;
+		emitter->connect(ObjectTestEmitter::changed_signal, callable_mp(this, &objecttest1::count));
+	}
+};
+
+static bool object_test_signal_ids() {
+	object_test_register_classes();
+
+	TEST_EQ((ObjectTestEmitter::changed_signal != INVALID_SIGNAL_ID), true);
+	TEST_EQ((ObjectTestEmitter::value_signal != ObjectTestEmitter::changed_signal), true);
+
+	// Inherited signals keep their IDs, and the class's own come after them.
+	const StringName &child = ObjectTestEmitterChild::get_class_name_static();
+	TEST_EQ(ClassRegistry::get_signal_count(child), 3);
+	TEST_EQ(ClassRegistry::get_signal_id(child, SNAME("changed")), ObjectTestEmitter::changed_signal);
+	TEST_EQ(ObjectTestEmitterChild::finished_signal, 2);
+	TEST_EQ(ClassRegistry::get_signal_id(ObjectTestEmitter::get_class_name_static(), SNAME("finished")),
+			INVALID_SIGNAL_ID);
+	TEST_EQ(ClassRegistry::has_signal(child, SNAME("value")), true);
+
+	return true;
+}
+
+static bool object_test_connect_and_emit() {
+	object_test_register_classes();
+	ObjectTestEmitterChild emitter;
+	objecttest1 first;
+	objecttest1 second;
+
+	// Nothing is connected yet, so emitting does nothing.
+	TEST_EQ(emitter.emit_signal(ObjectTestEmitter::changed_signal), OK);
+
+	TEST_EQ(emitter.connect(ObjectTestEmitter::value_signal, callable_mp(&first, &objecttest1::set_value)), OK);
+	TEST_EQ(emitter.connect(ObjectTestEmitter::value_signal, callable_mp(&second, &objecttest1::set_value)), OK);
+	TEST_EQ(emitter.connect(ObjectTestEmitter::value_signal, callable_mp(&first, &objecttest1::set_value)),
+			ERR_ALREADY_EXISTS);
+	TEST_EQ(emitter.connect(INVALID_SIGNAL_ID, callable_mp(&first, &objecttest1::count)), ERR_UNAVAILABLE);
+
+	TEST_EQ(emitter.emit_signal(ObjectTestEmitter::value_signal, 5), OK);
+	TEST_EQ(first.value, 5);
+	TEST_EQ(second.value, 5);
+
+	// The named versions go to the same connections.
+	TEST_EQ(emitter.emit_method(SNAME("value"), 7), OK);
+	TEST_EQ(first.value, 7);
+	TEST_EQ(emitter.emit_method(SNAME("missing")), ERR_UNAVAILABLE);
+
+	TEST_EQ(emitter.disconnect_method(SNAME("value"), callable_mp(&first, &objecttest1::set_value)), OK);
+	TEST_EQ(emitter.is_connected(ObjectTestEmitter::value_signal, callable_mp(&first, &objecttest1::set_value)),
+			false);
+	TEST_EQ(emitter.emit_signal(ObjectTestEmitter::value_signal, 9), OK);
+	TEST_EQ(first.value, 7);
+	TEST_EQ(second.value, 9);
+
+	// Signals of the inheriting class sit alongside the inherited ones.
+	TEST_EQ(emitter.connect_method(SNAME("finished"), callable_mp(&first, &objecttest1::count)), OK);
+	TEST_EQ(emitter.emit_signal(ObjectTestEmitterChild::finished_signal), OK);
+	TEST_EQ(first.calls, 3);
+
+	return true;
+}
+
+static bool object_test_emit_while_connecting() {
+	object_test_register_classes();
+	ObjectTestEmitter emitter;
+	objecttest1 self;
+	objecttest1 other;
+	objecttest1 disconnecter;
+	objecttest1 connecter;
+	self.emitter = &emitter;
+	disconnecter.emitter = &emitter;
+	disconnecter.other = &other;
+	connecter.emitter = &emitter;
+
+	SignalID changed = ObjectTestEmitter::changed_signal;
+	TEST_EQ(emitter.connect(changed, callable_mp(&self, &objecttest1::disconnect_self)), OK);
+	TEST_EQ(emitter.connect(changed, callable_mp(&disconnecter, &objecttest1::disconnect_other)), OK);
+	TEST_EQ(emitter.connect(changed, callable_mp(&other, &objecttest1::count)), OK);
+	TEST_EQ(emitter.connect(changed, callable_mp(&connecter, &objecttest1::connect_self)), OK);
+
+	// A method disconnected by an earlier one is skipped, and one connected while emitting waits for the next
+	// emission.
+	TEST_EQ(emitter.emit_signal(changed), OK);
+	TEST_EQ(self.calls, 1);
+	TEST_EQ(disconnecter.calls, 1);
+	TEST_EQ(other.calls, 0);
+	TEST_EQ(connecter.calls, 1);
+
+	TEST_EQ(emitter.is_connected(changed, callable_mp(&self, &objecttest1::disconnect_self)), false);
+	TEST_EQ(emitter.is_connected(changed, callable_mp(&connecter, &objecttest1::count)), true);
+
+	TEST_EQ(emitter.disconnect(changed, callable_mp(&connecter, &objecttest1::connect_self)), OK);
+	TEST_EQ(emitter.emit_signal(changed), OK);
+	TEST_EQ(self.calls, 1);
+	TEST_EQ(disconnecter.calls, 2);
+	TEST_EQ(connecter.calls, 2);
+
+	return true;
+}
+
+static bool object_test_cast_to() {
+	object_test_register_classes();
+	ObjectTestEmitter emitter;
+	ObjectTestEmitterChild child;
+	ObjectTestUnregistered unregistered;
+	ObjectTestLevel6 deep;
+
+	TEST_EQ((ClassRegistry::get_class_id(ObjectTestEmitterChild::get_class_name_static()) != 0), true);
+	TEST_EQ(ClassRegistry::get_class_id(ObjectTestUnregistered::get_class_name_static()), 0);
+
+	// Registered classes are numbered so that they fall within the range of every class they inherit.
+	const ClassType &level1 = ObjectTestLevel1::get_class_type_static();
+	const ClassType &level6 = ObjectTestLevel6::get_class_type_static();
+	TEST_EQ((level6.pre != 0), true);
+	TEST_EQ((level1.pre < level6.pre && level6.pre <= level1.post), true);
+	TEST_EQ(ObjectTestUnregistered::get_class_type_static().pre, 0);
+
+	// Casting up and down the registered classes.
+	TEST_EQ((Object::cast_to<ObjectTestEmitter>(&child) == &child), true);
+	TEST_EQ((Object::cast_to<ObjectTestEmitterChild>(&emitter) == nullptr), true);
+	TEST_EQ((Object::cast_to<Object>(&deep) == &deep), true);
+	TEST_EQ((Object::cast_to<ObjectTestLevel1>(&deep) == &deep), true);
+	TEST_EQ((Object::cast_to<ObjectTestLevel4>(&deep) == &deep), true);
+	TEST_EQ((Object::cast_to<ObjectTestEmitter>(&deep) == nullptr), true);
+	TEST_EQ((Object::cast_to<ObjectTestLevel1>(&child) == nullptr), true);
+
+	const Object *const_child = &child;
+	TEST_EQ((Object::cast_to<ObjectTestEmitter>(const_child) == &child), true);
+	TEST_EQ((Object::cast_to<ObjectTestEmitter>((Object *)nullptr) == nullptr), true);
+
+	// The same results for a class that was never registered.
+	TEST_EQ((Object::cast_to<ObjectTestEmitter>(&unregistered) == &unregistered), true);
+	TEST_EQ((Object::cast_to<ObjectTestUnregistered>(&unregistered) == &unregistered), true);
+	TEST_EQ((Object::cast_to<ObjectTestUnregistered>(&emitter) == nullptr), true);
+	TEST_EQ((Object::cast_to<ObjectTestEmitterChild>(&unregistered) == nullptr), true);
+
+	return true;
+}
+
+static bool object_test_notification_masks() {
+	object_test_register_classes();
+	ObjectTestNotifiedDeclared declared;
+	ObjectTestNotifiedUndeclared undeclared;
+	ObjectTestNotifiedChild child;
+	ObjectTestLevel6 none;
+
+	TEST_EQ(declared.handles_notification(NOTIFICATION_READY), true);
+	TEST_EQ(declared.handles_notification(NOTIFICATION_UPDATE), false);
+	TEST_EQ(undeclared.handles_notification(NOTIFICATION_UPDATE), true);
+	TEST_EQ(child.handles_notification(NOTIFICATION_READY), true);
+	TEST_EQ(child.handles_notification(NOTIFICATION_DRAW), false);
+	TEST_EQ(none.handles_notification(NOTIFICATION_READY), false);
+	TEST_EQ(ObjectTestLevel6::get_class_type_static().notification_mask, 0);
+
+	// Notifications the class did not declare never reach its `_notification`.
+	declared.notification(NOTIFICATION_UPDATE);
+	declared.notification(NOTIFICATION_READY);
+	TEST_EQ(declared.received, 1);
+	child.notification(NOTIFICATION_READY, true);
+	TEST_EQ(child.received, 1);
+
+	undeclared.notification(NOTIFICATION_UPDATE);
+	undeclared.notification(NOTIFICATION_DRAW);
+	TEST_EQ(undeclared.received, 2);
+
+	// Classes that were never registered are sent everything.
+	ObjectTestUnregistered unregistered;
+	TEST_EQ(unregistered.handles_notification(NOTIFICATION_DRAW), true);
+
+	return true;
+}
+
+void object_register_tests() {
+	register_test(object_test_signal_ids, "Object signal IDs following those of the inherited class");
+	register_test(object_test_connect_and_emit, "Object connecting and emitting signals by ID and by name");
+	register_test(object_test_emit_while_connecting, "Object connecting and disconnecting while emitting a signal");
+	register_test(object_test_cast_to, "Object casting between registered and unregistered classes");
+	register_test(object_test_notification_masks, "Object only sending the notifications a class handles");
+}
+
+static constexpr int OBJECT_BENCH_EMITS = 1000000;
+
+static void object_bench_emit() {
+	object_test_register_classes();
+	ObjectTestEmitter emitter;
+	objecttest1 receiver;
+	emitter.connect(ObjectTestEmitter::changed_signal, callable_mp(&receiver, &objecttest1::count));
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < OBJECT_BENCH_EMITS; i++) {
+		emitter.emit_signal(ObjectTestEmitter::changed_signal);
+	}
+	benchmark_report("Emit by ID", OBJECT_BENCH_EMITS, benchmark_get_time_usec() - start);
+
+	const StringName changed = SNAME("changed");
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < OBJECT_BENCH_EMITS; i++) {
+		emitter.emit_method(changed);
+	}
+	benchmark_report("Emit by name", OBJECT_BENCH_EMITS, benchmark_get_time_usec() - start);
+}
+
+static constexpr int OBJECT_BENCH_CASTS = 4000000;
+
+static void object_bench_cast_to() {
+	object_test_register_classes();
+	ObjectTestLevel6 deep;
+	ObjectTestEmitterChild child;
+	Object *objects[2] = {&deep, &child};
+
+	// Half of the casts succeed and half fail, which is what walking mixed children looks like.
+	uint64_t start = benchmark_get_time_usec();
+	int found = 0;
+	for (int i = 0; i < OBJECT_BENCH_CASTS; i++) {
+		found += dynamic_cast<ObjectTestLevel2 *>(objects[i & 1]) != nullptr;
+	}
+	benchmark_report("dynamic_cast, 6 levels deep", OBJECT_BENCH_CASTS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < OBJECT_BENCH_CASTS; i++) {
+		found += Object::cast_to<ObjectTestLevel2>(objects[i & 1]) != nullptr;
+	}
+	benchmark_report("cast_to, 6 levels deep", OBJECT_BENCH_CASTS, benchmark_get_time_usec() - start);
+
+	ERR_FAIL_COND(found != OBJECT_BENCH_CASTS);
+}
+
+static constexpr int OBJECT_BENCH_NOTIFICATIONS = 4000000;
+
+static void object_bench_notification() {
+	object_test_register_classes();
+	ObjectTestNotifiedDeclared declared;
+	ObjectTestNotifiedUndeclared undeclared;
+
+	// Neither handles UPDATE, but only one of them says so.
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < OBJECT_BENCH_NOTIFICATIONS; i++) {
+		undeclared.notification(NOTIFICATION_UPDATE);
+	}
+	benchmark_report("Unhandled, walking 8 classes", OBJECT_BENCH_NOTIFICATIONS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < OBJECT_BENCH_NOTIFICATIONS; i++) {
+		declared.notification(NOTIFICATION_UPDATE);
+	}
+	benchmark_report("Unhandled, skipped by the mask", OBJECT_BENCH_NOTIFICATIONS, benchmark_get_time_usec() - start);
+}
+
+void object_register_benchmarks() {
+	register_benchmark(object_bench_emit, "Object emitting a signal with one connection");
+	register_benchmark(object_bench_cast_to, "Object casting through a deep hierarchy");
+	register_benchmark(object_bench_notification, "Object sending a notification its class does not handle");
+}
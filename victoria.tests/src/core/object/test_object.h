@@ -0,0 +1,5 @@
+#pragma once
+
+void object_register_tests();
+
+void object_register_benchmarks();
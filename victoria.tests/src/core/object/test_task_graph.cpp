@@ -0,0 +1,196 @@
+#include "core/object/test_task_graph.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/atomic_counter.h>
+#include <core/data/local_vector.h>
+#include <core/object/task_graph.h>
+#include <core/object/worker_thread_pool.h>
+#include <core/os/memory.h>
+#include <core/string/vstring.h>
+
+struct taskgraphtest1 {
+	AtomicCounter<uint32_t> *sequence = nullptr;
+	// The position the task ran in, counting from 1.
+	uint32_t order = 0;
+	uint32_t runs = 0;
+};
+
+static void task_graph_test_record(void *p_userdata) {
+	taskgraphtest1 *data = (taskgraphtest1 *)p_userdata;
+	data->order = data->sequence->increment();
+	data->runs++;
+}
+
+static uint64_t task_graph_test_allocation_count() {
+	uint64_t count = 0;
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		count += Memory::get_tag_stats((MemoryTag)i).allocation_count;
+	}
+	return count;
+}
+
+static bool task_graph_test_dependencies() {
+	WorkerThreadPool pool;
+	pool.init(3);
+
+	// A diamond, A -> (B, C) -> D, with E continuing from D and F depending on nothing.
+	AtomicCounter<uint32_t> sequence;
+	taskgraphtest1 data[6];
+	TaskGraph graph;
+	for (int i = 0; i < 6; i++) {
+		data[i].sequence = &sequence;
+	}
+
+	TaskGraph::TaskID a = graph.add_task("A", task_graph_test_record, &data[0]);
+	TaskGraph::TaskID b = graph.add_task("B", task_graph_test_record, &data[1]);
+	TaskGraph::TaskID c = graph.add_task("C", task_graph_test_record, &data[2]);
+	TaskGraph::TaskID d = graph.add_task("D", task_graph_test_record, &data[3]);
+	graph.add_dependency(b, a);
+	graph.add_dependency(c, a);
+	graph.add_dependency(d, b);
+	graph.add_dependency(d, c);
+	// Adding the same dependency twice has no effect.
+	graph.add_dependency(d, c);
+	graph.add_continuation(d, "E", task_graph_test_record, &data[4]);
+	graph.add_task("F", task_graph_test_record, &data[5]);
+	TEST_EQ(graph.get_task_count(), 6u);
+	TEST_EQ(graph.get_task_name(d), "D");
+
+	// The first run sets up the graph, later runs should not allocate at all.
+	TEST_EQ(graph.run(&pool), OK);
+	uint64_t allocations = task_graph_test_allocation_count();
+
+	bool ordered = true;
+	for (int run = 0; run < 50; run++) {
+		sequence.set(0);
+		TEST_EQ(graph.run(&pool), OK);
+
+		ordered = ordered && data[0].order < data[1].order && data[0].order < data[2].order;
+		ordered = ordered && data[1].order < data[3].order && data[2].order < data[3].order;
+		ordered = ordered && data[3].order < data[4].order;
+	}
+	TEST_EQ(ordered, true);
+	TEST_EQ(task_graph_test_allocation_count(), allocations);
+	for (int i = 0; i < 6; i++) {
+		TEST_EQ(data[i].runs, 51u);
+	}
+
+	// Swapping the data a task works on between runs.
+	taskgraphtest1 other;
+	other.sequence = &sequence;
+	graph.set_userdata(a, &other);
+	TEST_EQ(graph.run(&pool), OK);
+	TEST_EQ(other.runs, 1u);
+	TEST_EQ(data[0].runs, 51u);
+
+	return true;
+}
+
+static bool task_graph_test_cycle() {
+	WorkerThreadPool pool;
+	pool.init(1);
+
+	AtomicCounter<uint32_t> sequence;
+	taskgraphtest1 data;
+	data.sequence = &sequence;
+
+	TaskGraph graph;
+	TaskGraph::TaskID a = graph.add_task("A", task_graph_test_record, &data);
+	TaskGraph::TaskID b = graph.add_continuation(a, "B", task_graph_test_record, &data);
+	TaskGraph::TaskID c = graph.add_continuation(b, "C", task_graph_test_record, &data);
+	graph.add_dependency(a, c);
+
+	// Nothing runs if the graph has a cycle.
+	TEST_EQ(graph.run(&pool), ERR_INVALID_DATA);
+	TEST_EQ(data.runs, 0u);
+
+	graph.clear();
+	TEST_EQ(graph.get_task_count(), 0u);
+	TEST_EQ(graph.run(&pool), OK);
+
+	return true;
+}
+
+static bool task_graph_test_trace() {
+	WorkerThreadPool pool;
+	pool.init(2);
+
+	AtomicCounter<uint32_t> sequence;
+	taskgraphtest1 data[3];
+	TaskGraph graph;
+	TaskGraph::TaskID first = graph.add_task("First \"quoted\"", task_graph_test_record, &data[0]);
+	for (int i = 1; i < 3; i++) {
+		data[i].sequence = &sequence;
+		graph.add_continuation(first, vformat("Second %d", i), task_graph_test_record, &data[i]);
+	}
+	data[0].sequence = &sequence;
+
+	graph.set_trace_enabled(true);
+	TEST_EQ(graph.run(&pool), OK);
+
+	LocalVector<TaskGraph::TraceEvent> events;
+	graph.get_trace(events);
+	TEST_EQ(events.size(), 3u);
+	bool valid = true;
+	for (const TaskGraph::TraceEvent &event : events) {
+		valid = valid && event.end_usec >= event.start_usec;
+		valid = valid && event.thread >= -1 && event.thread < (int)pool.get_thread_count();
+		// Continuations cannot start before the task they continue from has ended.
+		valid = valid && (event.task == first || event.start_usec >= events[first].end_usec);
+	}
+	TEST_EQ(valid, true);
+
+	String json = graph.export_trace();
+	TEST_EQ(json.begins_with("{\"traceEvents\":["), true);
+	TEST_EQ(json.contains("\"name\":\"First \\\"quoted\\\"\""), true);
+	TEST_EQ(json.contains("\"name\":\"Second 2\""), true);
+	TEST_EQ(json.contains("\"name\":\"Caller\""), true);
+	TEST_EQ(json.ends_with("]}\n"), true);
+
+	return true;
+}
+
+void task_graph_register_tests() {
+	register_test(task_graph_test_dependencies, "TaskGraph running tasks after their dependencies, every frame");
+	register_test(task_graph_test_cycle, "TaskGraph refusing to run a graph with a cycle");
+	register_test(task_graph_test_trace, "TaskGraph recording and exporting a trace of a run");
+}
+
+static constexpr int TASK_GRAPH_BENCH_TASKS = 256;
+static constexpr int TASK_GRAPH_BENCH_RUNS = 500;
+
+static void task_graph_bench_empty(void *) {
+}
+
+static void task_graph_bench_shape(const char *p_label, bool p_chain) {
+	WorkerThreadPool pool;
+	pool.init();
+
+	// Either every task depends on the one before it, or every task depends on the first one.
+	TaskGraph graph;
+	TaskGraph::TaskID first = graph.add_task("Root", task_graph_bench_empty, nullptr);
+	TaskGraph::TaskID previous = first;
+	for (int i = 1; i < TASK_GRAPH_BENCH_TASKS; i++) {
+		previous = graph.add_continuation(p_chain ? previous : first, "Task", task_graph_bench_empty, nullptr);
+	}
+	graph.run(&pool);
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < TASK_GRAPH_BENCH_RUNS; i++) {
+		graph.run(&pool);
+	}
+	benchmark_report(p_label,
+					 (uint64_t)TASK_GRAPH_BENCH_TASKS * TASK_GRAPH_BENCH_RUNS,
+					 benchmark_get_time_usec() - start);
+}
+
+static void task_graph_bench_run() {
+	task_graph_bench_shape("TaskGraph run, chain of 256 empty tasks", true);
+	task_graph_bench_shape("TaskGraph run, fan-out of 256 empty tasks", false);
+}
+
+void task_graph_register_benchmarks() {
+	register_benchmark(task_graph_bench_run, "TaskGraph scheduling overhead per task");
+}
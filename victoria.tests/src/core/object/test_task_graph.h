@@ -0,0 +1,5 @@
+#pragma once
+
+void task_graph_register_tests();
+
+void task_graph_register_benchmarks();
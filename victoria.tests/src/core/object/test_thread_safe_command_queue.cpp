@@ -0,0 +1,212 @@
+#include "core/object/test_thread_safe_command_queue.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/atomic_counter.h>
+#include <core/data/local_vector.h>
+#include <core/object/callable_method_pointer.h>
+#include <core/object/thread_safe_command_queue.h>
+#include <core/os/thread.h>
+#include <core/string/vstring.h>
+
+static constexpr int THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS = 4;
+static constexpr int THREAD_SAFE_COMMAND_QUEUE_TEST_COMMANDS = 3000;
+
+// Only ever touched from the flushing thread, as that is where the commands are called.
+static int thread_safe_command_queue_test_last[THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS];
+static int thread_safe_command_queue_test_calls = 0;
+static bool thread_safe_command_queue_test_in_order = true;
+
+static void thread_safe_command_queue_test_record(int p_thread, int p_sequence) {
+	thread_safe_command_queue_test_in_order = thread_safe_command_queue_test_in_order &&
+											  thread_safe_command_queue_test_last[p_thread] + 1 == p_sequence;
+	thread_safe_command_queue_test_last[p_thread] = p_sequence;
+	thread_safe_command_queue_test_calls++;
+}
+
+static void thread_safe_command_queue_test_count() {
+	thread_safe_command_queue_test_calls++;
+}
+
+struct threadsafecommandqueuetest1 {
+	ThreadSafeCommandQueue *queue = nullptr;
+	int index = 0;
+	AtomicCounter<uint32_t> *finished = nullptr;
+};
+
+static void thread_safe_command_queue_test_producer(void *p_userdata) {
+	threadsafecommandqueuetest1 *data = (threadsafecommandqueuetest1 *)p_userdata;
+	CallableMethod record = static_callable_mp(&thread_safe_command_queue_test_record);
+	for (int i = 0; i < THREAD_SAFE_COMMAND_QUEUE_TEST_COMMANDS; i++) {
+		data->queue->push_command(record, data->index, i);
+	}
+	data->finished->increment();
+}
+
+static bool thread_safe_command_queue_test_producers() {
+	ThreadSafeCommandQueue queue;
+	for (int i = 0; i < THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS; i++) {
+		thread_safe_command_queue_test_last[i] = -1;
+	}
+	thread_safe_command_queue_test_calls = 0;
+	thread_safe_command_queue_test_in_order = true;
+
+	AtomicCounter<uint32_t> finished;
+	threadsafecommandqueuetest1 data[THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS];
+	Thread threads[THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS];
+	for (int i = 0; i < THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS; i++) {
+		data[i].queue = &queue;
+		data[i].index = i;
+		data[i].finished = &finished;
+		threads[i].start(thread_safe_command_queue_test_producer, &data[i]);
+	}
+
+	// Flushing while the other threads push, so that blocks are read while they are still being written to.
+	while (finished.get() < THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS) {
+		queue.flush();
+	}
+	for (int i = 0; i < THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS; i++) {
+		threads[i].wait_to_finish();
+	}
+	queue.flush();
+
+	TEST_EQ(thread_safe_command_queue_test_in_order, true);
+	TEST_EQ(thread_safe_command_queue_test_calls,
+			THREAD_SAFE_COMMAND_QUEUE_TEST_THREADS * THREAD_SAFE_COMMAND_QUEUE_TEST_COMMANDS);
+
+	// A command with more arguments than fit in a block gets a block of its own.
+	LocalVector<Variant> args;
+	LocalVector<const Variant *> argptrs;
+	args.resize(200);
+	for (uint32_t i = 0; i < args.size(); i++) {
+		args[i] = (int)i;
+		argptrs.push_back(&args[i]);
+	}
+	thread_safe_command_queue_test_calls = 0;
+	CallableMethod count = static_callable_mp(&thread_safe_command_queue_test_count);
+	TEST_EQ(queue.push_command(count), OK);
+	TEST_EQ(queue.push_commandp(count, argptrs.ptrw(), args.size()), OK);
+	TEST_EQ(queue.push_command(count), OK);
+	queue.flush();
+	TEST_EQ(thread_safe_command_queue_test_calls, 3);
+
+	// Cleared commands are never called.
+	TEST_EQ(queue.push_command(count), OK);
+	queue.clear();
+	queue.flush();
+	TEST_EQ(thread_safe_command_queue_test_calls, 3);
+
+	return true;
+}
+
+struct threadsafecommandqueuetest2 {
+	ThreadSafeCommandQueue *queue = nullptr;
+	bool seen = false;
+	AtomicCounter<uint32_t> finished;
+};
+
+static int thread_safe_command_queue_test_value = 0;
+
+static void thread_safe_command_queue_test_set(int p_value) {
+	thread_safe_command_queue_test_value = p_value;
+}
+
+static void thread_safe_command_queue_test_waiter(void *p_userdata) {
+	threadsafecommandqueuetest2 *data = (threadsafecommandqueuetest2 *)p_userdata;
+	CallableMethod set = static_callable_mp(&thread_safe_command_queue_test_set);
+	data->queue->push_command(set, 42);
+	data->queue->flush_and_wait();
+	// Only the flushing thread writes the value, and it did so before the wait returned.
+	data->seen = thread_safe_command_queue_test_value == 42;
+	data->finished.increment();
+}
+
+static bool thread_safe_command_queue_test_flush_and_wait() {
+	ThreadSafeCommandQueue queue;
+	thread_safe_command_queue_test_value = 0;
+	threadsafecommandqueuetest2 data;
+	data.queue = &queue;
+
+	Thread thread;
+	thread.start(thread_safe_command_queue_test_waiter, &data);
+	while (data.finished.get() == 0) {
+		queue.flush();
+	}
+	thread.wait_to_finish();
+
+	TEST_EQ(data.seen, true);
+	// Nothing was pushed from this thread, so this only flushes.
+	queue.flush_and_wait();
+
+	return true;
+}
+
+void thread_safe_command_queue_register_tests() {
+	register_test(thread_safe_command_queue_test_producers,
+				  "ThreadSafeCommandQueue calling commands pushed by many threads");
+	register_test(thread_safe_command_queue_test_flush_and_wait,
+				  "ThreadSafeCommandQueue waiting on a synchronous call");
+}
+
+static constexpr int THREAD_SAFE_COMMAND_QUEUE_BENCH_COMMANDS = 200000;
+
+static void thread_safe_command_queue_bench_empty(int p_value) {
+}
+
+struct threadsafecommandqueuebench1 {
+	ThreadSafeCommandQueue *queue = nullptr;
+	int count = 0;
+	AtomicCounter<uint32_t> *finished = nullptr;
+};
+
+static void thread_safe_command_queue_bench_producer(void *p_userdata) {
+	threadsafecommandqueuebench1 *data = (threadsafecommandqueuebench1 *)p_userdata;
+	CallableMethod empty = static_callable_mp(&thread_safe_command_queue_bench_empty);
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_command(empty, i);
+	}
+	data->finished->increment();
+}
+
+static void thread_safe_command_queue_bench_producers() {
+	uint32_t max_threads = Thread::get_hardware_concurrency();
+	if (max_threads < 4) {
+		max_threads = 4;
+	}
+
+	// The same number of commands in total, split between more and more threads, while this thread flushes them.
+	for (uint32_t threads = 1; threads <= max_threads; threads++) {
+		ThreadSafeCommandQueue queue;
+		AtomicCounter<uint32_t> finished;
+		LocalVector<threadsafecommandqueuebench1> data;
+		LocalVector<Thread *> producers;
+		data.resize(threads);
+
+		uint64_t start = benchmark_get_time_usec();
+		for (uint32_t i = 0; i < threads; i++) {
+			data[i].queue = &queue;
+			data[i].count = THREAD_SAFE_COMMAND_QUEUE_BENCH_COMMANDS / threads;
+			data[i].finished = &finished;
+			producers.push_back(vnew(Thread));
+			producers[i]->start(thread_safe_command_queue_bench_producer, &data[i]);
+		}
+		while (finished.get() < threads) {
+			queue.flush();
+		}
+		for (Thread *thread : producers) {
+			thread->wait_to_finish();
+			vdelete(thread);
+		}
+		queue.flush();
+
+		benchmark_report(vformat("Push and flush, %u producers", threads),
+						 (uint64_t)(THREAD_SAFE_COMMAND_QUEUE_BENCH_COMMANDS / threads) * threads,
+						 benchmark_get_time_usec() - start);
+	}
+}
+
+void thread_safe_command_queue_register_benchmarks() {
+	register_benchmark(thread_safe_command_queue_bench_producers,
+					   "ThreadSafeCommandQueue pushes from one thread to many");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void thread_safe_command_queue_register_tests();
+
+void thread_safe_command_queue_register_benchmarks();
@@ -0,0 +1,166 @@
+#include "core/object/test_worker_thread_pool.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/atomic_counter.h>
+#include <core/data/local_vector.h>
+#include <core/math/math_funcs.h>
+#include <core/object/worker_thread_pool.h>
+#include <core/os/thread.h>
+#include <core/string/vstring.h>
+
+static void worker_thread_pool_test_increment(void *p_userdata) {
+	((AtomicCounter<uint32_t> *)p_userdata)->increment();
+}
+
+static bool worker_thread_pool_test_tasks() {
+	WorkerThreadPool pool;
+	pool.init(3);
+	TEST_EQ(pool.get_thread_count(), 3u);
+
+	AtomicCounter<uint32_t> counter;
+	LocalVector<WorkerThreadPool::TaskID> ids;
+	for (int i = 0; i < 256; i++) {
+		ids.push_back(pool.add_task(worker_thread_pool_test_increment, &counter));
+	}
+
+	for (WorkerThreadPool::TaskID id : ids) {
+		TEST_EQ(pool.wait_for_task_completion(id), OK);
+	}
+	TEST_EQ(counter.get(), 256u);
+
+	// Waiting frees the task, so its ID is no longer valid.
+	TEST_EQ(pool.wait_for_task_completion(ids[0]), ERR_INVALID_PARAMETER);
+	TEST_EQ(pool.add_task(nullptr, nullptr), WorkerThreadPool::INVALID_TASK_ID);
+
+	return true;
+}
+
+static void worker_thread_pool_test_square(void *p_userdata, uint32_t p_index) {
+	((uint64_t *)p_userdata)[p_index] = (uint64_t)p_index * p_index;
+}
+
+static bool worker_thread_pool_test_group() {
+	WorkerThreadPool pool;
+	pool.init(4);
+
+	// Covers both fewer indices than threads and enough indices for each task to claim them in batches.
+	const uint32_t counts[] = {0, 1, 3, 1000, 100003};
+	for (uint32_t count : counts) {
+		LocalVector<uint64_t> results;
+		results.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			results[i] = 0;
+		}
+
+		WorkerThreadPool::GroupID group = pool.add_group_task(worker_thread_pool_test_square, results.ptrw(), count);
+		TEST_EQ(pool.wait_for_group_task_completion(group), OK);
+
+		bool all_set = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_set = all_set && results[i] == (uint64_t)i * i;
+		}
+		TEST_EQ(all_set, true);
+	}
+
+	return true;
+}
+
+struct workerthreadpooltest1 {
+	WorkerThreadPool *pool = nullptr;
+	AtomicCounter<uint32_t> calls;
+};
+
+static void worker_thread_pool_test_inner(void *p_userdata, uint32_t p_index) {
+	((workerthreadpooltest1 *)p_userdata)->calls.increment();
+}
+
+static void worker_thread_pool_test_outer(void *p_userdata) {
+	workerthreadpooltest1 *data = (workerthreadpooltest1 *)p_userdata;
+	WorkerThreadPool::GroupID group = data->pool->add_group_task(worker_thread_pool_test_inner, data, 500);
+	data->pool->wait_for_group_task_completion(group);
+}
+
+static bool worker_thread_pool_test_nested() {
+	// More outer tasks than workers, so that every worker ends up waiting on work it added itself, which only
+	// completes because waiting threads run pending tasks and idle workers steal them.
+	WorkerThreadPool pool;
+	pool.init(2);
+
+	workerthreadpooltest1 data;
+	data.pool = &pool;
+	LocalVector<WorkerThreadPool::TaskID> ids;
+	for (int i = 0; i < 16; i++) {
+		ids.push_back(pool.add_task(worker_thread_pool_test_outer, &data));
+	}
+	for (WorkerThreadPool::TaskID id : ids) {
+		TEST_EQ(pool.wait_for_task_completion(id), OK);
+	}
+	TEST_EQ(data.calls.get(), 16u * 500u);
+
+	return true;
+}
+
+void worker_thread_pool_register_tests() {
+	register_test(worker_thread_pool_test_tasks, "WorkerThreadPool running and waiting on single tasks");
+	register_test(worker_thread_pool_test_group, "WorkerThreadPool group tasks calling every index once");
+	register_test(worker_thread_pool_test_nested, "WorkerThreadPool tasks waiting on group tasks they added");
+}
+
+static constexpr uint32_t WORKER_THREAD_POOL_BENCH_ITEMS = 20000;
+static constexpr uint32_t WORKER_THREAD_POOL_BENCH_WORK = 1000;
+static constexpr int WORKER_THREAD_POOL_BENCH_TASKS = 100000;
+
+static void worker_thread_pool_bench_work(void *p_userdata, uint32_t p_index) {
+	double acc = 0.0;
+	for (uint32_t i = 0; i < WORKER_THREAD_POOL_BENCH_WORK; i++) {
+		acc += Math::sqrt((double)(p_index + i));
+	}
+	((double *)p_userdata)[p_index] = acc;
+}
+
+static void worker_thread_pool_bench_empty(void *) {
+}
+
+static void worker_thread_pool_bench_scaling() {
+	LocalVector<double> results;
+	results.resize(WORKER_THREAD_POOL_BENCH_ITEMS);
+
+	// Splitting the group into one task per thread caps how many threads can run it at once.
+	uint32_t max_threads = Thread::get_hardware_concurrency();
+	for (uint32_t threads = 1; threads <= max_threads; threads++) {
+		WorkerThreadPool pool;
+		pool.init(threads);
+
+		uint64_t start = benchmark_get_time_usec();
+		WorkerThreadPool::GroupID group = pool.add_group_task(worker_thread_pool_bench_work,
+															  results.ptrw(),
+															  WORKER_THREAD_POOL_BENCH_ITEMS,
+															  threads);
+		pool.wait_for_group_task_completion(group);
+		benchmark_report(vformat("Group task, %u threads (Mcalls/s)", threads),
+						 (uint64_t)WORKER_THREAD_POOL_BENCH_ITEMS * WORKER_THREAD_POOL_BENCH_WORK,
+						 benchmark_get_time_usec() - start);
+	}
+
+	WorkerThreadPool pool;
+	pool.init();
+	LocalVector<WorkerThreadPool::TaskID> ids;
+	ids.resize(WORKER_THREAD_POOL_BENCH_TASKS);
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < WORKER_THREAD_POOL_BENCH_TASKS; i++) {
+		ids[i] = pool.add_task(worker_thread_pool_bench_empty, nullptr);
+	}
+	for (int i = 0; i < WORKER_THREAD_POOL_BENCH_TASKS; i++) {
+		pool.wait_for_task_completion(ids[i]);
+	}
+	benchmark_report("Add and wait on an empty task",
+					 WORKER_THREAD_POOL_BENCH_TASKS,
+					 benchmark_get_time_usec() - start);
+}
+
+void worker_thread_pool_register_benchmarks() {
+	register_benchmark(worker_thread_pool_bench_scaling, "WorkerThreadPool scaling from one thread to every core");
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void worker_thread_pool_register_tests();
+
+void worker_thread_pool_register_benchmarks();
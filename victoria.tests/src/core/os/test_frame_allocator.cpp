@@ -0,0 +1,155 @@
+#include "core/os/test_frame_allocator.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/frame_vector.h>
+#include <core/data/vector.h>
+#include <core/os/frame_allocator.h>
+#include <core/os/memory.h>
+#include <core/string/vstring.h>
+
+static bool frame_allocator_test_allocate() {
+	FrameAllocator::begin_frame();
+	TEST_EQ(FrameAllocator::get_thread_usage(), 0u);
+
+	uint8_t *a = (uint8_t *)FrameAllocator::allocate(3, 1);
+	uint8_t *b = (uint8_t *)FrameAllocator::allocate(16, 16);
+	TEST_EQ(((uintptr_t)b % 16), 0u);
+	TEST_EQ((b > a), true);
+	TEST_EQ((FrameAllocator::get_thread_usage() >= 19u), true);
+
+	// Only the most recent allocation can be grown in place
+	TEST_EQ(FrameAllocator::extend(b, 16, 64), true);
+	TEST_EQ(FrameAllocator::extend(a, 3, 8), false);
+	uint8_t *c = (uint8_t *)FrameAllocator::allocate(8, 8);
+	TEST_EQ((c >= b + 64), true);
+
+	// Allocations larger than a block should still succeed
+	uint8_t *large = (uint8_t *)FrameAllocator::allocate(1024 * 1024, 64);
+	TEST_EQ(((uintptr_t)large % 64), 0u);
+	Memory::vset_memory(large, 0xAB, 1024 * 1024);
+	TEST_EQ(large[1024 * 1024 - 1], 0xAB);
+
+	return true;
+}
+
+static bool frame_allocator_test_double_buffer() {
+	FrameAllocator::begin_frame();
+	uint64_t *first = (uint64_t *)FrameAllocator::allocate(sizeof(uint64_t) * 4);
+	for (int i = 0; i < 4; i++) {
+		first[i] = i;
+	}
+	uint64_t usage = FrameAllocator::get_thread_usage();
+
+	// Memory from the last frame must survive a new frame
+	FrameAllocator::begin_frame();
+	uint64_t *second = (uint64_t *)FrameAllocator::allocate(sizeof(uint64_t) * 4);
+	for (int i = 0; i < 4; i++) {
+		second[i] = 100 + i;
+	}
+	TEST_EQ(first[3], 3u);
+	TEST_EQ(FrameAllocator::get_thread_usage(), usage);
+
+	// ...but is reused two frames later
+	FrameAllocator::begin_frame();
+	uint64_t *third = (uint64_t *)FrameAllocator::allocate(sizeof(uint64_t) * 4);
+	TEST_EQ(third, first);
+	TEST_EQ(second[3], 103u);
+
+	TEST_EQ((Memory::get_frame_arena_max_usage() >= usage), true);
+
+	return true;
+}
+
+static bool frame_allocator_test_vector() {
+	FrameAllocator::begin_frame();
+
+	FrameVector<int> vec;
+	for (int i = 0; i < 8; i++) {
+		vec.push_back(i);
+	}
+	const int *ptr = vec.ptr();
+
+	// As nothing else was allocated, growing should happen in place
+	for (int i = 8; i < 100; i++) {
+		vec.push_back(i);
+	}
+	TEST_EQ(vec.ptr(), ptr);
+	TEST_EQ(vec.size(), 100u);
+	TEST_EQ(vec[99], 99);
+
+	// Another allocation in between forces the next growth to move the data
+	FrameVector<int> other;
+	other.push_back(1);
+	vec.resize(vec.get_capacity() + 1);
+	TEST_EQ((vec.ptr() != ptr), true);
+	TEST_EQ(vec[50], 50);
+	TEST_EQ(other[0], 1);
+
+	FrameVector<String> strings;
+	for (int i = 0; i < 20; i++) {
+		strings.push_back(itos(i));
+	}
+	TEST_EQ(strings[19], "19");
+	TEST_EQ(strings.find("7"), 7);
+
+	FrameVector<String> moved = std::move(strings);
+	TEST_EQ(strings.size(), 0u);
+	TEST_EQ(moved.size(), 20u);
+	TEST_EQ(moved[0], "0");
+
+	int count = 0;
+	for (const String &s : moved) {
+		TEST_EQ(s, itos(count));
+		count++;
+	}
+
+	return true;
+}
+
+void frame_allocator_register_tests() {
+	register_test(frame_allocator_test_allocate, "FrameAllocator allocating, aligning and extending memory");
+	register_test(frame_allocator_test_double_buffer, "FrameAllocator keeping memory for one frame and reusing it");
+	register_test(frame_allocator_test_vector, "FrameVector reading, writing, growing and moving");
+}
+
+static constexpr int FRAME_ALLOCATOR_BENCH_FRAMES = 10000;
+static constexpr int FRAME_ALLOCATOR_BENCH_ITEMS = 256;
+
+struct frameallocatortest1 {
+	uint64_t id = 0;
+	float transform[12] = {};
+};
+
+// Mimics how the renderer builds its list of instances to draw: a fresh array is filled every frame and thrown away
+// once the frame has been drawn.
+template <typename TVector>
+static void frame_allocator_bench_frames() {
+	for (int frame = 0; frame < FRAME_ALLOCATOR_BENCH_FRAMES; frame++) {
+		FrameAllocator::begin_frame();
+
+		TVector instances;
+		for (int i = 0; i < FRAME_ALLOCATOR_BENCH_ITEMS; i++) {
+			frameallocatortest1 inst;
+			inst.id = i;
+			instances.push_back(inst);
+		}
+	}
+}
+
+static void frame_allocator_bench_scratch() {
+	const uint64_t operations = (uint64_t)FRAME_ALLOCATOR_BENCH_FRAMES * FRAME_ALLOCATOR_BENCH_ITEMS;
+
+	uint64_t start = benchmark_get_time_usec();
+	frame_allocator_bench_frames<Vector<frameallocatortest1>>();
+	benchmark_report("Vector per frame", operations, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	frame_allocator_bench_frames<FrameVector<frameallocatortest1>>();
+	benchmark_report("FrameVector per frame", operations, benchmark_get_time_usec() - start);
+}
+
+void frame_allocator_register_benchmarks() {
+	register_benchmark(frame_allocator_bench_scratch, "FrameVector against Vector as a per-frame scratch array");
+}
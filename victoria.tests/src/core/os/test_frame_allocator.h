@@ -0,0 +1,5 @@
+#pragma once
+
+void frame_allocator_register_tests();
+
+void frame_allocator_register_benchmarks();
@@ -0,0 +1,248 @@
+#include "core/os/test_memory.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/local_vector.h>
+#include <core/os/memory.h>
+#include <core/string/vstring.h>
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <thread>
+
+// Large enough for its call site to be among the largest in the report.
+struct memorytest1 {
+	uint64_t values[16384] = {};
+};
+
+static bool memory_test_tags() {
+	MemoryTagStats before = Memory::get_tag_stats(MEMORY_TAG_RENDERING);
+
+	void *block = Memory::vallocate(100, MEMORY_TAG_RENDERING);
+	block = Memory::vreallocate(block, 100, 300);
+	MemoryTagStats during = Memory::get_tag_stats(MEMORY_TAG_RENDERING);
+	Memory::vfree(block, 300);
+	MemoryTagStats after = Memory::get_tag_stats(MEMORY_TAG_RENDERING);
+
+#ifdef DEBUG_ENABLED
+	// Reallocating keeps the tag the block was first allocated with
+	TEST_EQ(during.live_bytes, before.live_bytes + 300);
+	TEST_EQ(during.allocation_count, before.allocation_count + 1);
+	TEST_EQ(during.live_allocation_count, before.live_allocation_count + 1);
+	TEST_EQ((during.peak_bytes >= during.live_bytes), true);
+	TEST_EQ(after.live_bytes, before.live_bytes);
+	TEST_EQ(after.live_allocation_count, before.live_allocation_count);
+
+	// Strings are tracked separately from other containers
+	uint64_t string_bytes = Memory::get_tag_stats(MEMORY_TAG_STRING).live_bytes;
+	String s = "A string that is long enough to need its own buffer";
+	TEST_EQ((Memory::get_tag_stats(MEMORY_TAG_STRING).live_bytes > string_bytes), true);
+
+	uint64_t container_bytes = Memory::get_tag_stats(MEMORY_TAG_CONTAINER).live_bytes;
+	LocalVector<int> vec = {1, 2, 3};
+	uint64_t vec_bytes = vec.get_capacity() * sizeof(int);
+	TEST_EQ(Memory::get_tag_stats(MEMORY_TAG_CONTAINER).live_bytes, container_bytes + vec_bytes);
+#else
+	// Tags are compiled out of release builds
+	TEST_EQ(before.live_bytes, 0u);
+	TEST_EQ(during.allocation_count, 0u);
+	TEST_EQ(after.live_bytes, 0u);
+#endif
+
+	TEST_EQ(String(Memory::get_tag_name(MEMORY_TAG_STRING)), "String");
+
+	return true;
+}
+
+static bool memory_test_report() {
+	memorytest1 *obj = vnew_tagged(memorytest1, MEMORY_TAG_OBJECT);
+	obj->values[16383] = 7;
+	String report = Memory::get_report();
+	vdelete(obj);
+
+	TEST_EQ(report.is_empty(), false);
+#ifdef DEBUG_ENABLED
+	// Every `vnew` is recorded against the file and line it was called from
+	TEST_EQ((report.find("test_memory.cpp:") != -1), true);
+	TEST_EQ((report.find("Object") != -1), true);
+#endif
+
+	return true;
+}
+
+static bool memory_test_sized() {
+	uint64_t usage = Memory::get_memory_usage();
+
+	uint8_t *block = (uint8_t *)Memory::vallocate_zeroed(1000);
+	TEST_EQ(block[999], 0);
+	TEST_EQ(Memory::get_memory_usage(), usage + 1000);
+
+	block[0] = 42;
+	block = (uint8_t *)Memory::vreallocate(block, 1000, 4000);
+	TEST_EQ(block[0], 42);
+	TEST_EQ(Memory::get_memory_usage(), usage + 4000);
+	TEST_EQ((Memory::get_mem_max_usage() >= usage + 4000), true);
+
+	Memory::vfree(block, 4000);
+	TEST_EQ(Memory::get_memory_usage(), usage);
+
+	for (uint64_t alignment = 1; alignment <= 4096; alignment *= 4) {
+		void *aligned = Memory::vallocate_aligned(100, alignment);
+		TEST_EQ(((uintptr_t)aligned % alignment), 0u);
+		Memory::vset_memory(aligned, 0xCD, 100);
+		TEST_EQ(Memory::get_memory_usage(), usage + 100);
+		Memory::vfree_aligned(aligned, 100);
+	}
+	TEST_EQ(Memory::vallocate_aligned(100, 3), nullptr);
+
+	// Objects are freed without their size, so the usage counted for them may be rounded up by the system allocator
+	memorytest1 *obj = vnew(memorytest1);
+	TEST_EQ((Memory::get_memory_usage() >= usage + sizeof(memorytest1)), true);
+	vdelete(obj);
+	TEST_EQ(Memory::get_memory_usage(), usage);
+
+	return true;
+}
+
+static bool memory_test_threads() {
+	constexpr int BLOCK_COUNT = 64;
+	constexpr uint64_t BLOCK_SIZE = 256;
+	uint64_t usage = Memory::get_memory_usage();
+
+	// Blocks allocated on one thread and freed on another must still add up to nothing
+	void *blocks[BLOCK_COUNT];
+	std::thread producer([&blocks]() {
+		for (int i = 0; i < BLOCK_COUNT; i++) {
+			blocks[i] = Memory::vallocate(BLOCK_SIZE);
+		}
+	});
+	producer.join();
+	TEST_EQ(Memory::get_memory_usage(), usage + BLOCK_COUNT * BLOCK_SIZE);
+
+	std::thread consumer([&blocks]() {
+		for (int i = 0; i < BLOCK_COUNT; i++) {
+			Memory::vfree(blocks[i], BLOCK_SIZE);
+		}
+	});
+	consumer.join();
+	TEST_EQ(Memory::get_memory_usage(), usage);
+
+	// A thread that starts after others have exited takes over their counters, which must keep counting correctly
+	void *block = nullptr;
+	std::thread late([&block]() {
+		block = Memory::vallocate(BLOCK_SIZE);
+	});
+	late.join();
+	TEST_EQ(Memory::get_memory_usage(), usage + BLOCK_SIZE);
+	Memory::vfree(block, BLOCK_SIZE);
+	TEST_EQ(Memory::get_memory_usage(), usage);
+
+	return true;
+}
+
+void memory_register_tests() {
+	register_test(memory_test_tags, "Memory tracking live bytes, peaks and allocation counts for each tag");
+	register_test(memory_test_report, "Memory reporting call sites of tagged allocations");
+	register_test(memory_test_sized, "Memory counting sized, reallocated, aligned and unsized allocations");
+	register_test(memory_test_threads, "Memory usage adding up across threads");
+}
+
+static constexpr int MEMORY_BENCH_ALLOCATIONS = 1000000;
+static constexpr int MEMORY_BENCH_LIVE = 64;
+
+// The scheme used before release builds dropped the size header: every block carries its size in front of it, and
+// every allocation and free updates the same two global counters from whichever thread it is on.
+static std::atomic<uint64_t> memory_bench_header_usage{0};
+static std::atomic<uint64_t> memory_bench_header_max_usage{0};
+
+static void *memory_bench_header_allocate(uint64_t p_size) {
+	uint64_t *data = (uint64_t *)malloc(p_size + sizeof(uint64_t));
+	*data = p_size;
+	uint64_t usage = memory_bench_header_usage.fetch_add(p_size) + p_size;
+	uint64_t max = memory_bench_header_max_usage.load();
+	while (usage > max && !memory_bench_header_max_usage.compare_exchange_weak(max, usage)) {
+	}
+	return data + 1;
+}
+
+static void memory_bench_header_free(void *p_block) {
+	uint64_t *data = (uint64_t *)p_block - 1;
+	memory_bench_header_usage.fetch_sub(*data);
+	free(data);
+}
+
+struct MemoryBenchHeader {
+	static void *allocate(uint64_t p_size) {
+		return memory_bench_header_allocate(p_size);
+	}
+
+	static void free(void *p_block, uint64_t) {
+		memory_bench_header_free(p_block);
+	}
+};
+
+struct MemoryBenchSized {
+	static void *allocate(uint64_t p_size) {
+		return Memory::vallocate(p_size);
+	}
+
+	static void free(void *p_block, uint64_t p_size) {
+		Memory::vfree(p_block, p_size);
+	}
+};
+
+// Each thread keeps a small ring of live blocks of varying sizes, as containers and strings would.
+template <typename TAllocator>
+static void memory_bench_thread() {
+	void *live[MEMORY_BENCH_LIVE] = {};
+	uint64_t sizes[MEMORY_BENCH_LIVE] = {};
+	for (int i = 0; i < MEMORY_BENCH_ALLOCATIONS; i++) {
+		int slot = i % MEMORY_BENCH_LIVE;
+		if (live[slot]) {
+			TAllocator::free(live[slot], sizes[slot]);
+		}
+		sizes[slot] = 16 + (i % 15) * 16;
+		live[slot] = TAllocator::allocate(sizes[slot]);
+	}
+
+	for (int i = 0; i < MEMORY_BENCH_LIVE; i++) {
+		TAllocator::free(live[i], sizes[i]);
+	}
+}
+
+template <typename TAllocator>
+static uint64_t memory_bench_run(uint32_t p_thread_count) {
+	uint64_t start = benchmark_get_time_usec();
+	LocalVector<std::thread> threads;
+	for (uint32_t i = 0; i < p_thread_count; i++) {
+		threads.push_back(std::thread(memory_bench_thread<TAllocator>));
+	}
+	for (std::thread &t : threads) {
+		t.join();
+	}
+	return benchmark_get_time_usec() - start;
+}
+
+static void memory_bench_threads() {
+	// Always go up to a few threads, so that there is some contention to measure even on small machines.
+	uint32_t max_threads = std::thread::hardware_concurrency();
+	if (max_threads < 4) {
+		max_threads = 4;
+	}
+
+	for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+		uint64_t operations = (uint64_t)MEMORY_BENCH_ALLOCATIONS * threads;
+		benchmark_report(vformat("Size header, shared counters (%u threads)", threads),
+						 operations,
+						 memory_bench_run<MemoryBenchHeader>(threads));
+		benchmark_report(vformat("Memory::vallocate (%u threads)", threads),
+						 operations,
+						 memory_bench_run<MemoryBenchSized>(threads));
+	}
+}
+
+void memory_register_benchmarks() {
+	register_benchmark(memory_bench_threads, "Memory allocating and freeing from several threads at once");
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void memory_register_tests();
+void memory_register_benchmarks();
@@ -0,0 +1,77 @@
+#include "core/os/test_thread.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/os/mutex.h>
+#include <core/os/semaphore.h>
+#include <core/os/thread.h>
+
+struct threadtest1 {
+	Semaphore ping;
+	Semaphore pong;
+	BinaryMutex mutex;
+	int counter = 0;
+	Thread::ID id = Thread::UNASSIGNED_ID;
+};
+
+static void thread_test_ping_pong(void *p_userdata) {
+	threadtest1 *data = (threadtest1 *)p_userdata;
+	data->id = Thread::get_caller_id();
+
+	for (int i = 0; i < 100; i++) {
+		data->ping.wait();
+		{
+			MutexLock<BinaryMutex> lock(data->mutex);
+			data->counter++;
+		}
+		data->pong.post();
+	}
+}
+
+static bool thread_test_semaphore() {
+	TEST_EQ(Thread::get_caller_id(), Thread::MAIN_ID);
+	TEST_EQ(Thread::is_main_thread(), true);
+	TEST_EQ((Thread::get_hardware_concurrency() >= 1u), true);
+
+	threadtest1 data;
+	Thread thread;
+	TEST_EQ(thread.is_started(), false);
+	thread.start(thread_test_ping_pong, &data);
+	TEST_EQ(thread.is_started(), true);
+
+	// Each round trip only completes once the other thread has seen the previous one. Checked after the thread
+	// finishes, as returning early would leave it waiting forever.
+	bool in_step = true;
+	for (int i = 0; i < 100; i++) {
+		data.ping.post();
+		data.pong.wait();
+		MutexLock<BinaryMutex> lock(data.mutex);
+		in_step = in_step && data.counter == i + 1;
+	}
+
+	thread.wait_to_finish();
+	TEST_EQ(in_step, true);
+	TEST_EQ(thread.is_started(), false);
+	TEST_NEQ(data.id, Thread::MAIN_ID);
+	TEST_NEQ(data.id, Thread::UNASSIGNED_ID);
+
+	TEST_EQ(data.ping.try_wait(), false);
+	data.ping.post(2);
+	TEST_EQ(data.ping.get(), 2u);
+	TEST_EQ(data.ping.try_wait(), true);
+	TEST_EQ(data.ping.try_wait(), true);
+	TEST_EQ(data.ping.try_wait(), false);
+
+	// Unlike a `BinaryMutex`, a `Mutex` can be locked again by the thread holding it.
+	Mutex recursive;
+	MutexLock<Mutex> outer(recursive);
+	TEST_EQ(recursive.try_lock(), true);
+	recursive.unlock();
+
+	return true;
+}
+
+void thread_register_tests() {
+	register_test(thread_test_semaphore, "Thread, Semaphore and Mutex handing work between two threads");
+}
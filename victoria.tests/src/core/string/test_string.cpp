@@ -0,0 +1,153 @@
+#include "core/string/test_string.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/hashtable.h>
+#include <core/data/vector.h>
+#include <core/os/memory.h>
+#include <core/string/vstring.h>
+
+static bool string_test_inline() {
+	uint64_t usage = Memory::get_memory_usage();
+
+	// Short strings never allocate
+	String a = "root";
+	String b = "Text1";
+	String c = a;
+	c += "_child";
+	TEST_EQ(a.is_inline(), true);
+	TEST_EQ(c.is_inline(), true);
+	TEST_EQ(Memory::get_memory_usage(), usage);
+	TEST_EQ(c, "root_child");
+	TEST_EQ(a, "root");
+	TEST_EQ(b.length(), 5);
+
+	// Appending past the inline capacity moves the string to the heap, keeping its contents
+	String d = "0123456789";
+	d += "0123456789";
+	d += "012";
+	TEST_EQ(d.length(), String::INLINE_CAPACITY);
+	TEST_EQ(d.is_inline(), true);
+	d += "3";
+	TEST_EQ(d.is_inline(), false);
+	TEST_EQ(d, "012345678901234567890123");
+	TEST_EQ((Memory::get_memory_usage() > usage), true);
+
+	// Long strings are shared between copies until one is written to
+	String e = d;
+	e.set(0, 'X');
+	TEST_EQ(d[0], '0');
+	TEST_EQ(e[0], 'X');
+
+	// Shrinking a heap string that fits inline moves it back
+	e = e.left(4);
+	e.shrink_to_fit();
+	TEST_EQ(e.is_inline(), true);
+	TEST_EQ(e, "X123");
+
+	String moved = std::move(d);
+	TEST_EQ(d.is_empty(), true);
+	TEST_EQ(moved.length(), 24);
+
+	moved.clear();
+	e.clear();
+	TEST_EQ(moved.is_inline(), true);
+	TEST_EQ(Memory::get_memory_usage(), usage);
+
+	TEST_EQ((String() == ""), true);
+	TEST_EQ((String() == String("")), true);
+	TEST_EQ(vformat("%s%d", "Node", 12), "Node12");
+	TEST_EQ(vformat("%2000d", 1).length(), 2000);
+
+	return true;
+}
+
+static bool string_test_hash() {
+	String a = "A string that is long enough to be stored on the heap";
+	String b = "A string that is long enough to be stored on the heap";
+	uint32_t hash = a.hash();
+	TEST_EQ(hash, b.hash());
+	TEST_EQ(hash, hash_string(a.get_data(), a.length()));
+
+	// Writing to a string must forget the hash it had, but not the hash of its copies
+	String c = a;
+	c[0] = 'a';
+	TEST_EQ((c.hash() != hash), true);
+	TEST_EQ(a.hash(), hash);
+
+	String d = "short";
+	uint32_t short_hash = d.hash();
+	d += '!';
+	TEST_EQ((d.hash() != short_hash), true);
+	TEST_EQ(d.hash(), hash_string("short!", 6));
+
+	HashTable<String, int> h;
+	h.insert("root", 1);
+	h.insert(a, 2);
+	TEST_EQ(h["root"], 1);
+	TEST_EQ(h[b], 2);
+	TEST_EQ(h.has(c), false);
+
+	return true;
+}
+
+void string_register_tests() {
+	register_test(string_test_inline, "String storing short strings inline and moving long ones to the heap");
+	register_test(string_test_hash, "String caching its hash until it is written to");
+}
+
+static constexpr int STRING_BENCH_ITERATIONS = 1000000;
+
+struct stringtest1 {
+	String name;
+
+	// Matches what `GameObject::set_name` does with the names generated when adding children.
+	void set_name(const String &p_name) {
+		name = p_name;
+		name.replace(' ', '_');
+	}
+};
+
+static void string_bench_set_name() {
+	const String class_names[] = {"GameObject", "Label", "VBoxContainer", "MeshInstance3D"};
+	stringtest1 objects[64];
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < STRING_BENCH_ITERATIONS; i++) {
+		String name = class_names[i % 4];
+		name += itos(i % 100);
+		objects[i % 64].set_name(name);
+	}
+	benchmark_report("set_name", STRING_BENCH_ITERATIONS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < STRING_BENCH_ITERATIONS; i++) {
+		objects[i % 64].set_name(vformat("%s%d", class_names[i % 4].get_data(), i % 100));
+	}
+	benchmark_report("vformat", STRING_BENCH_ITERATIONS, benchmark_get_time_usec() - start);
+}
+
+static void string_bench_lookup() {
+	constexpr int key_count = 1024;
+	Vector<String> keys;
+	HashTable<String, int> h;
+	for (int i = 0; i < key_count; i++) {
+		String key = vformat("Node%d", i);
+		keys.push_back(key);
+		h.insert(key, i);
+	}
+
+	int64_t found = 0;
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < STRING_BENCH_ITERATIONS * 4; i++) {
+		found += h.get_ptr(keys[(i * 7) % key_count]) != nullptr;
+	}
+	benchmark_report("HashTable<String> lookup", STRING_BENCH_ITERATIONS * 4, benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(found == 0);
+}
+
+void string_register_benchmarks() {
+	register_benchmark(string_bench_set_name, "String building short names");
+	register_benchmark(string_bench_lookup, "String as a HashTable key");
+}
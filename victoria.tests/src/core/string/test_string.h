@@ -0,0 +1,5 @@
+#pragma once
+
+void string_register_tests();
+
+void string_register_benchmarks();
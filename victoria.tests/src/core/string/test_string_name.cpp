@@ -0,0 +1,128 @@
+#include "core/string/test_string_name.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/flat_hashtable.h>
+#include <core/data/hashtable.h>
+#include <core/data/vector.h>
+#include <core/object/object.h>
+#include <core/string/string_name.h>
+#include <core/string/vstring.h>
+
+static bool string_name_test_intern() {
+	StringName a = "string_name_test";
+	StringName b = String("string_name_") + String("test");
+	StringName c = "string_name_other";
+	TEST_EQ((a == b), true);
+	TEST_EQ((a != c), true);
+	TEST_EQ(a.hash(), b.hash());
+	TEST_EQ(a.get_data(), b.get_data()); // Both point at the same entry
+
+	TEST_EQ((a == "string_name_test"), true);
+	TEST_EQ((a == String("string_name_test")), true);
+	TEST_EQ((a != "string_name_tes"), true);
+	TEST_EQ(a.get_string(), "string_name_test");
+
+	uint32_t count = StringName::get_interned_count();
+	StringName d = "string_name_test";
+	TEST_EQ((d == a), true);
+	TEST_EQ(StringName::get_interned_count(), count);
+	TEST_EQ(StringName::search("string_name_test"), a);
+	TEST_EQ(StringName::search("string_name_never_interned").is_empty(), true);
+
+	StringName empty;
+	TEST_EQ(empty.is_empty(), true);
+	TEST_EQ((empty == StringName("")), true);
+	TEST_EQ((empty == ""), true);
+	TEST_EQ(String(empty.get_data()).is_empty(), true);
+
+	TEST_EQ((SNAME("string_name_test") == a), true);
+
+	return true;
+}
+
+static bool string_name_test_keys() {
+	HashTable<StringName, int> h;
+	FlatHashTable<StringName, int> fh;
+	for (int i = 0; i < 100; i++) {
+		StringName name = vformat("string_name_key%d", i);
+		h.insert(name, i);
+		fh.insert(name, i);
+	}
+
+	TEST_EQ(h.size(), 100);
+	TEST_EQ(h[StringName("string_name_key42")], 42);
+	TEST_EQ(fh[StringName("string_name_key99")], 99);
+	TEST_EQ(fh.has(StringName("string_name_key100")), false);
+
+	// Class names are interned once, and the same name is returned through every path
+	Object obj;
+	TEST_EQ((obj.get_class_name() == Object::get_class_name_static()), true);
+	TEST_EQ((&obj.get_class_name() == &Object::get_class_name_static()), true);
+	TEST_EQ((obj.get_class_name() == "Object"), true);
+	TEST_EQ(Object::get_inherited_class_name_static().is_empty(), true);
+
+	return true;
+}
+
+void string_name_register_tests() {
+	register_test(string_name_test_intern, "StringName interning, comparing and searching names");
+	register_test(string_name_test_keys, "StringName as a hash table key and as class names");
+}
+
+static constexpr int STRING_NAME_BENCH_NAMES = 256;
+static constexpr int STRING_NAME_BENCH_LOOKUPS = 4000000;
+
+template <typename TKey>
+static void string_name_bench_lookup(const char *p_label) {
+	// Signal and class names are short identifiers that mostly share a prefix.
+	Vector<TKey> keys;
+	FlatHashTable<TKey, int> h;
+	for (int i = 0; i < STRING_NAME_BENCH_NAMES; i++) {
+		TKey key = TKey(vformat("signal_name_%d", i));
+		keys.push_back(key);
+		h.insert(key, i);
+	}
+
+	int64_t found = 0;
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < STRING_NAME_BENCH_LOOKUPS; i++) {
+		found += h.get_ptr(keys[(i * 7) % STRING_NAME_BENCH_NAMES]) != nullptr;
+	}
+	benchmark_report(p_label, STRING_NAME_BENCH_LOOKUPS, benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(found == 0);
+}
+
+static void string_name_bench_compare() {
+	const char *names[] = {"GameObject", "GameObject3D", "CanvasItem", "UIObject", "Viewport", "VBoxContainer"};
+	constexpr int name_count = sizeof(names) / sizeof(names[0]);
+
+	String strings[name_count];
+	StringName string_names[name_count];
+	for (int i = 0; i < name_count; i++) {
+		strings[i] = names[i];
+		string_names[i] = names[i];
+	}
+
+	int64_t matches = 0;
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < STRING_NAME_BENCH_LOOKUPS; i++) {
+		matches += strings[i % name_count] == strings[(i / name_count) % name_count];
+	}
+	benchmark_report("String compare", STRING_NAME_BENCH_LOOKUPS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < STRING_NAME_BENCH_LOOKUPS; i++) {
+		matches += string_names[i % name_count] == string_names[(i / name_count) % name_count];
+	}
+	benchmark_report("StringName compare", STRING_NAME_BENCH_LOOKUPS, benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(matches == 0);
+
+	string_name_bench_lookup<String>("FlatHashTable lookup (String)");
+	string_name_bench_lookup<StringName>("FlatHashTable lookup (StringName)");
+}
+
+void string_name_register_benchmarks() {
+	register_benchmark(string_name_bench_compare, "StringName against String for comparing and looking up names");
+}
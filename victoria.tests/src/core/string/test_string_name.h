@@ -0,0 +1,5 @@
+#pragma once
+
+void string_name_register_tests();
+
+void string_name_register_benchmarks();
@@ -0,0 +1,172 @@
+#include "core/string/test_string_view.h"
+
+#include "test_macros.h"
+#include "test_manager.h"
+
+#include <core/data/vector.h>
+#include <core/string/string_view.h>
+#include <core/string/vstring.h>
+
+static bool string_view_test_slice() {
+	String s = "vt 0.5 -1.25";
+	StringView v = s.view();
+	TEST_EQ(v.length(), s.length());
+	TEST_EQ((v.ptr() == s.get_data()), true);
+
+	TEST_EQ(v.find("0.5"), 3);
+	TEST_EQ(v.find("0.5", 4), -1);
+	TEST_EQ(v.find("-1.25"), 7);
+	TEST_EQ(v.find("1.250"), -1);
+	TEST_EQ(v.find_char(' ', 3), 6);
+	TEST_EQ(StringView("aab").find("ab"), 1);
+	TEST_EQ(v.begins_with("vt "), true);
+	TEST_EQ(v.ends_with("1.25"), true);
+	TEST_EQ(v.ends_with("vt 0.5 -1.25 "), false);
+
+	TEST_EQ((v.substr(3, 3) == "0.5"), true);
+	TEST_EQ((v.substr(7) == "-1.25"), true);
+	TEST_EQ(v.substr(20).is_empty(), true);
+	TEST_EQ((v.left(2) == "vt"), true);
+	TEST_EQ((v.left(-6) == "vt 0.5"), true);
+	TEST_EQ((v.right(4) == "1.25"), true);
+	TEST_EQ((v.right(-7) == "-1.25"), true);
+	TEST_EQ((s.substr_view(3, 3).ptr() == s.get_data() + 3), true); // No copy was made
+	TEST_EQ((StringView(" \tf 1/2/3\r\n").strip_edges() == "f 1/2/3"), true);
+
+	TEST_EQ(String(v.substr(3, 3)), "0.5");
+	TEST_EQ(String(StringView()).is_empty(), true);
+
+	return true;
+}
+
+static bool string_view_test_split() {
+	StringView v = "f 1/2/3  4//6 ";
+
+	StringView expected[] = {"f", "1/2/3", "", "4//6", ""};
+	int count = 0;
+	for (const StringView &piece : v.split(" ")) {
+		TEST_EQ((count < 5), true);
+		TEST_EQ((piece == expected[count]), true);
+		count++;
+	}
+	TEST_EQ(count, 5);
+	TEST_EQ(v.split(" ", false).size(), 3);
+
+	StringView parts[3];
+	count = 0;
+	for (const StringView &part : StringView("4//6").split("/")) {
+		parts[count++] = part;
+	}
+	TEST_EQ(count, 3);
+	TEST_EQ(parts[1].is_empty(), true);
+	TEST_EQ(parts[2].to_int(), 6);
+
+	TEST_EQ(StringView("a::b::c").split("::").size(), 3);
+	TEST_EQ(StringView("").split(",").size(), 1);
+	TEST_EQ(StringView("").split(",", false).size(), 0);
+	TEST_EQ(StringView("abc").split("").size(), 1);
+
+	// String::split produces the same pieces as an owning vector
+	Vector<String> sv = String("a,b,,c").split(",");
+	TEST_EQ(sv.size(), 4);
+	TEST_EQ(sv[2].is_empty(), true);
+	TEST_EQ(sv[3], "c");
+
+	return true;
+}
+
+static bool string_view_test_parse() {
+	TEST_EQ(StringView("42").to_int(), 42);
+	TEST_EQ(StringView("-17").to_int(), -17);
+	TEST_EQ(StringView("+8/9").to_int(), 8);
+	TEST_EQ(StringView("9223372036854775807").to_int(), 9223372036854775807LL);
+	TEST_EQ(StringView("").to_int(), 0);
+
+	TEST_EQ(StringView("1.5").to_float(), 1.5);
+	TEST_EQ(StringView("-0.25").to_float(), -0.25);
+	TEST_EQ(StringView("0.1").to_float(), 0.1);
+	TEST_EQ(StringView("-3").to_float(), -3.0);
+	TEST_EQ(StringView(".5").to_float(), 0.5);
+	TEST_EQ(StringView("2.5e3").to_float(), 2500.0);
+	TEST_EQ(StringView("1E-2").to_float(), 0.01);
+	TEST_EQ(StringView("0.000001").to_float(), 0.000001);
+	TEST_EQ(StringView("123456.789").to_float(), 123456.789);
+
+	// The String parsers go through the same code
+	TEST_EQ(String("-0.5").to_float(), -0.5);
+	TEST_EQ(String("12").to_float(), 12.0);
+	TEST_EQ(String("-12").to_int(), -12);
+
+	return true;
+}
+
+void string_view_register_tests() {
+	register_test(string_view_test_slice, "StringView finding and slicing without copying");
+	register_test(string_view_test_split, "StringView splitting into ranges of views");
+	register_test(string_view_test_parse, "StringView parsing integers and floats");
+}
+
+static constexpr int STRING_VIEW_BENCH_LINES = 100000;
+
+static void string_view_bench_parse() {
+	// A mix of lines as they appear in an OBJ file.
+	String contents;
+	for (int i = 0; i < STRING_VIEW_BENCH_LINES; i++) {
+		switch (i % 4) {
+			case 0: {
+				contents += vformat("v %d.%06d -%d.%06d %d.%06d\n", i % 10, i, i % 7, i * 3, i % 5, i * 7);
+			} break;
+			case 1: {
+				contents += vformat("vn 0.%06d -0.%06d 0.%06d\n", i, i * 3, i * 7);
+			} break;
+			case 2: {
+				contents += vformat("vt 0.%06d 0.%06d\n", i, i * 3);
+			} break;
+			default: {
+				contents += vformat("f %d/%d/%d %d/%d/%d %d/%d/%d\n", i, i + 1, i + 2, i + 3, i + 4, i + 5, i, i, i);
+			} break;
+		}
+	}
+
+	double sum = 0.0;
+	uint64_t start = benchmark_get_time_usec();
+	for (const String &line : contents.split("\n")) {
+		Vector<String> tokens = line.split(" ");
+		for (int i = 1; i < tokens.size(); i++) {
+			if (tokens[0] == "f") {
+				for (const String &index : tokens[i].split("/")) {
+					sum += index.to_int();
+				}
+			} else {
+				sum += tokens[i].to_float();
+			}
+		}
+	}
+	benchmark_report("String::split lines", STRING_VIEW_BENCH_LINES, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (const StringView &line : contents.split_view("\n")) {
+		bool face = line.begins_with("f ");
+		bool first = true;
+		for (const StringView &token : line.split(" ", false)) {
+			if (first) {
+				first = false;
+				continue;
+			}
+
+			if (face) {
+				for (const StringView &index : token.split("/")) {
+					sum += index.to_int();
+				}
+			} else {
+				sum += token.to_float();
+			}
+		}
+	}
+	benchmark_report("StringView::split lines", STRING_VIEW_BENCH_LINES, benchmark_get_time_usec() - start);
+	ERR_FAIL_COND(sum == 0.0);
+}
+
+void string_view_register_benchmarks() {
+	register_benchmark(string_view_bench_parse, "Parsing OBJ-style lines with String and StringView");
+}
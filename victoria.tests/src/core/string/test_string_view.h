@@ -0,0 +1,5 @@
+#pragma once
+
+void string_view_register_tests();
+
+void string_view_register_benchmarks();
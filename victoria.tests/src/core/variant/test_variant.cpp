@@ -32,7 +32,127 @@ static bool variant_test_strings() {
 	return true;
 }
 
+static bool variant_test_conversions() {
+	Variant v = 3.75;
+	TEST_EQ((int64_t)v, 3);
+	TEST_EQ((bool)v, true);
+	TEST_EQ((float)Variant(2), 2.0f);
+	TEST_EQ((bool)Variant(), false);
+	TEST_EQ((String)Variant(12), "12");
+
+	Vector3 v3 = Variant(Vector2i(1, 2));
+	TEST_EQ(v3.x, 1.0);
+	TEST_EQ(v3.y, 2.0);
+	TEST_EQ(v3.z, 0.0);
+	Vector2i v2i = Variant(Vector4(1.5, 2.5, 3.5, 4.5));
+	TEST_EQ(v2i.x, 1);
+	TEST_EQ(v2i.y, 2);
+
+	// Types that cannot be converted give the default value.
+	TEST_EQ(Vector2(Variant("text")).x, 0.0);
+	TEST_EQ(Int32Array(Variant(12)).size(), 0);
+	return true;
+}
+
+static bool variant_test_equality() {
+	TEST_EQ((Variant() == Variant()), true);
+	TEST_EQ((Variant(1) == Variant(1.0)), false);
+	TEST_EQ((Variant(Vector3(1.0, 2.0, 3.0)) == Variant(Vector3(1.0, 2.0, 3.0))), true);
+	TEST_EQ((Variant(Vector3i(1, 2, 3)) == Variant(Vector3i(1, 2, 4))), false);
+
+	Float32Array floats;
+	floats.push_back(1.0f);
+	floats.push_back(2.0f);
+	Variant a = floats;
+	Variant b = floats;
+	TEST_EQ((a == b), true);
+	TEST_EQ(a.hash(), b.hash());
+	floats.push_back(3.0f);
+	b = floats;
+	TEST_EQ((a == b), false);
+
+	TEST_EQ(Variant("text").hash(), Variant(String("text")).hash());
+	TEST_EQ(Variant::construct(Variant::VECTOR4I).get_type(), Variant::VECTOR4I);
+	TEST_EQ((Variant::construct(Variant::INT) == Variant(0)), true);
+	return true;
+}
+
+static bool variant_test_evaluate() {
+	Variant ret;
+	TEST_EQ(Variant::evaluate(Variant::OP_ADD, 2, 3, ret), true);
+	TEST_EQ(ret.get_type(), Variant::INT);
+	TEST_EQ((int64_t)ret, 5);
+
+	TEST_EQ(Variant::evaluate(Variant::OP_MULTIPLY, 2, 1.5, ret), true);
+	TEST_EQ(ret.get_type(), Variant::FLOAT);
+	TEST_EQ((double)ret, 3.0);
+
+	TEST_EQ(Variant::evaluate(Variant::OP_DIVIDE, 1, 0, ret), false);
+	TEST_EQ((double)ret, 3.0);
+	TEST_EQ(Variant::evaluate(Variant::OP_DIVIDE, INT64_MIN, (int64_t)-1, ret), false);
+	TEST_EQ(Variant::evaluate(Variant::OP_DIVIDE, Vector2i(INT64_MIN, 4), Vector2i(-1, 2), ret), false);
+
+	TEST_EQ(Variant::evaluate(Variant::OP_SUBTRACT, Vector2(3.0, 4.0), Vector2(1.0, 1.0), ret), true);
+	TEST_EQ((ret == Variant(Vector2(2.0, 3.0))), true);
+	TEST_EQ(Variant::evaluate(Variant::OP_MULTIPLY, 2, Vector3i(1, 2, 3), ret), true);
+	TEST_EQ((ret == Variant(Vector3i(2, 4, 6))), true);
+	TEST_EQ(Variant::evaluate(Variant::OP_DIVIDE, Vector2i(4, 4), Vector2i(2, 0), ret), false);
+
+	TEST_EQ(Variant::evaluate(Variant::OP_ADD, "Hello, ", "World!", ret), true);
+	TEST_EQ(ret, "Hello, World!");
+	TEST_EQ(Variant::evaluate(Variant::OP_ADD, "text", 1, ret), false);
+	return true;
+}
+
 void variant_register_tests() {
 	register_test(variant_test_atomic, "Variant creation and casting from atomic datatypes.");
 	register_test(variant_test_strings, "Variant creation and casting from string datatypes.");
-}
\ No newline at end of file
+	register_test(variant_test_conversions, "Variant conversions between types.");
+	register_test(variant_test_equality, "Variant equality and hashing.");
+	register_test(variant_test_evaluate, "Variant evaluation of arithmetic operators.");
+}
+
+static constexpr int VARIANT_BENCH_OPERATIONS = 1000000;
+
+static void variant_bench_mixed_types() {
+	Int32Array ints;
+	ints.push_back(1);
+	ints.push_back(2);
+	const Variant values[8] = {
+		true, 12, 3.5, "text", Vector2(1.0, 2.0), Vector3i(1, 2, 3), Vector4(1.0, 2.0, 3.0, 4.0), ints};
+	double sum = 0.0;
+
+	uint64_t start = benchmark_get_time_usec();
+	for (int i = 0; i < VARIANT_BENCH_OPERATIONS; i++) {
+		Variant c = values[i & 7];
+		c = values[(i * 3 + 1) & 7];
+		sum += c.get_type();
+	}
+	benchmark_report("Copies", VARIANT_BENCH_OPERATIONS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < VARIANT_BENCH_OPERATIONS; i++) {
+		const Variant &a = values[i & 7];
+		const Variant &b = values[(i * 3 + 1) & 7];
+		sum += (int64_t)a + (double)b + Vector3(a).x + Vector2i(b).y;
+	}
+	benchmark_report("Conversions", VARIANT_BENCH_OPERATIONS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < VARIANT_BENCH_OPERATIONS; i++) {
+		sum += (values[i & 7] == values[(i * 3 + 1) & 7]) + (values[i & 7] == values[(i * 5) & 7]);
+	}
+	benchmark_report("Comparisons", VARIANT_BENCH_OPERATIONS, benchmark_get_time_usec() - start);
+
+	start = benchmark_get_time_usec();
+	for (int i = 0; i < VARIANT_BENCH_OPERATIONS; i++) {
+		sum += values[i & 7].stringify().length();
+	}
+	benchmark_report("Stringify", VARIANT_BENCH_OPERATIONS, benchmark_get_time_usec() - start);
+
+	ERR_FAIL_COND(sum == 0.0);
+}
+
+void variant_register_benchmarks() {
+	register_benchmark(variant_bench_mixed_types, "Variant operations on values of mixed types");
+}
@@ -1,3 +1,5 @@
 #pragma once
 
-void variant_register_tests();
\ No newline at end of file
+void variant_register_tests();
+
+void variant_register_benchmarks();
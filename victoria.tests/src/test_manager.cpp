@@ -2,12 +2,31 @@
 
 #include "test_macros.h"
 
+#include "core/data/test_flat_hashtable.h"
+#include "core/data/test_flat_map.h"
+#include "core/data/test_hashfuncs.h"
 #include "core/data/test_hashtable.h"
 #include "core/data/test_list.h"
+#include "core/data/test_local_vector.h"
+#include "core/data/test_paged_allocator.h"
 #include "core/data/test_vector.h"
 #include "core/data/vector.h"
+#include "core/io/test_marshalls.h"
 #include "core/math/test_mat4.h"
 #include "core/math/test_quaternion.h"
+#include "core/object/test_callable_method.h"
+#include "core/object/test_command_queue.h"
+#include "core/object/test_method_bind.h"
+#include "core/object/test_object.h"
+#include "core/object/test_task_graph.h"
+#include "core/object/test_thread_safe_command_queue.h"
+#include "core/object/test_worker_thread_pool.h"
+#include "core/os/test_frame_allocator.h"
+#include "core/os/test_memory.h"
+#include "core/os/test_thread.h"
+#include "core/string/test_string.h"
+#include "core/string/test_string_name.h"
+#include "core/string/test_string_view.h"
 #include "core/variant/test_array.h"
 #include "core/variant/test_variant.h"
 
@@ -22,29 +41,113 @@ struct Test {
 	}
 };
 
+struct Benchmark {
+	PFN_benchmark func = nullptr;
+	const char *desc;
+
+	Benchmark() {}
+	Benchmark(PFN_benchmark p_func, const char *p_desc) {
+		func = p_func;
+		desc = p_desc;
+	}
+};
+
 // Put faith in our ability to write code
 
 static Vector<Test> tests;
+static Vector<Benchmark> benchmarks;
 
 void register_test(PFN_test p_test, const char *p_desc) {
 	Test t(p_test, p_desc);
 	tests.push_back(t);
 }
 
+void register_benchmark(PFN_benchmark p_benchmark, const char *p_desc) {
+	Benchmark b(p_benchmark, p_desc);
+	benchmarks.push_back(b);
+}
+
+uint64_t benchmark_get_time_usec() {
+	return OS::get_singleton()->get_current_time_usec();
+}
+
+void benchmark_report(const char *p_label, uint64_t p_operations, uint64_t p_usec) {
+	double seconds = p_usec > 0 ? (double)p_usec / 1000000.0 : 1e-6;
+	MESSAGE("\t%-48s %10.3f ms  %12.3f Mops/s",
+			p_label,
+			(double)p_usec / 1000.0,
+			(double)p_operations / seconds / 1000000.0);
+}
+
+void benchmark_report_bytes(const char *p_label, uint64_t p_bytes, uint64_t p_usec) {
+	double seconds = p_usec > 0 ? (double)p_usec / 1000000.0 : 1e-6;
+	MESSAGE("\t%-48s %10.3f ms  %12.3f MB/s",
+			p_label,
+			(double)p_usec / 1000.0,
+			(double)p_bytes / seconds / 1000000.0);
+}
+
 /**
  * @brief Calls every `register_test` function to properly append the tests and allow for them to be called when we run
  * the tests.
  */
 void register_all_tests() {
 	vector_register_tests();
+	local_vector_register_tests();
 	list_register_tests();
+	hashfuncs_register_tests();
 	hashtable_register_tests();
+	flat_hashtable_register_tests();
+	flat_map_register_tests();
+	paged_allocator_register_tests();
 
 	mat4_register_tests();
 	quaternion_register_tests();
 
+	memory_register_tests();
+	frame_allocator_register_tests();
+	thread_register_tests();
+	callable_method_register_tests();
+	command_queue_register_tests();
+	object_register_tests();
+	method_bind_register_tests();
+	worker_thread_pool_register_tests();
+	task_graph_register_tests();
+	thread_safe_command_queue_register_tests();
+
+	string_register_tests();
+	string_name_register_tests();
+	string_view_register_tests();
+
 	variant_register_tests();
 	array_register_tests();
+	marshalls_register_tests();
+}
+
+/**
+ * @brief Calls every `register_benchmark` function so that they can be ran when requested on the command line.
+ */
+void register_all_benchmarks() {
+	vector_register_benchmarks();
+	local_vector_register_benchmarks();
+	hashfuncs_register_benchmarks();
+	flat_hashtable_register_benchmarks();
+	flat_map_register_benchmarks();
+	paged_allocator_register_benchmarks();
+	memory_register_benchmarks();
+	frame_allocator_register_benchmarks();
+	callable_method_register_benchmarks();
+	command_queue_register_benchmarks();
+	object_register_benchmarks();
+	method_bind_register_benchmarks();
+	worker_thread_pool_register_benchmarks();
+	task_graph_register_benchmarks();
+	thread_safe_command_queue_register_benchmarks();
+	string_register_benchmarks();
+	string_name_register_benchmarks();
+	string_view_register_benchmarks();
+	variant_register_benchmarks();
+	marshalls_register_benchmarks();
 }
 
 /**
@@ -69,12 +172,36 @@ void run_all_tests() {
 	MESSAGE("All tests have now ran.\nPASSED: %i\nFAILED: %i", passed, failed);
 }
 
-int main(void) {
+/**
+ * @brief Runs every registered benchmark, in the order they were registered in. Results are printed by the benchmarks
+ * themselves.
+ */
+void run_all_benchmarks() {
+	for (int i = 0; i < benchmarks.size(); i++) {
+		MESSAGE("BENCHMARK: %s", benchmarks[i].desc);
+		benchmarks[i].func();
+	}
+}
+
+int main(int argc, char *argv[]) {
 	// Needs stdout for pretty-printing.
 	(void)OS::create();
 
+	bool run_benchmarks = false;
+	for (int i = 1; i < argc; i++) {
+		if (vstring_compare(argv[i], "--bench")) {
+			run_benchmarks = true;
+		}
+	}
+
 	register_all_tests();
+	register_all_benchmarks();
 	run_all_tests();
+
+	if (run_benchmarks) {
+		run_all_benchmarks();
+	}
+
 	OS::destroy();
 	return 0;
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <core/typedefs.h>
+
 typedef bool (*PFN_test)();
+typedef void (*PFN_benchmark)();
 
 /**
  * @brief Registers a test to be ran. Adds it to the end of an array from which it can then be called in order,
@@ -10,3 +13,32 @@ typedef bool (*PFN_test)();
  * included in the description.
  */
 void register_test(PFN_test p_test, const char *p_desc);
+
+/**
+ * @brief Registers a benchmark to be ran. Benchmarks are only ran when the binary is launched with `--bench`, after
+ * every test has been ran, and are expected to report their own results through `benchmark_report`.
+ * @param p_benchmark The function pointer of the benchmark to register.
+ * @param p_desc A description of what the benchmark measures.
+ */
+void register_benchmark(PFN_benchmark p_benchmark, const char *p_desc);
+
+/**
+ * @brief Obtains the current time in microseconds, for timing sections of a benchmark.
+ */
+uint64_t benchmark_get_time_usec();
+
+/**
+ * @brief Prints the result of a timed section of a benchmark, alongside the number of operations performed per second.
+ * @param p_label A short description of the section that was timed.
+ * @param p_operations The number of operations performed inside of the timed section.
+ * @param p_usec The time the section took, in microseconds.
+ */
+void benchmark_report(const char *p_label, uint64_t p_operations, uint64_t p_usec);
+
+/**
+ * @brief Prints the result of a timed section of a benchmark, alongside the number of bytes processed per second.
+ * @param p_label A short description of the section that was timed.
+ * @param p_bytes The number of bytes processed inside of the timed section.
+ * @param p_usec The time the section took, in microseconds.
+ */
+void benchmark_report_bytes(const char *p_label, uint64_t p_bytes, uint64_t p_usec);